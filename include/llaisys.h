@@ -49,11 +49,14 @@ typedef enum {
     LLAISYS_DTYPE_C64 = 17,
     LLAISYS_DTYPE_C128 = 18,
     LLAISYS_DTYPE_BF16 = 19,
+    LLAISYS_DTYPE_F8E5M2 = 20, // LLAISYS_DTYPE_F8 is E4M3
 } llaisysDataType_t;
 
 // Runtime Types
 // Stream
 typedef void *llaisysStream_t;
+// Event: marks a position in a stream for cross-stream dependencies
+typedef void *llaisysEvent_t;
 
 // Memory Copy Directions
 typedef enum {
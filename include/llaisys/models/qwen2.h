@@ -1,6 +1,7 @@
 #ifndef LLAISYS_MODELS_QWEN2_H
 #define LLAISYS_MODELS_QWEN2_H
 
+#include "../ops.h"
 #include "../tensor.h"
 
 __C {
@@ -29,14 +30,150 @@ __C {
         llaisysTensor_t *mlp_down_w;
     };
 
+    // Weight-only quantization schemes for llaisysQwen2ModelQuantize.
+    typedef enum {
+        LLAISYS_QWEN2_QUANT_NONE = 0,
+        // Symmetric int8 with one float32 scale per output channel.
+        LLAISYS_QWEN2_QUANT_INT8 = 1,
+        // 4-bit, one float16 scale per group of `group_size` input features, symmetric.
+        LLAISYS_QWEN2_QUANT_INT4 = 2,
+        // As INT4, plus one uint8 zero point per group (asymmetric min/max range).
+        LLAISYS_QWEN2_QUANT_INT4_ZP = 3,
+        // FP8 E4M3 (LLAISYS_DTYPE_F8) with one float32 scale per output channel; keeps
+        // relative precision on outlier-heavy rows better than int8/int4.
+        LLAISYS_QWEN2_QUANT_FP8 = 4,
+        // As FP8 with E5M2 (LLAISYS_DTYPE_F8E5M2): wider range, one mantissa bit less.
+        LLAISYS_QWEN2_QUANT_FP8_E5M2 = 5,
+    } llaisysQwen2Quant_t;
+
     struct LlaisysQwen2Model;
 
+    // `device_ids` (ndevice entries, NULL/0 for device 0) selects where the model runs. With more
+    // than one CPU device the layers are split by tensor parallelism: every device (one per NUMA
+    // node, see get_device_count in runtime.h) holds a contiguous group of KV heads and a slice of the
+    // MLP intermediate columns in node-local memory and computes them on its node-pinned stream;
+    // the partial outputs of o_proj and down_proj are summed across devices (all-reduce through
+    // shared memory). Embedding, lm_head and sampling stay on CPU device 0. The slices are cut
+    // from the full weights at the first inference after loading or quantizing, so the full
+    // weights remain mapped as well.
     __export struct LlaisysQwen2Model *llaisysQwen2ModelCreate(const LlaisysQwen2Meta *meta, llaisysDeviceType_t device, int *device_ids, int ndevice);
 
     __export void llaisysQwen2ModelDestroy(struct LlaisysQwen2Model * model);
 
+    // Creates another model that shares every weight tensor of `model` (no copy) and starts
+    // with its current settings, while sequences, KV caches and decode graphs are its own.
+    // Shared models can run on different threads at the same time, so N serving workers keep a
+    // single copy of the weights. Loading or quantizing one of them replaces only its own
+    // weights; writing into shared weight tensors through llaisysQwen2ModelWeights affects all.
+    // Either model may be destroyed first.
+    __export struct LlaisysQwen2Model *llaisysQwen2ModelShare(struct LlaisysQwen2Model * model);
+
+    // Creates a model from a packed .llaisys file written by llaisys-convert. The file is
+    // memory-mapped and, on CPU, every weight is used in place without any conversion.
+    __export struct LlaisysQwen2Model *llaisysQwen2ModelLoad(const char *path, llaisysDeviceType_t device, int *device_ids, int ndevice);
+
+    // Writes the current weights, quantized ones with their scales and zero points, to a packed
+    // .llaisys file as llaisys-convert does. CPU only.
+    __export void llaisysQwen2ModelSave(struct LlaisysQwen2Model * model, const char *path);
+
+    __export const struct LlaisysQwen2Meta *llaisysQwen2ModelMeta(struct LlaisysQwen2Model * model);
+
     __export struct LlaisysQwen2Weights *llaisysQwen2ModelWeights(struct LlaisysQwen2Model * model);
 
+    // Loads HuggingFace weights from a .safetensors file or a directory of shards. The files
+    // are memory-mapped; on CPU, weights whose dtype matches meta->dtype point straight into
+    // the mapping (read-only, shared through the page cache), the others are converted and
+    // copied. The handles returned by llaisysQwen2ModelWeights are updated in place.
+    __export void llaisysQwen2ModelLoadSafetensors(struct LlaisysQwen2Model * model, const char *path);
+
+    // Quantizes the projection weights (attention, MLP and lm_head) in place; activations,
+    // the KV cache and the embedding table keep meta->dtype. Quantized weights are exposed
+    // through llaisysQwen2ModelWeights with their new dtype and are kept by .llaisys files
+    // written from this model. group_size applies to the 4-bit schemes and must be a multiple
+    // of 32 (0 selects 128); weights whose in_features it does not divide fall back to INT8.
+    // CPU only.
+    __export void llaisysQwen2ModelQuantize(struct LlaisysQwen2Model * model, llaisysQwen2Quant_t type, size_t group_size);
+
+    // Forward passes over at least min_tokens tokens (long prefills) also quantize the
+    // activations of INT8 projections per token and use an int8 x int8 integer GEMM, which
+    // trades a little accuracy for prefill throughput. 0 disables it (the default). The
+    // verify forward of llaisysQwen2ModelGenerate's drafting picks kernels as a one-token
+    // forward would, so drafting still does not change the output.
+    __export void llaisysQwen2ModelSetActQuant(struct LlaisysQwen2Model * model, size_t min_tokens);
+
+    // Storage type of the KV cache: meta->dtype (the default), LLAISYS_DTYPE_I8, LLAISYS_DTYPE_F8
+    // (FP8 E4M3) or LLAISYS_DTYPE_F8E5M2 (wider range, one mantissa bit less). Quantized caches
+    // keep one float32 scale per token and KV head and are dequantized inside attention, cutting
+    // KV memory to 1 byte per element. Must be called while no sequences are scheduled; the cache
+    // of the implicit sequence is dropped.
+    __export void llaisysQwen2ModelSetKVCacheDtype(struct LlaisysQwen2Model * model, llaisysDataType_t dtype);
+
+    // Single-sequence, one-token decode steps on CPU record their kernel launches once and
+    // replay that command list on later steps, updating only the token, position and KV length
+    // (enabled by default). The list is re-recorded when the sequence or its KV cache changes.
+    __export void llaisysQwen2ModelSetDecodeGraph(struct LlaisysQwen2Model * model, uint8_t enabled);
+
+    // Runs the implicit default sequence. token_ids is the whole context; a cached
+    // common prefix is reused and only the remaining tokens are fed to the model.
     __export int64_t llaisysQwen2ModelInfer(struct LlaisysQwen2Model * model, int64_t * token_ids, size_t ntoken);
+
+    // Decoding settings of llaisysQwen2ModelInfer and llaisysQwen2ModelGenerate (greedy by
+    // default). `seed` resets the random generator of the implicit sequence, and each
+    // generate call starts from it, so equal seeds reproduce the same output.
+    __export void llaisysQwen2ModelSetSampling(struct LlaisysQwen2Model * model, const LlaisysSamplingParams *params, uint64_t seed);
+
+    // Generation loop that runs entirely in native code, greedy unless sampling is configured. Writes at most max_new_tokens
+    // generated tokens (stopping after end_token) to out_tokens and returns their count.
+    // With ndraft > 0, up to ndraft tokens are drafted per step by n-gram lookup in the
+    // prompt and generated history, verified in one multi-token forward, and the rejected
+    // KV entries rolled back; the output is identical to ndraft = 0. Drafting only applies to
+    // greedy decoding and is skipped when sampling.
+    __export size_t llaisysQwen2ModelGenerate(struct LlaisysQwen2Model * model, int64_t * token_ids, size_t ntoken, size_t max_new_tokens, size_t ndraft, int64_t * out_tokens);
+
+    // Called once per generated token, in order, from the thread running the generation.
+    // Returning non-zero stops generation after this token.
+    typedef uint8_t (*llaisysQwen2TokenCallback)(int64_t token, void *user_data);
+
+    // Streaming variant of llaisysQwen2ModelGenerate: runs the same native loop and hands each
+    // token to `callback` as soon as it is produced, stopping after end_token, max_new_tokens
+    // or a non-zero callback result. `params` selects the decoding settings for this call only
+    // (NULL is greedy) and `seed` seeds its random generator. Returns the number of tokens
+    // generated.
+    __export size_t llaisysQwen2ModelGenerateStream(struct LlaisysQwen2Model * model, int64_t * token_ids, size_t ntoken, size_t max_new_tokens, size_t ndraft, const LlaisysSamplingParams *params, uint64_t seed, llaisysQwen2TokenCallback callback, void *user_data);
+
+    // Multi-sequence (continuous batching) API
+    struct LlaisysQwen2Sequence;
+
+    // Creates a sequence with the given prompt and queues it for admission by the scheduler.
+    __export struct LlaisysQwen2Sequence *llaisysQwen2SequenceCreate(struct LlaisysQwen2Model * model, int64_t * token_ids, size_t ntoken, size_t max_new_tokens);
+
+    // Decoding settings of one sequence (greedy by default) with its own random generator
+    // seeded by `seed`; call before the sequence emits its first token.
+    __export void llaisysQwen2SequenceSetSampling(struct LlaisysQwen2Sequence * seq, const LlaisysSamplingParams *params, uint64_t seed);
+
+    // Retires the sequence (if still scheduled) and releases its KV cache.
+    __export void llaisysQwen2SequenceDestroy(struct LlaisysQwen2Sequence * seq);
+
+    __export uint8_t llaisysQwen2SequenceFinished(struct LlaisysQwen2Sequence * seq);
+
+    // Copies the generated tokens into `tokens` (if not NULL) and returns their count.
+    __export size_t llaisysQwen2SequenceGetOutput(struct LlaisysQwen2Sequence * seq, int64_t * tokens);
+
+    // Maximum number of sequences advanced together in one step.
+    __export void llaisysQwen2ModelSetMaxBatch(struct LlaisysQwen2Model * model, size_t max_batch);
+
+    // Token budget of one step (0 = unlimited, the default). Decode tokens are scheduled
+    // first; the rest of the budget goes to a single prefill chunk, so long prompts fill
+    // their KV cache over several steps instead of stalling in-flight decodes.
+    __export void llaisysQwen2ModelSetMaxStepTokens(struct LlaisysQwen2Model * model, size_t max_step_tokens);
+
+    // Number of sequences that are running or waiting for admission.
+    __export size_t llaisysQwen2ModelNumPending(struct LlaisysQwen2Model * model);
+
+    // Admits waiting sequences, advances every running sequence by one token in a single
+    // batched forward pass and retires finished ones. A sequence whose prompt is still being
+    // prefilled in chunks emits nothing until its last chunk. The (sequence, token) pairs produced
+    // by this step are written to seqs/tokens (at most `capacity`); returns their count.
+    __export size_t llaisysQwen2ModelStep(struct LlaisysQwen2Model * model, struct LlaisysQwen2Sequence * *seqs, int64_t * tokens, size_t capacity);
 }
 #endif // LLAISYS_MODELS_QWEN2_H
\ No newline at end of file
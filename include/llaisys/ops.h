@@ -4,14 +4,59 @@
 #include "tensor.h"
 
 __C {
+    // Per-row settings of llaisysSample.
+    typedef struct {
+        float temperature;        // <= 0 selects greedy decoding
+        size_t top_k;             // 0 keeps the whole vocabulary
+        float top_p;              // >= 1 disables nucleus sampling
+        float repetition_penalty; // 1 disables it
+    } LlaisysSamplingParams;
+
     __export void llaisysAdd(llaisysTensor_t c, llaisysTensor_t a, llaisysTensor_t b);
     __export void llaisysArgmax(llaisysTensor_t max_idx, llaisysTensor_t max_val, llaisysTensor_t vals);
     __export void llaisysEmbedding(llaisysTensor_t out, llaisysTensor_t index, llaisysTensor_t weight);
     __export void llaisysLinear(llaisysTensor_t out, llaisysTensor_t in, llaisysTensor_t weight, llaisysTensor_t bias);
+    // Weight-only int8 linear; bias may be NULL.
+    __export void llaisysLinearQ8(llaisysTensor_t out, llaisysTensor_t in, llaisysTensor_t qweight, llaisysTensor_t scales, llaisysTensor_t bias);
+    __export void llaisysQuantizeQ8(llaisysTensor_t qweight, llaisysTensor_t scales, llaisysTensor_t weight);
+    // Same weights as llaisysLinearQ8, but activations are quantized per token to int8 on the
+    // fly and multiplied with an integer GEMM (AVX512-VNNI when available); bias may be NULL.
+    __export void llaisysLinearW8A8(llaisysTensor_t out, llaisysTensor_t in, llaisysTensor_t qweight, llaisysTensor_t scales, llaisysTensor_t bias);
+    // 4-bit group-wise linear: qweight uint8 [M, K/2] (two weights per byte), scales float16
+    // [M, K/group_size], zeros uint8 [M, K/group_size] or NULL (symmetric); bias may be NULL.
+    __export void llaisysLinearQ4(llaisysTensor_t out, llaisysTensor_t in, llaisysTensor_t qweight, llaisysTensor_t scales, llaisysTensor_t zeros, llaisysTensor_t bias);
+    __export void llaisysQuantizeQ4(llaisysTensor_t qweight, llaisysTensor_t scales, llaisysTensor_t zeros, llaisysTensor_t weight);
+    // FP8 weights: qweight float8 (E4M3 or E5M2) [M, K] with one float32 scale per output
+    // channel, accumulated in float32; bias may be NULL.
+    __export void llaisysLinearFP8(llaisysTensor_t out, llaisysTensor_t in, llaisysTensor_t qweight, llaisysTensor_t scales, llaisysTensor_t bias);
+    __export void llaisysQuantizeFP8(llaisysTensor_t qweight, llaisysTensor_t scales, llaisysTensor_t weight);
+    // Fused projection + selection (e.g. lm_head + argmax): the k largest entries of each row of
+    // in * weight^T, sorted descending (ties by lower index), into out_idx (int64 [N, k]) and
+    // out_val ([N, k], dtype of in). weight is a float weight of the dtype of in, or a quantized
+    // one as taken by the LinearQ8/Q4/FP8 ops with its scales and zeros (NULL when unused).
+    // Logits are computed in vocabulary slices and never stored unless `logits` ([N, M]) is given.
+    __export void llaisysLinearTopK(llaisysTensor_t out_idx, llaisysTensor_t out_val, llaisysTensor_t in, llaisysTensor_t weight, llaisysTensor_t scales, llaisysTensor_t zeros, llaisysTensor_t logits);
+    // Elementwise conversion between F32, F16, BF16, F8 (E4M3) and F8E5M2; fp8 results are
+    // rounded to nearest even and saturated, without scaling.
+    __export void llaisysCast(llaisysTensor_t out, llaisysTensor_t in);
     __export void llaisysRearrange(llaisysTensor_t out, llaisysTensor_t in);
     __export void llaisysRmsNorm(llaisysTensor_t out, llaisysTensor_t in, llaisysTensor_t weight, float eps);
     __export void llaisysROPE(llaisysTensor_t out, llaisysTensor_t in, llaisysTensor_t pos_ids, float theta);
     __export void llaisysSelfAttention(llaisysTensor_t attn_val, llaisysTensor_t q, llaisysTensor_t k, llaisysTensor_t v, float scale);
+    // Quantized KV cache: k/v are int8 or float8 (E4M3 or E5M2) [total_len, nkvhead, d] with float32
+    // [total_len, nkvhead] scales, as written by llaisysQuantizeKV; dequantized inside attention.
+    __export void llaisysSelfAttentionQuantKV(llaisysTensor_t attn_val, llaisysTensor_t q, llaisysTensor_t k, llaisysTensor_t v, llaisysTensor_t k_scale, llaisysTensor_t v_scale, float scale);
+    __export void llaisysQuantizeKV(llaisysTensor_t out, llaisysTensor_t scales, llaisysTensor_t in);
+    // Writes row i of src [n, nkvhead, d] to row slots[i] (int64 [n]) of a KV cache
+    // [capacity, nkvhead, d]. An int8 / float8 cache is quantized as by llaisysQuantizeKV into
+    // scales [capacity, nkvhead]; otherwise scales may be NULL.
+    __export void llaisysKVStore(llaisysTensor_t cache, llaisysTensor_t scales, llaisysTensor_t src, llaisysTensor_t slots);
+    // Samples one token per row of logits [batch, vocab] into out_idx (int64 [batch]) with
+    // params[batch]. Repetition penalty and temperature are applied to logits in place.
+    // rng_state is uint64 [batch], one generator per row, advanced by every random draw.
+    // The penalised tokens of row i are history[history_offsets[i] : history_offsets[i + 1]]
+    // (int64); both tensors may be NULL when no row uses a penalty.
+    __export void llaisysSample(llaisysTensor_t out_idx, llaisysTensor_t logits, const LlaisysSamplingParams *params, llaisysTensor_t rng_state, llaisysTensor_t history, llaisysTensor_t history_offsets);
     __export void llaisysSwiGLU(llaisysTensor_t out, llaisysTensor_t gate, llaisysTensor_t up);
 }
 
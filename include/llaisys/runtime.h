@@ -5,14 +5,28 @@
 
 __C {
     // Runtime API Functions
-    // Device
+    // Device. CPU device 0 is the whole machine; on hosts with several NUMA nodes devices
+    // 1..N are the nodes, with streams pinned to the node's cores and device memory placed on
+    // the node. LLAISYS_CPU_DEVICES=N sets the number of node devices (round-robin over the
+    // nodes, splitting a node's cores when there are more devices than nodes).
     typedef int (*get_device_count_api)();
     typedef void (*set_device_api)(int);
     typedef void (*device_synchronize_api)();
-    // Stream
+    // Stream. On CPU each stream is a worker thread that runs ops and async copies in submission
+    // order while the caller returns immediately; kernel errors surface at the next synchronize
+    // on the thread that created the stream. Device synchronize waits for every CPU stream in
+    // the process; memcpy_sync and host access to tensor data only wait for the calling
+    // thread's streams, so threads running their own work do not serialize each other.
+    // LLAISYS_CPU_STREAM=0 makes create_stream return NULL so everything runs on the caller.
     typedef llaisysStream_t (*create_stream_api)();
     typedef void (*destroy_stream_api)(llaisysStream_t);
     typedef void (*stream_synchronize_api)(llaisysStream_t);
+    // Event: marks a point in a stream; a stream waiting on it runs later work only after that point
+    typedef llaisysEvent_t (*create_event_api)();
+    typedef void (*destroy_event_api)(llaisysEvent_t);
+    typedef void (*event_record_api)(llaisysEvent_t, llaisysStream_t);
+    typedef void (*stream_wait_event_api)(llaisysStream_t, llaisysEvent_t);
+    typedef void (*event_synchronize_api)(llaisysEvent_t);
     // Memory
     typedef void *(*malloc_device_api)(size_t);
     typedef void (*free_device_api)(void *);
@@ -35,6 +49,11 @@ __C {
         free_host_api free_host;
         memcpy_sync_api memcpy_sync;
         memcpy_async_api memcpy_async;
+        create_event_api create_event;
+        destroy_event_api destroy_event;
+        event_record_api event_record;
+        stream_wait_event_api stream_wait_event;
+        event_synchronize_api event_synchronize;
     };
 
     // Llaisys API for getting the runtime APIs
@@ -42,6 +61,46 @@ __C {
 
     // Llaisys API for switching device context
     __export void llaisysSetContextRuntime(llaisysDeviceType_t, int);
+
+    // Op tracing: while enabled, every op call (plus model forward and per-layer scopes) is
+    // recorded with begin/end timestamps, tensor shapes, dtype and bytes touched into per-thread
+    // ring buffers (LLAISYS_TRACE_EVENTS entries each, default 65536). Setting LLAISYS_TRACE=<path>
+    // enables tracing at load time and dumps to <path> at exit. When disabled the cost per op is a
+    // single branch.
+    __export void llaisysTraceEnable(uint8_t enabled);
+    __export void llaisysTraceClear();
+    // Writes the recorded events as Chrome / Perfetto trace JSON and returns the number of events.
+    __export size_t llaisysTraceDump(const char *path);
+
+    // Per-op performance counters. While enabled, every op call (and model forward / layer scope)
+    // reads perf_event counters of all threads of the process before and after, and the deltas
+    // are summed per op name. Counters that cannot be opened (perf_event_paranoid, containers,
+    // no PMU, non-Linux) are left out of the availability mask and always read 0; call counts
+    // and wall time are always collected.
+    typedef enum {
+        LLAISYS_COUNTER_CYCLES = 1 << 0,
+        LLAISYS_COUNTER_INSTRUCTIONS = 1 << 1,
+        LLAISYS_COUNTER_LLC_MISSES = 1 << 2,
+        LLAISYS_COUNTER_TASK_CLOCK = 1 << 3, // CPU time summed over threads (software event)
+        LLAISYS_COUNTER_MEM_BYTES = 1 << 4,  // DRAM traffic from uncore IMC CAS counts, system-wide
+    } llaisysCounter_t;
+
+    struct LlaisysOpCounters {
+        char name[32];
+        uint64_t calls;
+        uint64_t time_ns;
+        uint64_t cycles;
+        uint64_t instructions;
+        uint64_t llc_misses;
+        uint64_t task_clock_ns;
+        uint64_t mem_bytes;
+    };
+
+    // Returns the mask of llaisysCounter_t values that are available (0 when disabling).
+    __export uint32_t llaisysCountersEnable(uint8_t enabled);
+    __export void llaisysCountersReset();
+    // Copies up to `capacity` per-op totals, sorted by name, and returns the total number of ops.
+    __export size_t llaisysCountersSummary(struct LlaisysOpCounters *out, size_t capacity);
 }
 
 #endif // LLAISYS_RUNTIME_H
@@ -0,0 +1,51 @@
+#ifndef LLAISYS_TOKENIZER_H
+#define LLAISYS_TOKENIZER_H
+
+#include "../llaisys.h"
+
+__C {
+    // Native byte-level BPE tokenizer for the Qwen2 family, loaded from a HuggingFace
+    // tokenizer.json. Encoding matches HuggingFace `tokenizers` without template tokens
+    // (add_special_tokens=False); added tokens are split out before pre-tokenization.
+    struct LlaisysTokenizer;
+
+    // `path` is a tokenizer.json file or a model directory containing one. Only the Qwen2
+    // pre-tokenizer (regex Split + ByteLevel) and an optional NFC normalizer are accepted.
+    __export struct LlaisysTokenizer *llaisysTokenizerLoad(const char *path);
+
+    __export void llaisysTokenizerDestroy(struct LlaisysTokenizer * tokenizer);
+
+    // One past the largest token id, added tokens included.
+    __export size_t llaisysTokenizerVocabSize(struct LlaisysTokenizer * tokenizer);
+
+    // Whether the vocabulary expects NFC-normalized input. The normalizer itself is not
+    // implemented natively; callers normalize the text before llaisysTokenizerEncode.
+    __export uint8_t llaisysTokenizerRequiresNFC(struct LlaisysTokenizer * tokenizer);
+
+    // Encodes `len` bytes of UTF-8 text. Never produces more tokens than input bytes, so a
+    // buffer of `len` entries always suffices; at most `capacity` ids are written to `ids`.
+    // Returns the total number of tokens. Safe to call from several threads.
+    __export size_t llaisysTokenizerEncode(struct LlaisysTokenizer * tokenizer, const char *text, size_t len, int64_t *ids, size_t capacity);
+
+    // Decodes `ntoken` ids into raw bytes (not NUL-terminated; may end in an incomplete UTF-8
+    // sequence). Ids outside the vocabulary decode to nothing. Writes at most `capacity`
+    // bytes and returns the full length.
+    __export size_t llaisysTokenizerDecode(struct LlaisysTokenizer * tokenizer, const int64_t *ids, size_t ntoken, uint8_t skip_special, char *text, size_t capacity);
+
+    // Incremental detokenizer for streaming: each step returns only complete UTF-8
+    // characters and holds back a multi-byte character split across tokens.
+    struct LlaisysDetokenizer;
+
+    // The detokenizer refers to `tokenizer`, which must outlive it.
+    __export struct LlaisysDetokenizer *llaisysDetokenizerCreate(struct LlaisysTokenizer * tokenizer, uint8_t skip_special);
+
+    __export void llaisysDetokenizerDestroy(struct LlaisysDetokenizer * detokenizer);
+
+    // Appends one token and returns the text that became ready, `*len` bytes long. The
+    // buffer belongs to the detokenizer and stays valid until its next call.
+    __export const char *llaisysDetokenizerStep(struct LlaisysDetokenizer * detokenizer, int64_t token, size_t *len);
+
+    // Returns the bytes still held back (possibly an incomplete character) and resets the state.
+    __export const char *llaisysDetokenizerFlush(struct LlaisysDetokenizer * detokenizer, size_t *len);
+}
+#endif // LLAISYS_TOKENIZER_H
@@ -3,9 +3,12 @@ from .libllaisys import DeviceType
 from .libllaisys import DataType
 from .libllaisys import MemcpyKind
 from .libllaisys import llaisysStream_t as Stream
+from .libllaisys import llaisysEvent_t as Event
 from .tensor import Tensor
 from .ops import Ops
+from .tokenizer import Tokenizer
 from . import models
+from . import trace
 from .models import *
 
 __all__ = [
@@ -14,7 +17,10 @@ __all__ = [
     "DataType",
     "MemcpyKind",
     "Stream",
+    "Event",
     "Tensor",
     "Ops",
+    "Tokenizer",
     "models",
+    "trace",
 ]
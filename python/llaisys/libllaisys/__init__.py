@@ -5,13 +5,22 @@ from pathlib import Path
 
 from .runtime import load_runtime
 from .runtime import LlaisysRuntimeAPI
+from .runtime import LlaisysOpCounters
 from .llaisys_types import llaisysDeviceType_t, DeviceType
 from .llaisys_types import llaisysDataType_t, DataType
 from .llaisys_types import llaisysMemcpyKind_t, MemcpyKind
-from .llaisys_types import llaisysStream_t
+from .llaisys_types import llaisysStream_t, llaisysEvent_t
 from .tensor import llaisysTensor_t
 from .tensor import load_tensor
 from .ops import load_ops
+from .ops import LlaisysSamplingParams
+from .qwen2 import load_qwen2
+from .qwen2 import LlaisysQwen2Meta, LlaisysQwen2Weights
+from .qwen2 import llaisysQwen2Model_t, llaisysQwen2Sequence_t
+from .qwen2 import llaisysQwen2TokenCallback
+from .qwen2 import llaisysQwen2Quant_t, Qwen2Quant
+from .tokenizer import load_tokenizer
+from .tokenizer import llaisysTokenizer_t, llaisysDetokenizer_t
 
 
 def load_shared_library():
@@ -38,12 +47,16 @@ LIB_LLAISYS = load_shared_library()
 load_runtime(LIB_LLAISYS)
 load_tensor(LIB_LLAISYS)
 load_ops(LIB_LLAISYS)
+load_qwen2(LIB_LLAISYS)
+load_tokenizer(LIB_LLAISYS)
 
 
 __all__ = [
     "LIB_LLAISYS",
     "LlaisysRuntimeAPI",
+    "LlaisysOpCounters",
     "llaisysStream_t",
+    "llaisysEvent_t",
     "llaisysTensor_t",
     "llaisysDataType_t",
     "DataType",
@@ -52,4 +65,14 @@ __all__ = [
     "llaisysMemcpyKind_t",
     "MemcpyKind",
     "llaisysStream_t",
+    "LlaisysSamplingParams",
+    "LlaisysQwen2Meta",
+    "LlaisysQwen2Weights",
+    "llaisysQwen2Model_t",
+    "llaisysQwen2Sequence_t",
+    "llaisysQwen2TokenCallback",
+    "llaisysQwen2Quant_t",
+    "Qwen2Quant",
+    "llaisysTokenizer_t",
+    "llaisysDetokenizer_t",
 ]
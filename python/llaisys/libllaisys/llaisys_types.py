@@ -34,6 +34,7 @@ class DataType(IntEnum):
     C64 = 17
     C128 = 18
     BF16 = 19
+    F8E5M2 = 20
 
 
 llaisysDataType_t = ctypes.c_int
@@ -52,6 +53,9 @@ llaisysMemcpyKind_t = ctypes.c_int
 # Stream type (opaque pointer)
 llaisysStream_t = ctypes.c_void_p
 
+# Event type (opaque pointer)
+llaisysEvent_t = ctypes.c_void_p
+
 __all__ = [
     "llaisysDeviceType_t",
     "DeviceType",
@@ -60,4 +64,5 @@ __all__ = [
     "llaisysMemcpyKind_t",
     "MemcpyKind",
     "llaisysStream_t",
+    "llaisysEvent_t",
 ]
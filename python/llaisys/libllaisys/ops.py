@@ -1,5 +1,15 @@
 from .tensor import llaisysTensor_t
-from ctypes import c_float
+from ctypes import POINTER, Structure, c_float, c_size_t
+
+
+class LlaisysSamplingParams(Structure):
+    _fields_ = [
+        ("temperature", c_float),
+        ("top_k", c_size_t),
+        ("top_p", c_float),
+        ("repetition_penalty", c_float),
+    ]
+
 
 def load_ops(lib):
     lib.llaisysAdd.argtypes = [llaisysTensor_t, llaisysTensor_t, llaisysTensor_t]
@@ -14,6 +24,66 @@ def load_ops(lib):
     lib.llaisysLinear.argtypes = [llaisysTensor_t, llaisysTensor_t, llaisysTensor_t, llaisysTensor_t]
     lib.llaisysLinear.restype = None
 
+    lib.llaisysLinearQ8.argtypes = [
+        llaisysTensor_t,  # out
+        llaisysTensor_t,  # in
+        llaisysTensor_t,  # qweight
+        llaisysTensor_t,  # scales
+        llaisysTensor_t,  # bias (nullable)
+    ]
+    lib.llaisysLinearQ8.restype = None
+
+    lib.llaisysQuantizeQ8.argtypes = [llaisysTensor_t, llaisysTensor_t, llaisysTensor_t]
+    lib.llaisysQuantizeQ8.restype = None
+
+    lib.llaisysLinearW8A8.argtypes = [
+        llaisysTensor_t,  # out
+        llaisysTensor_t,  # in
+        llaisysTensor_t,  # qweight
+        llaisysTensor_t,  # scales
+        llaisysTensor_t,  # bias (nullable)
+    ]
+    lib.llaisysLinearW8A8.restype = None
+
+    lib.llaisysLinearQ4.argtypes = [
+        llaisysTensor_t,  # out
+        llaisysTensor_t,  # in
+        llaisysTensor_t,  # qweight
+        llaisysTensor_t,  # scales
+        llaisysTensor_t,  # zeros (nullable)
+        llaisysTensor_t,  # bias (nullable)
+    ]
+    lib.llaisysLinearQ4.restype = None
+
+    lib.llaisysQuantizeQ4.argtypes = [llaisysTensor_t, llaisysTensor_t, llaisysTensor_t, llaisysTensor_t]
+    lib.llaisysQuantizeQ4.restype = None
+
+    lib.llaisysLinearFP8.argtypes = [
+        llaisysTensor_t,  # out
+        llaisysTensor_t,  # in
+        llaisysTensor_t,  # qweight
+        llaisysTensor_t,  # scales
+        llaisysTensor_t,  # bias (nullable)
+    ]
+    lib.llaisysLinearFP8.restype = None
+
+    lib.llaisysQuantizeFP8.argtypes = [llaisysTensor_t, llaisysTensor_t, llaisysTensor_t]
+    lib.llaisysQuantizeFP8.restype = None
+
+    lib.llaisysLinearTopK.argtypes = [
+        llaisysTensor_t,  # out_idx
+        llaisysTensor_t,  # out_val
+        llaisysTensor_t,  # in
+        llaisysTensor_t,  # weight
+        llaisysTensor_t,  # scales (nullable)
+        llaisysTensor_t,  # zeros (nullable)
+        llaisysTensor_t,  # logits (nullable)
+    ]
+    lib.llaisysLinearTopK.restype = None
+
+    lib.llaisysCast.argtypes = [llaisysTensor_t, llaisysTensor_t]
+    lib.llaisysCast.restype = None
+
     lib.llaisysRearrange.argtypes = [llaisysTensor_t, llaisysTensor_t]
     lib.llaisysRearrange.restype = None
 
@@ -32,5 +102,37 @@ def load_ops(lib):
     ]
     lib.llaisysSelfAttention.restype = None
 
+    lib.llaisysSelfAttentionQuantKV.argtypes = [
+        llaisysTensor_t,  # attn_val
+        llaisysTensor_t,  # q
+        llaisysTensor_t,  # k
+        llaisysTensor_t,  # v
+        llaisysTensor_t,  # k_scale
+        llaisysTensor_t,  # v_scale
+        c_float,  # scale
+    ]
+    lib.llaisysSelfAttentionQuantKV.restype = None
+
+    lib.llaisysQuantizeKV.argtypes = [llaisysTensor_t, llaisysTensor_t, llaisysTensor_t]
+    lib.llaisysQuantizeKV.restype = None
+
+    lib.llaisysKVStore.argtypes = [
+        llaisysTensor_t,  # cache
+        llaisysTensor_t,  # scales (nullable)
+        llaisysTensor_t,  # src
+        llaisysTensor_t,  # slots
+    ]
+    lib.llaisysKVStore.restype = None
+
+    lib.llaisysSample.argtypes = [
+        llaisysTensor_t,  # out_idx
+        llaisysTensor_t,  # logits
+        POINTER(LlaisysSamplingParams),  # params, one per row
+        llaisysTensor_t,  # rng_state
+        llaisysTensor_t,  # history (nullable)
+        llaisysTensor_t,  # history_offsets (nullable)
+    ]
+    lib.llaisysSample.restype = None
+
     lib.llaisysSwiGLU.argtypes = [llaisysTensor_t, llaisysTensor_t, llaisysTensor_t]
     lib.llaisysSwiGLU.restype = None
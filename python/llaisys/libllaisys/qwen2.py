@@ -0,0 +1,196 @@
+from ctypes import (
+    CFUNCTYPE,
+    POINTER,
+    Structure,
+    c_char_p,
+    c_float,
+    c_int,
+    c_int64,
+    c_size_t,
+    c_uint8,
+    c_uint64,
+    c_void_p,
+)
+from enum import IntEnum
+from .llaisys_types import llaisysDataType_t, llaisysDeviceType_t
+from .tensor import llaisysTensor_t
+from .ops import LlaisysSamplingParams
+
+
+class LlaisysQwen2Meta(Structure):
+    _fields_ = [
+        ("dtype", llaisysDataType_t),
+        ("nlayer", c_size_t),
+        ("hs", c_size_t),
+        ("nh", c_size_t),
+        ("nkvh", c_size_t),
+        ("dh", c_size_t),
+        ("di", c_size_t),
+        ("maxseq", c_size_t),
+        ("voc", c_size_t),
+        ("epsilon", c_float),
+        ("theta", c_float),
+        ("end_token", c_int64),
+    ]
+
+
+class LlaisysQwen2Weights(Structure):
+    _fields_ = [
+        ("in_embed", llaisysTensor_t),
+        ("out_embed", llaisysTensor_t),
+        ("out_norm_w", llaisysTensor_t),
+        ("attn_norm_w", POINTER(llaisysTensor_t)),
+        ("attn_q_w", POINTER(llaisysTensor_t)),
+        ("attn_q_b", POINTER(llaisysTensor_t)),
+        ("attn_k_w", POINTER(llaisysTensor_t)),
+        ("attn_k_b", POINTER(llaisysTensor_t)),
+        ("attn_v_w", POINTER(llaisysTensor_t)),
+        ("attn_v_b", POINTER(llaisysTensor_t)),
+        ("attn_o_w", POINTER(llaisysTensor_t)),
+        ("mlp_norm_w", POINTER(llaisysTensor_t)),
+        ("mlp_gate_w", POINTER(llaisysTensor_t)),
+        ("mlp_up_w", POINTER(llaisysTensor_t)),
+        ("mlp_down_w", POINTER(llaisysTensor_t)),
+    ]
+
+
+# Weight-only quantization schemes
+class Qwen2Quant(IntEnum):
+    NONE = 0
+    INT8 = 1
+    INT4 = 2
+    INT4_ZP = 3
+    FP8 = 4
+    FP8_E5M2 = 5
+
+
+llaisysQwen2Quant_t = c_int
+
+# Opaque handles
+llaisysQwen2Model_t = c_void_p
+llaisysQwen2Sequence_t = c_void_p
+
+# uint8_t (*)(int64_t token, void *user_data); non-zero stops generation
+llaisysQwen2TokenCallback = CFUNCTYPE(c_uint8, c_int64, c_void_p)
+
+
+def load_qwen2(lib):
+    lib.llaisysQwen2ModelCreate.argtypes = [
+        POINTER(LlaisysQwen2Meta),
+        llaisysDeviceType_t,
+        POINTER(c_int),  # device_ids
+        c_int,  # ndevice
+    ]
+    lib.llaisysQwen2ModelCreate.restype = llaisysQwen2Model_t
+
+    lib.llaisysQwen2ModelLoad.argtypes = [
+        c_char_p,  # path
+        llaisysDeviceType_t,
+        POINTER(c_int),  # device_ids
+        c_int,  # ndevice
+    ]
+    lib.llaisysQwen2ModelLoad.restype = llaisysQwen2Model_t
+
+    lib.llaisysQwen2ModelSave.argtypes = [llaisysQwen2Model_t, c_char_p]
+    lib.llaisysQwen2ModelSave.restype = None
+
+    lib.llaisysQwen2ModelMeta.argtypes = [llaisysQwen2Model_t]
+    lib.llaisysQwen2ModelMeta.restype = POINTER(LlaisysQwen2Meta)
+
+    lib.llaisysQwen2ModelDestroy.argtypes = [llaisysQwen2Model_t]
+    lib.llaisysQwen2ModelDestroy.restype = None
+
+    lib.llaisysQwen2ModelShare.argtypes = [llaisysQwen2Model_t]
+    lib.llaisysQwen2ModelShare.restype = llaisysQwen2Model_t
+
+    lib.llaisysQwen2ModelWeights.argtypes = [llaisysQwen2Model_t]
+    lib.llaisysQwen2ModelWeights.restype = POINTER(LlaisysQwen2Weights)
+
+    lib.llaisysQwen2ModelLoadSafetensors.argtypes = [llaisysQwen2Model_t, c_char_p]
+    lib.llaisysQwen2ModelLoadSafetensors.restype = None
+
+    lib.llaisysQwen2ModelQuantize.argtypes = [llaisysQwen2Model_t, llaisysQwen2Quant_t, c_size_t]
+    lib.llaisysQwen2ModelQuantize.restype = None
+
+    lib.llaisysQwen2ModelSetActQuant.argtypes = [llaisysQwen2Model_t, c_size_t]
+    lib.llaisysQwen2ModelSetActQuant.restype = None
+
+    lib.llaisysQwen2ModelSetKVCacheDtype.argtypes = [llaisysQwen2Model_t, llaisysDataType_t]
+    lib.llaisysQwen2ModelSetKVCacheDtype.restype = None
+
+    lib.llaisysQwen2ModelSetDecodeGraph.argtypes = [llaisysQwen2Model_t, c_uint8]
+    lib.llaisysQwen2ModelSetDecodeGraph.restype = None
+
+    lib.llaisysQwen2ModelSetSampling.argtypes = [
+        llaisysQwen2Model_t,
+        POINTER(LlaisysSamplingParams),
+        c_uint64,  # seed
+    ]
+    lib.llaisysQwen2ModelSetSampling.restype = None
+
+    lib.llaisysQwen2ModelInfer.argtypes = [llaisysQwen2Model_t, POINTER(c_int64), c_size_t]
+    lib.llaisysQwen2ModelInfer.restype = c_int64
+
+    lib.llaisysQwen2ModelGenerate.argtypes = [
+        llaisysQwen2Model_t,
+        POINTER(c_int64),  # token_ids
+        c_size_t,  # ntoken
+        c_size_t,  # max_new_tokens
+        c_size_t,  # ndraft
+        POINTER(c_int64),  # out_tokens
+    ]
+    lib.llaisysQwen2ModelGenerate.restype = c_size_t
+
+    lib.llaisysQwen2ModelGenerateStream.argtypes = [
+        llaisysQwen2Model_t,
+        POINTER(c_int64),  # token_ids
+        c_size_t,  # ntoken
+        c_size_t,  # max_new_tokens
+        c_size_t,  # ndraft
+        POINTER(LlaisysSamplingParams),  # params (nullable)
+        c_uint64,  # seed
+        llaisysQwen2TokenCallback,
+        c_void_p,  # user_data
+    ]
+    lib.llaisysQwen2ModelGenerateStream.restype = c_size_t
+
+    lib.llaisysQwen2SequenceCreate.argtypes = [
+        llaisysQwen2Model_t,
+        POINTER(c_int64),  # token_ids
+        c_size_t,  # ntoken
+        c_size_t,  # max_new_tokens
+    ]
+    lib.llaisysQwen2SequenceCreate.restype = llaisysQwen2Sequence_t
+
+    lib.llaisysQwen2SequenceSetSampling.argtypes = [
+        llaisysQwen2Sequence_t,
+        POINTER(LlaisysSamplingParams),
+        c_uint64,  # seed
+    ]
+    lib.llaisysQwen2SequenceSetSampling.restype = None
+
+    lib.llaisysQwen2SequenceDestroy.argtypes = [llaisysQwen2Sequence_t]
+    lib.llaisysQwen2SequenceDestroy.restype = None
+
+    lib.llaisysQwen2SequenceFinished.argtypes = [llaisysQwen2Sequence_t]
+    lib.llaisysQwen2SequenceFinished.restype = c_uint8
+
+    lib.llaisysQwen2SequenceGetOutput.argtypes = [llaisysQwen2Sequence_t, POINTER(c_int64)]
+    lib.llaisysQwen2SequenceGetOutput.restype = c_size_t
+
+    lib.llaisysQwen2ModelSetMaxBatch.argtypes = [llaisysQwen2Model_t, c_size_t]
+    lib.llaisysQwen2ModelSetMaxBatch.restype = None
+
+    lib.llaisysQwen2ModelSetMaxStepTokens.argtypes = [llaisysQwen2Model_t, c_size_t]
+    lib.llaisysQwen2ModelSetMaxStepTokens.restype = None
+
+    lib.llaisysQwen2ModelNumPending.argtypes = [llaisysQwen2Model_t]
+    lib.llaisysQwen2ModelNumPending.restype = c_size_t
+
+    lib.llaisysQwen2ModelStep.argtypes = [
+        llaisysQwen2Model_t,
+        POINTER(llaisysQwen2Sequence_t),  # seqs
+        POINTER(c_int64),  # tokens
+        c_size_t,  # capacity
+    ]
+    lib.llaisysQwen2ModelStep.restype = c_size_t
@@ -1,5 +1,5 @@
 import ctypes
-from ctypes import c_void_p, c_size_t, c_int, Structure, CFUNCTYPE
+from ctypes import c_void_p, c_size_t, c_int, c_uint8, c_uint32, c_uint64, c_char, c_char_p, Structure, CFUNCTYPE, POINTER
 from .llaisys_types import *
 
 # Define function pointer types
@@ -19,6 +19,12 @@ free_host_api = CFUNCTYPE(None, c_void_p)
 memcpy_sync_api = CFUNCTYPE(None, c_void_p, c_void_p, c_size_t, llaisysMemcpyKind_t)
 memcpy_async_api = CFUNCTYPE(None, c_void_p, c_void_p, c_size_t, llaisysMemcpyKind_t, llaisysStream_t)
 
+create_event_api = CFUNCTYPE(llaisysEvent_t)
+destroy_event_api = CFUNCTYPE(None, llaisysEvent_t)
+event_record_api = CFUNCTYPE(None, llaisysEvent_t, llaisysStream_t)
+stream_wait_event_api = CFUNCTYPE(None, llaisysStream_t, llaisysEvent_t)
+event_synchronize_api = CFUNCTYPE(None, llaisysEvent_t)
+
 
 # Define the struct matching LlaisysRuntimeAPI
 class LlaisysRuntimeAPI(Structure):
@@ -35,6 +41,24 @@ class LlaisysRuntimeAPI(Structure):
         ("free_host", free_host_api),
         ("memcpy_sync", memcpy_sync_api),
         ("memcpy_async", memcpy_async_api),
+        ("create_event", create_event_api),
+        ("destroy_event", destroy_event_api),
+        ("event_record", event_record_api),
+        ("stream_wait_event", stream_wait_event_api),
+        ("event_synchronize", event_synchronize_api),
+    ]
+
+
+class LlaisysOpCounters(Structure):
+    _fields_ = [
+        ("name", c_char * 32),
+        ("calls", c_uint64),
+        ("time_ns", c_uint64),
+        ("cycles", c_uint64),
+        ("instructions", c_uint64),
+        ("llc_misses", c_uint64),
+        ("task_clock_ns", c_uint64),
+        ("mem_bytes", c_uint64),
     ]
 
 
@@ -46,3 +70,21 @@ def load_runtime(lib):
 
     lib.llaisysSetContextRuntime.argtypes = [llaisysDeviceType_t, c_int]
     lib.llaisysSetContextRuntime.restype = None
+
+    lib.llaisysTraceEnable.argtypes = [c_uint8]
+    lib.llaisysTraceEnable.restype = None
+
+    lib.llaisysTraceClear.argtypes = []
+    lib.llaisysTraceClear.restype = None
+
+    lib.llaisysTraceDump.argtypes = [c_char_p]
+    lib.llaisysTraceDump.restype = c_size_t
+
+    lib.llaisysCountersEnable.argtypes = [c_uint8]
+    lib.llaisysCountersEnable.restype = c_uint32
+
+    lib.llaisysCountersReset.argtypes = []
+    lib.llaisysCountersReset.restype = None
+
+    lib.llaisysCountersSummary.argtypes = [POINTER(LlaisysOpCounters), c_size_t]
+    lib.llaisysCountersSummary.restype = c_size_t
@@ -0,0 +1,51 @@
+from ctypes import POINTER, c_char_p, c_int64, c_size_t, c_uint8, c_void_p
+
+# Opaque handles
+llaisysTokenizer_t = c_void_p
+llaisysDetokenizer_t = c_void_p
+
+
+def load_tokenizer(lib):
+    lib.llaisysTokenizerLoad.argtypes = [c_char_p]  # path
+    lib.llaisysTokenizerLoad.restype = llaisysTokenizer_t
+
+    lib.llaisysTokenizerDestroy.argtypes = [llaisysTokenizer_t]
+    lib.llaisysTokenizerDestroy.restype = None
+
+    lib.llaisysTokenizerVocabSize.argtypes = [llaisysTokenizer_t]
+    lib.llaisysTokenizerVocabSize.restype = c_size_t
+
+    lib.llaisysTokenizerRequiresNFC.argtypes = [llaisysTokenizer_t]
+    lib.llaisysTokenizerRequiresNFC.restype = c_uint8
+
+    lib.llaisysTokenizerEncode.argtypes = [
+        llaisysTokenizer_t,
+        c_char_p,  # text
+        c_size_t,  # len
+        POINTER(c_int64),  # ids
+        c_size_t,  # capacity
+    ]
+    lib.llaisysTokenizerEncode.restype = c_size_t
+
+    lib.llaisysTokenizerDecode.argtypes = [
+        llaisysTokenizer_t,
+        POINTER(c_int64),  # ids
+        c_size_t,  # ntoken
+        c_uint8,  # skip_special
+        c_char_p,  # text
+        c_size_t,  # capacity
+    ]
+    lib.llaisysTokenizerDecode.restype = c_size_t
+
+    lib.llaisysDetokenizerCreate.argtypes = [llaisysTokenizer_t, c_uint8]
+    lib.llaisysDetokenizerCreate.restype = llaisysDetokenizer_t
+
+    lib.llaisysDetokenizerDestroy.argtypes = [llaisysDetokenizer_t]
+    lib.llaisysDetokenizerDestroy.restype = None
+
+    # Both return a pointer into the detokenizer's buffer; read `len` bytes with string_at.
+    lib.llaisysDetokenizerStep.argtypes = [llaisysDetokenizer_t, c_int64, POINTER(c_size_t)]
+    lib.llaisysDetokenizerStep.restype = c_void_p
+
+    lib.llaisysDetokenizerFlush.argtypes = [llaisysDetokenizer_t, POINTER(c_size_t)]
+    lib.llaisysDetokenizerFlush.restype = c_void_p
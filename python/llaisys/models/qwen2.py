@@ -1,23 +1,163 @@
-from typing import Sequence
+from typing import Iterator, List, Sequence
 from ..libllaisys import LIB_LLAISYS
-from ..libllaisys import DeviceType
+from ..libllaisys import DeviceType, DataType
+from ..libllaisys import LlaisysQwen2Meta, Qwen2Quant, LlaisysSamplingParams
+from ..libllaisys import llaisysQwen2TokenCallback
 
+from ctypes import byref, c_int, c_int64
 from pathlib import Path
-import safetensors
+import json
+import queue
+import threading
+
+
+_DTYPES = {
+    "float32": DataType.F32,
+    "float16": DataType.F16,
+    "bfloat16": DataType.BF16,
+}
+
+
+def _sampling_params(top_k, top_p, temperature, repetition_penalty):
+    return LlaisysSamplingParams(
+        temperature=temperature,
+        top_k=max(top_k, 0),
+        top_p=top_p,
+        repetition_penalty=repetition_penalty,
+    )
 
 
 class Qwen2:
 
-    def __init__(self, model_path, device: DeviceType = DeviceType.CPU):
-        # TODO: Implement model constructor
+    def __init__(self, model_path, device: DeviceType = DeviceType.CPU, device_ids: Sequence[int] = None):
+        """Loads a HuggingFace model directory or a packed .llaisys file.
 
+        ``device_ids`` lists the devices to run on. Several CPU devices (NUMA nodes) split every
+        layer across them by tensor parallelism; the default is device 0, the whole machine.
+        """
         model_path = Path(model_path)
+        ids = list(device_ids) if device_ids else []
+        c_ids = (c_int * len(ids))(*ids) if ids else None
+
+        if model_path.suffix == ".llaisys":
+            # Packed file from llaisys-convert: meta and ready-to-use weights in one mapping.
+            self._model = LIB_LLAISYS.llaisysQwen2ModelLoad(
+                str(model_path).encode("utf-8"), device, c_ids, len(ids)
+            )
+            self._weights = LIB_LLAISYS.llaisysQwen2ModelWeights(self._model).contents
+            return
+
+        with open(model_path / "config.json", "r") as f:
+            config = json.load(f)
+
+        eos = config.get("eos_token_id", -1)
+        if isinstance(eos, list):
+            eos = eos[0]
+
+        meta = LlaisysQwen2Meta()
+        meta.dtype = _DTYPES.get(config.get("torch_dtype", "bfloat16"), DataType.BF16)
+        meta.nlayer = config["num_hidden_layers"]
+        meta.hs = config["hidden_size"]
+        meta.nh = config["num_attention_heads"]
+        meta.nkvh = config["num_key_value_heads"]
+        meta.dh = config["hidden_size"] // config["num_attention_heads"]
+        meta.di = config["intermediate_size"]
+        meta.maxseq = config["max_position_embeddings"]
+        meta.voc = config["vocab_size"]
+        meta.epsilon = config["rms_norm_eps"]
+        meta.theta = config.get("rope_theta", 10000.0)
+        meta.end_token = eos
+
+        self._model = LIB_LLAISYS.llaisysQwen2ModelCreate(byref(meta), device, c_ids, len(ids))
+        self._weights = LIB_LLAISYS.llaisysQwen2ModelWeights(self._model).contents
+
+        # Weights are memory-mapped natively; matching dtypes are used without a copy.
+        LIB_LLAISYS.llaisysQwen2ModelLoadSafetensors(
+            self._model, str(model_path).encode("utf-8")
+        )
+
+    def __del__(self):
+        if hasattr(self, "_model") and self._model is not None:
+            LIB_LLAISYS.llaisysQwen2ModelDestroy(self._model)
+            self._model = None
+
+    def share(self) -> "Qwen2":
+        """Another model instance that shares this model's weights without copying them.
+
+        The new instance starts with the current settings but has its own sequences and KV
+        caches, so each serving thread can use its own instance while memory holds a single
+        copy of the weights. Loading or quantizing one instance does not affect the other.
+        """
+        shared = Qwen2.__new__(Qwen2)
+        shared._model = LIB_LLAISYS.llaisysQwen2ModelShare(self._model)
+        shared._weights = LIB_LLAISYS.llaisysQwen2ModelWeights(shared._model).contents
+        return shared
+
+    def save(self, path):
+        """Writes the current (possibly quantized) weights to a packed .llaisys file.
+
+        Loading the file with ``Qwen2(path)`` maps it without any conversion, as for
+        files written by llaisys-convert. CPU only.
+        """
+        LIB_LLAISYS.llaisysQwen2ModelSave(self._model, str(path).encode("utf-8"))
+        return self
+
+    def quantize(self, scheme: str = "int8", group_size: int = 128):
+        """Weight-only quantization of the projection and lm_head weights (CPU only).
+
+        ``scheme`` is one of "none", "int8" (per-channel), "int4" (symmetric, per group),
+        "int4_zp" (per group with zero points), "fp8" (E4M3, per-channel scale) and
+        "fp8_e5m2"; ``group_size`` only applies to the 4-bit schemes. Activations and the KV cache keep the model dtype.
+        ``llaisys-convert --quant`` writes a packed file that is already quantized, so
+        loading it skips this step.
+        """
+        quant = {
+            "none": Qwen2Quant.NONE,
+            "int8": Qwen2Quant.INT8,
+            "int4": Qwen2Quant.INT4,
+            "int4_zp": Qwen2Quant.INT4_ZP,
+            "fp8": Qwen2Quant.FP8,
+            "fp8_e5m2": Qwen2Quant.FP8_E5M2,
+        }.get(scheme)
+        if quant is None:
+            raise ValueError(f"Unsupported quantization scheme: {scheme}")
+        LIB_LLAISYS.llaisysQwen2ModelQuantize(self._model, quant, group_size)
+        return self
+
+    def set_act_quant(self, min_tokens: int):
+        """Dynamic int8 activation quantization for forwards of at least ``min_tokens`` tokens.
+
+        Only affects int8-quantized weights: long prefills then run an integer GEMM
+        (AVX512-VNNI when available) instead of the float kernel. 0 disables it. Drafting
+        (``num_draft``) verifies with the kernels a one-token step would use, so it does not
+        change the output.
+        """
+        LIB_LLAISYS.llaisysQwen2ModelSetActQuant(self._model, min_tokens)
+        return self
+
+    def set_kv_cache_dtype(self, kv_dtype: str = None):
+        """Stores the KV cache as "int8", "fp8" (E4M3) or "fp8_e5m2" with per-token, per-head scales.
+
+        ``None`` restores the model dtype. Attention dequantizes the cache on the fly;
+        cached prefixes are dropped, and no batch may be in flight.
+        """
+        if kv_dtype is None:
+            dtype = LIB_LLAISYS.llaisysQwen2ModelMeta(self._model).contents.dtype
+        else:
+            dtype = {"int8": DataType.I8, "fp8": DataType.F8, "fp8_e5m2": DataType.F8E5M2}.get(kv_dtype)
+            if dtype is None:
+                raise ValueError(f"Unsupported KV cache dtype: {kv_dtype}")
+        LIB_LLAISYS.llaisysQwen2ModelSetKVCacheDtype(self._model, dtype)
+        return self
 
-        for file in sorted(model_path.glob("*.safetensors")):
-            data_ = safetensors.safe_open(file, framework="numpy", device="cpu")
-            for name_ in data_.keys():
-                ## TODO: load the model weights
-                pass
+    def set_decode_graph(self, enabled: bool = True):
+        """Replays a recorded command list for single-sequence decode steps on CPU.
+
+        On by default; the first step of a sequence records the kernel launches and
+        later steps skip op dispatch entirely. Outputs are identical either way.
+        """
+        LIB_LLAISYS.llaisysQwen2ModelSetDecodeGraph(self._model, 1 if enabled else 0)
+        return self
 
     def generate(
         self,
@@ -26,8 +166,131 @@ class Qwen2:
         top_k: int = 1,
         top_p: float = 0.8,
         temperature: float = 0.8,
+        num_draft: int = 0,
+        repetition_penalty: float = 1.0,
+        seed: int = 0,
     ):
+        """Generation in the native loop.
+
+        ``top_k == 1`` or ``temperature <= 0`` decodes greedily; otherwise tokens are sampled
+        natively with temperature, top-k (0 = whole vocabulary) and top-p, starting from
+        ``seed`` on every call. ``repetition_penalty`` follows the HuggingFace definition.
+        ``num_draft > 0`` enables speculative decoding with prompt-lookup drafts for greedy
+        decoding; the result is the same, but repetitive outputs need fewer forward passes.
+        """
+        if max_new_tokens is None:
+            max_new_tokens = 128
+
+        params = _sampling_params(top_k, top_p, temperature, repetition_penalty)
+        LIB_LLAISYS.llaisysQwen2ModelSetSampling(self._model, byref(params), seed)
+        token_ids = (c_int64 * len(inputs))(*inputs)
+        generated = (c_int64 * max_new_tokens)()
+        n = LIB_LLAISYS.llaisysQwen2ModelGenerate(
+            self._model, token_ids, len(inputs), max_new_tokens, num_draft, generated
+        )
+        return list(inputs) + list(generated[:n])
+
+    def stream(
+        self,
+        inputs: Sequence[int],
+        max_new_tokens: int = None,
+        top_k: int = 1,
+        top_p: float = 0.8,
+        temperature: float = 0.8,
+        num_draft: int = 0,
+        repetition_penalty: float = 1.0,
+        seed: int = 0,
+    ) -> Iterator[int]:
+        """Yields the generated tokens (without the prompt) as the native loop produces them.
+
+        Arguments are as in ``generate``. The loop runs on a worker thread without the GIL;
+        only the per-token hand-off takes it. Closing the iterator early stops generation
+        after the next token. The model must not be used elsewhere until the iterator ends.
+        """
+        if max_new_tokens is None:
+            max_new_tokens = 128
+
+        params = _sampling_params(top_k, top_p, temperature, repetition_penalty)
+        token_ids = (c_int64 * len(inputs))(*inputs)
+        tokens = queue.SimpleQueue()
+        stop = threading.Event()
+        done = object()
+
+        def on_token(token, _):
+            tokens.put(token)
+            return 1 if stop.is_set() else 0
+
+        callback = llaisysQwen2TokenCallback(on_token)
+
+        def run():
+            try:
+                LIB_LLAISYS.llaisysQwen2ModelGenerateStream(
+                    self._model, token_ids, len(inputs), max_new_tokens, num_draft,
+                    byref(params), seed, callback, None,
+                )
+            finally:
+                tokens.put(done)
+
+        worker = threading.Thread(target=run, daemon=True)
+        worker.start()
+        try:
+            while True:
+                token = tokens.get()
+                if token is done:
+                    break
+                yield token
+        finally:
+            stop.set()
+            worker.join()
+
+    def generate_batch(
+        self,
+        batch_inputs: Sequence[Sequence[int]],
+        max_new_tokens: int = 128,
+        max_batch: int = None,
+        max_step_tokens: int = None,
+        top_k: int = 1,
+        top_p: float = 1.0,
+        temperature: float = 1.0,
+        repetition_penalty: float = 1.0,
+        seed: int = 0,
+    ) -> List[List[int]]:
+        """Decodes several prompts together with the continuous-batching scheduler.
+
+        ``max_step_tokens`` bounds the tokens of one step; long prompts are then prefilled
+        in chunks interleaved with the decodes of the other sequences (0 = unlimited).
+        Sampling arguments are as in ``generate`` (greedy by default); prompt ``i`` draws
+        from its own generator seeded with ``seed + i``, independent of the rest of the batch.
+        """
+        if max_batch is not None:
+            LIB_LLAISYS.llaisysQwen2ModelSetMaxBatch(self._model, max_batch)
+        if max_step_tokens is not None:
+            LIB_LLAISYS.llaisysQwen2ModelSetMaxStepTokens(self._model, max_step_tokens)
+
+        params = _sampling_params(top_k, top_p, temperature, repetition_penalty)
+        seqs = []
+        try:
+            for inputs in batch_inputs:
+                token_ids = (c_int64 * len(inputs))(*inputs)
+                seqs.append(
+                    LIB_LLAISYS.llaisysQwen2SequenceCreate(
+                        self._model, token_ids, len(inputs), max_new_tokens
+                    )
+                )
+                LIB_LLAISYS.llaisysQwen2SequenceSetSampling(
+                    seqs[-1], byref(params), seed + len(seqs) - 1
+                )
 
-        # TODO: Implement generate function
+            while LIB_LLAISYS.llaisysQwen2ModelNumPending(self._model) > 0:
+                LIB_LLAISYS.llaisysQwen2ModelStep(self._model, None, None, 0)
 
-        return []
+            outputs = []
+            for inputs, seq in zip(batch_inputs, seqs):
+                n = LIB_LLAISYS.llaisysQwen2SequenceGetOutput(seq, None)
+                generated = (c_int64 * n)()
+                LIB_LLAISYS.llaisysQwen2SequenceGetOutput(seq, generated)
+                outputs.append(list(inputs) + list(generated))
+            return outputs
+        finally:
+            for seq in seqs:
+                LIB_LLAISYS.llaisysQwen2SequenceDestroy(seq)
@@ -1,4 +1,4 @@
-from .libllaisys import LIB_LLAISYS
+from .libllaisys import LIB_LLAISYS, LlaisysSamplingParams
 from .tensor import Tensor
 from ctypes import c_float, c_int
 
@@ -24,6 +24,90 @@ class Ops:
             out.lib_tensor(), inp.lib_tensor(), weight.lib_tensor(), bias.lib_tensor()
         )
 
+    @staticmethod
+    def linear_q8(out: Tensor, inp: Tensor, qweight: Tensor, scales: Tensor, bias: Tensor = None):
+        LIB_LLAISYS.llaisysLinearQ8(
+            out.lib_tensor(),
+            inp.lib_tensor(),
+            qweight.lib_tensor(),
+            scales.lib_tensor(),
+            bias.lib_tensor() if bias is not None else None,
+        )
+
+    @staticmethod
+    def quantize_q8(qweight: Tensor, scales: Tensor, weight: Tensor):
+        LIB_LLAISYS.llaisysQuantizeQ8(qweight.lib_tensor(), scales.lib_tensor(), weight.lib_tensor())
+
+    @staticmethod
+    def linear_w8a8(out: Tensor, inp: Tensor, qweight: Tensor, scales: Tensor, bias: Tensor = None):
+        LIB_LLAISYS.llaisysLinearW8A8(
+            out.lib_tensor(),
+            inp.lib_tensor(),
+            qweight.lib_tensor(),
+            scales.lib_tensor(),
+            bias.lib_tensor() if bias is not None else None,
+        )
+
+    @staticmethod
+    def linear_q4(
+        out: Tensor, inp: Tensor, qweight: Tensor, scales: Tensor, zeros: Tensor = None, bias: Tensor = None
+    ):
+        LIB_LLAISYS.llaisysLinearQ4(
+            out.lib_tensor(),
+            inp.lib_tensor(),
+            qweight.lib_tensor(),
+            scales.lib_tensor(),
+            zeros.lib_tensor() if zeros is not None else None,
+            bias.lib_tensor() if bias is not None else None,
+        )
+
+    @staticmethod
+    def quantize_q4(qweight: Tensor, scales: Tensor, zeros: Tensor, weight: Tensor):
+        LIB_LLAISYS.llaisysQuantizeQ4(
+            qweight.lib_tensor(),
+            scales.lib_tensor(),
+            zeros.lib_tensor() if zeros is not None else None,
+            weight.lib_tensor(),
+        )
+
+    @staticmethod
+    def linear_fp8(out: Tensor, inp: Tensor, qweight: Tensor, scales: Tensor, bias: Tensor = None):
+        LIB_LLAISYS.llaisysLinearFP8(
+            out.lib_tensor(),
+            inp.lib_tensor(),
+            qweight.lib_tensor(),
+            scales.lib_tensor(),
+            bias.lib_tensor() if bias is not None else None,
+        )
+
+    @staticmethod
+    def quantize_fp8(qweight: Tensor, scales: Tensor, weight: Tensor):
+        LIB_LLAISYS.llaisysQuantizeFP8(qweight.lib_tensor(), scales.lib_tensor(), weight.lib_tensor())
+
+    @staticmethod
+    def linear_topk(
+        out_idx: Tensor,
+        out_val: Tensor,
+        inp: Tensor,
+        weight: Tensor,
+        scales: Tensor = None,
+        zeros: Tensor = None,
+        logits: Tensor = None,
+    ):
+        LIB_LLAISYS.llaisysLinearTopK(
+            out_idx.lib_tensor(),
+            out_val.lib_tensor(),
+            inp.lib_tensor(),
+            weight.lib_tensor(),
+            scales.lib_tensor() if scales is not None else None,
+            zeros.lib_tensor() if zeros is not None else None,
+            logits.lib_tensor() if logits is not None else None,
+        )
+
+    @staticmethod
+    def cast(out: Tensor, inp: Tensor):
+        LIB_LLAISYS.llaisysCast(out.lib_tensor(), inp.lib_tensor())
+
     @staticmethod
     def rearrange(out: Tensor, inp: Tensor):
         LIB_LLAISYS.llaisysRearrange(out.lib_tensor(), inp.lib_tensor())
@@ -41,7 +125,21 @@ class Ops:
         )
 
     @staticmethod
-    def self_attention(attn_val: Tensor, q: Tensor, k: Tensor, v: Tensor, scale: float):
+    def self_attention(
+        attn_val: Tensor, q: Tensor, k: Tensor, v: Tensor, scale: float, k_scale: Tensor = None, v_scale: Tensor = None
+    ):
+        # k_scale/v_scale accompany an int8 / fp8 KV cache written by quantize_kv
+        if k_scale is not None or v_scale is not None:
+            LIB_LLAISYS.llaisysSelfAttentionQuantKV(
+                attn_val.lib_tensor(),
+                q.lib_tensor(),
+                k.lib_tensor(),
+                v.lib_tensor(),
+                k_scale.lib_tensor(),
+                v_scale.lib_tensor(),
+                c_float(scale),
+            )
+            return
         LIB_LLAISYS.llaisysSelfAttention(
             attn_val.lib_tensor(),
             q.lib_tensor(),
@@ -50,6 +148,42 @@ class Ops:
             c_float(scale),
         )
 
+    @staticmethod
+    def quantize_kv(out: Tensor, scales: Tensor, inp: Tensor):
+        LIB_LLAISYS.llaisysQuantizeKV(out.lib_tensor(), scales.lib_tensor(), inp.lib_tensor())
+
+    @staticmethod
+    def kv_store(cache: Tensor, scales: Tensor, src: Tensor, slots: Tensor):
+        # scales is None unless the cache is int8 / fp8
+        LIB_LLAISYS.llaisysKVStore(
+            cache.lib_tensor(),
+            scales.lib_tensor() if scales is not None else None,
+            src.lib_tensor(),
+            slots.lib_tensor(),
+        )
+
+    @staticmethod
+    def sample(
+        out_idx: Tensor,
+        logits: Tensor,
+        params,
+        rng_state: Tensor,
+        history: Tensor = None,
+        history_offsets: Tensor = None,
+    ):
+        """``params`` is one LlaisysSamplingParams shared by all rows, or a list with one per row."""
+        if isinstance(params, LlaisysSamplingParams):
+            params = [params] * logits.shape()[0]
+        arr = (LlaisysSamplingParams * len(params))(*params)
+        LIB_LLAISYS.llaisysSample(
+            out_idx.lib_tensor(),
+            logits.lib_tensor(),
+            arr,
+            rng_state.lib_tensor(),
+            history.lib_tensor() if history is not None else None,
+            history_offsets.lib_tensor() if history_offsets is not None else None,
+        )
+
     @staticmethod
     def swiglu(out: Tensor, gate: Tensor, up: Tensor):
         LIB_LLAISYS.llaisysSwiGLU(out.lib_tensor(), gate.lib_tensor(), up.lib_tensor())
@@ -0,0 +1,76 @@
+from typing import List, Sequence
+from .libllaisys import LIB_LLAISYS
+
+from ctypes import byref, c_int64, c_size_t, create_string_buffer, string_at
+from pathlib import Path
+import unicodedata
+
+
+class Detokenizer:
+    """Incremental decoding for streaming: ``step`` returns only complete characters."""
+
+    def __init__(self, tokenizer: "Tokenizer", skip_special_tokens: bool = True):
+        # Keeps the tokenizer alive for as long as the native detokenizer refers to it.
+        self._tokenizer = tokenizer
+        self._detok = LIB_LLAISYS.llaisysDetokenizerCreate(
+            tokenizer._tokenizer, skip_special_tokens
+        )
+
+    def __del__(self):
+        if hasattr(self, "_detok") and self._detok is not None:
+            LIB_LLAISYS.llaisysDetokenizerDestroy(self._detok)
+            self._detok = None
+
+    def step(self, token: int) -> str:
+        n = c_size_t()
+        ptr = LIB_LLAISYS.llaisysDetokenizerStep(self._detok, token, byref(n))
+        return string_at(ptr, n.value).decode("utf-8", errors="replace")
+
+    def flush(self) -> str:
+        n = c_size_t()
+        ptr = LIB_LLAISYS.llaisysDetokenizerFlush(self._detok, byref(n))
+        return string_at(ptr, n.value).decode("utf-8", errors="replace")
+
+
+class Tokenizer:
+    """Native byte-level BPE tokenizer for Qwen2-family ``tokenizer.json`` files.
+
+    ``encode`` matches ``tokenizers.Tokenizer.encode(text, add_special_tokens=False)``;
+    chat templates and BOS tokens are left to the caller.
+    """
+
+    def __init__(self, path):
+        self._tokenizer = LIB_LLAISYS.llaisysTokenizerLoad(str(Path(path)).encode("utf-8"))
+        self._nfc = bool(LIB_LLAISYS.llaisysTokenizerRequiresNFC(self._tokenizer))
+
+    def __del__(self):
+        if hasattr(self, "_tokenizer") and self._tokenizer is not None:
+            LIB_LLAISYS.llaisysTokenizerDestroy(self._tokenizer)
+            self._tokenizer = None
+
+    @property
+    def vocab_size(self) -> int:
+        return LIB_LLAISYS.llaisysTokenizerVocabSize(self._tokenizer)
+
+    def encode(self, text: str) -> List[int]:
+        if self._nfc and not unicodedata.is_normalized("NFC", text):
+            text = unicodedata.normalize("NFC", text)
+        data = text.encode("utf-8")
+        # Never more tokens than bytes.
+        ids = (c_int64 * max(len(data), 1))()
+        n = LIB_LLAISYS.llaisysTokenizerEncode(self._tokenizer, data, len(data), ids, len(data))
+        return ids[:n]
+
+    def decode(self, ids: Sequence[int], skip_special_tokens: bool = False) -> str:
+        token_ids = (c_int64 * len(ids))(*ids)
+        n = LIB_LLAISYS.llaisysTokenizerDecode(
+            self._tokenizer, token_ids, len(ids), skip_special_tokens, None, 0
+        )
+        text = create_string_buffer(n)
+        LIB_LLAISYS.llaisysTokenizerDecode(
+            self._tokenizer, token_ids, len(ids), skip_special_tokens, text, n
+        )
+        return text.raw[:n].decode("utf-8", errors="replace")
+
+    def detokenizer(self, skip_special_tokens: bool = True) -> Detokenizer:
+        return Detokenizer(self, skip_special_tokens)
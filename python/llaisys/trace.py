@@ -0,0 +1,71 @@
+"""Op-level tracing that exports Chrome / Perfetto trace JSON.
+
+Usage::
+
+    llaisys.trace.enable()
+    model.generate(...)
+    llaisys.trace.dump("decode.json")  # open in chrome://tracing or ui.perfetto.dev
+
+Setting ``LLAISYS_TRACE=<path>`` in the environment enables tracing at import time and
+writes the trace to ``<path>`` when the process exits.
+
+``enable_counters`` additionally attributes perf_event hardware counters to each op::
+
+    available = llaisys.trace.enable_counters()  # e.g. ["cycles", "instructions", ...]
+    model.generate(...)
+    for row in llaisys.trace.counters():
+        print(row["name"], row["calls"], row["ipc"])
+"""
+
+from .libllaisys import LIB_LLAISYS, LlaisysOpCounters
+
+COUNTERS = ["cycles", "instructions", "llc_misses", "task_clock_ns", "mem_bytes"]
+
+
+def enable() -> None:
+    LIB_LLAISYS.llaisysTraceEnable(1)
+
+
+def disable() -> None:
+    LIB_LLAISYS.llaisysTraceEnable(0)
+
+
+def clear() -> None:
+    """Drops the events recorded so far."""
+    LIB_LLAISYS.llaisysTraceClear()
+
+
+def dump(path: str) -> int:
+    """Writes the recorded events to ``path`` and returns how many were written."""
+    return LIB_LLAISYS.llaisysTraceDump(str(path).encode("utf-8"))
+
+
+def enable_counters() -> list:
+    """Starts per-op counters and returns the names of those the system allows.
+
+    Counters missing from the list (perf restricted, no PMU) always read 0."""
+    mask = LIB_LLAISYS.llaisysCountersEnable(1)
+    return [name for i, name in enumerate(COUNTERS) if mask & (1 << i)]
+
+
+def disable_counters() -> None:
+    LIB_LLAISYS.llaisysCountersEnable(0)
+
+
+def reset_counters() -> None:
+    LIB_LLAISYS.llaisysCountersReset()
+
+
+def counters() -> list:
+    """Per-op totals as dicts, sorted by op name, with derived ``ipc`` and ``llc_miss_per_kinst``."""
+    n = LIB_LLAISYS.llaisysCountersSummary(None, 0)
+    rows = (LlaisysOpCounters * n)()
+    n = min(n, LIB_LLAISYS.llaisysCountersSummary(rows, n))
+    result = []
+    for r in rows[:n]:
+        row = {"name": r.name.decode("utf-8"), "calls": r.calls, "time_ns": r.time_ns}
+        row.update({name: getattr(r, name) for name in COUNTERS})
+        row["ipc"] = r.instructions / r.cycles if r.cycles else 0.0
+        row["llc_miss_per_kinst"] = 1000.0 * r.llc_misses / r.instructions if r.instructions else 0.0
+        result.append(row)
+    return result
@@ -1,4 +1,5 @@
 #include "context.hpp"
+#include "../../device/runtime_api.hpp"
 #include "../../utils.hpp"
 #include <thread>
 
@@ -15,7 +16,7 @@ Context::Context() {
     // Create runtimes for each device type.
     // Activate the first available device. If no other device is available, activate CPU runtime.
     for (auto device_type : device_typs) {
-        const LlaisysRuntimeAPI *api_ = llaisysGetRuntimeAPI(device_type);
+        const LlaisysRuntimeAPI *api_ = device::getRuntimeAPI(device_type);
         int device_count = api_->get_device_count();
         std::vector<Runtime *> runtimes_(device_count);
         for (int device_id = 0; device_id < device_count; device_id++) {
@@ -52,7 +53,7 @@ Context::~Context() {
 void Context::setDevice(llaisysDeviceType_t device_type, int device_id) {
     // If doest not match the current runtime.
     if (_current_runtime == nullptr || _current_runtime->deviceType() != device_type || _current_runtime->deviceId() != device_id) {
-        auto runtimes = _runtime_map[device_type];
+        auto &runtimes = _runtime_map[device_type];
         CHECK_ARGUMENT((size_t)device_id < runtimes.size() && device_id >= 0, "invalid device id");
         if (_current_runtime != nullptr) {
             _current_runtime->_deactivate();
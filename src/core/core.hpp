@@ -9,6 +9,7 @@ using storage_t = std::shared_ptr<Storage>;
 class MemoryAllocator;
 
 class Runtime;
+class SharedRuntime;
 class Context;
 
 // Global function to get thread local context
@@ -0,0 +1,75 @@
+#include "graph.hpp"
+
+#include "../context/context.hpp"
+
+#include <utility>
+
+namespace llaisys::core {
+namespace {
+thread_local Graph *capturing = nullptr;
+} // namespace
+
+void Graph::replay() const {
+    if (device::cpu::Stream *stream = launchStream()) {
+        stream->enqueue([commands = _commands] {
+            for (const auto &command : *commands) {
+                command();
+            }
+        });
+        return;
+    }
+    if (!_markers.empty() && trace::measuring()) {
+        return replayTraced();
+    }
+    for (const auto &command : *_commands) {
+        command();
+    }
+}
+
+void Graph::replayTraced() const {
+    std::vector<std::pair<const trace::Label *, trace::Span>> open;
+    size_t m = 0;
+    const Commands &commands = *_commands;
+    for (size_t i = 0; i <= commands.size(); i++) {
+        for (; m < _markers.size() && _markers[m].at == i; m++) {
+            if (_markers[m].label) {
+                open.emplace_back(_markers[m].label.get(), trace::Span{});
+                open.back().second.open();
+            } else if (!open.empty()) {
+                open.back().second.close(*open.back().first);
+                open.pop_back();
+            }
+        }
+        if (i < commands.size()) {
+            commands[i]();
+        }
+    }
+}
+
+Graph *capturingGraph() {
+    return capturing;
+}
+
+device::cpu::Stream *launchStream() {
+    Runtime &runtime = context().runtime();
+    if (runtime.deviceType() != LLAISYS_DEVICE_CPU) {
+        return nullptr;
+    }
+    device::cpu::Stream *stream = device::cpu::toStream(runtime.stream());
+    if (stream && trace::measuring()) {
+        stream->synchronize();
+        return nullptr;
+    }
+    return stream;
+}
+
+GraphCapture::GraphCapture(Graph &graph) : _prev(capturing) {
+    capturing = &graph;
+    trace::beginCapture();
+}
+
+GraphCapture::~GraphCapture() {
+    trace::endCapture();
+    capturing = _prev;
+}
+} // namespace llaisys::core
@@ -0,0 +1,89 @@
+#pragma once
+
+#include "../../device/cpu/cpu_stream.hpp"
+#include "../trace/trace.hpp"
+
+#include <functional>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace llaisys::core {
+// 命令图：捕获期间，算子照常完成校验、形状推导与设备/类型分派，但不执行内核，
+// 而是把解析好的调用（内核函数、数据指针与形状）记录为一条命令；回放时按顺序直接执行，
+// 不再经过算子层。命令只持有裸指针，所引用的张量须在图的生命周期内保持不变；
+// 随步数变化的量（token id、位置、KV 写入行与有效长度）由内核在执行时从张量中读取，
+// 回放前更新这些张量的内容即可。
+//
+// 捕获时的 trace 作用域记为命令之间的标记（label 为空表示结束），回放时只有开启 trace 或计数器才逐个计时，
+// 关闭时与没有标记的图一样直接顺序执行。回放整体作为一个任务提交到 CPU 流，
+// 任务持有命令列表的引用，回放后立即 clear 或销毁图是安全的。
+class Graph {
+private:
+    struct Marker {
+        size_t at; // 标记位于第 at 条命令之前
+        std::shared_ptr<const trace::Label> label;
+    };
+    using Commands = std::vector<std::function<void()>>;
+    std::shared_ptr<Commands> _commands = std::make_shared<Commands>();
+    std::vector<Marker> _markers;
+
+    void replayTraced() const;
+
+public:
+    void record(std::function<void()> command) { _commands->push_back(std::move(command)); }
+    void mark(std::shared_ptr<const trace::Label> label) { _markers.push_back({_commands->size(), std::move(label)}); }
+    void replay() const;
+    void clear() {
+        _commands = std::make_shared<Commands>();
+        _markers.clear();
+    }
+    bool empty() const { return _commands->empty(); }
+    size_t size() const { return _commands->size(); }
+};
+
+// 当前线程正在捕获的命令图，nullptr 表示算子立即执行
+Graph *capturingGraph();
+
+// 作用域内当前线程的算子调用记录到 graph 中（追加在已有命令之后）
+class GraphCapture {
+private:
+    Graph *_prev;
+
+public:
+    explicit GraphCapture(Graph &graph);
+    ~GraphCapture();
+
+    GraphCapture(const GraphCapture &) = delete;
+    GraphCapture &operator=(const GraphCapture &) = delete;
+};
+
+// 当前线程运行时的 CPU 流，内核应在调用线程上立即执行时返回 nullptr：当前运行时不是 CPU、
+// 流被关闭（LLAISYS_CPU_STREAM=0），或开启了 trace / 计数器（此时先等流中已有的任务完成，保证计时准确）
+device::cpu::Stream *launchStream();
+
+// 算子的内核调用入口：参数按值绑定，捕获时记录为命令，否则提交到当前线程的 CPU 流异步执行。
+// 内核只能引用数据指针与按值传入的参数，张量内容在执行时才读取
+template <typename Fn, typename... Args>
+void launch(Fn *kernel, Args... args) {
+    if (Graph *graph = capturingGraph()) {
+        graph->record([kernel, args...] { kernel(args...); });
+    } else if (device::cpu::Stream *stream = launchStream()) {
+        stream->enqueue([kernel, args...] { kernel(args...); });
+    } else {
+        kernel(args...);
+    }
+}
+
+// 需要在执行时读取参数（如从张量中读取长度）的内核，以可调用对象的形式提交
+template <typename F>
+void launch(F &&command) {
+    if (Graph *graph = capturingGraph()) {
+        graph->record(std::forward<F>(command));
+    } else if (device::cpu::Stream *stream = launchStream()) {
+        stream->enqueue(std::forward<F>(command));
+    } else {
+        command();
+    }
+}
+} // namespace llaisys::core
@@ -5,5 +5,7 @@
 #include "core.hpp"
 
 #include "context/context.hpp"
+#include "graph/graph.hpp"
 #include "runtime/runtime.hpp"
+#include "trace/trace.hpp"
 #include "storage/storage.hpp"
@@ -1,22 +1,92 @@
 #include "runtime.hpp"
 
+#include "../../device/cpu/cpu_stream.hpp"
 #include "../../device/runtime_api.hpp"
 #include "../allocator/naive_allocator.hpp"
 
+#include <map>
+#include <utility>
+
 namespace llaisys::core {
-Runtime::Runtime(llaisysDeviceType_t device_type, int device_id)
-    : _device_type(device_type), _device_id(device_id), _is_active(false) {
+SharedRuntime::SharedRuntime(llaisysDeviceType_t device_type, int device_id)
+    : _device_type(device_type), _device_id(device_id) {
     _api = llaisys::device::getRuntimeAPI(_device_type);
-    _stream = _api->create_stream();
     _allocator = new allocators::NaiveAllocator(_api);
 }
 
+SharedRuntime &SharedRuntime::get(llaisysDeviceType_t device_type, int device_id) {
+    // 登记表与其中的实例都不析构：静态对象析构阶段、线程退出之后释放的张量仍要用到它们
+    static std::mutex *mutex = new std::mutex;
+    static auto *runtimes = new std::map<std::pair<llaisysDeviceType_t, int>, SharedRuntime *>;
+    std::lock_guard<std::mutex> lock(*mutex);
+    SharedRuntime *&runtime = (*runtimes)[{device_type, device_id}];
+    if (runtime == nullptr) {
+        runtime = new SharedRuntime(device_type, device_id);
+    }
+    return *runtime;
+}
+
+llaisysDeviceType_t SharedRuntime::deviceType() const {
+    return _device_type;
+}
+
+int SharedRuntime::deviceId() const {
+    return _device_id;
+}
+
+const LlaisysRuntimeAPI *SharedRuntime::api() const {
+    return _api;
+}
+
+// Storage 对象与控制块在同一个池化的块中分配
+storage_t SharedRuntime::allocateDeviceStorage(size_t size) {
+    std::byte *memory;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        memory = _allocator->allocate(size);
+    }
+    return std::allocate_shared<Storage>(utils::PoolAllocator<Storage>(), memory, size, *this, false);
+}
+
+storage_t SharedRuntime::allocateHostStorage(size_t size) {
+    return std::allocate_shared<Storage>(utils::PoolAllocator<Storage>(), (std::byte *)_api->malloc_host(size), size,
+                                         *this, true);
+}
+
+storage_t SharedRuntime::wrapHostStorage(std::byte *memory, size_t size, std::shared_ptr<void> owner) {
+    return std::allocate_shared<Storage>(utils::PoolAllocator<Storage>(), memory, size, *this, true, std::move(owner));
+}
+
+// CPU 流中已入队的内核可能仍在读写这块内存（不一定来自释放它的线程），
+// 释放排在所有流已提交的任务之后；外部内存则延后放开对持有者的引用
+void SharedRuntime::freeStorage(Storage *storage) {
+    std::byte *memory = storage->memory();
+    if (storage->isExternal()) {
+        device::cpu::afterPending([owner = std::move(storage->_owner)]() mutable { owner.reset(); });
+    } else if (storage->isHost()) {
+        device::cpu::afterPending([api = _api, memory] { api->free_host(memory); });
+    } else {
+        device::cpu::afterPending([this, memory] {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _allocator->release(memory);
+        });
+    }
+}
+
+Runtime::Runtime(llaisysDeviceType_t device_type, int device_id)
+    : _device_type(device_type), _device_id(device_id), _shared(SharedRuntime::get(device_type, device_id)),
+      _is_active(false) {
+    _api = _shared.api();
+    // 流属于创建时的当前设备（CPU 节点设备的流绑定在节点上）
+    _api->set_device(_device_id);
+    _stream = _api->create_stream();
+}
+
 Runtime::~Runtime() {
     if (!_is_active) {
         std::cerr << "Mallicious destruction of inactive runtime." << std::endl;
     }
-    delete _allocator;
-    _allocator = nullptr;
+    // 执行完本线程流中排队的任务；内存归 SharedRuntime 管理，本线程的张量在线程退出后仍然有效
     _api->destroy_stream(_stream);
     _api = nullptr;
 }
@@ -47,19 +117,15 @@ const LlaisysRuntimeAPI *Runtime::api() const {
 }
 
 storage_t Runtime::allocateDeviceStorage(size_t size) {
-    return std::shared_ptr<Storage>(new Storage(_allocator->allocate(size), size, *this, false));
+    return _shared.allocateDeviceStorage(size);
 }
 
 storage_t Runtime::allocateHostStorage(size_t size) {
-    return std::shared_ptr<Storage>(new Storage((std::byte *)_api->malloc_host(size), size, *this, true));
+    return _shared.allocateHostStorage(size);
 }
 
-void Runtime::freeStorage(Storage *storage) {
-    if (storage->isHost()) {
-        _api->free_host(storage->memory());
-    } else {
-        _allocator->release(storage->memory());
-    }
+storage_t Runtime::wrapHostStorage(std::byte *memory, size_t size, std::shared_ptr<void> owner) {
+    return _shared.wrapHostStorage(memory, size, std::move(owner));
 }
 
 llaisysStream_t Runtime::stream() const {
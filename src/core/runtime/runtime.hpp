@@ -4,13 +4,45 @@
 #include "../../device/runtime_api.hpp"
 #include "../allocator/allocator.hpp"
 
+#include <mutex>
+
 namespace llaisys::core {
-class Runtime {
+// 进程内每个设备唯一的共享部分：运行时 API 与内存分配器。由全局登记表按需创建且永不析构，
+// 各线程的 Runtime 引用同一个实例。Storage 持有它而不是创建线程的 Runtime，
+// 因此张量（如只读共享的权重）可以在任意线程使用和释放，创建它的线程先退出也不受影响
+class SharedRuntime {
 private:
     llaisysDeviceType_t _device_type;
     int _device_id;
     const LlaisysRuntimeAPI *_api;
+    // 分配器实现不必线程安全，分配与释放都在 _mutex 下调用
+    std::mutex _mutex;
     MemoryAllocator *_allocator;
+    SharedRuntime(llaisysDeviceType_t device_type, int device_id);
+
+public:
+    static SharedRuntime &get(llaisysDeviceType_t device_type, int device_id);
+
+    SharedRuntime(const SharedRuntime &) = delete;
+    SharedRuntime &operator=(const SharedRuntime &) = delete;
+
+    llaisysDeviceType_t deviceType() const;
+    int deviceId() const;
+    const LlaisysRuntimeAPI *api() const;
+
+    storage_t allocateDeviceStorage(size_t size);
+    storage_t allocateHostStorage(size_t size);
+    storage_t wrapHostStorage(std::byte *memory, size_t size, std::shared_ptr<void> owner);
+    void freeStorage(Storage *storage);
+};
+
+// 线程私有的运行时：当前设备的激活状态与本线程的流，内存管理委托给设备的 SharedRuntime
+class Runtime {
+private:
+    llaisysDeviceType_t _device_type;
+    int _device_id;
+    const LlaisysRuntimeAPI *_api;
+    SharedRuntime &_shared;
     bool _is_active;
     void _activate();
     void _deactivate();
@@ -37,9 +69,9 @@ public:
     const LlaisysRuntimeAPI *api() const;
 
     storage_t allocateDeviceStorage(size_t size);
-    ;
     storage_t allocateHostStorage(size_t size);
-    void freeStorage(Storage *storage);
+    // Wraps host memory owned by `owner` without copying; the memory is released together with `owner`.
+    storage_t wrapHostStorage(std::byte *memory, size_t size, std::shared_ptr<void> owner);
 
     llaisysStream_t stream() const;
     void synchronize() const;
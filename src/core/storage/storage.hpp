@@ -3,6 +3,8 @@
 
 #include "../core.hpp"
 
+#include "../../utils/pool_allocator.hpp"
+
 #include <memory>
 
 namespace llaisys::core {
@@ -10,12 +12,15 @@ class Storage {
 private:
     std::byte *_memory;
     size_t _size;
-    Runtime &_runtime;
+    SharedRuntime &_runtime;
     bool _is_host;
-    Storage(std::byte *memory, size_t size, Runtime &runtime, bool is_host);
+    // Keeps externally owned memory (e.g. a file mapping) alive; such storage is never freed by the runtime.
+    std::shared_ptr<void> _owner;
+    Storage(std::byte *memory, size_t size, SharedRuntime &runtime, bool is_host, std::shared_ptr<void> owner = nullptr);
 
 public:
-    friend class Runtime;
+    friend class SharedRuntime;
+    friend struct utils::PoolAllocator<Storage>;
     ~Storage();
 
     std::byte *memory() const;
@@ -23,6 +28,7 @@ public:
     llaisysDeviceType_t deviceType() const;
     int deviceId() const;
     bool isHost() const;
+    bool isExternal() const;
 };
 
 }; // namespace llaisys::core
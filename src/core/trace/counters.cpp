@@ -0,0 +1,306 @@
+#include "counters.hpp"
+
+#include "trace.hpp"
+
+#include <chrono>
+#include <map>
+#include <mutex>
+
+#ifdef __linux__
+#include <dirent.h>
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#endif
+
+namespace llaisys::core::trace::counters {
+namespace {
+// 最外层作用域至多每隔这么久重新枚举一次线程
+constexpr auto kRescanInterval = std::chrono::milliseconds(100);
+
+struct ThreadCounters {
+    long tid;
+    int hw = -1; // 硬件事件组的组长（周期数），组内依次为 hw_order 中的事件
+    int sw = -1; // task-clock
+    std::vector<int> members;
+};
+
+struct State {
+    std::mutex mutex;
+    unsigned available = 0;
+    std::vector<Counter> hw_order;
+    std::vector<ThreadCounters> threads;
+    std::vector<int> imc; // uncore IMC 的 CAS 读 / 写计数
+    std::chrono::steady_clock::time_point last_scan;
+    std::map<std::string, Totals> totals;
+};
+
+State &state() {
+    static State s;
+    return s;
+}
+
+thread_local unsigned depth = 0;
+
+#ifdef __linux__
+int openEvent(uint32_t type, uint64_t config, long tid, int cpu, int group, uint64_t read_format) {
+    perf_event_attr attr{};
+    attr.size = sizeof(attr);
+    attr.type = type;
+    attr.config = config;
+    attr.read_format = read_format;
+    // perf_event_paranoid >= 2 时只允许统计用户态
+    attr.exclude_kernel = tid >= 0 ? 1 : 0;
+    attr.exclude_hv = 1;
+    return static_cast<int>(syscall(SYS_perf_event_open, &attr, static_cast<pid_t>(tid), cpu, group, 0));
+}
+
+uint64_t hwConfig(Counter c) {
+    switch (c) {
+    case CYCLES:
+        return PERF_COUNT_HW_CPU_CYCLES;
+    case INSTRUCTIONS:
+        return PERF_COUNT_HW_INSTRUCTIONS;
+    default:
+        return PERF_COUNT_HW_CACHE_MISSES;
+    }
+}
+
+// 为一个线程打开计数器。首个线程决定硬件事件组的组成，之后的线程按相同组成打开
+void openThread(State &s, long tid, bool first) {
+    ThreadCounters t{tid};
+    if (first) {
+        t.hw = openEvent(PERF_TYPE_HARDWARE, hwConfig(CYCLES), tid, -1, -1, PERF_FORMAT_GROUP);
+        if (t.hw >= 0) {
+            s.hw_order = {CYCLES};
+            for (Counter c : {INSTRUCTIONS, LLC_MISSES}) {
+                const int fd = openEvent(PERF_TYPE_HARDWARE, hwConfig(c), tid, -1, t.hw, PERF_FORMAT_GROUP);
+                if (fd >= 0) {
+                    s.hw_order.push_back(c);
+                    t.members.push_back(fd);
+                }
+            }
+        }
+    } else if (!s.hw_order.empty()) {
+        t.hw = openEvent(PERF_TYPE_HARDWARE, hwConfig(CYCLES), tid, -1, -1, PERF_FORMAT_GROUP);
+        for (size_t i = 1; t.hw >= 0 && i < s.hw_order.size(); i++) {
+            const int fd = openEvent(PERF_TYPE_HARDWARE, hwConfig(s.hw_order[i]), tid, -1, t.hw, PERF_FORMAT_GROUP);
+            if (fd >= 0) {
+                t.members.push_back(fd);
+            }
+        }
+    }
+    t.sw = openEvent(PERF_TYPE_SOFTWARE, PERF_COUNT_SW_TASK_CLOCK, tid, -1, -1, 0);
+    if (first) {
+        for (Counter c : s.hw_order) {
+            s.available |= 1u << c;
+        }
+        s.available |= t.sw >= 0 ? 1u << TASK_CLOCK : 0u;
+    }
+    s.threads.push_back(std::move(t));
+}
+
+void scanThreads(State &s) {
+    DIR *dir = opendir("/proc/self/task");
+    if (!dir) {
+        return;
+    }
+    while (dirent *entry = readdir(dir)) {
+        const long tid = std::strtol(entry->d_name, nullptr, 10);
+        if (tid <= 0) {
+            continue;
+        }
+        bool known = false;
+        for (const auto &t : s.threads) {
+            known = known || t.tid == tid;
+        }
+        if (!known) {
+            openThread(s, tid, s.threads.empty());
+        }
+    }
+    closedir(dir);
+    s.last_scan = std::chrono::steady_clock::now();
+}
+
+std::string readLine(const std::string &path) {
+    std::ifstream f(path);
+    std::string line;
+    std::getline(f, line);
+    return line;
+}
+
+// 按 sysfs 中 PMU 的 format/ 位段描述，把 events/<name> 的 "event=0x04,umask=0x03" 拼成 config
+bool pmuConfig(const std::string &pmu, const std::string &event, uint64_t &config) {
+    const std::string terms = readLine(pmu + "/events/" + event);
+    if (terms.empty()) {
+        return false;
+    }
+    config = 0;
+    std::stringstream ss(terms);
+    std::string term;
+    while (std::getline(ss, term, ',')) {
+        const size_t eq = term.find('=');
+        const std::string key = term.substr(0, eq);
+        const uint64_t value = eq == std::string::npos ? 1 : std::strtoull(term.c_str() + eq + 1, nullptr, 0);
+        const std::string format = readLine(pmu + "/format/" + key);
+        if (format.rfind("config:", 0) != 0) {
+            return false;
+        }
+        const unsigned lo = static_cast<unsigned>(std::strtoul(format.c_str() + 7, nullptr, 10));
+        config |= value << lo;
+    }
+    return true;
+}
+
+// 内存带宽只有 uncore IMC 能直接计数，且须按 CPU 全系统打开（通常要求 perf_event_paranoid <= 0）
+void openMemoryCounters(State &s) {
+    const std::string root = "/sys/bus/event_source/devices";
+    DIR *dir = opendir(root.c_str());
+    if (!dir) {
+        return;
+    }
+    while (dirent *entry = readdir(dir)) {
+        if (std::strncmp(entry->d_name, "uncore_imc", 10) != 0) {
+            continue;
+        }
+        const std::string pmu = root + "/" + entry->d_name;
+        const uint32_t type = static_cast<uint32_t>(std::strtoul(readLine(pmu + "/type").c_str(), nullptr, 10));
+        std::stringstream cpus(readLine(pmu + "/cpumask"));
+        std::string cpu;
+        while (std::getline(cpus, cpu, ',')) {
+            for (const char *event : {"cas_count_read", "cas_count_write"}) {
+                uint64_t config = 0;
+                if (!pmuConfig(pmu, event, config)) {
+                    continue;
+                }
+                const int fd = openEvent(type, config, -1, std::atoi(cpu.c_str()), -1, 0);
+                if (fd >= 0) {
+                    s.imc.push_back(fd);
+                }
+            }
+        }
+    }
+    closedir(dir);
+    s.available |= s.imc.empty() ? 0u : 1u << MEM_BYTES;
+}
+
+uint64_t readValue(int fd) {
+    uint64_t value = 0;
+    return fd >= 0 && ::read(fd, &value, sizeof(value)) == sizeof(value) ? value : 0;
+}
+
+void closeAll(State &s) {
+    for (const auto &t : s.threads) {
+        if (t.hw >= 0) {
+            close(t.hw);
+        }
+        if (t.sw >= 0) {
+            close(t.sw);
+        }
+        for (int fd : t.members) {
+            close(fd);
+        }
+    }
+    for (int fd : s.imc) {
+        close(fd);
+    }
+    s.threads.clear();
+    s.imc.clear();
+    s.hw_order.clear();
+    s.available = 0;
+}
+
+void readAll(const State &s, Snapshot &snapshot) {
+    snapshot.fill(0);
+    uint64_t group[1 + NUM_COUNTERS];
+    for (const auto &t : s.threads) {
+        if (t.hw >= 0 && ::read(t.hw, group, sizeof(group)) >= static_cast<ssize_t>(sizeof(uint64_t))) {
+            for (uint64_t i = 0; i < group[0] && i < s.hw_order.size(); i++) {
+                snapshot[s.hw_order[i]] += group[1 + i];
+            }
+        }
+        snapshot[TASK_CLOCK] += readValue(t.sw);
+    }
+    for (int fd : s.imc) {
+        snapshot[MEM_BYTES] += readValue(fd) * 64;
+    }
+}
+#else
+// 非 Linux 平台没有 perf_event，只统计调用次数与墙钟时间
+void scanThreads(State &s) {
+    s.last_scan = std::chrono::steady_clock::now();
+}
+void openMemoryCounters(State &) {}
+void closeAll(State &s) {
+    s.available = 0;
+}
+void readAll(const State &, Snapshot &snapshot) {
+    snapshot.fill(0);
+}
+#endif
+} // namespace
+
+bool enabled() {
+    return detail::state.load(std::memory_order_relaxed) & 2;
+}
+
+unsigned setEnabled(bool on) {
+    auto &s = state();
+    std::lock_guard<std::mutex> lock(s.mutex);
+    closeAll(s);
+    if (on) {
+        scanThreads(s);
+        openMemoryCounters(s);
+        detail::state.fetch_or(2, std::memory_order_relaxed);
+    } else {
+        detail::state.fetch_and(~2u, std::memory_order_relaxed);
+    }
+    return s.available;
+}
+
+unsigned available() {
+    auto &s = state();
+    std::lock_guard<std::mutex> lock(s.mutex);
+    return s.available;
+}
+
+void read(Snapshot &snapshot) {
+    auto &s = state();
+    std::lock_guard<std::mutex> lock(s.mutex);
+    if (depth++ == 0 && std::chrono::steady_clock::now() - s.last_scan >= kRescanInterval) {
+        scanThreads(s);
+    }
+    readAll(s, snapshot);
+}
+
+void accumulate(const char *name, uint64_t time_ns, const Snapshot &begin) {
+    auto &s = state();
+    std::lock_guard<std::mutex> lock(s.mutex);
+    depth--;
+    Snapshot end;
+    readAll(s, end);
+    Totals &t = s.totals[name];
+    t.calls++;
+    t.time_ns += time_ns;
+    for (size_t i = 0; i < NUM_COUNTERS; i++) {
+        t.values[i] += end[i] > begin[i] ? end[i] - begin[i] : 0;
+    }
+}
+
+std::vector<std::pair<std::string, Totals>> summary() {
+    auto &s = state();
+    std::lock_guard<std::mutex> lock(s.mutex);
+    return {s.totals.begin(), s.totals.end()};
+}
+
+void reset() {
+    auto &s = state();
+    std::lock_guard<std::mutex> lock(s.mutex);
+    s.totals.clear();
+}
+} // namespace llaisys::core::trace::counters
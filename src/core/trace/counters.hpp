@@ -0,0 +1,44 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace llaisys::core::trace::counters {
+// 硬件 / 软件计数器。位序与 C API 的 LLAISYS_COUNTER_* 掩码一致
+enum Counter : unsigned {
+    CYCLES = 0,       // 用户态周期数
+    INSTRUCTIONS = 1, // 用户态退休指令数
+    LLC_MISSES = 2,   // 末级缓存未命中
+    TASK_CLOCK = 3,   // 各线程 CPU 时间（ns），软件事件，受限环境下通常仍可用
+    MEM_BYTES = 4,    // 内存控制器读写字节（uncore IMC 的 CAS 计数 × 64），全系统计数
+    NUM_COUNTERS = 5,
+};
+
+using Snapshot = std::array<uint64_t, NUM_COUNTERS>;
+
+// 同名作用域的累计值：调用次数、墙钟时间与各计数器增量之和
+struct Totals {
+    uint64_t calls = 0;
+    uint64_t time_ns = 0;
+    Snapshot values{};
+};
+
+bool enabled();
+// 开启时为当前进程的各线程打开计数器，返回成功打开的计数器掩码（1 << Counter）；
+// perf_event_open 被禁止或硬件不支持的计数器不计入掩码，其增量恒为 0。关闭时释放全部计数器
+unsigned setEnabled(bool enabled);
+unsigned available();
+
+// 读取各线程计数器之和。最外层作用域开始时顺带发现新线程（如 OpenMP 线程池），
+// 同一作用域内参与求和的线程集合保持不变
+void read(Snapshot &snapshot);
+// 把 [begin, now] 的增量计入 name 的累计值
+void accumulate(const char *name, uint64_t time_ns, const Snapshot &begin);
+
+// 按名称排序的累计值
+std::vector<std::pair<std::string, Totals>> summary();
+void reset();
+} // namespace llaisys::core::trace::counters
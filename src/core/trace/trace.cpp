@@ -0,0 +1,247 @@
+#include "trace.hpp"
+
+#include "../graph/graph.hpp"
+
+#include "../../utils.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+namespace llaisys::core::trace {
+namespace detail {
+std::atomic<unsigned> state{0};
+} // namespace detail
+
+namespace {
+constexpr size_t kArgsLen = 112;
+constexpr size_t kDefaultEvents = size_t(1) << 16;
+
+struct Event {
+    const char *name;
+    uint64_t begin, end;
+    size_t bytes;
+    llaisysDataType_t dtype;
+    char args[kArgsLen];
+};
+
+// 每个线程一个定长环形缓冲区：只有所属线程写入 events 与 head（release），
+// dump 以 acquire 读取 head 后拷出最近的 capacity 条；clear 只移动 base，不与写入方竞争
+struct Ring {
+    uint32_t tid;
+    std::vector<Event> events;
+    std::atomic<uint64_t> head{0};
+    std::atomic<uint64_t> base{0};
+};
+
+struct Registry;
+size_t dumpTo(Registry &r, const std::string &path);
+
+// 全部缓冲区归注册表所有，线程退出后其事件仍可导出。mutex 只保护 rings 列表本身，
+// 即只在线程首次记录、clear 与 dump 时加锁。设置了 LLAISYS_TRACE=<path> 时启动即开启，
+// 进程退出时（注册表析构）导出到该路径
+struct Registry {
+    std::mutex mutex;
+    std::vector<std::unique_ptr<Ring>> rings;
+    std::chrono::steady_clock::time_point epoch = std::chrono::steady_clock::now();
+    size_t capacity = kDefaultEvents;
+    std::string exit_path;
+
+    Registry() {
+        if (const char *n = std::getenv("LLAISYS_TRACE_EVENTS")) {
+            capacity = std::max<size_t>(std::strtoull(n, nullptr, 10), 1);
+        }
+        if (const char *path = std::getenv("LLAISYS_TRACE"); path && *path) {
+            exit_path = path;
+            detail::state.fetch_or(1, std::memory_order_relaxed);
+        }
+    }
+    ~Registry() {
+        if (!exit_path.empty()) {
+            try {
+                dumpTo(*this, exit_path);
+            } catch (const std::exception &e) {
+                std::fprintf(stderr, "[llaisys] trace dump failed: %s\n", e.what());
+            }
+        }
+    }
+};
+
+Registry &registry() {
+    static Registry r;
+    return r;
+}
+
+// 确保环境变量在首个算子之前生效
+const bool kInitFromEnv = (registry(), true);
+
+Ring &localRing() {
+    thread_local Ring *ring = [] {
+        auto &r = registry();
+        std::lock_guard<std::mutex> lock(r.mutex);
+        auto owned = std::make_unique<Ring>();
+        owned->tid = static_cast<uint32_t>(r.rings.size() + 1);
+        owned->events.resize(r.capacity);
+        r.rings.push_back(std::move(owned));
+        return r.rings.back().get();
+    }();
+    return *ring;
+}
+
+void writeEscaped(std::ostream &os, const char *s) {
+    for (; *s; s++) {
+        if (*s == '"' || *s == '\\') {
+            os << '\\';
+        }
+        os << *s;
+    }
+}
+} // namespace
+
+bool enabled() {
+    return detail::state.load(std::memory_order_relaxed) & 1;
+}
+
+void setEnabled(bool enabled) {
+    if (enabled) {
+        detail::state.fetch_or(1, std::memory_order_relaxed);
+    } else {
+        detail::state.fetch_and(~1u, std::memory_order_relaxed);
+    }
+}
+
+void beginCapture() {
+    detail::state.fetch_add(4, std::memory_order_relaxed);
+}
+
+void endCapture() {
+    detail::state.fetch_sub(4, std::memory_order_relaxed);
+}
+
+uint64_t now() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                     std::chrono::steady_clock::now() - registry().epoch)
+                                     .count());
+}
+
+void record(const Label &label, uint64_t begin, uint64_t end) {
+    Ring &ring = localRing();
+    const uint64_t h = ring.head.load(std::memory_order_relaxed);
+    Event &e = ring.events[h % ring.events.size()];
+    e.name = label.name;
+    e.begin = begin;
+    e.end = end;
+    e.bytes = label.bytes;
+    e.dtype = label.dtype;
+    const size_t n = std::min(label.args.size(), kArgsLen - 1);
+    std::memcpy(e.args, label.args.data(), n);
+    e.args[n] = '\0';
+    ring.head.store(h + 1, std::memory_order_release);
+}
+
+void clear() {
+    auto &r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    for (auto &ring : r.rings) {
+        ring->base.store(ring->head.load(std::memory_order_acquire), std::memory_order_relaxed);
+    }
+}
+
+namespace {
+size_t dumpTo(Registry &r, const std::string &path) {
+    std::ofstream f(path);
+    if (!f.good()) {
+        throw std::runtime_error("Trace: cannot open " + path);
+    }
+    f << "{\"displayTimeUnit\": \"ns\", \"traceEvents\": [";
+    size_t count = 0;
+    bool separator = false;
+    char num[64];
+    std::lock_guard<std::mutex> lock(r.mutex);
+    for (const auto &ring : r.rings) {
+        const uint64_t head = ring->head.load(std::memory_order_acquire);
+        const uint64_t cap = ring->events.size();
+        const uint64_t first = std::max(ring->base.load(std::memory_order_relaxed), head > cap ? head - cap : 0);
+        f << (separator ? ",\n" : "\n") << "{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": " << ring->tid
+          << ", \"args\": {\"name\": \"llaisys-" << ring->tid << "\"}}";
+        separator = true;
+        for (uint64_t i = first; i < head; i++) {
+            const Event &e = ring->events[i % cap];
+            // Chrome trace 的时间单位为微秒
+            std::snprintf(num, sizeof(num), "%.3f, \"dur\": %.3f", e.begin * 1e-3, (e.end - e.begin) * 1e-3);
+            f << ",\n{\"name\": \"";
+            writeEscaped(f, e.name);
+            f << "\", \"cat\": \"llaisys\", \"ph\": \"X\", \"pid\": 1, \"tid\": " << ring->tid << ", \"ts\": " << num
+              << ", \"args\": {\"detail\": \"";
+            writeEscaped(f, e.args);
+            f << "\"";
+            if (e.bytes > 0) {
+                f << ", \"bytes\": " << e.bytes;
+            }
+            if (e.dtype != LLAISYS_DTYPE_INVALID) {
+                f << ", \"dtype\": \"" << utils::dtype_to_str(e.dtype) << "\"";
+            }
+            f << "}}";
+            count++;
+        }
+    }
+    f << "\n]}\n";
+    return count;
+}
+} // namespace
+
+size_t dump(const std::string &path) {
+    return dumpTo(registry(), path);
+}
+
+void Span::open() {
+    begin = now();
+    counted = counters::enabled();
+    if (counted) {
+        counters::read(values);
+    }
+}
+
+void Span::close(const Label &label) const {
+    const uint64_t end = now();
+    if (counted) {
+        counters::accumulate(label.name, end - begin, values);
+    }
+    if (enabled()) {
+        record(label, begin, end);
+    }
+}
+
+bool Scope::open() {
+    _captured = capturingGraph() != nullptr;
+    return _captured || measuring();
+}
+
+void Scope::start() {
+    if (_captured) {
+        capturingGraph()->mark(std::make_shared<const Label>(*_label));
+    } else {
+        _span.open();
+    }
+}
+
+void Scope::finish() {
+    if (_captured) {
+        // 捕获期间作用域内没有执行内核，只记下结束标记
+        if (Graph *graph = capturingGraph()) {
+            graph->mark(nullptr);
+        }
+    } else {
+        _span.close(*_label);
+    }
+    delete _label;
+    _label = nullptr;
+}
+} // namespace llaisys::core::trace
@@ -0,0 +1,96 @@
+#pragma once
+
+#include "llaisys.h"
+
+#include "counters.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+
+namespace llaisys::core::trace {
+// 一条记录的描述：name 须为静态字符串（算子名、"qwen2.layer" 等），
+// args 为张量摘要（如 "bfloat16[4,896] bfloat16[896,896]"），bytes 为读写张量的总字节数
+struct Label {
+    const char *name = nullptr;
+    std::string args;
+    llaisysDataType_t dtype = LLAISYS_DTYPE_INVALID;
+    size_t bytes = 0;
+};
+
+namespace detail {
+// 第 0 位为 trace 开关，第 1 位为计数器开关，其余位为各线程正在进行的图捕获数（每个捕获加 4）。
+// 合并为一个字，全部关闭且无捕获时 Scope 只有一次 relaxed 读与一个分支
+extern std::atomic<unsigned> state;
+} // namespace detail
+
+inline bool active() {
+    return detail::state.load(std::memory_order_relaxed) != 0;
+}
+
+// trace 或计数器至少开启一个，即作用域需要计时
+inline bool measuring() {
+    return detail::state.load(std::memory_order_relaxed) & 3;
+}
+
+bool enabled();
+void setEnabled(bool enabled);
+// 丢弃已记录的事件（不影响开关）
+void clear();
+// 把各线程环形缓冲区中的事件写成 Chrome / Perfetto 可读的 trace JSON，返回写出的事件数
+size_t dump(const std::string &path);
+
+// 图捕获开始 / 结束时调用：捕获期间即使未开启 trace，Scope 也要把标签记入图中
+void beginCapture();
+void endCapture();
+
+// 自 trace 时钟起点的纳秒数
+uint64_t now();
+// 向当前线程的环形缓冲区追加一条 [begin, end) 事件，只由本线程写入，无锁
+void record(const Label &label, uint64_t begin, uint64_t end);
+
+// 一段计时区间，Scope 与命令图回放共用：open 记下开始时刻（计数器开启时还读取计数器），
+// close 按当时的开关写入 trace 事件与计数器累计值
+struct Span {
+    uint64_t begin = 0;
+    bool counted = false;
+    counters::Snapshot values;
+
+    void open();
+    void close(const Label &label) const;
+};
+
+// 作用域计时：开启 trace 或计数器时度量作用域的起止；当前线程正在捕获命令图时不计时，
+// 而是在图中记入开始 / 结束标记，回放时按标记计时。describe 只在需要时才调用以填充标签。
+class Scope {
+private:
+    Label *_label = nullptr;
+    Span _span;
+    bool _captured = false;
+
+    bool open();
+    void start();
+    void finish();
+
+public:
+    template <typename Describe>
+    Scope(const char *name, Describe &&describe) {
+        if (active() && open()) {
+            _label = new Label;
+            _label->name = name;
+            std::forward<Describe>(describe)(*_label);
+            start();
+        }
+    }
+    ~Scope() {
+        if (_label) {
+            finish();
+        }
+    }
+
+    Scope(const Scope &) = delete;
+    Scope &operator=(const Scope &) = delete;
+};
+} // namespace llaisys::core::trace
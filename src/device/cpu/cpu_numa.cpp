@@ -0,0 +1,188 @@
+#include "cpu_numa.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+
+#ifdef __linux__
+#include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace llaisys::device::cpu {
+namespace {
+struct Device {
+    int node;
+    std::vector<int> cpus;
+};
+
+struct Topology {
+    size_t nnodes = 1;
+    std::vector<Device> devices; // 下标 0 为整机
+};
+
+// 解析 "0-3,8,10-11" 形式的列表
+std::vector<int> parseList(const std::string &text) {
+    std::vector<int> ids;
+    std::stringstream ss(text);
+    std::string range;
+    while (std::getline(ss, range, ',')) {
+        if (range.find_first_of("0123456789") == std::string::npos) {
+            continue;
+        }
+        const size_t dash = range.find('-');
+        const int first = std::stoi(range.substr(0, dash));
+        const int last = dash == std::string::npos ? first : std::stoi(range.substr(dash + 1));
+        for (int id = first; id <= last; id++) {
+            ids.push_back(id);
+        }
+    }
+    return ids;
+}
+
+std::string readFile(const std::string &path) {
+    std::ifstream in(path);
+    std::string text;
+    std::getline(in, text);
+    return text;
+}
+
+// 进程允许运行的 CPU
+std::vector<int> allowedCpus() {
+    std::vector<int> cpus;
+#ifdef __linux__
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    if (sched_getaffinity(0, sizeof(set), &set) == 0) {
+        for (int cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+            if (CPU_ISSET(cpu, &set)) {
+                cpus.push_back(cpu);
+            }
+        }
+    }
+#endif
+    if (cpus.empty()) {
+        for (int cpu = 0; cpu < static_cast<int>(std::max(1u, std::thread::hardware_concurrency())); cpu++) {
+            cpus.push_back(cpu);
+        }
+    }
+    return cpus;
+}
+
+// 节点 -> 其上进程允许运行的 CPU；没有 CPU 的节点（纯内存节点）不作为设备
+std::vector<Device> readNodes(const std::vector<int> &allowed) {
+    std::vector<Device> nodes;
+#ifdef __linux__
+    for (int node : parseList(readFile("/sys/devices/system/node/online"))) {
+        std::vector<int> cpus;
+        for (int cpu : parseList(readFile("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist"))) {
+            if (std::find(allowed.begin(), allowed.end(), cpu) != allowed.end()) {
+                cpus.push_back(cpu);
+            }
+        }
+        if (!cpus.empty()) {
+            nodes.push_back({node, std::move(cpus)});
+        }
+    }
+#endif
+    if (nodes.empty()) {
+        nodes.push_back({-1, allowed});
+    }
+    return nodes;
+}
+
+Topology detect() {
+    Topology topo;
+    const auto nodes = readNodes(allowedCpus());
+    topo.nnodes = nodes.size();
+    topo.devices.push_back({-1, {}});
+
+    size_t count = nodes.size() > 1 ? nodes.size() : 0;
+    if (const char *env = std::getenv("LLAISYS_CPU_DEVICES")) {
+        count = static_cast<size_t>(std::max(0, std::atoi(env)));
+    }
+    // 第 d 个节点设备位于节点 d % nnodes，是该节点上的第 d / nnodes 个设备
+    for (size_t d = 0; d < count; d++) {
+        const Device &node = nodes[d % nodes.size()];
+        const size_t share = count / nodes.size() + (d % nodes.size() < count % nodes.size() ? 1 : 0);
+        const size_t k = d / nodes.size();
+        const size_t begin = node.cpus.size() * k / share, end = node.cpus.size() * (k + 1) / share;
+        std::vector<int> cpus(node.cpus.begin() + begin, node.cpus.begin() + end);
+        // CPU 少于设备数时与同节点的设备共用整个节点
+        topo.devices.push_back({node.node, cpus.empty() ? node.cpus : std::move(cpus)});
+    }
+    return topo;
+}
+
+const Topology &topology() {
+    static const Topology topo = detect();
+    return topo;
+}
+
+const Device &device(int id) {
+    const auto &devices = topology().devices;
+    return devices[static_cast<size_t>(id) < devices.size() ? id : 0];
+}
+} // namespace
+
+int deviceCount() {
+    return static_cast<int>(topology().devices.size());
+}
+
+int deviceNode(int id) {
+    return device(id).node;
+}
+
+const std::vector<int> &deviceCpus(int id) {
+    return device(id).cpus;
+}
+
+void pinThread(int id) {
+#ifdef __linux__
+    const auto &cpus = deviceCpus(id);
+    if (cpus.empty()) {
+        return;
+    }
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (int cpu : cpus) {
+        CPU_SET(cpu, &set);
+    }
+    sched_setaffinity(0, sizeof(set), &set);
+#else
+    (void)id;
+#endif
+}
+
+bool placesMemory(int id) {
+    return topology().nnodes > 1 && deviceNode(id) >= 0;
+}
+
+void placeMemory(void *memory, size_t size, int id) {
+#if defined(__linux__) && defined(SYS_mbind)
+    const int node = deviceNode(id);
+    if (memory == nullptr || size == 0 || node < 0 || node >= 1024) {
+        return;
+    }
+    // 不依赖 libnuma，直接调用 mbind：MPOL_PREFERRED 在节点内存不足时退回其他节点，MPOL_MF_MOVE 迁移已有的页
+    constexpr int kMpolPreferred = 1;
+    constexpr unsigned kMpolMfMove = 1u << 1;
+    constexpr size_t kBits = 8 * sizeof(unsigned long);
+    unsigned long mask[1024 / kBits] = {};
+    mask[node / kBits] |= 1ul << (node % kBits);
+    const auto page = static_cast<uintptr_t>(sysconf(_SC_PAGESIZE));
+    const auto begin = reinterpret_cast<uintptr_t>(memory) & ~(page - 1);
+    const auto end = reinterpret_cast<uintptr_t>(memory) + size;
+    syscall(SYS_mbind, begin, end - begin, kMpolPreferred, mask, 1024 + 1, kMpolMfMove);
+#else
+    (void)memory;
+    (void)size;
+    (void)id;
+#endif
+}
+} // namespace llaisys::device::cpu
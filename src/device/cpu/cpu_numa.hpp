@@ -0,0 +1,23 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+namespace llaisys::device::cpu {
+// CPU 设备编号：0 号设备是整机（线程与内存都不绑定，与单设备时的行为一致）；
+// 有多个 NUMA 节点时，1..N 号设备各对应一个节点，其流的工作线程绑定在该节点的 CPU 上，
+// 设备内存优先从该节点分配。LLAISYS_CPU_DEVICES=N 指定节点设备的个数：多于节点数时按节点轮流分配，
+// 同一节点上的设备平分该节点的 CPU（单节点主机上也可以据此切分出多个设备）。
+// 所有 CPU 设备位于同一地址空间，内核可以读写任意设备的内存，只是跨节点访问更慢
+int deviceCount();
+// 设备绑定的 NUMA 节点，0 号设备与未知拓扑返回 -1
+int deviceNode(int device);
+// 设备可用的 CPU 编号，0 号设备返回空列表（不绑定）
+const std::vector<int> &deviceCpus(int device);
+// 把调用线程绑定到设备的 CPU 上，0 号设备不做任何事
+void pinThread(int device);
+// 设备内存是否需要按节点放置（多节点主机上的节点设备）
+bool placesMemory(int device);
+// 让 [memory, memory + size) 的页优先分配在设备的节点上（已分配的页随之迁移），失败时忽略
+void placeMemory(void *memory, size_t size, int device);
+} // namespace llaisys::device::cpu
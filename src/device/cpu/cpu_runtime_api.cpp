@@ -1,36 +1,60 @@
 #include "../runtime_api.hpp"
 
+#include "cpu_numa.hpp"
+#include "cpu_stream.hpp"
+
 #include <cstdlib>
 #include <cstring>
 
 namespace llaisys::device::cpu {
 
 namespace runtime_api {
+namespace {
+// 当前线程的 CPU 设备：决定新建流绑定的节点与设备内存放置的节点
+thread_local int current_device = 0;
+} // namespace
+
 int getDeviceCount() {
-    return 1;
+    return cpu::deviceCount();
 }
 
-void setDevice(int) {
-    // do nothing
+void setDevice(int device) {
+    current_device = device;
 }
 
+// 整个进程的屏障：等待所有线程的流
 void deviceSynchronize() {
-    // do nothing
+    cpu::synchronizeAll();
 }
 
+// 每个流有一个按序执行任务的工作线程；关闭流时返回空流，空流上的操作同步执行
 llaisysStream_t createStream() {
-    return (llaisysStream_t)0; // null stream
+    return cpu::streamsEnabled() ? cpu::createStream(current_device) : nullptr;
 }
 
 void destroyStream(llaisysStream_t stream) {
-    // do nothing
+    if (stream) {
+        cpu::destroyStream(cpu::toStream(stream));
+    }
 }
+
 void streamSynchronize(llaisysStream_t stream) {
-    // do nothing
+    if (stream) {
+        cpu::toStream(stream)->synchronize();
+    }
 }
 
+// 节点设备的内存按页对齐分配并放置到节点上；其余设备与单节点主机上直接 malloc
 void *mallocDevice(size_t size) {
-    return std::malloc(size);
+    if (!cpu::placesMemory(current_device)) {
+        return std::malloc(size);
+    }
+    void *memory = nullptr;
+    if (posix_memalign(&memory, 4096, size) != 0) {
+        return nullptr;
+    }
+    cpu::placeMemory(memory, size, current_device);
+    return memory;
 }
 
 void freeDevice(void *ptr) {
@@ -45,12 +69,39 @@ void freeHost(void *ptr) {
     freeDevice(ptr);
 }
 
+// 同步拷贝先等待调用线程的流（含其在各设备上的流）：源数据可能仍由已入队的内核写入，目标也可能仍被读取。
+// 其他线程的流不等待，各线程的张量由各自的流读写
 void memcpySync(void *dst, const void *src, size_t size, llaisysMemcpyKind_t kind) {
+    cpu::synchronizeThread();
     std::memcpy(dst, src, size);
 }
 
 void memcpyAsync(void *dst, const void *src, size_t size, llaisysMemcpyKind_t kind, llaisysStream_t stream) {
-    memcpySync(dst, src, size, kind);
+    if (stream) {
+        cpu::toStream(stream)->enqueue([=] { std::memcpy(dst, src, size); });
+    } else {
+        memcpySync(dst, src, size, kind);
+    }
+}
+
+llaisysEvent_t createEvent() {
+    return new cpu::Event;
+}
+
+void destroyEvent(llaisysEvent_t event) {
+    delete static_cast<cpu::Event *>(event);
+}
+
+void eventRecord(llaisysEvent_t event, llaisysStream_t stream) {
+    static_cast<cpu::Event *>(event)->record(cpu::toStream(stream));
+}
+
+void streamWaitEvent(llaisysStream_t stream, llaisysEvent_t event) {
+    static_cast<cpu::Event *>(event)->block(cpu::toStream(stream));
+}
+
+void eventSynchronize(llaisysEvent_t event) {
+    static_cast<cpu::Event *>(event)->synchronize();
 }
 
 static const LlaisysRuntimeAPI RUNTIME_API = {
@@ -65,7 +116,12 @@ static const LlaisysRuntimeAPI RUNTIME_API = {
     &mallocHost,
     &freeHost,
     &memcpySync,
-    &memcpyAsync};
+    &memcpyAsync,
+    &createEvent,
+    &destroyEvent,
+    &eventRecord,
+    &streamWaitEvent,
+    &eventSynchronize};
 
 } // namespace runtime_api
 
@@ -0,0 +1,247 @@
+#include "cpu_stream.hpp"
+
+#include "cpu_numa.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace llaisys::device::cpu {
+namespace {
+struct Registry {
+    std::mutex mutex;
+    std::vector<std::shared_ptr<Stream>> streams;
+};
+
+Registry &registry() {
+    static Registry r;
+    return r;
+}
+
+int ompThreads() {
+#ifdef _OPENMP
+    return omp_get_max_threads();
+#else
+    return 1;
+#endif
+}
+} // namespace
+
+Stream::Stream(int device)
+    : _device(device), _max_threads(static_cast<int>(deviceCpus(device).size())),
+      _owner(std::this_thread::get_id()), _worker(&Stream::run, this) {}
+
+Stream::~Stream() {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stop = true;
+    }
+    _ready.notify_one();
+    _worker.join();
+}
+
+void Stream::run() {
+    pinThread(_device);
+    std::unique_lock<std::mutex> lock(_mutex);
+    while (true) {
+        _ready.wait(lock, [&] { return _stop || !_tasks.empty(); });
+        if (_tasks.empty()) {
+            return;
+        }
+        Task task = std::move(_tasks.front());
+        _tasks.pop_front();
+        lock.unlock();
+#ifdef _OPENMP
+        if (task.nthreads != omp_get_max_threads()) {
+            omp_set_num_threads(task.nthreads);
+        }
+#endif
+        std::exception_ptr error;
+        try {
+            task.run();
+        } catch (...) {
+            error = std::current_exception();
+        }
+        // 任务持有的对象在锁外析构：析构时可能向本流提交释放任务
+        task.run = nullptr;
+        lock.lock();
+        if (error && !_error) {
+            _error = error;
+        }
+        _completed++;
+        _done.notify_all();
+    }
+}
+
+void Stream::enqueue(std::function<void()> task) {
+    const int nthreads = _max_threads > 0 ? std::min(ompThreads(), _max_threads) : ompThreads();
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _tasks.push_back({std::move(task), nthreads});
+        _submitted++;
+    }
+    _ready.notify_one();
+}
+
+void Stream::synchronize() {
+    if (onWorker()) {
+        return;
+    }
+    std::unique_lock<std::mutex> lock(_mutex);
+    _done.wait(lock, [&] { return _completed == _submitted; });
+    if (_error && ownedByCaller()) {
+        std::rethrow_exception(std::exchange(_error, nullptr));
+    }
+}
+
+bool Stream::idle() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _completed == _submitted;
+}
+
+uint64_t Stream::submitted() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _submitted;
+}
+
+void Stream::waitFor(uint64_t ticket) {
+    if (onWorker()) {
+        return;
+    }
+    std::unique_lock<std::mutex> lock(_mutex);
+    _done.wait(lock, [&] { return _completed >= ticket; });
+}
+
+bool Stream::onWorker() const {
+    return std::this_thread::get_id() == _worker.get_id();
+}
+
+bool Stream::ownedByCaller() const {
+    return std::this_thread::get_id() == _owner;
+}
+
+void Event::record(Stream *stream) {
+    _stream = stream;
+    _ticket = stream ? stream->submitted() : 0;
+}
+
+void Event::synchronize() const {
+    if (_stream) {
+        _stream->waitFor(_ticket);
+    }
+}
+
+void Event::block(Stream *stream) const {
+    if (!_stream) {
+        return;
+    }
+    if (!stream) {
+        // 空流上的操作同步执行，等待即可
+        return synchronize();
+    }
+    if (stream != _stream) {
+        stream->enqueue([source = _stream, ticket = _ticket] { source->waitFor(ticket); });
+    }
+}
+
+bool streamsEnabled() {
+    static const bool enabled = [] {
+        const char *env = std::getenv("LLAISYS_CPU_STREAM");
+        return env == nullptr || env[0] == '\0' || env[0] != '0';
+    }();
+    return enabled;
+}
+
+Stream *createStream(int device) {
+    auto stream = std::make_shared<Stream>(device);
+    auto &r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    r.streams.push_back(stream);
+    return stream.get();
+}
+
+void destroyStream(Stream *stream) {
+    // 先在登记状态下执行完已提交的任务，期间其他线程的延迟释放仍会等待本流
+    stream->waitFor(stream->submitted());
+    std::shared_ptr<Stream> owned;
+    {
+        auto &r = registry();
+        std::lock_guard<std::mutex> lock(r.mutex);
+        auto it = std::find_if(r.streams.begin(), r.streams.end(),
+                               [&](const std::shared_ptr<Stream> &s) { return s.get() == stream; });
+        if (it == r.streams.end()) {
+            return;
+        }
+        owned = std::move(*it);
+        r.streams.erase(it);
+    }
+    // owned 在锁外析构并等待工作线程退出：此间入队的释放任务可能需要访问登记表
+}
+
+void synchronizeAll() {
+    std::vector<std::shared_ptr<Stream>> streams;
+    {
+        auto &r = registry();
+        std::lock_guard<std::mutex> lock(r.mutex);
+        streams = r.streams;
+    }
+    for (const auto &stream : streams) {
+        stream->synchronize();
+    }
+}
+
+void synchronizeThread() {
+    std::vector<std::shared_ptr<Stream>> streams;
+    {
+        auto &r = registry();
+        std::lock_guard<std::mutex> lock(r.mutex);
+        for (const auto &stream : r.streams) {
+            if (stream->ownedByCaller()) {
+                streams.push_back(stream);
+            }
+        }
+    }
+    for (const auto &stream : streams) {
+        stream->synchronize();
+    }
+}
+
+void afterPending(std::function<void()> release) {
+    struct Pending {
+        std::atomic<size_t> left;
+        std::function<void()> release;
+    };
+    {
+        auto &r = registry();
+        std::lock_guard<std::mutex> lock(r.mutex);
+        std::vector<Stream *> busy;
+        for (const auto &stream : r.streams) {
+            if (!stream->idle()) {
+                busy.push_back(stream.get());
+            }
+        }
+        if (!busy.empty()) {
+            // 每个忙碌的流各排一个计数任务，最后一个执行到的流负责释放
+            auto pending = std::make_shared<Pending>();
+            pending->left = busy.size();
+            pending->release = std::move(release);
+            for (Stream *stream : busy) {
+                stream->enqueue([pending] {
+                    if (pending->left.fetch_sub(1) == 1) {
+                        pending->release();
+                    }
+                });
+            }
+            return;
+        }
+    }
+    release();
+}
+} // namespace llaisys::device::cpu
@@ -0,0 +1,93 @@
+#pragma once
+
+#include "llaisys.h"
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace llaisys::device::cpu {
+// CPU 上的流：一个专用工作线程按提交顺序逐个执行任务。enqueue 立即返回，调用线程可以在内核执行期间
+// 继续做主机端的工作；synchronize 等待已提交的任务全部完成。
+// 任务抛出的第一个异常被保存下来，在创建流的线程下一次 synchronize 时重新抛出（其后的任务照常执行）；
+// 其他线程等待本流时不取走异常，以免错误被报告给无关的线程而流的所有者继续运行。
+// 提交时记下调用线程的 OpenMP 线程数，工作线程执行前按它设置，内核的并行度与同步执行时一致。
+// 节点设备（见 cpu_numa.hpp）的流把工作线程绑定在节点的 CPU 上，线程数不超过节点的 CPU 数。
+class Stream {
+private:
+    struct Task {
+        std::function<void()> run;
+        int nthreads;
+    };
+
+    std::mutex _mutex;
+    std::condition_variable _ready; // 有新任务或要求退出
+    std::condition_variable _done;  // 完成数推进
+    std::deque<Task> _tasks;
+    uint64_t _submitted = 0;
+    uint64_t _completed = 0;
+    std::exception_ptr _error;
+    bool _stop = false;
+    int _device;
+    int _max_threads; // 0 表示不限制
+    std::thread::id _owner; // 创建流的线程
+    std::thread _worker;
+
+    void run();
+
+public:
+    explicit Stream(int device = 0);
+    // 执行完已提交的任务后退出工作线程，未取出的异常被丢弃
+    ~Stream();
+
+    Stream(const Stream &) = delete;
+    Stream &operator=(const Stream &) = delete;
+
+    void enqueue(std::function<void()> task);
+    void synchronize();
+    bool idle();
+    // 已提交的任务数，事件以它标记流中的位置
+    uint64_t submitted();
+    // 等待前 ticket 个任务完成（不检查异常）
+    void waitFor(uint64_t ticket);
+    // 调用线程是否为本流的工作线程：任务中不能等待自身所在的流
+    bool onWorker() const;
+    // 调用线程是否为创建本流的线程
+    bool ownedByCaller() const;
+};
+
+// 事件：record 记下流中当前的位置，synchronize 与其他流的 wait 等到该位置之前的任务全部完成。
+// 未 record 过的事件视为已完成
+class Event {
+private:
+    Stream *_stream = nullptr;
+    uint64_t _ticket = 0;
+
+public:
+    void record(Stream *stream);
+    void synchronize() const;
+    // 在 stream 中插入一个等待本事件的任务：stream 之后提交的任务在事件完成后才执行
+    void block(Stream *stream) const;
+};
+
+// LLAISYS_CPU_STREAM=0 时不创建流（返回空流），内核在调用线程上同步执行
+bool streamsEnabled();
+// 流由全局登记表持有，设备同步与延迟释放据此遍历所有流
+Stream *createStream(int device = 0);
+void destroyStream(Stream *stream);
+// 空流返回 nullptr
+inline Stream *toStream(llaisysStream_t stream) {
+    return static_cast<Stream *>(stream);
+}
+// 等待所有流完成已提交的任务（设备同步），重新抛出调用线程自己的流中的第一个异常
+void synchronizeAll();
+// 只等待调用线程创建的流：同步拷贝等主机端访问不必等其他线程排队的内核
+void synchronizeThread();
+// 在所有流已提交的任务都完成后执行 release（没有未完成任务时立即执行）。
+// 用于释放内存：已入队的内核可能仍在读写它，且未必来自释放它的线程的流
+void afterPending(std::function<void()> release);
+} // namespace llaisys::device::cpu
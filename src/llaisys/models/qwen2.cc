@@ -0,0 +1,232 @@
+#include "llaisys/models/qwen2.h"
+
+#include "../llaisys_tensor.hpp"
+
+#include "../../models/loader/packed.hpp"
+#include "../../models/qwen2/qwen2.hpp"
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+using llaisys::models::qwen2::Model;
+using llaisys::models::qwen2::Sequence;
+
+__C {
+    struct LlaisysQwen2Model {
+        std::unique_ptr<Model> model;
+        LlaisysQwen2Weights weights;
+        // Handles exposed through `weights`, sharing storage with the model tensors.
+        std::vector<std::unique_ptr<LlaisysTensor>> handles;
+        std::vector<std::vector<llaisysTensor_t>> layer_handles;
+    };
+
+    struct LlaisysQwen2Sequence : public Sequence {
+        using Sequence::Sequence;
+        LlaisysQwen2Model *owner = nullptr;
+    };
+}
+
+static llaisysTensor_t wrap(LlaisysQwen2Model *m, const llaisys::tensor_t &tensor) {
+    m->handles.emplace_back(new LlaisysTensor{tensor});
+    return m->handles.back().get();
+}
+
+static llaisysTensor_t *wrapLayers(LlaisysQwen2Model *m, const std::vector<llaisys::tensor_t> &tensors) {
+    std::vector<llaisysTensor_t> layer;
+    for (const auto &t : tensors) {
+        layer.push_back(wrap(m, t));
+    }
+    m->layer_handles.push_back(std::move(layer));
+    return m->layer_handles.back().data();
+}
+
+// Re-points the exposed handles after the model replaced its weight tensors.
+static void syncHandles(LlaisysQwen2Model *m) {
+    auto &w = m->model->weights();
+    auto &h = m->weights;
+    h.in_embed->tensor = w.in_embed;
+    h.out_embed->tensor = w.out_embed;
+    h.out_norm_w->tensor = w.out_norm_w;
+    for (size_t i = 0; i < m->model->meta().nlayer; i++) {
+        h.attn_norm_w[i]->tensor = w.attn_norm_w[i];
+        h.attn_q_w[i]->tensor = w.attn_q_w[i];
+        h.attn_q_b[i]->tensor = w.attn_q_b[i];
+        h.attn_k_w[i]->tensor = w.attn_k_w[i];
+        h.attn_k_b[i]->tensor = w.attn_k_b[i];
+        h.attn_v_w[i]->tensor = w.attn_v_w[i];
+        h.attn_v_b[i]->tensor = w.attn_v_b[i];
+        h.attn_o_w[i]->tensor = w.attn_o_w[i];
+        h.mlp_norm_w[i]->tensor = w.mlp_norm_w[i];
+        h.mlp_gate_w[i]->tensor = w.mlp_gate_w[i];
+        h.mlp_up_w[i]->tensor = w.mlp_up_w[i];
+        h.mlp_down_w[i]->tensor = w.mlp_down_w[i];
+    }
+}
+
+// Wraps a model and exposes its weight tensors through handles.
+static LlaisysQwen2Model *wrapModel(std::unique_ptr<Model> model) {
+    auto *m = new LlaisysQwen2Model;
+    m->model = std::move(model);
+
+    auto &w = m->model->weights();
+    m->layer_handles.reserve(12);
+    m->weights.in_embed = wrap(m, w.in_embed);
+    m->weights.out_embed = wrap(m, w.out_embed);
+    m->weights.out_norm_w = wrap(m, w.out_norm_w);
+    m->weights.attn_norm_w = wrapLayers(m, w.attn_norm_w);
+    m->weights.attn_q_w = wrapLayers(m, w.attn_q_w);
+    m->weights.attn_q_b = wrapLayers(m, w.attn_q_b);
+    m->weights.attn_k_w = wrapLayers(m, w.attn_k_w);
+    m->weights.attn_k_b = wrapLayers(m, w.attn_k_b);
+    m->weights.attn_v_w = wrapLayers(m, w.attn_v_w);
+    m->weights.attn_v_b = wrapLayers(m, w.attn_v_b);
+    m->weights.attn_o_w = wrapLayers(m, w.attn_o_w);
+    m->weights.mlp_norm_w = wrapLayers(m, w.mlp_norm_w);
+    m->weights.mlp_gate_w = wrapLayers(m, w.mlp_gate_w);
+    m->weights.mlp_up_w = wrapLayers(m, w.mlp_up_w);
+    m->weights.mlp_down_w = wrapLayers(m, w.mlp_down_w);
+    return m;
+}
+
+__C {
+    struct LlaisysQwen2Model *llaisysQwen2ModelCreate(const LlaisysQwen2Meta *meta, llaisysDeviceType_t device, int *device_ids, int ndevice) {
+        std::vector<int> ids;
+        if (device_ids != nullptr && ndevice > 0) {
+            ids.assign(device_ids, device_ids + ndevice);
+        }
+        return wrapModel(std::make_unique<Model>(*meta, device, ids));
+    }
+
+    struct LlaisysQwen2Model *llaisysQwen2ModelShare(struct LlaisysQwen2Model * model) {
+        return wrapModel(model->model->share());
+    }
+
+    void llaisysQwen2ModelDestroy(struct LlaisysQwen2Model * model) {
+        delete model;
+    }
+
+    const struct LlaisysQwen2Meta *llaisysQwen2ModelMeta(struct LlaisysQwen2Model * model) {
+        return &model->model->meta();
+    }
+
+    struct LlaisysQwen2Weights *llaisysQwen2ModelWeights(struct LlaisysQwen2Model * model) {
+        return &model->weights;
+    }
+
+    struct LlaisysQwen2Model *llaisysQwen2ModelLoad(const char *path, llaisysDeviceType_t device, int *device_ids, int ndevice) {
+        llaisys::models::loader::PackedFile file(path);
+        // Owned until loading succeeds, so a failing loadPacked does not leak the model.
+        std::unique_ptr<LlaisysQwen2Model> m(llaisysQwen2ModelCreate(&file.meta(), device, device_ids, ndevice));
+        m->model->loadPacked(file);
+        syncHandles(m.get());
+        return m.release();
+    }
+
+    void llaisysQwen2ModelSave(struct LlaisysQwen2Model * model, const char *path) {
+        model->model->savePacked(path);
+    }
+
+    void llaisysQwen2ModelLoadSafetensors(struct LlaisysQwen2Model * model, const char *path) {
+        model->model->loadSafetensors(path);
+        syncHandles(model);
+    }
+
+    void llaisysQwen2ModelQuantize(struct LlaisysQwen2Model * model, llaisysQwen2Quant_t type, size_t group_size) {
+        model->model->quantize(type, group_size == 0 ? 128 : group_size);
+        syncHandles(model);
+    }
+
+    void llaisysQwen2ModelSetActQuant(struct LlaisysQwen2Model * model, size_t min_tokens) {
+        model->model->setActQuant(min_tokens);
+    }
+
+    void llaisysQwen2ModelSetKVCacheDtype(struct LlaisysQwen2Model * model, llaisysDataType_t dtype) {
+        model->model->setKVCacheDtype(dtype);
+    }
+
+    void llaisysQwen2ModelSetDecodeGraph(struct LlaisysQwen2Model * model, uint8_t enabled) {
+        model->model->setDecodeGraph(enabled != 0);
+    }
+
+    int64_t llaisysQwen2ModelInfer(struct LlaisysQwen2Model * model, int64_t * token_ids, size_t ntoken) {
+        return model->model->infer(token_ids, ntoken);
+    }
+
+    void llaisysQwen2ModelSetSampling(struct LlaisysQwen2Model * model, const LlaisysSamplingParams *params, uint64_t seed) {
+        model->model->setSampling(*params, seed);
+    }
+
+    size_t llaisysQwen2ModelGenerate(struct LlaisysQwen2Model * model, int64_t * token_ids, size_t ntoken, size_t max_new_tokens, size_t ndraft, int64_t * out_tokens) {
+        auto generated = model->model->generate(token_ids, ntoken, max_new_tokens, ndraft);
+        std::copy(generated.begin(), generated.end(), out_tokens);
+        return generated.size();
+    }
+
+    size_t llaisysQwen2ModelGenerateStream(struct LlaisysQwen2Model * model, int64_t * token_ids, size_t ntoken, size_t max_new_tokens, size_t ndraft, const LlaisysSamplingParams *params, uint64_t seed, llaisysQwen2TokenCallback callback, void *user_data) {
+        const LlaisysSamplingParams greedy{0.0f, 0, 1.0f, 1.0f};
+        Model::TokenCallback on_token;
+        if (callback != nullptr) {
+            on_token = [callback, user_data](int64_t token) { return callback(token, user_data) == 0; };
+        }
+        return model->model->generate(token_ids, ntoken, max_new_tokens, ndraft, params ? *params : greedy, seed, on_token).size();
+    }
+
+    struct LlaisysQwen2Sequence *llaisysQwen2SequenceCreate(struct LlaisysQwen2Model * model, int64_t * token_ids, size_t ntoken, size_t max_new_tokens) {
+        auto seq = std::make_unique<LlaisysQwen2Sequence>(token_ids, ntoken, max_new_tokens);
+        seq->owner = model;
+        model->model->submit(seq.get());
+        return seq.release();
+    }
+
+    void llaisysQwen2SequenceSetSampling(struct LlaisysQwen2Sequence * seq, const LlaisysSamplingParams *params, uint64_t seed) {
+        seq->sampling = *params;
+        seq->rng_state = seed;
+    }
+
+    void llaisysQwen2SequenceDestroy(struct LlaisysQwen2Sequence * seq) {
+        if (seq == nullptr) {
+            return;
+        }
+        seq->owner->model->retire(seq);
+        delete seq;
+    }
+
+    uint8_t llaisysQwen2SequenceFinished(struct LlaisysQwen2Sequence * seq) {
+        return uint8_t(seq->finished);
+    }
+
+    size_t llaisysQwen2SequenceGetOutput(struct LlaisysQwen2Sequence * seq, int64_t * tokens) {
+        if (tokens != nullptr) {
+            std::copy(seq->tokens.begin() + seq->nprompt, seq->tokens.end(), tokens);
+        }
+        return seq->numGenerated();
+    }
+
+    void llaisysQwen2ModelSetMaxBatch(struct LlaisysQwen2Model * model, size_t max_batch) {
+        model->model->setMaxBatch(max_batch);
+    }
+
+    void llaisysQwen2ModelSetMaxStepTokens(struct LlaisysQwen2Model * model, size_t max_step_tokens) {
+        model->model->setMaxStepTokens(max_step_tokens);
+    }
+
+    size_t llaisysQwen2ModelNumPending(struct LlaisysQwen2Model * model) {
+        return model->model->numPending();
+    }
+
+    size_t llaisysQwen2ModelStep(struct LlaisysQwen2Model * model, struct LlaisysQwen2Sequence * *seqs, int64_t * tokens, size_t capacity) {
+        std::vector<std::pair<Sequence *, int64_t>> emitted;
+        model->model->step(emitted);
+        size_t n = std::min(capacity, emitted.size());
+        for (size_t i = 0; i < n; i++) {
+            if (seqs != nullptr) {
+                seqs[i] = static_cast<LlaisysQwen2Sequence *>(emitted[i].first);
+            }
+            if (tokens != nullptr) {
+                tokens[i] = emitted[i].second;
+            }
+        }
+        return n;
+    }
+}
@@ -4,11 +4,23 @@
 
 #include "../ops/add/op.hpp"
 #include "../ops/argmax/op.hpp"
+#include "../ops/cast/op.hpp"
 #include "../ops/embedding/op.hpp"
+#include "../ops/kv_store/op.hpp"
 #include "../ops/linear/op.hpp"
+#include "../ops/linear_fp8/op.hpp"
+#include "../ops/linear_q4/op.hpp"
+#include "../ops/linear_q8/op.hpp"
+#include "../ops/linear_topk/op.hpp"
+#include "../ops/linear_w8a8/op.hpp"
+#include "../ops/quantize_fp8/op.hpp"
+#include "../ops/quantize_kv/op.hpp"
+#include "../ops/quantize_q4/op.hpp"
+#include "../ops/quantize_q8/op.hpp"
 #include "../ops/rearrange/op.hpp"
 #include "../ops/rms_norm/op.hpp"
 #include "../ops/rope/op.hpp"
+#include "../ops/sample/op.hpp"
 #include "../ops/self_attention/op.hpp"
 #include "../ops/swiglu/op.hpp"
 
@@ -25,6 +37,35 @@ __C {
     void llaisysLinear(llaisysTensor_t out, llaisysTensor_t in, llaisysTensor_t weight, llaisysTensor_t bias) {
         llaisys::ops::linear(out->tensor, in->tensor, weight->tensor, bias->tensor);
     }
+    void llaisysLinearQ8(llaisysTensor_t out, llaisysTensor_t in, llaisysTensor_t qweight, llaisysTensor_t scales, llaisysTensor_t bias) {
+        llaisys::ops::linear_q8(out->tensor, in->tensor, qweight->tensor, scales->tensor, bias ? bias->tensor : nullptr);
+    }
+    void llaisysQuantizeQ8(llaisysTensor_t qweight, llaisysTensor_t scales, llaisysTensor_t weight) {
+        llaisys::ops::quantize_q8(qweight->tensor, scales->tensor, weight->tensor);
+    }
+    void llaisysLinearW8A8(llaisysTensor_t out, llaisysTensor_t in, llaisysTensor_t qweight, llaisysTensor_t scales, llaisysTensor_t bias) {
+        llaisys::ops::linear_w8a8(out->tensor, in->tensor, qweight->tensor, scales->tensor, bias ? bias->tensor : nullptr);
+    }
+    void llaisysLinearQ4(llaisysTensor_t out, llaisysTensor_t in, llaisysTensor_t qweight, llaisysTensor_t scales, llaisysTensor_t zeros, llaisysTensor_t bias) {
+        llaisys::ops::linear_q4(out->tensor, in->tensor, qweight->tensor, scales->tensor,
+                                zeros ? zeros->tensor : nullptr, bias ? bias->tensor : nullptr);
+    }
+    void llaisysQuantizeQ4(llaisysTensor_t qweight, llaisysTensor_t scales, llaisysTensor_t zeros, llaisysTensor_t weight) {
+        llaisys::ops::quantize_q4(qweight->tensor, scales->tensor, zeros ? zeros->tensor : nullptr, weight->tensor);
+    }
+    void llaisysLinearFP8(llaisysTensor_t out, llaisysTensor_t in, llaisysTensor_t qweight, llaisysTensor_t scales, llaisysTensor_t bias) {
+        llaisys::ops::linear_fp8(out->tensor, in->tensor, qweight->tensor, scales->tensor, bias ? bias->tensor : nullptr);
+    }
+    void llaisysQuantizeFP8(llaisysTensor_t qweight, llaisysTensor_t scales, llaisysTensor_t weight) {
+        llaisys::ops::quantize_fp8(qweight->tensor, scales->tensor, weight->tensor);
+    }
+    void llaisysLinearTopK(llaisysTensor_t out_idx, llaisysTensor_t out_val, llaisysTensor_t in, llaisysTensor_t weight, llaisysTensor_t scales, llaisysTensor_t zeros, llaisysTensor_t logits) {
+        llaisys::ops::linear_topk(out_idx->tensor, out_val->tensor, in->tensor, weight->tensor, scales ? scales->tensor : nullptr,
+                                  zeros ? zeros->tensor : nullptr, logits ? logits->tensor : nullptr);
+    }
+    void llaisysCast(llaisysTensor_t out, llaisysTensor_t in) {
+        llaisys::ops::cast(out->tensor, in->tensor);
+    }
     void llaisysRearrange(llaisysTensor_t out, llaisysTensor_t in) {
         llaisys::ops::rearrange(out->tensor, in->tensor);
     }
@@ -37,6 +78,19 @@ __C {
     void llaisysSelfAttention(llaisysTensor_t attn_val, llaisysTensor_t q, llaisysTensor_t k, llaisysTensor_t v, float scale) {
         llaisys::ops::self_attention(attn_val->tensor, q->tensor, k->tensor, v->tensor, scale);
     }
+    void llaisysSelfAttentionQuantKV(llaisysTensor_t attn_val, llaisysTensor_t q, llaisysTensor_t k, llaisysTensor_t v, llaisysTensor_t k_scale, llaisysTensor_t v_scale, float scale) {
+        llaisys::ops::self_attention(attn_val->tensor, q->tensor, k->tensor, v->tensor, scale, k_scale->tensor, v_scale->tensor);
+    }
+    void llaisysQuantizeKV(llaisysTensor_t out, llaisysTensor_t scales, llaisysTensor_t in) {
+        llaisys::ops::quantize_kv(out->tensor, scales->tensor, in->tensor);
+    }
+    void llaisysKVStore(llaisysTensor_t cache, llaisysTensor_t scales, llaisysTensor_t src, llaisysTensor_t slots) {
+        llaisys::ops::kv_store(cache->tensor, scales ? scales->tensor : nullptr, src->tensor, slots->tensor);
+    }
+    void llaisysSample(llaisysTensor_t out_idx, llaisysTensor_t logits, const LlaisysSamplingParams *params, llaisysTensor_t rng_state, llaisysTensor_t history, llaisysTensor_t history_offsets) {
+        llaisys::ops::sample(out_idx->tensor, logits->tensor, params, rng_state->tensor,
+                             history ? history->tensor : nullptr, history_offsets ? history_offsets->tensor : nullptr);
+    }
     void llaisysSwiGLU(llaisysTensor_t out, llaisysTensor_t gate, llaisysTensor_t up) {
         llaisys::ops::swiglu(out->tensor, gate->tensor, up->tensor);
     }
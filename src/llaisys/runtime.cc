@@ -1,5 +1,9 @@
 #include "llaisys/runtime.h"
 #include "../core/context/context.hpp"
+#include "../core/trace/trace.hpp"
+
+#include <algorithm>
+#include <cstring>
 #include "../device/runtime_api.hpp"
 
 // Llaisys API for setting context runtime.
@@ -10,4 +14,42 @@ __C void llaisysSetContextRuntime(llaisysDeviceType_t device_type, int device_id
 // Llaisys API for getting the runtime APIs
 __C const LlaisysRuntimeAPI *llaisysGetRuntimeAPI(llaisysDeviceType_t device_type) {
     return llaisys::device::getRuntimeAPI(device_type);
-}
\ No newline at end of file
+}
+__C void llaisysTraceEnable(uint8_t enabled) {
+    llaisys::core::trace::setEnabled(enabled != 0);
+}
+
+__C void llaisysTraceClear() {
+    llaisys::core::trace::clear();
+}
+
+__C size_t llaisysTraceDump(const char *path) {
+    return llaisys::core::trace::dump(path);
+}
+
+__C uint32_t llaisysCountersEnable(uint8_t enabled) {
+    return llaisys::core::trace::counters::setEnabled(enabled != 0);
+}
+
+__C void llaisysCountersReset() {
+    llaisys::core::trace::counters::reset();
+}
+
+__C size_t llaisysCountersSummary(LlaisysOpCounters *out, size_t capacity) {
+    namespace counters = llaisys::core::trace::counters;
+    const auto summary = counters::summary();
+    for (size_t i = 0; i < std::min(capacity, summary.size()); i++) {
+        const auto &[name, t] = summary[i];
+        LlaisysOpCounters &o = out[i];
+        std::memset(o.name, 0, sizeof(o.name));
+        std::strncpy(o.name, name.c_str(), sizeof(o.name) - 1);
+        o.calls = t.calls;
+        o.time_ns = t.time_ns;
+        o.cycles = t.values[counters::CYCLES];
+        o.instructions = t.values[counters::INSTRUCTIONS];
+        o.llc_misses = t.values[counters::LLC_MISSES];
+        o.task_clock_ns = t.values[counters::TASK_CLOCK];
+        o.mem_bytes = t.values[counters::MEM_BYTES];
+    }
+    return summary.size();
+}
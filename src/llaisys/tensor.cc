@@ -1,6 +1,8 @@
 #include "llaisys_tensor.hpp"
 
-#include <vector>
+#include "../core/context/context.hpp"
+
+#include <algorithm>
 
 __C {
     llaisysTensor_t tensorCreate(
@@ -9,7 +11,8 @@ __C {
         llaisysDataType_t dtype,
         llaisysDeviceType_t device_type,
         int device_id) {
-        std::vector<size_t> shape_vec(shape, shape + ndim);
+        llaisys::shape_t shape_vec;
+        shape_vec.assign(shape, shape + ndim);
         return new LlaisysTensor{llaisys::Tensor::create(shape_vec, dtype, device_type, device_id)};
     }
 
@@ -20,6 +23,11 @@ __C {
 
     void *tensorGetData(
         llaisysTensor_t tensor) {
+        // 调用方会在主机端直接读写 CPU 张量：先等调用线程在该设备上的流中已提交的内核完成
+        if (tensor->tensor->deviceType() == LLAISYS_DEVICE_CPU) {
+            llaisys::core::context().setDevice(LLAISYS_DEVICE_CPU, tensor->tensor->deviceId());
+            llaisys::core::context().runtime().synchronize();
+        }
         return tensor->tensor->data();
     }
 
@@ -75,14 +83,16 @@ __C {
         llaisysTensor_t tensor,
         size_t * shape,
         size_t ndim) {
-        std::vector<size_t> shape_vec(shape, shape + ndim);
+        llaisys::shape_t shape_vec;
+        shape_vec.assign(shape, shape + ndim);
         return new LlaisysTensor{tensor->tensor->view(shape_vec)};
     }
 
     llaisysTensor_t tensorPermute(
         llaisysTensor_t tensor,
         size_t * order) {
-        std::vector<size_t> order_vec(order, order + tensor->tensor->ndim());
+        llaisys::shape_t order_vec;
+        order_vec.assign(order, order + tensor->tensor->ndim());
         return new LlaisysTensor{tensor->tensor->permute(order_vec)};
     }
 
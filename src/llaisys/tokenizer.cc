@@ -0,0 +1,72 @@
+#include "llaisys/tokenizer.h"
+
+#include "../models/tokenizer/tokenizer.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+using llaisys::models::tokenizer::Detokenizer;
+using llaisys::models::tokenizer::Tokenizer;
+
+__C {
+    struct LlaisysTokenizer : public Tokenizer {
+        using Tokenizer::Tokenizer;
+    };
+
+    struct LlaisysDetokenizer : public Detokenizer {
+        using Detokenizer::Detokenizer;
+    };
+
+    struct LlaisysTokenizer *llaisysTokenizerLoad(const char *path) {
+        return new LlaisysTokenizer(path);
+    }
+
+    void llaisysTokenizerDestroy(struct LlaisysTokenizer * tokenizer) {
+        delete tokenizer;
+    }
+
+    size_t llaisysTokenizerVocabSize(struct LlaisysTokenizer * tokenizer) {
+        return tokenizer->vocabSize();
+    }
+
+    uint8_t llaisysTokenizerRequiresNFC(struct LlaisysTokenizer * tokenizer) {
+        return tokenizer->nfc();
+    }
+
+    size_t llaisysTokenizerEncode(struct LlaisysTokenizer * tokenizer, const char *text, size_t len, int64_t *ids, size_t capacity) {
+        std::vector<int64_t> out;
+        out.reserve(std::min(len, capacity));
+        tokenizer->encode(std::string_view(text, len), out);
+        std::copy_n(out.begin(), std::min(out.size(), capacity), ids);
+        return out.size();
+    }
+
+    size_t llaisysTokenizerDecode(struct LlaisysTokenizer * tokenizer, const int64_t *ids, size_t ntoken, uint8_t skip_special, char *text, size_t capacity) {
+        const std::string out = tokenizer->decode(ids, ntoken, skip_special);
+        if (text != nullptr) {
+            std::memcpy(text, out.data(), std::min(out.size(), capacity));
+        }
+        return out.size();
+    }
+
+    struct LlaisysDetokenizer *llaisysDetokenizerCreate(struct LlaisysTokenizer * tokenizer, uint8_t skip_special) {
+        return new LlaisysDetokenizer(*tokenizer, skip_special);
+    }
+
+    void llaisysDetokenizerDestroy(struct LlaisysDetokenizer * detokenizer) {
+        delete detokenizer;
+    }
+
+    const char *llaisysDetokenizerStep(struct LlaisysDetokenizer * detokenizer, int64_t token, size_t *len) {
+        const std::string &out = detokenizer->step(token);
+        *len = out.size();
+        return out.data();
+    }
+
+    const char *llaisysDetokenizerFlush(struct LlaisysDetokenizer * detokenizer, size_t *len) {
+        const std::string &out = detokenizer->flush();
+        *len = out.size();
+        return out.data();
+    }
+}
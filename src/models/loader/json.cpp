@@ -0,0 +1,254 @@
+#include "json.hpp"
+
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+namespace llaisys::models::loader {
+namespace {
+class Parser {
+private:
+    const char *_p;
+    const char *_end;
+
+    [[noreturn]] void fail(const char *what) const {
+        throw std::runtime_error(std::string("JSON: ") + what);
+    }
+
+    void skipSpace() {
+        while (_p < _end && (*_p == ' ' || *_p == '\t' || *_p == '\n' || *_p == '\r')) {
+            _p++;
+        }
+    }
+
+    char peek() {
+        skipSpace();
+        if (_p >= _end) {
+            fail("unexpected end of input");
+        }
+        return *_p;
+    }
+
+    void expect(char c) {
+        if (peek() != c) {
+            fail("unexpected character");
+        }
+        _p++;
+    }
+
+    bool consume(char c) {
+        if (peek() == c) {
+            _p++;
+            return true;
+        }
+        return false;
+    }
+
+    void expectWord(const char *word) {
+        for (; *word != '\0'; word++, _p++) {
+            if (_p >= _end || *_p != *word) {
+                fail("invalid literal");
+            }
+        }
+    }
+
+    void appendUtf8(std::string &s, uint32_t cp) {
+        if (cp < 0x80) {
+            s += static_cast<char>(cp);
+        } else if (cp < 0x800) {
+            s += static_cast<char>(0xC0 | (cp >> 6));
+            s += static_cast<char>(0x80 | (cp & 0x3F));
+        } else if (cp < 0x10000) {
+            s += static_cast<char>(0xE0 | (cp >> 12));
+            s += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+            s += static_cast<char>(0x80 | (cp & 0x3F));
+        } else {
+            s += static_cast<char>(0xF0 | (cp >> 18));
+            s += static_cast<char>(0x80 | ((cp >> 12) & 0x3F));
+            s += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+            s += static_cast<char>(0x80 | (cp & 0x3F));
+        }
+    }
+
+    uint32_t parseHex4() {
+        if (_end - _p < 4) {
+            fail("bad unicode escape");
+        }
+        uint32_t v = 0;
+        for (int i = 0; i < 4; i++, _p++) {
+            char c = *_p;
+            v <<= 4;
+            if (c >= '0' && c <= '9') {
+                v |= static_cast<uint32_t>(c - '0');
+            } else if (c >= 'a' && c <= 'f') {
+                v |= static_cast<uint32_t>(c - 'a' + 10);
+            } else if (c >= 'A' && c <= 'F') {
+                v |= static_cast<uint32_t>(c - 'A' + 10);
+            } else {
+                fail("bad unicode escape");
+            }
+        }
+        return v;
+    }
+
+    std::string parseString() {
+        expect('"');
+        std::string s;
+        while (_p < _end && *_p != '"') {
+            if (*_p != '\\') {
+                s += *_p++;
+                continue;
+            }
+            if (++_p >= _end) {
+                fail("bad escape");
+            }
+            char c = *_p++;
+            switch (c) {
+            case 'n': s += '\n'; break;
+            case 't': s += '\t'; break;
+            case 'r': s += '\r'; break;
+            case 'b': s += '\b'; break;
+            case 'f': s += '\f'; break;
+            case 'u': {
+                uint32_t cp = parseHex4();
+                // UTF-16 代理对
+                if (cp >= 0xD800 && cp < 0xDC00 && _end - _p >= 6 && _p[0] == '\\' && _p[1] == 'u') {
+                    _p += 2;
+                    uint32_t low = parseHex4();
+                    cp = 0x10000 + ((cp - 0xD800) << 10) + (low - 0xDC00);
+                }
+                appendUtf8(s, cp);
+                break;
+            }
+            default: s += c; break;
+            }
+        }
+        if (_p >= _end) {
+            fail("unterminated string");
+        }
+        _p++;
+        return s;
+    }
+
+    void parseNumber(JsonValue &v) {
+        const char *start = _p;
+        bool integer = true;
+        if (_p < _end && *_p == '-') {
+            integer = false;
+            _p++;
+        }
+        while (_p < _end && ((*_p >= '0' && *_p <= '9') || *_p == '.' || *_p == 'e' || *_p == 'E' || *_p == '+' || *_p == '-')) {
+            if (*_p < '0' || *_p > '9') {
+                integer = false;
+            }
+            _p++;
+        }
+        std::string text(start, _p);
+        if (text.empty() || text == "-") {
+            fail("invalid number");
+        }
+        v.type = JsonValue::Type::Number;
+        v.number = std::strtod(text.c_str(), nullptr);
+        if (integer) {
+            v.is_uint = true;
+            v.uint = std::strtoull(text.c_str(), nullptr, 10);
+        }
+    }
+
+public:
+    Parser(const char *begin, const char *end) : _p(begin), _end(end) {}
+
+    JsonValue parseValue() {
+        JsonValue v;
+        char c = peek();
+        if (c == '{') {
+            _p++;
+            v.type = JsonValue::Type::Object;
+            if (consume('}')) {
+                return v;
+            }
+            do {
+                std::string key = parseString();
+                expect(':');
+                v.object[std::move(key)] = parseValue();
+            } while (consume(','));
+            expect('}');
+        } else if (c == '[') {
+            _p++;
+            v.type = JsonValue::Type::Array;
+            if (consume(']')) {
+                return v;
+            }
+            do {
+                v.array.push_back(parseValue());
+            } while (consume(','));
+            expect(']');
+        } else if (c == '"') {
+            v.type = JsonValue::Type::String;
+            v.string = parseString();
+        } else if (c == 't') {
+            expectWord("true");
+            v.type = JsonValue::Type::Bool;
+            v.boolean = true;
+        } else if (c == 'f') {
+            expectWord("false");
+            v.type = JsonValue::Type::Bool;
+        } else if (c == 'n') {
+            expectWord("null");
+        } else {
+            parseNumber(v);
+        }
+        return v;
+    }
+};
+} // namespace
+
+bool JsonValue::contains(const std::string &key) const {
+    return type == Type::Object && object.count(key) > 0;
+}
+
+const JsonValue &JsonValue::operator[](const std::string &key) const {
+    auto it = object.find(key);
+    if (type != Type::Object || it == object.end()) {
+        throw std::out_of_range("JSON: missing key " + key);
+    }
+    return it->second;
+}
+
+double JsonValue::asNumber() const {
+    if (type != Type::Number) {
+        throw std::runtime_error("JSON: value is not a number");
+    }
+    return number;
+}
+
+uint64_t JsonValue::asUInt() const {
+    if (type != Type::Number || !is_uint) {
+        throw std::runtime_error("JSON: value is not an unsigned integer");
+    }
+    return uint;
+}
+
+const std::string &JsonValue::asString() const {
+    if (type != Type::String) {
+        throw std::runtime_error("JSON: value is not a string");
+    }
+    return string;
+}
+
+JsonValue parseJson(const char *begin, const char *end) {
+    return Parser(begin, end).parseValue();
+}
+
+JsonValue parseJsonFile(const std::string &path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        throw std::runtime_error("JSON: cannot open " + path);
+    }
+    std::stringstream ss;
+    ss << file.rdbuf();
+    std::string text = ss.str();
+    return parseJson(text.data(), text.data() + text.size());
+}
+} // namespace llaisys::models::loader
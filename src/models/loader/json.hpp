@@ -0,0 +1,41 @@
+#pragma once
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace llaisys::models::loader {
+// 读取 config.json 与 safetensors 头部所需的最小 JSON 实现（只读 DOM）
+class JsonValue {
+public:
+    enum class Type {
+        Null,
+        Bool,
+        Number,
+        String,
+        Array,
+        Object,
+    };
+
+    Type type = Type::Null;
+    bool boolean = false;
+    double number = 0.0;
+    // 非负整数字面量另存一份，避免大偏移量经 double 丢失精度
+    bool is_uint = false;
+    uint64_t uint = 0;
+    std::string string;
+    std::vector<JsonValue> array;
+    std::map<std::string, JsonValue> object;
+
+    bool contains(const std::string &key) const;
+    // 对象成员访问，缺失时抛出异常
+    const JsonValue &operator[](const std::string &key) const;
+
+    double asNumber() const;
+    uint64_t asUInt() const;
+    const std::string &asString() const;
+};
+
+JsonValue parseJson(const char *begin, const char *end);
+JsonValue parseJsonFile(const std::string &path);
+} // namespace llaisys::models::loader
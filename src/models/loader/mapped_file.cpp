@@ -0,0 +1,93 @@
+#include "mapped_file.hpp"
+
+#include "../../core/llaisys_core.hpp"
+
+#include <stdexcept>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace llaisys::models::loader {
+
+std::shared_ptr<MappedFile> MappedFile::open(const std::string &path) {
+    std::shared_ptr<MappedFile> file(new MappedFile());
+    file->_data = nullptr;
+    file->_size = 0;
+#ifdef _WIN32
+    file->_file = nullptr;
+    file->_mapping = nullptr;
+    HANDLE handle = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                                FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (handle == INVALID_HANDLE_VALUE) {
+        throw std::runtime_error("MappedFile: cannot open " + path);
+    }
+    file->_file = handle;
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(handle, &size) || size.QuadPart == 0) {
+        throw std::runtime_error("MappedFile: cannot map empty file " + path);
+    }
+    file->_size = static_cast<size_t>(size.QuadPart);
+    HANDLE mapping = CreateFileMappingA(handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mapping == nullptr) {
+        throw std::runtime_error("MappedFile: cannot map " + path);
+    }
+    file->_mapping = mapping;
+    file->_data = static_cast<std::byte *>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+    if (file->_data == nullptr) {
+        throw std::runtime_error("MappedFile: cannot map " + path);
+    }
+#else
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("MappedFile: cannot open " + path);
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size == 0) {
+        ::close(fd);
+        throw std::runtime_error("MappedFile: cannot map empty file " + path);
+    }
+    void *addr = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (addr == MAP_FAILED) {
+        throw std::runtime_error("MappedFile: cannot map " + path);
+    }
+    file->_data = static_cast<std::byte *>(addr);
+    file->_size = static_cast<size_t>(st.st_size);
+#endif
+    return file;
+}
+
+MappedFile::~MappedFile() {
+#ifdef _WIN32
+    if (_data != nullptr) {
+        UnmapViewOfFile(_data);
+    }
+    if (_mapping != nullptr) {
+        CloseHandle(_mapping);
+    }
+    if (_file != nullptr) {
+        CloseHandle(_file);
+    }
+#else
+    if (_data != nullptr) {
+        munmap(_data, _size);
+    }
+#endif
+}
+
+tensor_t MappedFile::tensor(const std::vector<size_t> &shape, llaisysDataType_t dtype, size_t offset) {
+    // 整个映射共用一个 Storage，Storage 持有 MappedFile 的引用，张量存活期间映射不会被解除
+    auto storage = _storage.lock();
+    if (storage == nullptr) {
+        storage = core::context().runtime().wrapHostStorage(_data, _size, shared_from_this());
+        _storage = storage;
+    }
+    return Tensor::create(shape, dtype, storage, offset);
+}
+} // namespace llaisys::models::loader
@@ -0,0 +1,36 @@
+#pragma once
+#include "../../tensor/tensor.hpp"
+
+#include <memory>
+#include <string>
+
+namespace llaisys::models::loader {
+// 只读内存映射文件。映射在最后一个引用（包括由它创建的张量 Storage）释放时解除，
+// 同一主机上的多个进程映射同一文件时共享页缓存中的一份物理内存。
+class MappedFile : public std::enable_shared_from_this<MappedFile> {
+private:
+    std::byte *_data;
+    size_t _size;
+#ifdef _WIN32
+    void *_file;
+    void *_mapping;
+#endif
+    // 弱引用：Storage 持有 MappedFile，反向强引用会形成环
+    std::weak_ptr<core::Storage> _storage;
+
+    MappedFile() = default;
+
+public:
+    static std::shared_ptr<MappedFile> open(const std::string &path);
+    ~MappedFile();
+
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+
+    const std::byte *data() const { return _data; }
+    size_t size() const { return _size; }
+
+    // 零拷贝创建指向映射中 [offset, offset + nbytes) 的 CPU 张量。映射为只读，不能写入这些张量。
+    tensor_t tensor(const std::vector<size_t> &shape, llaisysDataType_t dtype, size_t offset);
+};
+} // namespace llaisys::models::loader
@@ -0,0 +1,189 @@
+#include "packed.hpp"
+
+#include "../../utils.hpp"
+
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+namespace llaisys::models::loader {
+namespace {
+size_t alignUp(size_t v) {
+    return (v + kPackedAlignment - 1) / kPackedAlignment * kPackedAlignment;
+}
+
+template <typename T>
+void put(std::string &buf, T v) {
+    buf.append(reinterpret_cast<const char *>(&v), sizeof(T));
+}
+
+class Reader {
+private:
+    const std::byte *_p;
+    const std::byte *_end;
+
+public:
+    Reader(const std::byte *begin, const std::byte *end) : _p(begin), _end(end) {}
+
+    template <typename T>
+    T get() {
+        if (static_cast<size_t>(_end - _p) < sizeof(T)) {
+            throw std::runtime_error("Packed: truncated index");
+        }
+        T v;
+        std::memcpy(&v, _p, sizeof(T));
+        _p += sizeof(T);
+        return v;
+    }
+
+    std::string getString(size_t len) {
+        if (static_cast<size_t>(_end - _p) < len) {
+            throw std::runtime_error("Packed: truncated index");
+        }
+        std::string s(reinterpret_cast<const char *>(_p), len);
+        _p += len;
+        return s;
+    }
+};
+} // namespace
+
+void writePacked(const std::string &path, const LlaisysQwen2Meta &meta,
+                 const std::vector<std::pair<std::string, tensor_t>> &tensors) {
+    // 1. 布局数据区：同一块内存只写一次
+    std::map<const std::byte *, size_t> written;
+    std::vector<const Tensor *> payload;
+    std::vector<size_t> offsets;
+    std::string index;
+    size_t data_size = 0;
+    for (const auto &[name, tensor] : tensors) {
+        CHECK_ARGUMENT(tensor->deviceType() == LLAISYS_DEVICE_CPU && tensor->isContiguous(),
+                       "Packed: tensors must be contiguous CPU tensors");
+        const std::byte *data = tensor->data();
+        size_t nbytes = tensor->numel() * tensor->elementSize();
+        auto it = written.find(data);
+        size_t offset;
+        if (it != written.end()) {
+            offset = it->second;
+        } else {
+            offset = alignUp(data_size);
+            data_size = offset + nbytes;
+            written.emplace(data, offset);
+            payload.push_back(tensor.get());
+            offsets.push_back(offset);
+        }
+        put<uint32_t>(index, static_cast<uint32_t>(name.size()));
+        index += name;
+        put<uint32_t>(index, static_cast<uint32_t>(tensor->dtype()));
+        put<uint32_t>(index, static_cast<uint32_t>(tensor->ndim()));
+        for (auto d : tensor->shape()) {
+            put<uint64_t>(index, d);
+        }
+        put<uint64_t>(index, offset);
+        put<uint64_t>(index, nbytes);
+    }
+
+    // 2. 头部
+    PackedHeader header{};
+    std::memcpy(header.magic, kPackedMagic, sizeof(kPackedMagic));
+    header.version = kPackedVersion;
+    header.ntensor = static_cast<uint32_t>(tensors.size());
+    header.index_offset = sizeof(PackedHeader);
+    header.dtype = static_cast<uint32_t>(meta.dtype);
+    header.nlayer = meta.nlayer;
+    header.hs = meta.hs;
+    header.nh = meta.nh;
+    header.nkvh = meta.nkvh;
+    header.dh = meta.dh;
+    header.di = meta.di;
+    header.maxseq = meta.maxseq;
+    header.voc = meta.voc;
+    header.epsilon = meta.epsilon;
+    header.theta = meta.theta;
+    header.end_token = meta.end_token;
+
+    // 3. 写出：头部、索引、填充到对齐边界，数据偏移相对于数据区起点
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        throw std::runtime_error("Packed: cannot create " + path);
+    }
+    const size_t data_begin = alignUp(sizeof(PackedHeader) + index.size());
+    out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    out.write(index.data(), static_cast<std::streamsize>(index.size()));
+    size_t pos = sizeof(PackedHeader) + index.size();
+    const std::string zeros(kPackedAlignment, '\0');
+    for (size_t i = 0; i < payload.size(); i++) {
+        size_t target = data_begin + offsets[i];
+        out.write(zeros.data(), static_cast<std::streamsize>(target - pos));
+        size_t nbytes = payload[i]->numel() * payload[i]->elementSize();
+        out.write(reinterpret_cast<const char *>(payload[i]->data()), static_cast<std::streamsize>(nbytes));
+        pos = target + nbytes;
+    }
+    if (!out) {
+        throw std::runtime_error("Packed: failed to write " + path);
+    }
+}
+
+PackedFile::PackedFile(const std::string &path) : _file(MappedFile::open(path)) {
+    if (_file->size() < sizeof(PackedHeader)) {
+        throw std::runtime_error("Packed: file too small: " + path);
+    }
+    PackedHeader header;
+    std::memcpy(&header, _file->data(), sizeof(header));
+    if (std::memcmp(header.magic, kPackedMagic, sizeof(kPackedMagic)) != 0) {
+        throw std::runtime_error("Packed: not a .llaisys file: " + path);
+    }
+    if (header.version != kPackedVersion) {
+        throw std::runtime_error("Packed: unsupported version, please convert the model again: " + path);
+    }
+    _meta.dtype = static_cast<llaisysDataType_t>(header.dtype);
+    _meta.nlayer = header.nlayer;
+    _meta.hs = header.hs;
+    _meta.nh = header.nh;
+    _meta.nkvh = header.nkvh;
+    _meta.dh = header.dh;
+    _meta.di = header.di;
+    _meta.maxseq = header.maxseq;
+    _meta.voc = header.voc;
+    _meta.epsilon = header.epsilon;
+    _meta.theta = header.theta;
+    _meta.end_token = header.end_token;
+
+    Reader reader(_file->data() + header.index_offset, _file->data() + _file->size());
+    std::vector<std::pair<std::string, TensorInfo>> entries;
+    size_t index_end = header.index_offset;
+    for (uint32_t i = 0; i < header.ntensor; i++) {
+        std::string name = reader.getString(reader.get<uint32_t>());
+        TensorInfo info;
+        info.dtype = static_cast<llaisysDataType_t>(reader.get<uint32_t>());
+        info.shape.resize(reader.get<uint32_t>());
+        for (auto &d : info.shape) {
+            d = reader.get<uint64_t>();
+        }
+        info.offset = reader.get<uint64_t>();
+        info.nbytes = reader.get<uint64_t>();
+        index_end += sizeof(uint32_t) * 3 + name.size() + sizeof(uint64_t) * (info.shape.size() + 2);
+        entries.emplace_back(std::move(name), std::move(info));
+    }
+
+    const size_t data_begin = alignUp(index_end);
+    for (auto &[name, info] : entries) {
+        info.offset += data_begin;
+        size_t numel = 1;
+        for (auto d : info.shape) {
+            numel *= d;
+        }
+        if (info.offset + info.nbytes > _file->size() || numel * utils::dsize(info.dtype) != info.nbytes) {
+            throw std::runtime_error("Packed: corrupted tensor " + name);
+        }
+        _tensors.emplace(std::move(name), std::move(info));
+    }
+}
+
+tensor_t PackedFile::get(const std::string &name) const {
+    auto it = _tensors.find(name);
+    if (it == _tensors.end()) {
+        throw std::out_of_range("Packed: no tensor named " + name);
+    }
+    return _file->tensor(it->second.shape, it->second.dtype, it->second.offset);
+}
+} // namespace llaisys::models::loader
@@ -0,0 +1,52 @@
+#pragma once
+#include "llaisys/models/qwen2.h"
+
+#include "safetensors.hpp"
+
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace llaisys::models::loader {
+// .llaisys 打包格式（小端）：
+//   PackedHeader | 张量索引 | 按 kPackedAlignment 对齐的张量数据
+// 张量以引擎运行时使用的 dtype 与布局存放，加载时直接映射、无需任何计算。
+// 索引项：u32 名称长度、名称、u32 dtype、u32 ndim、u64 shape[ndim]、u64 偏移、u64 字节数。
+// 多个索引项可以指向同一段数据（如共享的 embedding 与 lm_head）。
+constexpr char kPackedMagic[8] = {'L', 'L', 'A', 'I', 'S', 'Y', 'S', '\0'};
+constexpr uint32_t kPackedVersion = 1;
+constexpr size_t kPackedAlignment = 64;
+
+struct PackedHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t ntensor;
+    uint64_t index_offset;
+    // LlaisysQwen2Meta 的定宽表示
+    uint32_t dtype;
+    uint32_t reserved;
+    uint64_t nlayer, hs, nh, nkvh, dh, di, maxseq, voc;
+    float epsilon, theta;
+    int64_t end_token;
+};
+
+// 写出 .llaisys 文件，tensors 须为 CPU 上的连续张量
+void writePacked(const std::string &path, const LlaisysQwen2Meta &meta,
+                 const std::vector<std::pair<std::string, tensor_t>> &tensors);
+
+class PackedFile {
+private:
+    std::shared_ptr<MappedFile> _file;
+    LlaisysQwen2Meta _meta;
+    std::map<std::string, TensorInfo> _tensors;
+
+public:
+    explicit PackedFile(const std::string &path);
+
+    const LlaisysQwen2Meta &meta() const { return _meta; }
+    const std::map<std::string, TensorInfo> &tensors() const { return _tensors; }
+    // 返回指向映射内存的只读 CPU 张量
+    tensor_t get(const std::string &name) const;
+};
+} // namespace llaisys::models::loader
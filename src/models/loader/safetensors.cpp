@@ -0,0 +1,117 @@
+#include "safetensors.hpp"
+
+#include "json.hpp"
+
+#include "../../ops/cast/cpu/cast_cpu.hpp"
+#include "../../utils.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <stdexcept>
+
+namespace llaisys::models::loader {
+namespace {
+llaisysDataType_t parseDtype(const std::string &name) {
+    static const std::map<std::string, llaisysDataType_t> table = {
+        {"BOOL", LLAISYS_DTYPE_BOOL},
+        {"U8", LLAISYS_DTYPE_U8},
+        {"I8", LLAISYS_DTYPE_I8},
+        {"U16", LLAISYS_DTYPE_U16},
+        {"I16", LLAISYS_DTYPE_I16},
+        {"U32", LLAISYS_DTYPE_U32},
+        {"I32", LLAISYS_DTYPE_I32},
+        {"U64", LLAISYS_DTYPE_U64},
+        {"I64", LLAISYS_DTYPE_I64},
+        {"F8_E4M3", LLAISYS_DTYPE_F8},
+        {"F8_E5M2", LLAISYS_DTYPE_F8E5M2},
+        {"F16", LLAISYS_DTYPE_F16},
+        {"BF16", LLAISYS_DTYPE_BF16},
+        {"F32", LLAISYS_DTYPE_F32},
+        {"F64", LLAISYS_DTYPE_F64},
+    };
+    auto it = table.find(name);
+    return it == table.end() ? LLAISYS_DTYPE_INVALID : it->second;
+}
+} // namespace
+
+SafeTensorsFile::SafeTensorsFile(const std::string &path) : _file(MappedFile::open(path)) {
+    const size_t file_size = _file->size();
+    if (file_size < 8) {
+        throw std::runtime_error("SafeTensors: file too small: " + path);
+    }
+    uint64_t header_len = 0;
+    for (int i = 7; i >= 0; i--) {
+        header_len = (header_len << 8) | static_cast<uint64_t>(_file->data()[i]);
+    }
+    if (header_len > file_size - 8) {
+        throw std::runtime_error("SafeTensors: header exceeds file size: " + path);
+    }
+    const char *header = reinterpret_cast<const char *>(_file->data() + 8);
+    const size_t data_begin = 8 + header_len;
+
+    auto root = parseJson(header, header + header_len);
+    for (const auto &[name, entry] : root.object) {
+        if (name == "__metadata__") {
+            continue;
+        }
+        TensorInfo info{parseDtype(entry["dtype"].asString()), {}, 0, 0};
+        for (const auto &d : entry["shape"].array) {
+            info.shape.push_back(d.asUInt());
+        }
+        const auto &offsets = entry["data_offsets"].array;
+        if (offsets.size() != 2 || offsets[0].asUInt() > offsets[1].asUInt()
+            || offsets[1].asUInt() > file_size - data_begin) {
+            throw std::runtime_error("SafeTensors: invalid data_offsets for " + name);
+        }
+        info.offset = data_begin + offsets[0].asUInt();
+        info.nbytes = offsets[1].asUInt() - offsets[0].asUInt();
+        if (info.dtype != LLAISYS_DTYPE_INVALID) {
+            size_t numel = 1;
+            for (auto d : info.shape) {
+                numel *= d;
+            }
+            if (numel * utils::dsize(info.dtype) != info.nbytes) {
+                throw std::runtime_error("SafeTensors: size mismatch for " + name);
+            }
+        }
+        _tensors.emplace(name, std::move(info));
+    }
+}
+
+tensor_t SafeTensorsFile::get(const std::string &name) const {
+    auto it = _tensors.find(name);
+    if (it == _tensors.end()) {
+        throw std::out_of_range("SafeTensors: no tensor named " + name);
+    }
+    const auto &info = it->second;
+    if (info.dtype == LLAISYS_DTYPE_INVALID) {
+        throw std::runtime_error("SafeTensors: unsupported dtype of " + name);
+    }
+    return _file->tensor(info.shape, info.dtype, info.offset);
+}
+
+std::vector<std::string> listSafeTensors(const std::string &path) {
+    namespace fs = std::filesystem;
+    std::vector<std::string> files;
+    if (!fs::is_directory(path)) {
+        files.push_back(path);
+        return files;
+    }
+    for (const auto &entry : fs::directory_iterator(path)) {
+        if (entry.is_regular_file() && entry.path().extension() == ".safetensors") {
+            files.push_back(entry.path().string());
+        }
+    }
+    std::sort(files.begin(), files.end());
+    if (files.empty()) {
+        throw std::runtime_error("SafeTensors: no *.safetensors file in " + path);
+    }
+    return files;
+}
+
+void convertDtype(std::byte *dst, llaisysDataType_t dst_dtype,
+                  const std::byte *src, llaisysDataType_t src_dtype, size_t numel) {
+    ops::cpu::cast(dst, dst_dtype, src, src_dtype, numel);
+}
+} // namespace llaisys::models::loader
@@ -0,0 +1,38 @@
+#pragma once
+#include "mapped_file.hpp"
+
+#include <map>
+#include <string>
+#include <vector>
+
+namespace llaisys::models::loader {
+struct TensorInfo {
+    llaisysDataType_t dtype; // 不支持的 safetensors 类型为 LLAISYS_DTYPE_INVALID
+    std::vector<size_t> shape;
+    size_t offset; // 相对文件起始处的字节偏移
+    size_t nbytes;
+};
+
+// safetensors 文件：8 字节小端头长度 + JSON 头 + 数据区。
+// 打开时只解析头部并映射整个文件，张量数据按需以零拷贝方式取出。
+class SafeTensorsFile {
+private:
+    std::shared_ptr<MappedFile> _file;
+    std::map<std::string, TensorInfo> _tensors;
+
+public:
+    explicit SafeTensorsFile(const std::string &path);
+
+    const std::map<std::string, TensorInfo> &tensors() const { return _tensors; }
+    bool contains(const std::string &name) const { return _tensors.count(name) > 0; }
+    // 返回指向映射内存的 CPU 张量，不拷贝数据
+    tensor_t get(const std::string &name) const;
+};
+
+// 列出 path 下的全部 *.safetensors 文件（按文件名排序）；path 为文件时直接返回它
+std::vector<std::string> listSafeTensors(const std::string &path);
+
+// 在 F32 / F16 / BF16 / F8 (E4M3、E5M2) 之间逐元素转换
+void convertDtype(std::byte *dst, llaisysDataType_t dst_dtype,
+                  const std::byte *src, llaisysDataType_t src_dtype, size_t numel);
+} // namespace llaisys::models::loader
@@ -0,0 +1,1194 @@
+#include "qwen2.hpp"
+
+#include "../../core/llaisys_core.hpp"
+#include "../../device/cpu/cpu_stream.hpp"
+#include "../../utils.hpp"
+
+#include "../../ops/add/op.hpp"
+#include "../../ops/argmax/op.hpp"
+#include "../../ops/embedding/op.hpp"
+#include "../../ops/kv_store/op.hpp"
+#include "../../ops/linear/op.hpp"
+#include "../../ops/linear_fp8/op.hpp"
+#include "../../ops/linear_q4/op.hpp"
+#include "../../ops/linear_q8/op.hpp"
+#include "../../ops/linear_topk/op.hpp"
+#include "../../ops/linear_w8a8/op.hpp"
+#include "../../ops/quantize_fp8/op.hpp"
+#include "../../ops/quantize_kv/op.hpp"
+#include "../../ops/quantize_q4/op.hpp"
+#include "../../ops/quantize_q8/op.hpp"
+#include "../../ops/rearrange/op.hpp"
+#include "../../ops/rms_norm/op.hpp"
+#include "../../ops/rope/op.hpp"
+#include "../../ops/sample/op.hpp"
+#include "../../ops/self_attention/op.hpp"
+#include "../../ops/swiglu/op.hpp"
+
+#include "../loader/json.hpp"
+#include "../loader/packed.hpp"
+#include "../loader/safetensors.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <numeric>
+
+namespace llaisys::models::qwen2 {
+
+Sequence::Sequence(const int64_t *token_ids, size_t ntoken, size_t max_new_tokens)
+    : tokens(token_ids, token_ids + ntoken), nprompt(ntoken), max_new_tokens(max_new_tokens) {}
+
+Model::Model(const LlaisysQwen2Meta &meta, llaisysDeviceType_t device, const std::vector<int> &device_ids,
+             Weights weights)
+    : _meta(meta), _device(device), _device_id(device_ids.size() == 1 ? device_ids[0] : 0),
+      _weights(std::move(weights)), _default_seq(nullptr, 0, 0), _max_batch(8), _max_step_tokens(0),
+      _act_quant_min_tokens(0), _kv_dtype(meta.dtype), _sampling(_default_seq.sampling), _seed(0),
+      _use_decode_graph(true) {
+    CHECK_ARGUMENT(meta.nlayer > 0 && meta.nh > 0 && meta.nkvh > 0 && meta.nh % meta.nkvh == 0,
+                   "Qwen2: invalid head configuration");
+    if (device_ids.size() > 1) {
+        CHECK_ARGUMENT(device == LLAISYS_DEVICE_CPU, "Qwen2: tensor parallelism is only supported on CPU");
+        CHECK_ARGUMENT(device_ids.size() <= meta.nkvh, "Qwen2: more devices than key/value heads");
+        _shard_devices = device_ids;
+    }
+}
+
+Model::Model(const LlaisysQwen2Meta &meta, llaisysDeviceType_t device, int device_id)
+    : Model(meta, device, std::vector<int>{device_id}) {}
+
+Model::Model(const LlaisysQwen2Meta &meta, llaisysDeviceType_t device, const std::vector<int> &device_ids)
+    : Model(meta, device, device_ids.empty() ? std::vector<int>{0} : device_ids, Weights{}) {
+
+    const size_t hs = meta.hs, dh = meta.dh, di = meta.di, voc = meta.voc;
+    const size_t q_out = meta.nh * dh, kv_out = meta.nkvh * dh;
+    auto dtype = meta.dtype;
+
+    _weights.in_embed = createTensor({voc, hs}, dtype);
+    _weights.out_embed = createTensor({voc, hs}, dtype);
+    _weights.out_norm_w = createTensor({hs}, dtype);
+    for (size_t i = 0; i < meta.nlayer; i++) {
+        _weights.attn_norm_w.push_back(createTensor({hs}, dtype));
+        _weights.attn_q_w.push_back(createTensor({q_out, hs}, dtype));
+        _weights.attn_q_b.push_back(createTensor({q_out}, dtype));
+        _weights.attn_k_w.push_back(createTensor({kv_out, hs}, dtype));
+        _weights.attn_k_b.push_back(createTensor({kv_out}, dtype));
+        _weights.attn_v_w.push_back(createTensor({kv_out, hs}, dtype));
+        _weights.attn_v_b.push_back(createTensor({kv_out}, dtype));
+        _weights.attn_o_w.push_back(createTensor({hs, q_out}, dtype));
+        _weights.mlp_norm_w.push_back(createTensor({hs}, dtype));
+        _weights.mlp_gate_w.push_back(createTensor({di, hs}, dtype));
+        _weights.mlp_up_w.push_back(createTensor({di, hs}, dtype));
+        _weights.mlp_down_w.push_back(createTensor({hs, di}, dtype));
+    }
+    for (auto *params : {&_weights.attn_q_s, &_weights.attn_k_s, &_weights.attn_v_s, &_weights.attn_o_s,
+                         &_weights.mlp_gate_s, &_weights.mlp_up_s, &_weights.mlp_down_s,
+                         &_weights.attn_q_z, &_weights.attn_k_z, &_weights.attn_v_z, &_weights.attn_o_z,
+                         &_weights.mlp_gate_z, &_weights.mlp_up_z, &_weights.mlp_down_z}) {
+        params->resize(meta.nlayer);
+    }
+}
+
+std::unique_ptr<Model> Model::share() const {
+    // 量化得到的权重可能仍在 CPU 流中写入，交给其他线程读取前须先完成
+    core::context().setDevice(_device, _device_id);
+    core::context().runtime().api()->device_synchronize();
+    const auto device_ids = _shard_devices.empty() ? std::vector<int>{_device_id} : _shard_devices;
+    std::unique_ptr<Model> model(new Model(_meta, _device, device_ids, _weights));
+    model->_shards = _shards;
+    model->_max_batch = _max_batch;
+    model->_max_step_tokens = _max_step_tokens;
+    model->_act_quant_min_tokens = _act_quant_min_tokens;
+    model->_kv_dtype = _kv_dtype;
+    model->_use_decode_graph = _use_decode_graph;
+    model->setSampling(_sampling, _seed);
+    return model;
+}
+
+tensor_t Model::createTensor(const shape_t &shape, llaisysDataType_t dtype) const {
+    return Tensor::create(shape, dtype, _device, _device_id);
+}
+
+tensor_t Model::createTensor(const shape_t &shape, llaisysDataType_t dtype, int device_id) const {
+    return Tensor::create(shape, dtype, _device, device_id);
+}
+
+namespace {
+// HuggingFace 每层权重名（去掉 "model.layers.<i>." 前缀）与权重槽、量化缩放系数槽、零点槽的对应关系，
+// 不参与量化的权重后两者为 nullptr
+struct LayerWeight {
+    const char *name;
+    std::vector<tensor_t> Weights::*weight;
+    std::vector<tensor_t> Weights::*scales;
+    std::vector<tensor_t> Weights::*zeros;
+};
+const LayerWeight kLayerWeights[] = {
+    {"input_layernorm.weight", &Weights::attn_norm_w, nullptr, nullptr},
+    {"self_attn.q_proj.weight", &Weights::attn_q_w, &Weights::attn_q_s, &Weights::attn_q_z},
+    {"self_attn.q_proj.bias", &Weights::attn_q_b, nullptr, nullptr},
+    {"self_attn.k_proj.weight", &Weights::attn_k_w, &Weights::attn_k_s, &Weights::attn_k_z},
+    {"self_attn.k_proj.bias", &Weights::attn_k_b, nullptr, nullptr},
+    {"self_attn.v_proj.weight", &Weights::attn_v_w, &Weights::attn_v_s, &Weights::attn_v_z},
+    {"self_attn.v_proj.bias", &Weights::attn_v_b, nullptr, nullptr},
+    {"self_attn.o_proj.weight", &Weights::attn_o_w, &Weights::attn_o_s, &Weights::attn_o_z},
+    {"post_attention_layernorm.weight", &Weights::mlp_norm_w, nullptr, nullptr},
+    {"mlp.gate_proj.weight", &Weights::mlp_gate_w, &Weights::mlp_gate_s, &Weights::mlp_gate_z},
+    {"mlp.up_proj.weight", &Weights::mlp_up_w, &Weights::mlp_up_s, &Weights::mlp_up_z},
+    {"mlp.down_proj.weight", &Weights::mlp_down_w, &Weights::mlp_down_s, &Weights::mlp_down_z},
+};
+const std::string kLayerPrefix = "model.layers.";
+const std::string kScaleSuffix = ".q_scale";
+const std::string kZeroSuffix = ".q_zero";
+
+bool stripSuffix(std::string &name, const std::string &suffix) {
+    if (name.size() > suffix.size() && name.compare(name.size() - suffix.size(), suffix.size(), suffix) == 0) {
+        name.resize(name.size() - suffix.size());
+        return true;
+    }
+    return false;
+}
+} // namespace
+
+LlaisysQwen2Meta loadConfig(const std::string &model_dir) {
+    auto config = loader::parseJsonFile(model_dir + "/config.json");
+    LlaisysQwen2Meta meta;
+    meta.dtype = LLAISYS_DTYPE_BF16;
+    if (config.contains("torch_dtype")) {
+        const auto &name = config["torch_dtype"].asString();
+        meta.dtype = name == "float32" ? LLAISYS_DTYPE_F32 : name == "float16" ? LLAISYS_DTYPE_F16 : LLAISYS_DTYPE_BF16;
+    }
+    meta.nlayer = config["num_hidden_layers"].asUInt();
+    meta.hs = config["hidden_size"].asUInt();
+    meta.nh = config["num_attention_heads"].asUInt();
+    meta.nkvh = config["num_key_value_heads"].asUInt();
+    meta.dh = meta.hs / meta.nh;
+    meta.di = config["intermediate_size"].asUInt();
+    meta.maxseq = config["max_position_embeddings"].asUInt();
+    meta.voc = config["vocab_size"].asUInt();
+    meta.epsilon = static_cast<float>(config["rms_norm_eps"].asNumber());
+    meta.theta = config.contains("rope_theta") ? static_cast<float>(config["rope_theta"].asNumber()) : 10000.0f;
+    meta.end_token = -1;
+    if (config.contains("eos_token_id")) {
+        const auto &eos = config["eos_token_id"];
+        meta.end_token = static_cast<int64_t>(eos.type == loader::JsonValue::Type::Array ? eos.array.at(0).asNumber() : eos.asNumber());
+    }
+    return meta;
+}
+
+tensor_t *Model::findWeight(const std::string &name) {
+    // "<name>.q_scale"、"<name>.q_zero" 为量化权重 <name> 的缩放系数与零点
+    std::string base = name;
+    const bool is_scale = stripSuffix(base, kScaleSuffix);
+    const bool is_zero = !is_scale && stripSuffix(base, kZeroSuffix);
+
+    if (base == "lm_head.weight") {
+        return is_scale ? &_weights.out_embed_s : is_zero ? &_weights.out_embed_z : &_weights.out_embed;
+    }
+    if (name == "model.embed_tokens.weight") {
+        return &_weights.in_embed;
+    }
+    if (name == "model.norm.weight") {
+        return &_weights.out_norm_w;
+    }
+
+    if (base.compare(0, kLayerPrefix.size(), kLayerPrefix) != 0) {
+        return nullptr;
+    }
+    size_t dot = base.find('.', kLayerPrefix.size());
+    if (dot == std::string::npos) {
+        return nullptr;
+    }
+    size_t layer = std::stoul(base.substr(kLayerPrefix.size(), dot - kLayerPrefix.size()));
+    if (layer >= _meta.nlayer) {
+        return nullptr;
+    }
+    const char *key = base.c_str() + dot + 1;
+    for (const auto &entry : kLayerWeights) {
+        if (std::strcmp(key, entry.name) == 0) {
+            if (is_scale || is_zero) {
+                auto member = is_scale ? entry.scales : entry.zeros;
+                return member ? &(_weights.*member)[layer] : nullptr;
+            }
+            return &(_weights.*entry.weight)[layer];
+        }
+    }
+    return nullptr;
+}
+
+std::vector<std::pair<std::string, tensor_t>> Model::namedWeights() const {
+    std::vector<std::pair<std::string, tensor_t>> named = {
+        {"model.embed_tokens.weight", _weights.in_embed},
+        {"lm_head.weight", _weights.out_embed},
+        {"model.norm.weight", _weights.out_norm_w},
+    };
+    if (_weights.out_embed_s) {
+        named.emplace_back("lm_head.weight" + kScaleSuffix, _weights.out_embed_s);
+    }
+    if (_weights.out_embed_z) {
+        named.emplace_back("lm_head.weight" + kZeroSuffix, _weights.out_embed_z);
+    }
+    for (size_t i = 0; i < _meta.nlayer; i++) {
+        for (const auto &entry : kLayerWeights) {
+            std::string name = kLayerPrefix + std::to_string(i) + "." + entry.name;
+            if (entry.scales && (_weights.*entry.scales)[i]) {
+                named.emplace_back(name + kScaleSuffix, (_weights.*entry.scales)[i]);
+            }
+            if (entry.zeros && (_weights.*entry.zeros)[i]) {
+                named.emplace_back(name + kZeroSuffix, (_weights.*entry.zeros)[i]);
+            }
+            named.emplace_back(std::move(name), (_weights.*entry.weight)[i]);
+        }
+    }
+    return named;
+}
+
+void Model::assignWeight(tensor_t &slot, const tensor_t &src) {
+    // 量化权重（int8 / 打包的 4-bit / fp8）与量化参数（槽在量化前为空）保持源 dtype 与形状
+    const bool quantized = src->dtype() == LLAISYS_DTYPE_I8 || src->dtype() == LLAISYS_DTYPE_U8
+                        || src->dtype() == LLAISYS_DTYPE_F8 || src->dtype() == LLAISYS_DTYPE_F8E5M2 || slot == nullptr;
+    const llaisysDataType_t dtype = quantized ? src->dtype() : _meta.dtype;
+    CHECK_ARGUMENT(quantized || src->shape() == slot->shape(), "Qwen2: weight shape mismatch");
+    if (src->dtype() == dtype && _device == LLAISYS_DEVICE_CPU && src->deviceId() == _device_id) {
+        // 零拷贝：权重直接指向文件映射，原先分配的张量随之释放。绑定节点的设备仍拷贝一份到节点内存
+        slot = src;
+        return;
+    }
+    // 槽中可能是只读映射或共享的张量，拷贝前先换成新分配的张量
+    slot = createTensor(src->shape(), dtype);
+    if (src->dtype() == dtype) {
+        slot->load(src->data());
+    } else {
+        std::vector<std::byte> buffer(slot->numel() * slot->elementSize());
+        loader::convertDtype(buffer.data(), _meta.dtype, src->data(), src->dtype(), src->numel());
+        slot->load(buffer.data());
+    }
+}
+
+void Model::loadSafetensors(const std::string &path) {
+    invalidateDecodeGraph();
+    _shards.clear();
+    bool has_lm_head = false;
+    for (const auto &file : loader::listSafeTensors(path)) {
+        loader::SafeTensorsFile st(file);
+        for (const auto &[name, info] : st.tensors()) {
+            tensor_t *slot = findWeight(name);
+            if (slot == nullptr) {
+                continue;
+            }
+            has_lm_head |= name == "lm_head.weight";
+            assignWeight(*slot, st.get(name));
+        }
+    }
+    if (!has_lm_head) {
+        _weights.out_embed = _weights.in_embed;
+    }
+}
+
+void Model::loadPacked(const loader::PackedFile &file) {
+    CHECK_ARGUMENT(file.meta().dtype == _meta.dtype && file.meta().nlayer == _meta.nlayer,
+                   "Qwen2: packed file does not match the model");
+    invalidateDecodeGraph();
+    _shards.clear();
+    for (const auto &[name, info] : file.tensors()) {
+        tensor_t *slot = findWeight(name);
+        CHECK_ARGUMENT(slot != nullptr, "Qwen2: unknown weight in packed file: " + name);
+        assignWeight(*slot, file.get(name));
+    }
+}
+
+void Model::savePacked(const std::string &path) const {
+    CHECK_ARGUMENT(_device == LLAISYS_DEVICE_CPU, "Qwen2: only CPU models can be packed");
+    // 量化得到的权重可能仍在 CPU 流中写入
+    core::context().setDevice(_device, _device_id);
+    core::context().runtime().synchronize();
+    loader::writePacked(path, _meta, namedWeights());
+}
+
+void Model::quantize(llaisysQwen2Quant_t type, size_t group_size) {
+    if (type == LLAISYS_QWEN2_QUANT_NONE) {
+        return;
+    }
+    invalidateDecodeGraph();
+    _shards.clear();
+    const bool fp8 = type == LLAISYS_QWEN2_QUANT_FP8 || type == LLAISYS_QWEN2_QUANT_FP8_E5M2;
+    CHECK_ARGUMENT(type == LLAISYS_QWEN2_QUANT_INT8 || type == LLAISYS_QWEN2_QUANT_INT4
+                       || type == LLAISYS_QWEN2_QUANT_INT4_ZP || fp8,
+                   "Qwen2: unsupported quantization type");
+    CHECK_ARGUMENT(type == LLAISYS_QWEN2_QUANT_INT8 || fp8 || (group_size > 0 && group_size % 32 == 0),
+                   "Qwen2: group_size must be a positive multiple of 32");
+
+    auto quantizeOne = [&](tensor_t &weight, tensor_t &scales, tensor_t &zeros) {
+        if (scales) {
+            return;
+        }
+        // 新建张量承接量化结果：原权重可能是只读映射，或与 in_embed 共享（tied lm_head）
+        const size_t rows = weight->shape()[0], cols = weight->shape()[1];
+        tensor_t qweight;
+        if (fp8) {
+            qweight = createTensor({rows, cols}, type == LLAISYS_QWEN2_QUANT_FP8 ? LLAISYS_DTYPE_F8 : LLAISYS_DTYPE_F8E5M2);
+            scales = createTensor({rows}, LLAISYS_DTYPE_F32);
+            ops::quantize_fp8(qweight, scales, weight);
+            weight = qweight;
+            return;
+        }
+        // in_features 不能被 group_size 整除的权重退回逐通道 int8，project 按 dtype 分派
+        if (type == LLAISYS_QWEN2_QUANT_INT8 || cols % group_size != 0) {
+            qweight = createTensor({rows, cols}, LLAISYS_DTYPE_I8);
+            scales = createTensor({rows}, LLAISYS_DTYPE_F32);
+            ops::quantize_q8(qweight, scales, weight);
+        } else {
+            qweight = createTensor({rows, cols / 2}, LLAISYS_DTYPE_U8);
+            scales = createTensor({rows, cols / group_size}, LLAISYS_DTYPE_F16);
+            if (type == LLAISYS_QWEN2_QUANT_INT4_ZP) {
+                zeros = createTensor({rows, cols / group_size}, LLAISYS_DTYPE_U8);
+            }
+            ops::quantize_q4(qweight, scales, zeros, weight);
+        }
+        weight = qweight;
+    };
+    for (size_t i = 0; i < _meta.nlayer; i++) {
+        for (const auto &entry : kLayerWeights) {
+            if (entry.scales) {
+                quantizeOne((_weights.*entry.weight)[i], (_weights.*entry.scales)[i], (_weights.*entry.zeros)[i]);
+            }
+        }
+    }
+    quantizeOne(_weights.out_embed, _weights.out_embed_s, _weights.out_embed_z);
+}
+
+void Model::setActQuant(size_t min_tokens) {
+    _act_quant_min_tokens = min_tokens;
+    invalidateDecodeGraph();
+}
+
+void Model::setKVCacheDtype(llaisysDataType_t dtype) {
+    CHECK_ARGUMENT(dtype == _meta.dtype || dtype == LLAISYS_DTYPE_I8 || dtype == LLAISYS_DTYPE_F8
+                       || dtype == LLAISYS_DTYPE_F8E5M2,
+                   "Qwen2: KV cache dtype must be the model dtype, int8 or float8");
+    CHECK_ARGUMENT(_running.empty() && _waiting.empty(), "Qwen2: cannot change the KV cache dtype with scheduled sequences");
+    if (dtype == _kv_dtype) {
+        return;
+    }
+    _kv_dtype = dtype;
+    invalidateDecodeGraph();
+    // 已有缓存的布局随类型改变，隐式序列从头重新 prefill
+    _default_seq.ncached = 0;
+    _default_seq.k_cache.clear();
+    _default_seq.v_cache.clear();
+    _default_seq.k_scale.clear();
+    _default_seq.v_scale.clear();
+}
+
+void Model::setSampling(const LlaisysSamplingParams &params, uint64_t seed) {
+    _sampling = params;
+    _seed = seed;
+    _default_seq.sampling = params;
+    _default_seq.rng_state = seed;
+}
+
+void Model::project(tensor_t out, tensor_t in, const tensor_t &weight, const tensor_t &scales, const tensor_t &zeros,
+                    tensor_t bias) {
+    switch (weight->dtype()) {
+    case LLAISYS_DTYPE_I8:
+        if (_act_quant_min_tokens > 0
+            && (_act_quant_rows > 0 ? _act_quant_rows : in->shape()[0]) >= _act_quant_min_tokens) {
+            return ops::linear_w8a8(out, in, weight, scales, bias);
+        }
+        return ops::linear_q8(out, in, weight, scales, bias);
+    case LLAISYS_DTYPE_U8:
+        return ops::linear_q4(out, in, weight, scales, zeros, bias);
+    case LLAISYS_DTYPE_F8:
+    case LLAISYS_DTYPE_F8E5M2:
+        return ops::linear_fp8(out, in, weight, scales, bias);
+    default:
+        return ops::linear(out, in, weight, bias);
+    }
+}
+
+void Model::reserveCache(Sequence &seq, size_t len) {
+    CHECK_ARGUMENT(len <= _meta.maxseq, "Qwen2: sequence exceeds maxseq");
+    size_t old_cap = seq.capacity();
+    if (len <= old_cap) {
+        return;
+    }
+    // 倍增扩容，摊销拷贝开销
+    size_t new_cap = std::min(_meta.maxseq, std::max({len, old_cap * 2, size_t(16)}));
+    const bool quantized = _kv_dtype != _meta.dtype;
+    // 分片时每层每个分片一块，第 layer * nshard + s 块位于分片 s 的设备上、只存该分片的 KV 头
+    const size_t nshard = std::max<size_t>(_shards.size(), 1);
+    const size_t ncache = _meta.nlayer * nshard;
+    seq.k_cache.resize(ncache);
+    seq.v_cache.resize(ncache);
+    seq.k_scale.resize(quantized ? ncache : 0);
+    seq.v_scale.resize(quantized ? ncache : 0);
+    auto grow = [&](tensor_t &cache, const shape_t &shape, llaisysDataType_t dtype, int device_id) {
+        auto fresh = createTensor(shape, dtype, device_id);
+        if (seq.ncached > 0) {
+            ops::rearrange(fresh->slice(0, 0, seq.ncached), cache->slice(0, 0, seq.ncached));
+        }
+        cache = fresh;
+    };
+    for (size_t i = 0; i < ncache; i++) {
+        const int device_id = _shards.empty() ? _device_id : _shards[i % nshard].device_id;
+        const size_t nkvh = _shards.empty() ? _meta.nkvh : _shards[i % nshard].nkvh;
+        grow(seq.k_cache[i], {new_cap, nkvh, _meta.dh}, _kv_dtype, device_id);
+        grow(seq.v_cache[i], {new_cap, nkvh, _meta.dh}, _kv_dtype, device_id);
+        if (quantized) {
+            grow(seq.k_scale[i], {new_cap, nkvh}, LLAISYS_DTYPE_F32, device_id);
+            grow(seq.v_scale[i], {new_cap, nkvh}, LLAISYS_DTYPE_F32, device_id);
+        }
+    }
+}
+
+namespace {
+// 融合 lm_head 保留的候选数上限：更大的 top_k 退回完整 logits，逐元素插入的代价不再可忽略
+constexpr size_t kMaxFusedTopK = 64;
+} // namespace
+
+Model::Activations Model::createActivations(size_t ntok) const {
+    return createActivations(ntok, _meta.nh, _meta.nkvh, _meta.di, _device_id);
+}
+
+Model::Activations Model::createActivations(size_t ntok, size_t nh, size_t nkvh, size_t di, int device_id) const {
+    const size_t hs = _meta.hs, dh = _meta.dh;
+    const auto dtype = _meta.dtype;
+    Activations a;
+    a.x = createTensor({ntok, hs}, dtype, device_id);
+    a.xn = createTensor({ntok, hs}, dtype, device_id);
+    a.q = createTensor({ntok, nh * dh}, dtype, device_id);
+    a.k = createTensor({ntok, nkvh * dh}, dtype, device_id);
+    a.v = createTensor({ntok, nkvh * dh}, dtype, device_id);
+    a.attn = createTensor({ntok, nh, dh}, dtype, device_id);
+    a.proj = createTensor({ntok, hs}, dtype, device_id);
+    a.gate = createTensor({ntok, di}, dtype, device_id);
+    a.up = createTensor({ntok, di}, dtype, device_id);
+    a.act = createTensor({ntok, di}, dtype, device_id);
+
+    a.q3 = a.q->view({ntok, nh, dh});
+    a.k3 = a.k->view({ntok, nkvh, dh});
+    a.v3 = a.v->view({ntok, nkvh, dh});
+    a.attn2 = a.attn->view({ntok, nh * dh});
+    return a;
+}
+
+void Model::attentionInput(const Weights &w, size_t layer, const Activations &a, const tensor_t &pos) {
+    ops::rms_norm(a.xn, a.x, w.attn_norm_w[layer], _meta.epsilon);
+    project(a.q, a.xn, w.attn_q_w[layer], w.attn_q_s[layer], w.attn_q_z[layer], w.attn_q_b[layer]);
+    project(a.k, a.xn, w.attn_k_w[layer], w.attn_k_s[layer], w.attn_k_z[layer], w.attn_k_b[layer]);
+    project(a.v, a.xn, w.attn_v_w[layer], w.attn_v_s[layer], w.attn_v_z[layer], w.attn_v_b[layer]);
+    ops::rope(a.q3, a.q3, pos, _meta.theta);
+    ops::rope(a.k3, a.k3, pos, _meta.theta);
+}
+
+void Model::attention(size_t cache, const std::vector<Segment> &segments, const Activations &a) {
+    const float scale = 1.0f / std::sqrt(static_cast<float>(_meta.dh));
+    size_t offset = 0;
+    for (const auto &seg : segments) {
+        auto &seq = *seg.seq;
+        size_t begin = seq.ncached, end = seq.ncached + seg.ntoken;
+        auto k_cache = seq.k_cache[cache];
+        auto v_cache = seq.v_cache[cache];
+        tensor_t k_scale, v_scale;
+        if (seq.k_scale.empty()) {
+            ops::rearrange(k_cache->slice(0, begin, end), a.k3->slice(0, offset, offset + seg.ntoken));
+            ops::rearrange(v_cache->slice(0, begin, end), a.v3->slice(0, offset, offset + seg.ntoken));
+        } else {
+            // 量化 KV Cache：新 token 的 K/V 量化后写入，注意力中逐行反量化
+            ops::quantize_kv(k_cache->slice(0, begin, end), seq.k_scale[cache]->slice(0, begin, end),
+                             a.k3->slice(0, offset, offset + seg.ntoken));
+            ops::quantize_kv(v_cache->slice(0, begin, end), seq.v_scale[cache]->slice(0, begin, end),
+                             a.v3->slice(0, offset, offset + seg.ntoken));
+            k_scale = seq.k_scale[cache]->slice(0, 0, end);
+            v_scale = seq.v_scale[cache]->slice(0, 0, end);
+        }
+        ops::self_attention(a.attn->slice(0, offset, offset + seg.ntoken),
+                            a.q3->slice(0, offset, offset + seg.ntoken),
+                            k_cache->slice(0, 0, end),
+                            v_cache->slice(0, 0, end),
+                            scale, k_scale, v_scale);
+        offset += seg.ntoken;
+    }
+}
+
+void Model::attentionOutput(size_t layer, const Activations &a) {
+    const auto &w = _weights;
+    project(a.proj, a.attn2, w.attn_o_w[layer], w.attn_o_s[layer], w.attn_o_z[layer], nullptr);
+    ops::add(a.x, a.x, a.proj);
+    mlp(w, layer, a, a.proj);
+    ops::add(a.x, a.x, a.proj);
+}
+
+void Model::mlp(const Weights &w, size_t layer, const Activations &a, tensor_t out) {
+    ops::rms_norm(a.xn, a.x, w.mlp_norm_w[layer], _meta.epsilon);
+    project(a.gate, a.xn, w.mlp_gate_w[layer], w.mlp_gate_s[layer], w.mlp_gate_z[layer], nullptr);
+    project(a.up, a.xn, w.mlp_up_w[layer], w.mlp_up_s[layer], w.mlp_up_z[layer], nullptr);
+    ops::swiglu(a.act, a.gate, a.up);
+    project(out, a.act, w.mlp_down_w[layer], w.mlp_down_s[layer], w.mlp_down_z[layer], nullptr);
+}
+
+tensor_t Model::copySlice(const tensor_t &src, size_t dim, size_t begin, size_t end, int device_id) const {
+    tensor_t view = src->slice(dim, begin, end);
+    if (!view->isContiguous()) {
+        // 列切片先在源设备上整理为连续张量
+        auto packed = Tensor::create(view->shape(), view->dtype(), src->deviceType(), src->deviceId());
+        ops::rearrange(packed, view);
+        view = packed;
+    }
+    auto dst = createTensor(view->shape(), view->dtype(), device_id);
+    core::context().runtime().api()->memcpy_sync(dst->data(), view->data(), view->numel() * view->elementSize(),
+                                                 LLAISYS_MEMCPY_D2D);
+    return dst;
+}
+
+void Model::buildShards() {
+    const size_t n = _shard_devices.size(), dh = _meta.dh, group = _meta.nh / _meta.nkvh;
+    // 中间维按 unit 对齐切分，使 4-bit 的 down 投影按列切分时边界尽量落在量化组上
+    const size_t unit = std::gcd(_meta.di, size_t(128));
+    CHECK_ARGUMENT(n <= _meta.di / unit, "Qwen2: more devices than MLP column blocks");
+    _shards.clear();
+    for (size_t s = 0; s < n; s++) {
+        Shard shard{_shard_devices[s], 0, 0, 0, Weights{}};
+        const size_t kv_begin = _meta.nkvh * s / n, kv_end = _meta.nkvh * (s + 1) / n;
+        const size_t di_begin = _meta.di / unit * s / n * unit, di_end = _meta.di / unit * (s + 1) / n * unit;
+        shard.nkvh = kv_end - kv_begin;
+        shard.nh = shard.nkvh * group;
+        shard.di = di_end - di_begin;
+        // 各投影权重按输出行切分的范围；o_proj 与 down 按输入列切分，范围与 q、gate 的行相同
+        const size_t q_begin = kv_begin * group * dh, q_end = kv_end * group * dh;
+        auto rowRange = [&](std::vector<tensor_t> Weights::*slot) -> std::pair<size_t, size_t> {
+            if (slot == &Weights::attn_q_w || slot == &Weights::attn_q_b || slot == &Weights::attn_o_w) {
+                return {q_begin, q_end};
+            }
+            if (slot == &Weights::attn_k_w || slot == &Weights::attn_k_b || slot == &Weights::attn_v_w
+                || slot == &Weights::attn_v_b) {
+                return {kv_begin * dh, kv_end * dh};
+            }
+            return {di_begin, di_end};
+        };
+
+        auto &w = shard.weights;
+        for (const auto &entry : kLayerWeights) {
+            (w.*entry.weight).resize(_meta.nlayer);
+            if (entry.scales) {
+                (w.*entry.scales).resize(_meta.nlayer);
+                (w.*entry.zeros).resize(_meta.nlayer);
+            }
+        }
+        for (size_t i = 0; i < _meta.nlayer; i++) {
+            for (const auto &entry : kLayerWeights) {
+                const tensor_t &src = (_weights.*entry.weight)[i];
+                tensor_t &dst = (w.*entry.weight)[i];
+                if (entry.weight == &Weights::attn_norm_w || entry.weight == &Weights::mlp_norm_w) {
+                    dst = copySlice(src, 0, 0, src->shape()[0], shard.device_id);
+                    continue;
+                }
+                const auto [begin, end] = rowRange(entry.weight);
+                const tensor_t scales = entry.scales ? (_weights.*entry.scales)[i] : nullptr;
+                const tensor_t zeros = entry.zeros ? (_weights.*entry.zeros)[i] : nullptr;
+                if (entry.weight != &Weights::attn_o_w && entry.weight != &Weights::mlp_down_w) {
+                    dst = copySlice(src, 0, begin, end, shard.device_id);
+                    if (scales) {
+                        (w.*entry.scales)[i] = copySlice(scales, 0, begin, end, shard.device_id);
+                    }
+                    if (zeros) {
+                        (w.*entry.zeros)[i] = copySlice(zeros, 0, begin, end, shard.device_id);
+                    }
+                    continue;
+                }
+                // 按输入列切分：打包的 4-bit 权重每字节两列；逐行缩放系数（int8 / fp8）整份复制，
+                // 逐组的缩放系数与零点按组切分
+                const size_t in_features = entry.weight == &Weights::attn_o_w ? _meta.nh * dh : _meta.di;
+                const size_t pack = in_features / src->shape()[1];
+                dst = copySlice(src, 1, begin / pack, end / pack, shard.device_id);
+                if (scales && scales->ndim() == 1) {
+                    (w.*entry.scales)[i] = copySlice(scales, 0, 0, scales->shape()[0], shard.device_id);
+                } else if (scales) {
+                    const size_t group_size = in_features / scales->shape()[1];
+                    CHECK_ARGUMENT(begin % group_size == 0 && end % group_size == 0,
+                                   "Qwen2: shard boundary does not align with the quantization groups");
+                    (w.*entry.scales)[i] = copySlice(scales, 1, begin / group_size, end / group_size, shard.device_id);
+                    if (zeros) {
+                        (w.*entry.zeros)[i] = copySlice(zeros, 1, begin / group_size, end / group_size, shard.device_id);
+                    }
+                }
+            }
+        }
+        _shards.push_back(std::move(shard));
+    }
+}
+
+std::vector<const std::byte *> Model::cacheAddresses(const Sequence &seq) const {
+    std::vector<const std::byte *> addr;
+    for (const auto *caches : {&seq.k_cache, &seq.v_cache, &seq.k_scale, &seq.v_scale}) {
+        for (const auto &cache : *caches) {
+            addr.push_back(cache->data());
+        }
+    }
+    return addr;
+}
+
+bool Model::useDecodeGraph(const std::vector<Segment> &segments) const {
+    return _use_decode_graph && _device == LLAISYS_DEVICE_CPU && _shard_devices.empty() && segments.size() == 1 && segments[0].ntoken == 1
+        && segments[0].nlogits == 1;
+}
+
+void Model::captureDecode(Sequence &seq) {
+    const float scale = 1.0f / std::sqrt(static_cast<float>(_meta.dh));
+    auto &g = _decode_graph;
+    g = DecodeGraph{};
+    g.token = createTensor({1}, LLAISYS_DTYPE_I64);
+    g.pos = createTensor({1}, LLAISYS_DTYPE_I64);
+    g.kv_len = createTensor({1}, LLAISYS_DTYPE_I64);
+    g.hn = createTensor({1, _meta.hs}, _meta.dtype);
+    g.act = createActivations(1);
+    g.seq = &seq;
+    g.cache = cacheAddresses(seq);
+    g.capacity = seq.capacity();
+    const auto &a = g.act;
+
+    // 与 forward 相同的算子序列；KV 写入行与注意力长度改为从 pos / kv_len 张量中读取，
+    // 注意力直接作用于整块 KV Cache
+    core::GraphCapture capture(g.graph);
+    ops::embedding(a.x, g.token, _weights.in_embed);
+    for (size_t layer = 0; layer < _meta.nlayer; layer++) {
+        core::trace::Scope layer_trace("qwen2.layer", [&](core::trace::Label &label) {
+            label.args = "layer " + std::to_string(layer);
+        });
+        attentionInput(_weights, layer, a, g.pos);
+        tensor_t k_scale = seq.k_scale.empty() ? nullptr : seq.k_scale[layer];
+        tensor_t v_scale = seq.v_scale.empty() ? nullptr : seq.v_scale[layer];
+        ops::kv_store(seq.k_cache[layer], k_scale, a.k3, g.pos);
+        ops::kv_store(seq.v_cache[layer], v_scale, a.v3, g.pos);
+        ops::self_attention(a.attn, a.q3, seq.k_cache[layer], seq.v_cache[layer], scale, k_scale, v_scale, g.kv_len);
+        attentionOutput(layer, a);
+    }
+    ops::rms_norm(g.hn, a.x, _weights.out_norm_w, _meta.epsilon);
+}
+
+void Model::invalidateDecodeGraph() {
+    _decode_graph = DecodeGraph{};
+}
+
+void Model::releaseDecodeGraph(const Sequence &seq) {
+    if (_decode_graph.seq == &seq) {
+        invalidateDecodeGraph();
+    }
+}
+
+void Model::setDecodeGraph(bool enabled) {
+    _use_decode_graph = enabled;
+    invalidateDecodeGraph();
+}
+
+void Model::forward(const std::vector<Segment> &segments, int64_t *next_tokens, size_t act_quant_rows) {
+    _act_quant_rows = act_quant_rows;
+    // trace 中每次前向一个作用域，标注段数与 token 数，其下按层、按算子嵌套
+    core::trace::Scope trace("qwen2.forward", [&](core::trace::Label &label) {
+        size_t ntok = 0;
+        for (const auto &seg : segments) {
+            ntok += seg.ntoken;
+        }
+        label.args = std::to_string(segments.size()) + " segments, " + std::to_string(ntok) + " tokens";
+    });
+    if (useDecodeGraph(segments)) {
+        // 单 token decode：回放命令图，token、位置与 KV 有效长度直接写入图的输入张量（CPU 内存）
+        auto &seq = *segments[0].seq;
+        reserveCache(seq, seq.ncached + 1);
+        auto &g = _decode_graph;
+        if (g.graph.empty() || g.seq != &seq || g.capacity != seq.capacity() || g.cache != cacheAddresses(seq)) {
+            captureDecode(seq);
+        }
+        *reinterpret_cast<int64_t *>(g.token->data()) = seq.tokens[seq.ncached];
+        *reinterpret_cast<int64_t *>(g.pos->data()) = static_cast<int64_t>(seq.ncached);
+        *reinterpret_cast<int64_t *>(g.kv_len->data()) = static_cast<int64_t>(seq.ncached + 1);
+        g.graph.replay();
+        seq.ncached += 1;
+        return selectTokens(segments, g.hn, next_tokens);
+    }
+
+    if (!_shard_devices.empty() && _shards.empty()) {
+        buildShards();
+    }
+    const Batch batch = prepareBatch(segments);
+    if (!_shards.empty()) {
+        return forwardSharded(segments, batch, next_tokens);
+    }
+    const size_t ntok = batch.token_ids.size();
+
+    auto idx = createTensor({ntok}, LLAISYS_DTYPE_I64);
+    auto pos = createTensor({ntok}, LLAISYS_DTYPE_I64);
+    idx->load(batch.token_ids.data());
+    pos->load(batch.pos_ids.data());
+
+    // 2. 激活缓冲区
+    const auto a = createActivations(ntok);
+
+    ops::embedding(a.x, idx, _weights.in_embed);
+
+    for (size_t layer = 0; layer < _meta.nlayer; layer++) {
+        core::trace::Scope layer_trace("qwen2.layer", [&](core::trace::Label &label) {
+            label.args = "layer " + std::to_string(layer);
+        });
+        // 3. 自注意力：所有序列的 token 共享一次 QKV 投影（GEMM），注意力按序列分别计算
+        attentionInput(_weights, layer, a, pos);
+        attention(layer, segments, a);
+
+        // 4. o_proj 与 MLP
+        attentionOutput(layer, a);
+    }
+
+    finishForward(segments, batch, a.x, next_tokens);
+}
+
+Model::Batch Model::prepareBatch(const std::vector<Segment> &segments) {
+    // 1. 拼接各段的 token id 与位置 id
+    Batch batch;
+    for (const auto &seg : segments) {
+        auto &seq = *seg.seq;
+        reserveCache(seq, seq.ncached + seg.ntoken);
+        for (size_t t = 0; t < seg.ntoken; t++) {
+            batch.token_ids.push_back(seq.tokens[seq.ncached + t]);
+            batch.pos_ids.push_back(static_cast<int64_t>(seq.ncached + t));
+        }
+        for (size_t t = seg.ntoken - seg.nlogits; t < seg.ntoken; t++) {
+            batch.last_ids.push_back(static_cast<int64_t>(batch.token_ids.size() - seg.ntoken + t));
+        }
+    }
+    return batch;
+}
+
+void Model::finishForward(const std::vector<Segment> &segments, const Batch &batch, const tensor_t &x,
+                          int64_t *next_tokens) {
+    for (const auto &seg : segments) {
+        seg.seq->ncached += seg.ntoken;
+    }
+
+    const size_t nlogits = batch.last_ids.size();
+    if (nlogits == 0) {
+        return;
+    }
+
+    // 5. 只对需要输出的位置做 final norm 与 lm_head
+    auto last = createTensor({nlogits}, LLAISYS_DTYPE_I64);
+    last->load(batch.last_ids.data());
+    auto h = createTensor({nlogits, _meta.hs}, _meta.dtype);
+    auto hn = createTensor({nlogits, _meta.hs}, _meta.dtype);
+    ops::embedding(h, last, x);
+    ops::rms_norm(hn, h, _weights.out_norm_w, _meta.epsilon);
+    selectTokens(segments, hn, next_tokens);
+}
+
+namespace {
+// 在设备之间搬运激活：所有 CPU 设备共享地址空间，作为普通内核提交到目标设备的流
+void copyBytes(std::byte *dst, const std::byte *src, size_t size) {
+    std::memcpy(dst, src, size);
+}
+} // namespace
+
+void Model::shardBarrier() const {
+    std::vector<int> devices{_device_id};
+    for (const auto &shard : _shards) {
+        devices.push_back(shard.device_id);
+    }
+    std::vector<device::cpu::Event> events(devices.size());
+    for (size_t i = 0; i < devices.size(); i++) {
+        core::context().setDevice(_device, devices[i]);
+        events[i].record(core::launchStream());
+    }
+    for (size_t i = 0; i < devices.size(); i++) {
+        core::context().setDevice(_device, devices[i]);
+        device::cpu::Stream *stream = core::launchStream();
+        for (size_t j = 0; j < devices.size(); j++) {
+            if (j != i) {
+                events[j].block(stream);
+            }
+        }
+    }
+}
+
+void Model::allReduce(const std::vector<Activations> &acts, const std::vector<std::vector<tensor_t>> &parts) {
+    const size_t n = _shards.size();
+    const size_t bytes = parts[0][0]->numel() * parts[0][0]->elementSize();
+    shardBarrier();
+    for (size_t s = 0; s < n; s++) {
+        core::context().setDevice(_device, _shards[s].device_id);
+        for (size_t t = 0; t < n; t++) {
+            if (t != s) {
+                core::launch(copyBytes, parts[s][t]->data(), parts[t][t]->data(), bytes);
+            }
+        }
+        // 每个分片按相同的顺序累加，各分片的残差逐位一致
+        for (size_t t = 0; t < n; t++) {
+            ops::add(acts[s].x, acts[s].x, parts[s][t]);
+        }
+    }
+}
+
+void Model::forwardSharded(const std::vector<Segment> &segments, const Batch &batch, int64_t *next_tokens) {
+    const size_t n = _shards.size(), ntok = batch.token_ids.size(), hs = _meta.hs;
+    const size_t bytes = ntok * hs * utils::dsize(_meta.dtype);
+
+    // 2. 主设备上做 embedding；每个分片一套激活与两组部分和缓冲区（注意力与 MLP 交替使用，
+    //    下一轮写入时其他分片已取走上一轮的结果），parts[s][t] 是分片 s 上存放分片 t 结果的 [ntok, hs] 块
+    auto idx = createTensor({ntok}, LLAISYS_DTYPE_I64);
+    idx->load(batch.token_ids.data());
+    auto x = createTensor({ntok, hs}, _meta.dtype);
+    ops::embedding(x, idx, _weights.in_embed);
+
+    std::vector<Activations> acts;
+    std::vector<tensor_t> pos;
+    std::vector<std::vector<tensor_t>> attn_parts(n), mlp_parts(n);
+    for (size_t s = 0; s < n; s++) {
+        const auto &shard = _shards[s];
+        acts.push_back(createActivations(ntok, shard.nh, shard.nkvh, shard.di, shard.device_id));
+        pos.push_back(createTensor({ntok}, LLAISYS_DTYPE_I64, shard.device_id));
+        pos.back()->load(batch.pos_ids.data());
+        for (auto *parts : {&attn_parts[s], &mlp_parts[s]}) {
+            auto buffer = createTensor({n, ntok, hs}, _meta.dtype, shard.device_id);
+            for (size_t t = 0; t < n; t++) {
+                parts->push_back(buffer->slice(0, t, t + 1)->view({ntok, hs}));
+            }
+        }
+    }
+
+    // 各分片从主设备取得 embedding 的结果
+    shardBarrier();
+    for (size_t s = 0; s < n; s++) {
+        core::context().setDevice(_device, _shards[s].device_id);
+        core::launch(copyBytes, acts[s].x->data(), x->data(), bytes);
+    }
+
+    for (size_t layer = 0; layer < _meta.nlayer; layer++) {
+        core::trace::Scope layer_trace("qwen2.layer", [&](core::trace::Label &label) {
+            label.args = "layer " + std::to_string(layer);
+        });
+        // 3. 每个分片计算自己的注意力头，o_proj 得到部分和
+        for (size_t s = 0; s < n; s++) {
+            const auto &w = _shards[s].weights;
+            core::context().setDevice(_device, _shards[s].device_id);
+            attentionInput(w, layer, acts[s], pos[s]);
+            attention(layer * n + s, segments, acts[s]);
+            project(attn_parts[s][s], acts[s].attn2, w.attn_o_w[layer], w.attn_o_s[layer], w.attn_o_z[layer], nullptr);
+        }
+        allReduce(acts, attn_parts);
+
+        // 4. 每个分片计算 MLP 中间维的一段，down 投影得到部分和
+        for (size_t s = 0; s < n; s++) {
+            core::context().setDevice(_device, _shards[s].device_id);
+            mlp(_shards[s].weights, layer, acts[s], mlp_parts[s][s]);
+        }
+        allReduce(acts, mlp_parts);
+    }
+
+    // 各分片的残差相同，取分片 0 的结果回到主设备
+    shardBarrier();
+    core::context().setDevice(_device, _device_id);
+    core::launch(copyBytes, x->data(), acts[0].x->data(), bytes);
+    finishForward(segments, batch, x, next_tokens);
+}
+
+void Model::selectTokens(const std::vector<Segment> &segments, tensor_t hn, int64_t *next_tokens) {
+    const size_t nlogits = hn->shape()[0];
+    const auto dtype = _meta.dtype;
+
+    core::context().setDevice(_device, _device_id);
+    auto *api = core::context().runtime().api();
+    const auto d2h = _device == LLAISYS_DEVICE_CPU ? LLAISYS_MEMCPY_H2H : LLAISYS_MEMCPY_D2H;
+    const size_t topk = fusedTopK(segments);
+    if (topk == 0) {
+        // 6a. 重复惩罚或不限 top_k 的采样需要完整的 logits
+        auto logits = createTensor({nlogits, _meta.voc}, dtype);
+        project(logits, hn, _weights.out_embed, _weights.out_embed_s, _weights.out_embed_z, nullptr);
+        auto sampled = createTensor({nlogits}, LLAISYS_DTYPE_I64);
+        sampleLogits(segments, logits, sampled);
+        api->memcpy_sync(next_tokens, sampled->data(), nlogits * sizeof(int64_t), d2h);
+        return;
+    }
+
+    // 6b. lm_head 与选择融合：词表分块投影，只保留每行的前 topk 个候选，不写出完整 logits。
+    //     全部贪心时 topk = 1 即 argmax；否则在候选上采样（top-k 归一化只依赖前 k 个 logits），再映射回 token id
+    auto cand_idx = createTensor({nlogits, topk}, LLAISYS_DTYPE_I64);
+    auto cand_val = createTensor({nlogits, topk}, dtype);
+    ops::linear_topk(cand_idx, cand_val, hn, _weights.out_embed, _weights.out_embed_s, _weights.out_embed_z);
+    std::vector<int64_t> cand(nlogits * topk);
+    api->memcpy_sync(cand.data(), cand_idx->data(), cand.size() * sizeof(int64_t), d2h);
+    std::vector<int64_t> pick(nlogits, 0);
+    if (!std::all_of(segments.begin(), segments.end(),
+                     [](const Segment &seg) { return ops::isGreedy(seg.seq->sampling); })) {
+        auto sampled = createTensor({nlogits}, LLAISYS_DTYPE_I64);
+        sampleLogits(segments, cand_val, sampled);
+        api->memcpy_sync(pick.data(), sampled->data(), nlogits * sizeof(int64_t), d2h);
+    }
+    for (size_t i = 0; i < nlogits; i++) {
+        next_tokens[i] = cand[i * topk + pick[i]];
+    }
+}
+
+size_t Model::fusedTopK(const std::vector<Segment> &segments) const {
+    size_t topk = 1;
+    for (const auto &seg : segments) {
+        const auto &p = seg.seq->sampling;
+        if (seg.nlogits == 0 || ops::isGreedy(p)) {
+            continue;
+        }
+        if (p.repetition_penalty != 1.0f || p.top_k == 0 || p.top_k > kMaxFusedTopK) {
+            return 0;
+        }
+        topk = std::max(topk, std::min(p.top_k, _meta.voc));
+    }
+    return topk;
+}
+
+void Model::sampleLogits(const std::vector<Segment> &segments, tensor_t logits, tensor_t out_idx) {
+    // 每个输出位置一行：采样参数、随机数状态与参与重复惩罚的历史（该位置及之前的全部 token）
+    std::vector<LlaisysSamplingParams> params;
+    std::vector<uint64_t> states;
+    std::vector<int64_t> history, offsets{0};
+    bool penalty = false;
+    for (const auto &seg : segments) {
+        auto &seq = *seg.seq;
+        CHECK_ARGUMENT(seg.nlogits <= 1 || ops::isGreedy(seq.sampling),
+                       "Qwen2: a sampled sequence outputs at most one token per forward");
+        penalty = penalty || seq.sampling.repetition_penalty != 1.0f;
+        // forward 已推进 ncached，本段的末尾位置为 ncached - 1
+        for (size_t t = seq.ncached - seg.nlogits; t < seq.ncached; t++) {
+            params.push_back(seq.sampling);
+            states.push_back(seq.rng_state);
+            if (seq.sampling.repetition_penalty != 1.0f) {
+                history.insert(history.end(), seq.tokens.begin(), seq.tokens.begin() + t + 1);
+            }
+            offsets.push_back(static_cast<int64_t>(history.size()));
+        }
+    }
+    const size_t nlogits = params.size();
+
+    auto rng = createTensor({nlogits}, LLAISYS_DTYPE_U64);
+    rng->load(states.data());
+    tensor_t hist, hist_offsets;
+    if (penalty) {
+        hist = createTensor({std::max(history.size(), size_t(1))}, LLAISYS_DTYPE_I64);
+        hist_offsets = createTensor({nlogits + 1}, LLAISYS_DTYPE_I64);
+        if (!history.empty()) {
+            hist->load(history.data());
+        }
+        hist_offsets->load(offsets.data());
+    }
+    ops::sample(out_idx, logits, params.data(), rng, hist, hist_offsets);
+
+    // 写回推进后的随机数状态
+    core::context().setDevice(_device, _device_id);
+    core::context().runtime().api()->memcpy_sync(
+        states.data(), rng->data(), nlogits * sizeof(uint64_t),
+        _device == LLAISYS_DEVICE_CPU ? LLAISYS_MEMCPY_H2H : LLAISYS_MEMCPY_D2H);
+    size_t row = 0;
+    for (const auto &seg : segments) {
+        if (seg.nlogits > 0) {
+            row += seg.nlogits;
+            seg.seq->rng_state = states[row - 1];
+        }
+    }
+}
+
+int64_t Model::infer(const int64_t *token_ids, size_t ntoken) {
+    CHECK_ARGUMENT(ntoken > 0, "Qwen2: empty input");
+    auto &seq = _default_seq;
+
+    // 复用与缓存一致的最长公共前缀，至少保留一个 token 用于产生 logits
+    size_t common = 0;
+    size_t limit = std::min(seq.ncached, ntoken - 1);
+    while (common < limit && seq.tokens[common] == token_ids[common]) {
+        common++;
+    }
+    seq.ncached = common;
+    seq.tokens.assign(token_ids, token_ids + ntoken);
+    seq.nprompt = ntoken;
+
+    int64_t next = 0;
+    forward({{&seq, ntoken - common}}, &next);
+    return next;
+}
+
+namespace {
+// Prompt lookup 起草：在历史中寻找与末尾 n-gram（n 从 kMaxNgram 递减到 1）相同的最近一次出现，
+// 取其后续最多 ndraft 个 token 作为草稿
+constexpr size_t kMaxNgram = 3;
+
+std::vector<int64_t> draftByNgram(const std::vector<int64_t> &tokens, size_t ndraft) {
+    const size_t len = tokens.size();
+    for (size_t n = std::min(kMaxNgram, len - 1); n > 0; n--) {
+        const int64_t *suffix = tokens.data() + len - n;
+        for (size_t start = len - n; start-- > 0;) {
+            if (std::equal(suffix, suffix + n, tokens.data() + start)) {
+                size_t begin = start + n;
+                size_t end = std::min(len, begin + ndraft);
+                return std::vector<int64_t>(tokens.begin() + begin, tokens.begin() + end);
+            }
+        }
+    }
+    return {};
+}
+} // namespace
+
+std::vector<int64_t> Model::generate(const int64_t *token_ids, size_t ntoken, size_t max_new_tokens, size_t ndraft) {
+    return generate(token_ids, ntoken, max_new_tokens, ndraft, _sampling, _seed);
+}
+
+std::vector<int64_t> Model::generate(const int64_t *token_ids, size_t ntoken, size_t max_new_tokens, size_t ndraft,
+                                     const LlaisysSamplingParams &sampling, uint64_t seed,
+                                     const TokenCallback &on_token) {
+    CHECK_ARGUMENT(ntoken > 0 && ntoken < _meta.maxseq, "Qwen2: invalid prompt length");
+    Sequence seq(token_ids, ntoken, max_new_tokens);
+    seq.sampling = sampling;
+    seq.rng_state = seed;
+    // 草稿验证依赖贪心输出，采样时不起草
+    if (!ops::isGreedy(sampling)) {
+        ndraft = 0;
+    }
+    std::vector<int64_t> next(ndraft + 1);
+
+    // 按顺序把 seq.tokens[from:] 中的新 token 交给回调；回调要求停止时丢弃其后的 token
+    bool stopped = false;
+    auto emit = [&](size_t from) {
+        if (!on_token) {
+            return;
+        }
+        for (size_t i = from; i < seq.tokens.size(); i++) {
+            if (!on_token(seq.tokens[i])) {
+                seq.tokens.resize(i + 1);
+                stopped = true;
+                return;
+            }
+        }
+    };
+    auto finished = [&]() {
+        return stopped || seq.numGenerated() >= max_new_tokens || seq.tokens.size() >= _meta.maxseq
+            || (seq.numGenerated() > 0 && seq.tokens.back() == _meta.end_token);
+    };
+
+    // 1. prefill
+    if (max_new_tokens > 0) {
+        forward({{&seq, ntoken}}, next.data());
+        seq.tokens.push_back(next[0]);
+        emit(ntoken);
+    }
+
+    while (!finished()) {
+        // 2. 起草：草稿长度受剩余生成数与 maxseq 限制，验证后至少还会多出一个 token
+        size_t limit = std::min(max_new_tokens - seq.numGenerated() - 1, _meta.maxseq - seq.tokens.size() - 1);
+        auto draft = draftByNgram(seq.tokens, std::min(ndraft, limit));
+
+        // 3. 一次前向验证：输入 [上一个 token, 草稿...]，每个位置都输出 argmax。
+        //    激活按 token 量化、整数 GEMM 精确累加，各行互不影响；按单 token 前向选择内核，
+        //    结果与 ndraft = 0 逐 token 解码一致
+        const size_t base = seq.ncached;
+        seq.tokens.insert(seq.tokens.end(), draft.begin(), draft.end());
+        forward({{&seq, draft.size() + 1, draft.size() + 1}}, next.data(), 1);
+
+        // 4. 接受与模型输出一致的最长草稿前缀，再追加模型在第一个分歧处给出的 token
+        size_t accepted = 0;
+        while (accepted < draft.size() && draft[accepted] == next[accepted]
+               && draft[accepted] != _meta.end_token) {
+            accepted++;
+        }
+
+        // 5. 回滚：被拒绝的草稿从 token 历史中移除，对应的 KV Cache 条目在下次写入时覆盖
+        seq.ncached = base + 1 + accepted;
+        seq.tokens.resize(seq.ncached);
+        seq.tokens.push_back(next[accepted]);
+        emit(base + 1);
+    }
+    releaseDecodeGraph(seq);
+    return std::vector<int64_t>(seq.tokens.begin() + ntoken, seq.tokens.end());
+}
+
+void Model::submit(Sequence *seq) {
+    CHECK_ARGUMENT(seq != nullptr && seq->nprompt > 0, "Qwen2: sequence must have a non-empty prompt");
+    CHECK_ARGUMENT(seq->nprompt < _meta.maxseq, "Qwen2: prompt exceeds maxseq");
+    if (seq->max_new_tokens == 0) {
+        seq->finished = true;
+        return;
+    }
+    _waiting.push_back(seq);
+}
+
+void Model::retire(Sequence *seq) {
+    _waiting.erase(std::remove(_waiting.begin(), _waiting.end(), seq), _waiting.end());
+    _running.erase(std::remove(_running.begin(), _running.end(), seq), _running.end());
+    releaseDecodeGraph(*seq);
+}
+
+void Model::setMaxBatch(size_t max_batch) {
+    CHECK_ARGUMENT(max_batch > 0, "Qwen2: max_batch must be positive");
+    _max_batch = max_batch;
+}
+
+void Model::setMaxStepTokens(size_t max_step_tokens) {
+    _max_step_tokens = max_step_tokens;
+}
+
+size_t Model::numPending() const {
+    return _waiting.size() + _running.size();
+}
+
+size_t Model::step(std::vector<std::pair<Sequence *, int64_t>> &emitted) {
+    // 1. 接纳等待中的序列
+    while (_running.size() < _max_batch && !_waiting.empty()) {
+        _running.push_back(_waiting.front());
+        _waiting.pop_front();
+    }
+    if (_running.empty()) {
+        return 0;
+    }
+
+    // 2. decode 序列各喂入上一步生成的 token，合并为一次前向
+    std::vector<Segment> segments;
+    size_t budget = _max_step_tokens;
+    for (auto *seq : _running) {
+        if (seq->tokens.size() - seq->ncached == 1) {
+            segments.push_back({seq, 1});
+        }
+    }
+
+    // 3. prefill：不限预算时整段喂入全部新序列；否则每个 step 只混入一个 prefill 分块，
+    //    分块大小为扣除 decode token 后的剩余预算（至少 1），长 prompt 分多个 step 写入 KV Cache
+    for (auto *seq : _running) {
+        size_t remaining = seq->tokens.size() - seq->ncached;
+        if (remaining == 1) {
+            continue;
+        }
+        if (budget == 0) {
+            segments.push_back({seq, remaining});
+            continue;
+        }
+        size_t chunk = budget > segments.size() ? budget - segments.size() : 1;
+        chunk = std::min(chunk, remaining);
+        segments.push_back({seq, chunk, chunk == remaining ? size_t(1) : size_t(0)});
+        break;
+    }
+    if (segments.empty()) {
+        return 0;
+    }
+    std::vector<int64_t> next(segments.size());
+    forward(segments, next.data());
+
+    // 4. 记录输出并移除结束的序列
+    size_t nemitted = 0;
+    for (const auto &seg : segments) {
+        if (seg.nlogits == 0) {
+            continue;
+        }
+        auto *seq = seg.seq;
+        int64_t token = next[nemitted++];
+        seq->tokens.push_back(token);
+        emitted.emplace_back(seq, token);
+        if (token == _meta.end_token || seq->numGenerated() >= seq->max_new_tokens
+            || seq->tokens.size() >= _meta.maxseq) {
+            seq->finished = true;
+        }
+    }
+    _running.erase(std::remove_if(_running.begin(), _running.end(),
+                                  [](Sequence *seq) { return seq->finished; }),
+                   _running.end());
+    return nemitted;
+}
+} // namespace llaisys::models::qwen2
@@ -0,0 +1,279 @@
+#pragma once
+#include "llaisys/models/qwen2.h"
+
+#include "../../core/graph/graph.hpp"
+#include "../../tensor/tensor.hpp"
+
+#include <deque>
+#include <functional>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace llaisys::models::loader {
+class PackedFile;
+} // namespace llaisys::models::loader
+
+namespace llaisys::models::qwen2 {
+// 从 HuggingFace 模型目录的 config.json 读取超参数
+LlaisysQwen2Meta loadConfig(const std::string &model_dir);
+
+struct Weights {
+    tensor_t in_embed;
+    tensor_t out_embed;
+    tensor_t out_norm_w;
+    std::vector<tensor_t> attn_norm_w;
+    std::vector<tensor_t> attn_q_w;
+    std::vector<tensor_t> attn_q_b;
+    std::vector<tensor_t> attn_k_w;
+    std::vector<tensor_t> attn_k_b;
+    std::vector<tensor_t> attn_v_w;
+    std::vector<tensor_t> attn_v_b;
+    std::vector<tensor_t> attn_o_w;
+    std::vector<tensor_t> mlp_norm_w;
+    std::vector<tensor_t> mlp_gate_w;
+    std::vector<tensor_t> mlp_up_w;
+    std::vector<tensor_t> mlp_down_w;
+
+    // 量化参数，未量化的权重对应空指针。量化时对应的 *_w 被替换为量化张量：
+    //   int8：*_w 为 int8 [M, K]，*_s 为每输出通道的 float32 缩放系数 [M]
+    //   4-bit：*_w 为打包的 uint8 [M, K / 2]，*_s 为每组的 float16 缩放系数 [M, K / group_size]，
+    //          *_z 为每组的 uint8 零点（对称量化时为空）
+    //   fp8：*_w 为 fp8 E4M3 / E5M2 [M, K]，*_s 同 int8
+    // in_embed 始终保持浮点以供 embedding 查表。
+    tensor_t out_embed_s;
+    tensor_t out_embed_z;
+    std::vector<tensor_t> attn_q_s, attn_q_z;
+    std::vector<tensor_t> attn_k_s, attn_k_z;
+    std::vector<tensor_t> attn_v_s, attn_v_z;
+    std::vector<tensor_t> attn_o_s, attn_o_z;
+    std::vector<tensor_t> mlp_gate_s, mlp_gate_z;
+    std::vector<tensor_t> mlp_up_s, mlp_up_z;
+    std::vector<tensor_t> mlp_down_s, mlp_down_z;
+};
+
+// 一个推理序列：token 历史 + 独立的 KV Cache。
+// KV Cache 每层一块 [capacity, nkvh, dh] 的连续内存，按需倍增扩容，
+// 因此任意前缀 slice(0, 0, len) 都是连续张量，可直接交给 self_attention。
+// 量化 KV Cache（int8 / fp8）另有每层一块 [capacity, nkvh] 的 float32 缩放系数。
+class Sequence {
+public:
+    Sequence(const int64_t *token_ids, size_t ntoken, size_t max_new_tokens);
+    virtual ~Sequence() = default;
+
+    std::vector<int64_t> tokens; // prompt + 已生成的 token
+    size_t nprompt;
+    size_t max_new_tokens;
+    size_t ncached = 0; // 已写入 KV Cache 的 token 数
+    bool finished = false;
+    // 采样设置（默认贪心）与该序列独立的随机数发生器状态
+    LlaisysSamplingParams sampling{0.0f, 0, 1.0f, 1.0f};
+    uint64_t rng_state = 0;
+
+    std::vector<tensor_t> k_cache;
+    std::vector<tensor_t> v_cache;
+    std::vector<tensor_t> k_scale;
+    std::vector<tensor_t> v_scale;
+
+    size_t numGenerated() const { return tokens.size() - nprompt; }
+    size_t capacity() const { return k_cache.empty() ? 0 : k_cache[0]->shape()[0]; }
+};
+
+// 一次前向中的一段：同一序列从 seq->ncached 开始的 ntoken 个 token。
+// nlogits 为需要输出下一个 token 的末尾位置数（采样的序列至多为 1）：分块 prefill 的中间块为 0，
+// 投机解码的验证段为 1 + 草稿长度。
+struct Segment {
+    Sequence *seq;
+    size_t ntoken;
+    size_t nlogits = 1;
+};
+
+class Model {
+private:
+    // 一次前向的激活缓冲区，ntok 行
+    struct Activations {
+        tensor_t x, xn, q, k, v, attn, proj, gate, up, act;
+        tensor_t q3, k3, v3, attn2; // q/k/v 按 head 展开、attn 按行合并的视图
+    };
+
+    // 单序列逐 token 解码的命令图：从 embedding 到 final norm 捕获一次，之后每步只更新 token、位置
+    // 与 KV 有效长度后回放。命令引用捕获时 KV Cache 的地址与容量，二者变化（换序列、扩容）时重新捕获。
+    // 图的缓冲区在序列结束时随之释放
+    struct DecodeGraph {
+        core::Graph graph;
+        const Sequence *seq = nullptr;
+        std::vector<const std::byte *> cache; // 捕获时各层 K/V Cache 与缩放系数的地址
+        size_t capacity = 0;
+        tensor_t token, pos, kv_len;          // 回放前写入的输入，pos 同时是 KV 写入行
+        tensor_t hn;                          // final norm 的输出 [1, hs]
+        Activations act;                      // 命令引用的激活缓冲区
+    };
+
+    // 一次前向的输入：各段拼接的 token id 与位置 id，以及需要输出下一个 token 的位置在批次中的下标
+    struct Batch {
+        std::vector<int64_t> token_ids, pos_ids, last_ids;
+    };
+
+    // 张量并行的一个分片：位于一个 CPU 设备（NUMA 节点）上，负责一组连续的 KV 头（及其对应的 Q 头）
+    // 与 MLP 中间维的一段。q/k/v、gate/up 的权重按输出行切分，o_proj、down 按输入列切分，
+    // 两处的部分和经 all-reduce 累加回残差；norm 权重每个分片各有一份
+    struct Shard {
+        int device_id;
+        size_t nh, nkvh, di;
+        Weights weights; // 只填充各层的权重，embedding 与 lm_head 留在主设备
+    };
+
+    LlaisysQwen2Meta _meta;
+    llaisysDeviceType_t _device;
+    // 完整权重、embedding、lm_head 与采样所在的设备；分片时为 0 号 CPU 设备（整机）
+    int _device_id;
+    Weights _weights;
+    // 分片所在的设备，不分片时为空
+    std::vector<int> _shard_devices;
+    // 由 _weights 切出的分片，首次分片前向时建立，权重被替换后清空重建
+    std::vector<Shard> _shards;
+
+    // llaisysQwen2ModelInfer 使用的隐式序列
+    Sequence _default_seq;
+
+    // 迭代级调度：每个 step 之间接纳等待中的序列、移除已结束的序列
+    std::deque<Sequence *> _waiting;
+    std::vector<Sequence *> _running;
+    size_t _max_batch;
+    // 每个 step 的 token 预算（0 表示不限制）：decode token 优先，剩余预算给一个 prefill 分块
+    size_t _max_step_tokens;
+    // 前向 token 数不少于该值时，int8 权重的投影改用动态量化激活的整数 GEMM（0 表示关闭）
+    size_t _act_quant_min_tokens;
+    // 当前前向按多少行判断是否启用激活量化（0 表示按实际行数），见 forward 的 act_quant_rows
+    size_t _act_quant_rows = 0;
+    // KV Cache 的存储类型：meta.dtype（默认）、int8 或 fp8 E4M3
+    llaisysDataType_t _kv_dtype;
+    // generate / infer 的采样设置与随机种子
+    LlaisysSamplingParams _sampling;
+    uint64_t _seed;
+    // CPU 上单序列 decode 是否走命令图（默认开启）
+    bool _use_decode_graph;
+    DecodeGraph _decode_graph;
+
+    // 使用给定权重的实例，不分配权重张量
+    Model(const LlaisysQwen2Meta &meta, llaisysDeviceType_t device, const std::vector<int> &device_ids,
+          Weights weights);
+
+    tensor_t createTensor(const shape_t &shape, llaisysDataType_t dtype) const;
+    tensor_t createTensor(const shape_t &shape, llaisysDataType_t dtype, int device_id) const;
+    // HuggingFace 权重名对应的权重槽，未知名称返回 nullptr
+    tensor_t *findWeight(const std::string &name);
+    // 把 CPU 上的源张量放入权重槽：dtype 一致的 CPU 模型直接共享，否则转换/拷贝。
+    // 量化权重与缩放系数保持源 dtype 与形状
+    void assignWeight(tensor_t &slot, const tensor_t &src);
+    // 线性投影：按权重 dtype 选择 int8（I8）、4-bit（U8）或浮点 kernel，
+    // int8 权重在长前向中按 _act_quant_min_tokens 切换为 w8a8
+    void project(tensor_t out, tensor_t in, const tensor_t &weight, const tensor_t &scales, const tensor_t &zeros,
+                 tensor_t bias);
+    void reserveCache(Sequence &seq, size_t len);
+    Activations createActivations(size_t ntok) const;
+    // nh / nkvh / di 为分片的头数与中间维
+    Activations createActivations(size_t ntok, size_t nh, size_t nkvh, size_t di, int device_id) const;
+    // 一层的注意力输入：attn norm、QKV 投影与 q/k 的 RoPE
+    void attentionInput(const Weights &w, size_t layer, const Activations &a, const tensor_t &pos);
+    // 各段的 K/V 写入序列的第 cache 块 KV Cache，再按段计算注意力
+    void attention(size_t cache, const std::vector<Segment> &segments, const Activations &a);
+    // 注意力之后的部分：o_proj 与残差、MLP 与残差
+    void attentionOutput(size_t layer, const Activations &a);
+    // MLP 的 norm、gate/up、SwiGLU 与 down 投影，结果写入 out（不加残差）
+    void mlp(const Weights &w, size_t layer, const Activations &a, tensor_t out);
+    // 由 _weights 建立 _shards
+    void buildShards();
+    // src 沿 dim 的 [begin, end) 切片拷贝为 device_id 上的连续张量
+    tensor_t copySlice(const tensor_t &src, size_t dim, size_t begin, size_t end, int device_id) const;
+    // 序列 KV Cache 的当前地址，与容量一起判断命令图能否回放
+    std::vector<const std::byte *> cacheAddresses(const Sequence &seq) const;
+    bool useDecodeGraph(const std::vector<Segment> &segments) const;
+    // 捕获 seq 的单 token decode 命令图（只记录，不执行）
+    void captureDecode(Sequence &seq);
+    void invalidateDecodeGraph();
+    // 释放属于 seq 的命令图
+    void releaseDecodeGraph(const Sequence &seq);
+    // 把所有段拼成一个 [ntoken, hs] 的批次做一次前向，按段的顺序把每段末尾 nlogits 个位置的
+    // 下一个 token 依次写入 next_tokens：全部贪心时取 argmax，否则按各序列的设置采样。
+    // act_quant_rows 非 0 时，各投影按该行数而不是实际行数判断是否启用激活量化
+    void forward(const std::vector<Segment> &segments, int64_t *next_tokens, size_t act_quant_rows = 0);
+    // 为各段预留 KV Cache 并拼接本次前向的输入
+    Batch prepareBatch(const std::vector<Segment> &segments);
+    // 前向的末尾：推进各段的 ncached，取出输出位置的隐藏状态（x 为 [ntoken, hs]）做 final norm 后选出 token
+    void finishForward(const std::vector<Segment> &segments, const Batch &batch, const tensor_t &x,
+                       int64_t *next_tokens);
+    // 分片模型的 forward：embedding 在主设备上计算后分发给各分片，各层在分片上并行计算，
+    // 残差收回主设备后做 final norm 与 lm_head
+    void forwardSharded(const std::vector<Segment> &segments, const Batch &batch, int64_t *next_tokens);
+    // 主设备与各分片的流之间的屏障：之后提交到任一流的任务在所有流已提交的任务完成后才执行
+    void shardBarrier() const;
+    // 张量并行的 all-reduce：调用前分片 s 已把部分和写入 parts[s][s]，各分片取来其他分片的部分和，
+    // 按相同顺序累加到自己的残差上
+    void allReduce(const std::vector<Activations> &acts, const std::vector<std::vector<tensor_t>> &parts);
+    // forward 的末尾：由各段输出位置 final norm 后的隐藏状态 hn [nlogits, hs] 选出下一个 token
+    void selectTokens(const std::vector<Segment> &segments, tensor_t hn, int64_t *next_tokens);
+    // 融合 lm_head 时每行保留的候选数：全部贪心为 1；采样的序列都只用 top_k（不超过 kMaxFusedTopK）
+    // 且无重复惩罚时为其中最大的 top_k；否则为 0，需要完整 logits
+    size_t fusedTopK(const std::vector<Segment> &segments) const;
+    // 按各段序列的采样设置从 logits [nlogits, n]（完整词表或融合 lm_head 的候选）中抽取下标写入 out_idx，
+    // 并推进各序列的随机数状态
+    void sampleLogits(const std::vector<Segment> &segments, tensor_t logits, tensor_t out_idx);
+
+public:
+    Model(const LlaisysQwen2Meta &meta, llaisysDeviceType_t device, int device_id);
+    // 多个 CPU 设备（NUMA 节点，见 device/cpu/cpu_numa.hpp）时按张量并行切分各层：每个设备持有本节点内存中的
+    // 权重分片，由绑定在节点上的流计算。只有一个设备时等同于单设备构造
+    Model(const LlaisysQwen2Meta &meta, llaisysDeviceType_t device, const std::vector<int> &device_ids);
+    ~Model() = default;
+
+    // 与本实例共享全部权重张量（不拷贝）的新实例，继承当前设置；序列、KV Cache 与命令图各自独立，
+    // 两个实例可以在不同线程上同时推理。推理只读权重；加载与量化替换实例自己的权重槽，不影响另一方
+    std::unique_ptr<Model> share() const;
+
+    const LlaisysQwen2Meta &meta() const { return _meta; }
+    Weights &weights() { return _weights; }
+
+    // 从 safetensors 文件或目录加载权重。CPU 上 dtype 一致的权重直接指向文件映射（零拷贝），
+    // 其余权重转换 dtype 后拷贝。未提供 lm_head.weight 时与 embed_tokens 共享权重。
+    void loadSafetensors(const std::string &path);
+    // 从 .llaisys 打包文件加载：张量已是运行时的 dtype 与布局，CPU 上全部零拷贝
+    void loadPacked(const loader::PackedFile &file);
+    // 按 .llaisys 格式写出当前权重（共享的权重只写一份）
+    void savePacked(const std::string &path) const;
+    // 以 HuggingFace 名称列出全部权重，量化权重的缩放系数与零点以 "<name>.q_scale"、"<name>.q_zero" 列出
+    std::vector<std::pair<std::string, tensor_t>> namedWeights() const;
+    // 仅权重量化：把各层投影与 lm_head 的权重原地替换为量化权重，激活与 KV Cache 保持 meta.dtype。
+    // group_size 只用于 4-bit 方案，不能整除 in_features 的权重退回 int8。已量化的权重保持不变
+    void quantize(llaisysQwen2Quant_t type, size_t group_size = 128);
+    void setActQuant(size_t min_tokens);
+    // 切换 KV Cache 存储类型；要求没有调度中的序列，隐式序列的缓存被清空
+    void setKVCacheDtype(llaisysDataType_t dtype);
+    // 开关单序列 decode 的命令图；关闭时释放已捕获的图
+    void setDecodeGraph(bool enabled);
+
+    // 设置 generate / infer 的采样参数，并以 seed 重置隐式序列的随机数发生器
+    void setSampling(const LlaisysSamplingParams &params, uint64_t seed);
+
+    int64_t infer(const int64_t *token_ids, size_t ntoken);
+    // 原生生成循环，按 _sampling 解码，每次调用都从 _seed 开始采样。
+    // 贪心解码且 ndraft > 0 时启用投机解码：用 prompt 与已生成历史做 n-gram 匹配起草，
+    // 一次多 token 前向验证草稿，接受最长匹配前缀并回滚被拒绝部分的 KV Cache
+    std::vector<int64_t> generate(const int64_t *token_ids, size_t ntoken, size_t max_new_tokens, size_t ndraft);
+    // 每产生一个 token 调用一次，返回 false 时在该 token 之后停止
+    using TokenCallback = std::function<bool(int64_t)>;
+    // 同上，但使用给定的采样设置与种子，并逐个把生成的 token 交给 on_token（投机解码一次接受的多个 token 依次回调）
+    std::vector<int64_t> generate(const int64_t *token_ids, size_t ntoken, size_t max_new_tokens, size_t ndraft,
+                                  const LlaisysSamplingParams &sampling, uint64_t seed,
+                                  const TokenCallback &on_token = nullptr);
+
+    // 调度器接口：submit 不转移所有权，调用者负责在 retire 之后释放序列
+    void submit(Sequence *seq);
+    void retire(Sequence *seq);
+    void setMaxBatch(size_t max_batch);
+    void setMaxStepTokens(size_t max_step_tokens);
+    size_t numPending() const;
+    size_t step(std::vector<std::pair<Sequence *, int64_t>> &emitted);
+};
+} // namespace llaisys::models::qwen2
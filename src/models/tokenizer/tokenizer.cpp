@@ -0,0 +1,475 @@
+#include "tokenizer.hpp"
+
+#include "unicode.hpp"
+
+#include "../loader/json.hpp"
+
+#include <algorithm>
+#include <array>
+#include <filesystem>
+#include <stdexcept>
+
+namespace llaisys::models::tokenizer {
+namespace {
+using loader::JsonValue;
+
+// Qwen2 的预分词正则，由 nextPiece 手工实现
+constexpr const char *kQwen2Pattern = "(?i:'s|'t|'re|'ve|'m|'ll|'d)|[^\\r\\n\\p{L}\\p{N}]?\\p{L}+|\\p{N}| ?[^\\s\\p{L}\\p{N}]+[\\r\\n]*|\\s*[\\r\\n]+|\\s+(?!\\S)|\\s+";
+
+// BPE 缓存只收录不超过该长度的片段，条目数达到上限后不再插入
+constexpr size_t kMaxCachedPiece = 256;
+constexpr size_t kCacheCapacity = 1 << 16;
+
+// GPT-2 的 bytes_to_unicode：可见字节映射到自身，其余字节依次映射到 U+0100 起的码位
+class ByteLevel {
+private:
+    std::array<int16_t, 324> _byte{}; // 码位 -> 字节，-1 表示不在字母表中
+
+public:
+    ByteLevel() {
+        _byte.fill(-1);
+        uint32_t extra = 256;
+        for (uint32_t b = 0; b < 256; b++) {
+            const bool visible = (b >= '!' && b <= '~') || (b >= 0xA1 && b <= 0xAC) || (b >= 0xAE && b <= 0xFF);
+            _byte[visible ? b : extra++] = static_cast<int16_t>(b);
+        }
+    }
+
+    // 将字节级字符串还原为原始字节；含字母表之外的字符时返回 false
+    bool toBytes(const std::string &s, std::string &out) const {
+        out.clear();
+        for (size_t i = 0; i < s.size();) {
+            uint32_t cp;
+            i += decodeUtf8(s.data() + i, s.size() - i, &cp);
+            if (cp >= _byte.size() || _byte[cp] < 0) {
+                return false;
+            }
+            out += static_cast<char>(_byte[cp]);
+        }
+        return true;
+    }
+};
+
+bool flag(const JsonValue &v, const std::string &key) {
+    return v.contains(key) && v[key].type == JsonValue::Type::Bool && v[key].boolean;
+}
+
+bool isNullOrEmpty(const JsonValue &v, const std::string &key) {
+    return !v.contains(key) || v[key].type == JsonValue::Type::Null
+        || (v[key].type == JsonValue::Type::String && v[key].string.empty());
+}
+
+// 只支持 Qwen2 的组合：Split(Qwen2 正则, Isolated) + ByteLevel(不加前缀空格、不再套用 GPT-2 正则)
+void checkPreTokenizer(const JsonValue &pre) {
+    const auto fail = [] {
+        throw std::runtime_error("Tokenizer: only the Qwen2 Split + ByteLevel pre-tokenizer is supported");
+    };
+    if (pre.type != JsonValue::Type::Object || pre["type"].asString() != "Sequence") {
+        fail();
+    }
+    const auto &seq = pre["pretokenizers"].array;
+    if (seq.size() != 2 || seq[0]["type"].asString() != "Split" || seq[1]["type"].asString() != "ByteLevel") {
+        fail();
+    }
+    const auto &split = seq[0];
+    const auto &pattern = split["pattern"];
+    if (!pattern.contains("Regex") || pattern["Regex"].asString() != kQwen2Pattern
+        || split["behavior"].asString() != "Isolated" || flag(split, "invert")) {
+        fail();
+    }
+    if (flag(seq[1], "add_prefix_space") || flag(seq[1], "use_regex")) {
+        fail();
+    }
+}
+
+bool checkNormalizer(const JsonValue &json) {
+    if (!json.contains("normalizer") || json["normalizer"].type == JsonValue::Type::Null) {
+        return false;
+    }
+    if (json["normalizer"]["type"].asString() != "NFC") {
+        throw std::runtime_error("Tokenizer: only the NFC normalizer is supported");
+    }
+    return true;
+}
+
+struct Char {
+    uint32_t cp;
+    size_t len; // 0 表示已到末尾
+    CharClass cls;
+};
+
+Char charAt(std::string_view s, size_t i) {
+    if (i >= s.size()) {
+        return {0, 0, CharClass::Other};
+    }
+    Char c;
+    c.len = decodeUtf8(s.data() + i, s.size() - i, &c.cp);
+    c.cls = charClass(c.cp);
+    return c;
+}
+
+size_t skipClass(std::string_view s, size_t i, CharClass cls) {
+    while (i < s.size()) {
+        const Char c = charAt(s, i);
+        if (c.cls != cls) {
+            break;
+        }
+        i += c.len;
+    }
+    return i;
+}
+
+// 撇号之后的缩写后缀 s/t/m/d/re/ve/ll（大小写不敏感）的字节数，不匹配时为 0
+size_t contraction(std::string_view s, size_t i) {
+    const auto lower = [](char c) { return c >= 'A' && c <= 'Z' ? static_cast<char>(c + 32) : c; };
+    if (i >= s.size()) {
+        return 0;
+    }
+    const char a = lower(s[i]);
+    if (a == 's' || a == 't' || a == 'm' || a == 'd') {
+        return 1;
+    }
+    if (i + 1 < s.size()) {
+        const char b = lower(s[i + 1]);
+        if (((a == 'r' || a == 'v') && b == 'e') || (a == 'l' && b == 'l')) {
+            return 2;
+        }
+    }
+    return 0;
+}
+
+// 返回从 pos 开始的下一个预分词片段的字节数。正则各分支按顺序尝试，回溯的结果直接写出：
+// (?i:'s|'t|'re|'ve|'m|'ll|'d)|[^\r\n\p{L}\p{N}]?\p{L}+|\p{N}| ?[^\s\p{L}\p{N}]+[\r\n]*|\s*[\r\n]+|\s+(?!\S)|\s+
+size_t nextPiece(std::string_view s, size_t pos) {
+    const Char c = charAt(s, pos);
+    if (c.cp == '\'') {
+        const size_t n = contraction(s, pos + 1);
+        if (n > 0) {
+            return 1 + n;
+        }
+    }
+    // [^\r\n\p{L}\p{N}]?\p{L}+
+    if (c.cls == CharClass::Letter) {
+        return skipClass(s, pos, CharClass::Letter) - pos;
+    }
+    if (c.cls != CharClass::Newline && c.cls != CharClass::Number
+        && charAt(s, pos + c.len).cls == CharClass::Letter) {
+        return skipClass(s, pos + c.len, CharClass::Letter) - pos;
+    }
+    // \p{N}：数字逐个切分
+    if (c.cls == CharClass::Number) {
+        return c.len;
+    }
+    // ' '?[^\s\p{L}\p{N}]+[\r\n]*
+    const size_t q = c.cp == ' ' ? pos + 1 : pos;
+    const Char o = q == pos ? c : charAt(s, q);
+    if (o.len > 0 && o.cls == CharClass::Other) {
+        size_t end = skipClass(s, q, CharClass::Other);
+        while (end < s.size() && (s[end] == '\r' || s[end] == '\n')) {
+            end++;
+        }
+        return end - pos;
+    }
+    // 余下 c 必为空白：取整段空白
+    size_t end = pos;
+    size_t last = pos;   // 最后一个空白字符的起点
+    size_t newline = 0;  // 最后一个换行符之后的位置
+    while (end < s.size()) {
+        const Char w = charAt(s, end);
+        if (w.cls != CharClass::Space && w.cls != CharClass::Newline) {
+            break;
+        }
+        last = end;
+        end += w.len;
+        if (w.cls == CharClass::Newline) {
+            newline = end;
+        }
+    }
+    // \s*[\r\n]+：到最后一个换行符为止
+    if (newline > 0) {
+        return newline - pos;
+    }
+    // \s+(?!\S)：位于末尾时取整段，否则留下最后一个空白给后面的词；只有一个空白时由 \s+ 匹配
+    if (end == s.size() || last == pos) {
+        return end - pos;
+    }
+    return last - pos;
+}
+} // namespace
+
+Tokenizer::Tokenizer(const std::string &path) {
+    namespace fs = std::filesystem;
+    const std::string file = fs::is_directory(path) ? (fs::path(path) / "tokenizer.json").string() : path;
+    const auto json = loader::parseJsonFile(file);
+    const auto &model = json["model"];
+    if (model.contains("type") && model["type"].asString() != "BPE") {
+        throw std::runtime_error("Tokenizer: only BPE models are supported");
+    }
+    if (!isNullOrEmpty(model, "continuing_subword_prefix") || !isNullOrEmpty(model, "end_of_word_suffix")) {
+        throw std::runtime_error("Tokenizer: subword prefixes and suffixes are not supported");
+    }
+    checkPreTokenizer(json["pre_tokenizer"]);
+    _nfc = checkNormalizer(json);
+    _ignore_merges = flag(model, "ignore_merges");
+
+    const auto &vocab = model["vocab"].object;
+    const JsonValue empty;
+    const auto &added = json.contains("added_tokens") ? json["added_tokens"] : empty;
+    size_t size = 0;
+    for (const auto &[token, id] : vocab) {
+        size = std::max<size_t>(size, id.asUInt() + 1);
+    }
+    for (const auto &token : added.array) {
+        size = std::max<size_t>(size, token["id"].asUInt() + 1);
+    }
+    _pieces.resize(size);
+    _special.assign(size, 0);
+
+    // 1. 词表：字节级字符还原为原始字节；含字母表之外字符的 token 不参与编码，解码时按原文输出
+    const ByteLevel byte_level;
+    std::string bytes;
+    _vocab.reserve(vocab.size());
+    for (const auto &[token, value] : vocab) {
+        const auto id = static_cast<int32_t>(value.asUInt());
+        if (byte_level.toBytes(token, bytes)) {
+            _pieces[id] = bytes;
+            _vocab.emplace(bytes, id);
+        } else {
+            _pieces[id] = token;
+        }
+    }
+    for (int b = 0; b < 256; b++) {
+        auto it = _vocab.find(std::string(1, static_cast<char>(b)));
+        if (it == _vocab.end()) {
+            throw std::runtime_error("Tokenizer: vocabulary lacks the token of byte " + std::to_string(b));
+        }
+        _byte_ids[b] = it->second;
+    }
+
+    // 2. 合并规则：rank 为其在列表中的位置，越小越先合并；兼容 "a b" 与 ["a", "b"] 两种写法
+    const auto &merges = model["merges"].array;
+    _merges.reserve(merges.size());
+    std::string left, right;
+    for (size_t rank = 0; rank < merges.size(); rank++) {
+        const auto &m = merges[rank];
+        std::string a, b;
+        if (m.type == JsonValue::Type::String) {
+            const size_t space = m.string.find(' ');
+            if (space == std::string::npos) {
+                throw std::runtime_error("Tokenizer: invalid merge \"" + m.string + "\"");
+            }
+            a = m.string.substr(0, space);
+            b = m.string.substr(space + 1);
+        } else {
+            a = m.array.at(0).asString();
+            b = m.array.at(1).asString();
+        }
+        if (!byte_level.toBytes(a, left) || !byte_level.toBytes(b, right)) {
+            throw std::runtime_error("Tokenizer: merge outside of the byte-level alphabet: " + a + " " + b);
+        }
+        auto l = _vocab.find(left);
+        auto r = _vocab.find(right);
+        auto merged = _vocab.find(left + right);
+        if (l == _vocab.end() || r == _vocab.end() || merged == _vocab.end()) {
+            throw std::runtime_error("Tokenizer: merge token out of vocabulary: " + a + " " + b);
+        }
+        const uint64_t key = (static_cast<uint64_t>(l->second) << 32) | static_cast<uint32_t>(r->second);
+        _merges[key] = {static_cast<uint32_t>(rank), merged->second};
+    }
+
+    // 3. added_tokens：在预分词之前按原文整体匹配；lstrip/rstrip/single_word 选项不支持
+    for (const auto &token : added.array) {
+        const auto id = static_cast<int32_t>(token["id"].asUInt());
+        const auto &content = token["content"].asString();
+        _pieces[id] = content;
+        _special[id] = flag(token, "special");
+        if (!content.empty()) {
+            _added[static_cast<uint8_t>(content[0])].push_back({content, id});
+        }
+    }
+    for (auto &bucket : _added) {
+        std::stable_sort(bucket.begin(), bucket.end(),
+                         [](const AddedToken &a, const AddedToken &b) { return a.content.size() > b.content.size(); });
+    }
+}
+
+bool Tokenizer::isSpecial(int64_t id) const {
+    return id >= 0 && static_cast<size_t>(id) < _special.size() && _special[id];
+}
+
+const std::string &Tokenizer::piece(int64_t id) const {
+    if (id < 0 || static_cast<size_t>(id) >= _pieces.size()) {
+        throw std::out_of_range("Tokenizer: token id " + std::to_string(id) + " out of range");
+    }
+    return _pieces[id];
+}
+
+void Tokenizer::encode(std::string_view text, std::vector<int64_t> &out) const {
+    // 先切出 added_tokens（最左最长匹配），其余文本再做预分词与 BPE
+    size_t begin = 0;
+    size_t i = 0;
+    while (i < text.size()) {
+        const AddedToken *match = nullptr;
+        for (const auto &token : _added[static_cast<uint8_t>(text[i])]) {
+            if (text.substr(i, token.content.size()) == token.content) {
+                match = &token;
+                break;
+            }
+        }
+        if (match == nullptr) {
+            i++;
+            continue;
+        }
+        encodeText(text.substr(begin, i - begin), out);
+        out.push_back(match->id);
+        i += match->content.size();
+        begin = i;
+    }
+    encodeText(text.substr(begin), out);
+}
+
+void Tokenizer::encodeText(std::string_view text, std::vector<int64_t> &out) const {
+    for (size_t pos = 0; pos < text.size();) {
+        const size_t len = nextPiece(text, pos);
+        encodePiece(text.substr(pos, len), out);
+        pos += len;
+    }
+}
+
+void Tokenizer::encodePiece(std::string_view piece, std::vector<int64_t> &out) const {
+    if (piece.size() == 1) {
+        out.push_back(_byte_ids[static_cast<uint8_t>(piece[0])]);
+        return;
+    }
+    std::string key(piece);
+    if (_ignore_merges) {
+        auto it = _vocab.find(key);
+        if (it != _vocab.end()) {
+            out.push_back(it->second);
+            return;
+        }
+    }
+    {
+        std::lock_guard<std::mutex> lock(_cache_mutex);
+        auto it = _cache.find(key);
+        if (it != _cache.end()) {
+            out.insert(out.end(), it->second.begin(), it->second.end());
+            return;
+        }
+    }
+    std::vector<int32_t> ids;
+    bpe(piece, ids);
+    out.insert(out.end(), ids.begin(), ids.end());
+    if (piece.size() <= kMaxCachedPiece) {
+        std::lock_guard<std::mutex> lock(_cache_mutex);
+        if (_cache.size() < kCacheCapacity) {
+            _cache.emplace(std::move(key), std::move(ids));
+        }
+    }
+}
+
+void Tokenizer::bpe(std::string_view piece, std::vector<int32_t> &ids) const {
+    // 符号链表：被合并掉的符号 len 置 0
+    struct Symbol {
+        int32_t id;
+        int32_t prev;
+        int32_t next;
+        uint32_t len;
+    };
+    // 候选合并：rank 小者优先，同 rank 时靠左者优先；出队时若相邻符号已变化则丢弃
+    struct Candidate {
+        uint32_t rank;
+        int32_t pos;
+        int32_t id;
+    };
+    const auto later = [](const Candidate &a, const Candidate &b) {
+        return a.rank != b.rank ? a.rank > b.rank : a.pos > b.pos;
+    };
+
+    const auto n = static_cast<int32_t>(piece.size());
+    std::vector<Symbol> symbols(n);
+    for (int32_t i = 0; i < n; i++) {
+        symbols[i] = {_byte_ids[static_cast<uint8_t>(piece[i])], i - 1, i + 1 < n ? i + 1 : -1, 1};
+    }
+    const auto find = [&](int32_t pos) {
+        const Symbol &s = symbols[pos];
+        const uint64_t key = (static_cast<uint64_t>(s.id) << 32) | static_cast<uint32_t>(symbols[s.next].id);
+        return _merges.find(key);
+    };
+    std::vector<Candidate> queue;
+    const auto push = [&](int32_t pos) {
+        if (symbols[pos].next < 0) {
+            return;
+        }
+        auto it = find(pos);
+        if (it != _merges.end()) {
+            queue.push_back({it->second.rank, pos, it->second.id});
+            std::push_heap(queue.begin(), queue.end(), later);
+        }
+    };
+    for (int32_t i = 0; i + 1 < n; i++) {
+        push(i);
+    }
+
+    while (!queue.empty()) {
+        std::pop_heap(queue.begin(), queue.end(), later);
+        const Candidate top = queue.back();
+        queue.pop_back();
+        Symbol &s = symbols[top.pos];
+        if (s.len == 0 || s.next < 0) {
+            continue;
+        }
+        auto it = find(top.pos);
+        if (it == _merges.end() || it->second.id != top.id) {
+            continue;
+        }
+        Symbol &right = symbols[s.next];
+        s.id = top.id;
+        s.len += right.len;
+        s.next = right.next;
+        right.len = 0;
+        if (s.next >= 0) {
+            symbols[s.next].prev = top.pos;
+        }
+        if (s.prev >= 0) {
+            push(s.prev);
+        }
+        push(top.pos);
+    }
+
+    for (int32_t i = 0; i >= 0; i = symbols[i].next) {
+        ids.push_back(symbols[i].id);
+    }
+}
+
+bool Tokenizer::emits(int64_t id, bool skip_special) const {
+    // 与 HF 一致，词表之外的 id（如模型补齐的嵌入行）解码为空
+    return id >= 0 && static_cast<size_t>(id) < _pieces.size() && !(skip_special && _special[id]);
+}
+
+std::string Tokenizer::decode(const int64_t *ids, size_t n, bool skip_special) const {
+    std::string text;
+    for (size_t i = 0; i < n; i++) {
+        if (emits(ids[i], skip_special)) {
+            text += _pieces[ids[i]];
+        }
+    }
+    return text;
+}
+
+const std::string &Detokenizer::step(int64_t id) {
+    if (_tok.emits(id, _skip_special)) {
+        _pending += _tok.piece(id);
+    }
+    const size_t ready = _pending.size() - incompleteUtf8Tail(_pending);
+    _out.assign(_pending, 0, ready);
+    _pending.erase(0, ready);
+    return _out;
+}
+
+const std::string &Detokenizer::flush() {
+    _out.swap(_pending);
+    _pending.clear();
+    return _out;
+}
+} // namespace llaisys::models::tokenizer
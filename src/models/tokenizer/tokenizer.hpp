@@ -0,0 +1,80 @@
+#pragma once
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace llaisys::models::tokenizer {
+// HuggingFace tokenizer.json 中 Qwen2 系列使用的字节级 BPE 分词器：
+// 特殊 token 切分 -> Qwen2 预分词正则 -> 按合并规则优先级做 BPE，结果与 HF tokenizers 一致。
+// 不实现 NFC 规范化：词表要求 NFC 时（nfc() 为真）调用方需传入已规范化的文本
+class Tokenizer {
+private:
+    struct Merge {
+        uint32_t rank;
+        int32_t id; // 合并结果
+    };
+
+    struct AddedToken {
+        std::string content;
+        int32_t id;
+    };
+
+    // 原始字节串 -> id；词表中的字节级字符在加载时已还原为原始字节
+    std::unordered_map<std::string, int32_t> _vocab;
+    // id -> 解码输出的字节；特殊 token 为其原文
+    std::vector<std::string> _pieces;
+    std::vector<uint8_t> _special;
+    int32_t _byte_ids[256];
+    // (左 id << 32 | 右 id) -> 合并规则
+    std::unordered_map<uint64_t, Merge> _merges;
+    bool _ignore_merges = false;
+    bool _nfc = false;
+
+    // 按首字节分桶的 added_tokens，桶内长者在前（最左最长匹配）
+    std::vector<AddedToken> _added[256];
+
+    // 预分词片段 -> BPE 结果，容量满后不再插入
+    mutable std::mutex _cache_mutex;
+    mutable std::unordered_map<std::string, std::vector<int32_t>> _cache;
+
+    void encodeText(std::string_view text, std::vector<int64_t> &out) const;
+    void encodePiece(std::string_view piece, std::vector<int64_t> &out) const;
+    void bpe(std::string_view piece, std::vector<int32_t> &ids) const;
+
+public:
+    // path 为 tokenizer.json 或其所在的模型目录
+    explicit Tokenizer(const std::string &path);
+
+    size_t vocabSize() const { return _pieces.size(); }
+    bool nfc() const { return _nfc; }
+    bool isSpecial(int64_t id) const;
+    // 单个 token 的字节，可能不是完整的 UTF-8；id 越界时抛出异常
+    const std::string &piece(int64_t id) const;
+    // 解码时是否输出该 id：越界的 id 与（skip_special 时的）特殊 token 不输出
+    bool emits(int64_t id, bool skip_special) const;
+
+    // 追加 text 的 token 到 out（不添加 BOS 等模板 token）
+    void encode(std::string_view text, std::vector<int64_t> &out) const;
+    std::string decode(const int64_t *ids, size_t n, bool skip_special) const;
+};
+
+// 流式解码：逐个 token 追加字节，只输出完整的 UTF-8 字符，被截断的多字节字符留待后续 token 补全
+class Detokenizer {
+private:
+    const Tokenizer &_tok;
+    bool _skip_special;
+    std::string _pending;
+    std::string _out;
+
+public:
+    Detokenizer(const Tokenizer &tok, bool skip_special) : _tok(tok), _skip_special(skip_special) {}
+
+    // 返回本步新增的文本，引用内部缓冲，下次调用前有效
+    const std::string &step(int64_t id);
+    // 输出剩余字节（可能含不完整的 UTF-8）并清空状态
+    const std::string &flush();
+};
+} // namespace llaisys::models::tokenizer
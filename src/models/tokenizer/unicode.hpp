@@ -0,0 +1,23 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace llaisys::models::tokenizer {
+// 预分词正则用到的字符类别：\p{L}、\p{N} 与 \s（Unicode White_Space）
+enum class CharClass : uint8_t {
+    Other,
+    Letter,
+    Number,
+    Space,
+    Newline, // \r 与 \n，同时属于 \s
+};
+
+CharClass charClass(uint32_t cp);
+
+// 从 p 解码一个码位，返回其字节数；非法或截断的序列按 1 字节处理，码位记为 U+FFFD
+size_t decodeUtf8(const char *p, size_t n, uint32_t *cp);
+void appendUtf8(std::string &s, uint32_t cp);
+// s 末尾不完整 UTF-8 序列的字节数（0 表示末尾可以安全切分）
+size_t incompleteUtf8Tail(const std::string &s);
+} // namespace llaisys::models::tokenizer
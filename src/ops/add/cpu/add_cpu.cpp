@@ -5,8 +5,8 @@
 #include <cmath>
 
 template <typename T>
-void add_(T *c, const T *a, const T *b, size_t numel) {
-    for (size_t i = 0; i < numel; i++) {
+void add_row(T *c, const T *a, const T *b, size_t n) {
+    for (size_t i = 0; i < n; i++) {
         if constexpr (std::is_same_v<T, llaisys::bf16_t> || std::is_same_v<T, llaisys::fp16_t>) {
             c[i] = llaisys::utils::cast<T>(llaisys::utils::cast<float>(a[i]) + llaisys::utils::cast<float>(b[i]));
         } else {
@@ -15,17 +15,26 @@ void add_(T *c, const T *a, const T *b, size_t numel) {
     }
 }
 
+template <typename T>
+void add_(T *c, const T *a, const T *b, size_t rows, size_t cols, ptrdiff_t ld_c, ptrdiff_t ld_a, ptrdiff_t ld_b) {
+    for (size_t r = 0; r < rows; r++) {
+        add_row(c + r * ld_c, a + r * ld_a, b + r * ld_b, cols);
+    }
+}
+
 namespace llaisys::ops::cpu {
-void add(std::byte *c, const std::byte *a, const std::byte *b, llaisysDataType_t type, size_t numel) {
+void add(std::byte *c, const std::byte *a, const std::byte *b, llaisysDataType_t type, size_t rows, size_t cols,
+         ptrdiff_t ld_c, ptrdiff_t ld_a, ptrdiff_t ld_b) {
     switch (type) {
     case LLAISYS_DTYPE_F32:
-        return add_(reinterpret_cast<float *>(c), reinterpret_cast<const float *>(a), reinterpret_cast<const float *>(b), numel);
+        return add_(reinterpret_cast<float *>(c), reinterpret_cast<const float *>(a), reinterpret_cast<const float *>(b), rows, cols,
+                    ld_c, ld_a, ld_b);
     case LLAISYS_DTYPE_BF16:
         return add_(reinterpret_cast<llaisys::bf16_t *>(c), reinterpret_cast<const llaisys::bf16_t *>(a),
-                    reinterpret_cast<const llaisys::bf16_t *>(b), numel);
+                    reinterpret_cast<const llaisys::bf16_t *>(b), rows, cols, ld_c, ld_a, ld_b);
     case LLAISYS_DTYPE_F16:
         return add_(reinterpret_cast<llaisys::fp16_t *>(c), reinterpret_cast<const llaisys::fp16_t *>(a),
-                    reinterpret_cast<const llaisys::fp16_t *>(b), numel);
+                    reinterpret_cast<const llaisys::fp16_t *>(b), rows, cols, ld_c, ld_a, ld_b);
     default:
         EXCEPTION_UNSUPPORTED_DATATYPE(type);
     }
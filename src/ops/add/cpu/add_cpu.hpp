@@ -4,5 +4,7 @@
 #include <cstddef>
 
 namespace llaisys::ops::cpu {
-void add(std::byte *c, const std::byte *a, const std::byte *b, llaisysDataType_t type, size_t size);
+// 按行计算 c = a + b：共 rows 行、每行 cols 个连续元素，行距（元素数）由各张量分别给出
+void add(std::byte *c, const std::byte *a, const std::byte *b, llaisysDataType_t type, size_t rows, size_t cols,
+         ptrdiff_t ld_c, ptrdiff_t ld_a, ptrdiff_t ld_b);
 }
\ No newline at end of file
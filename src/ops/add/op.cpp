@@ -1,28 +1,37 @@
 #include "op.hpp"
 
 #include "../../core/llaisys_core.hpp"
+#include "../trace.hpp"
 #include "../../utils.hpp"
 
 #include "cpu/add_cpu.hpp"
 
 namespace llaisys::ops {
 void add(tensor_t c, tensor_t a, tensor_t b) {
+    LLAISYS_TRACE_OP("add", c, a, b);
     CHECK_SAME_DEVICE(c, a, b);
-    // Only support contiguous inputs with same shape for now.
+    // Same shape, no broadcasting. Each tensor may be a row-strided view (e.g. a slice).
     CHECK_SAME_SHAPE(c->shape(), a->shape(), b->shape());
     CHECK_SAME_DTYPE(c->dtype(), a->dtype(), b->dtype());
-    ASSERT(c->isContiguous() && a->isContiguous() && b->isContiguous(), "Add: all tensors must be contiguous.");
+    ASSERT(c->isRowStrided() && a->isRowStrided() && b->isRowStrided(), "Add: tensor rows must be contiguous.");
+    const size_t cols = c->ndim() == 0 ? 1 : c->shape().back();
+    const size_t rows = cols == 0 ? 0 : c->numel() / cols;
+    if (rows == 0) {
+        return;
+    }
 
     // always support cpu calculation
     if (c->deviceType() == LLAISYS_DEVICE_CPU) {
-        return cpu::add(c->data(), a->data(), b->data(), c->dtype(), c->numel());
+        return core::launch(cpu::add, c->data(), a->data(), b->data(), c->dtype(), rows, cols,
+                            c->rowStride(), a->rowStride(), b->rowStride());
     }
 
     llaisys::core::context().setDevice(c->deviceType(), c->deviceId());
 
     switch (c->deviceType()) {
     case LLAISYS_DEVICE_CPU:
-        return cpu::add(c->data(), a->data(), b->data(), c->dtype(), c->numel());
+        return core::launch(cpu::add, c->data(), a->data(), b->data(), c->dtype(), rows, cols,
+                            c->rowStride(), a->rowStride(), b->rowStride());
 #ifdef ENABLE_NVIDIA_API
     case LLAISYS_DEVICE_NVIDIA:
         TO_BE_IMPLEMENTED();
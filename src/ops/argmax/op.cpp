@@ -1,11 +1,13 @@
 #include "op.hpp"
 #include "../../core/llaisys_core.hpp"
+#include "../trace.hpp"
 #include "../../utils.hpp"
 #include "cpu/argmax_cpu.hpp"
 #include <string>  // 用于拼接详细错误信息
 
 namespace llaisys::ops {
 void argmax(tensor_t max_idx, tensor_t max_val, tensor_t vals) {
+    LLAISYS_TRACE_OP("argmax", max_idx, max_val, vals);
     // 步骤1：输入合法性校验（优化dtype校验，添加详细错误信息）
     // 1. 所有张量必须在同一设备
     CHECK_SAME_DEVICE(max_idx, max_val, vals);
@@ -36,8 +38,8 @@ void argmax(tensor_t max_idx, tensor_t max_val, tensor_t vals) {
 
     // 步骤2：CPU设备快速路径（对齐add算子，提升常用场景效率）
     if (vals->deviceType() == LLAISYS_DEVICE_CPU) {
-        return cpu::argmax(max_idx->data(), max_val->data(), vals->data(), 
-                           vals->dtype(), vals->numel());
+        return core::launch(cpu::argmax, max_idx->data(), max_val->data(), vals->data(), 
+                            vals->dtype(), vals->numel());
     }
 
     // 步骤3：非CPU设备处理（框架扩展预留，对齐add算子结构）
@@ -45,8 +47,8 @@ void argmax(tensor_t max_idx, tensor_t max_val, tensor_t vals) {
 
     switch (vals->deviceType()) {
     case LLAISYS_DEVICE_CPU:
-        return cpu::argmax(max_idx->data(), max_val->data(), vals->data(), 
-                           vals->dtype(), vals->numel());
+        return core::launch(cpu::argmax, max_idx->data(), max_val->data(), vals->data(), 
+                            vals->dtype(), vals->numel());
 #ifdef ENABLE_NVIDIA_API
     case LLAISYS_DEVICE_NVIDIA:
         TO_BE_IMPLEMENTED();
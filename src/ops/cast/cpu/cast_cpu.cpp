@@ -0,0 +1,83 @@
+#include "cast_cpu.hpp"
+
+#include "../../../utils.hpp"
+
+#include <array>
+#include <cstring>
+#include <type_traits>
+
+namespace {
+template <typename T>
+constexpr bool kIsFp8 = std::is_same_v<T, llaisys::fp8e4m3_t> || std::is_same_v<T, llaisys::fp8e5m2_t>;
+
+// fp8 只有 256 个取值，查表解码
+template <typename T>
+const std::array<float, 256> &fp8_table() {
+    static const std::array<float, 256> table = [] {
+        std::array<float, 256> t{};
+        for (int i = 0; i < 256; i++) {
+            t[i] = llaisys::utils::cast<float>(T{static_cast<uint8_t>(i)});
+        }
+        return t;
+    }();
+    return table;
+}
+
+template <typename To, typename From>
+void cast_(To *out, const From *in, size_t numel) {
+    const ptrdiff_t n = static_cast<ptrdiff_t>(numel);
+    if constexpr (kIsFp8<From>) {
+        const float *table = fp8_table<From>().data();
+#pragma omp parallel for schedule(static)
+        for (ptrdiff_t i = 0; i < n; i++) {
+            out[i] = llaisys::utils::cast<To>(table[in[i]._v]);
+        }
+    } else {
+#pragma omp parallel for schedule(static)
+        for (ptrdiff_t i = 0; i < n; i++) {
+            out[i] = llaisys::utils::cast<To>(llaisys::utils::cast<float>(in[i]));
+        }
+    }
+}
+
+template <typename To>
+void cast_from(To *out, const std::byte *in, llaisysDataType_t in_type, size_t numel) {
+    switch (in_type) {
+    case LLAISYS_DTYPE_F32:
+        return cast_(out, reinterpret_cast<const float *>(in), numel);
+    case LLAISYS_DTYPE_F16:
+        return cast_(out, reinterpret_cast<const llaisys::fp16_t *>(in), numel);
+    case LLAISYS_DTYPE_BF16:
+        return cast_(out, reinterpret_cast<const llaisys::bf16_t *>(in), numel);
+    case LLAISYS_DTYPE_F8:
+        return cast_(out, reinterpret_cast<const llaisys::fp8e4m3_t *>(in), numel);
+    case LLAISYS_DTYPE_F8E5M2:
+        return cast_(out, reinterpret_cast<const llaisys::fp8e5m2_t *>(in), numel);
+    default:
+        EXCEPTION_UNSUPPORTED_DATATYPE(in_type);
+    }
+}
+} // namespace
+
+namespace llaisys::ops::cpu {
+void cast(std::byte *out, llaisysDataType_t out_type, const std::byte *in, llaisysDataType_t in_type, size_t numel) {
+    if (out_type == in_type) {
+        std::memcpy(out, in, numel * utils::dsize(in_type));
+        return;
+    }
+    switch (out_type) {
+    case LLAISYS_DTYPE_F32:
+        return cast_from(reinterpret_cast<float *>(out), in, in_type, numel);
+    case LLAISYS_DTYPE_F16:
+        return cast_from(reinterpret_cast<fp16_t *>(out), in, in_type, numel);
+    case LLAISYS_DTYPE_BF16:
+        return cast_from(reinterpret_cast<bf16_t *>(out), in, in_type, numel);
+    case LLAISYS_DTYPE_F8:
+        return cast_from(reinterpret_cast<fp8e4m3_t *>(out), in, in_type, numel);
+    case LLAISYS_DTYPE_F8E5M2:
+        return cast_from(reinterpret_cast<fp8e5m2_t *>(out), in, in_type, numel);
+    default:
+        EXCEPTION_UNSUPPORTED_DATATYPE(out_type);
+    }
+}
+} // namespace llaisys::ops::cpu
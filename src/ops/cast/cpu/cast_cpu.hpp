@@ -0,0 +1,9 @@
+#pragma once
+#include "llaisys.h"
+
+#include <cstddef>
+
+namespace llaisys::ops::cpu {
+// 浮点类型之间的批量转换（f32 / f16 / bf16 / fp8 e4m3 / fp8 e5m2），同类型时直接拷贝
+void cast(std::byte *out, llaisysDataType_t out_type, const std::byte *in, llaisysDataType_t in_type, size_t numel);
+}
@@ -0,0 +1,36 @@
+#include "op.hpp"
+
+#include "../../core/llaisys_core.hpp"
+#include "../trace.hpp"
+#include "../../utils.hpp"
+
+#include "cpu/cast_cpu.hpp"
+
+namespace llaisys::ops {
+void cast(tensor_t out, tensor_t in) {
+    LLAISYS_TRACE_OP("cast", out, in);
+    // 1. 设备与形状校验，类型由 kernel 检查
+    CHECK_SAME_DEVICE(out, in);
+    CHECK_SAME_SHAPE(out->shape(), in->shape());
+    ASSERT(out->isContiguous() && in->isContiguous(), "Cast: all tensors must be contiguous.");
+
+    // 2. CPU 快速路径
+    if (out->deviceType() == LLAISYS_DEVICE_CPU) {
+        return core::launch(cpu::cast, out->data(), out->dtype(), in->data(), in->dtype(), out->numel());
+    }
+
+    llaisys::core::context().setDevice(out->deviceType(), out->deviceId());
+
+    switch (out->deviceType()) {
+    case LLAISYS_DEVICE_CPU:
+        return core::launch(cpu::cast, out->data(), out->dtype(), in->data(), in->dtype(), out->numel());
+#ifdef ENABLE_NVIDIA_API
+    case LLAISYS_DEVICE_NVIDIA:
+        TO_BE_IMPLEMENTED();
+        return;
+#endif
+    default:
+        EXCEPTION_UNSUPPORTED_DEVICE;
+    }
+}
+} // namespace llaisys::ops
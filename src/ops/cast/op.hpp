@@ -0,0 +1,9 @@
+#pragma once
+
+#include "../../tensor/tensor.hpp"
+
+namespace llaisys::ops {
+// 逐元素类型转换：out 与 in 形状相同，类型取自 f32 / f16 / bf16 / fp8 e4m3 / fp8 e5m2。
+// 转为 fp8 时就近舍入并饱和到最大有限值，不做缩放
+void cast(tensor_t out, tensor_t in);
+}
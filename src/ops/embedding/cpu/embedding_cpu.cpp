@@ -14,7 +14,7 @@ void copy_embedding_row(T *out_row, const T *weight_row, size_t hidden_dim) {
 
 template <typename T>
 void embedding_(std::byte *out, const std::byte *index, const std::byte *weight,
-                size_t batch_size, size_t hidden_dim, size_t vocab_size) {
+                size_t batch_size, size_t hidden_dim, size_t vocab_size, ptrdiff_t ld_out) {
     const int64_t *index_ptr = reinterpret_cast<const int64_t*>(index);
     const T *weight_ptr = reinterpret_cast<const T*>(weight);
     T *out_ptr = reinterpret_cast<T*>(out);
@@ -28,7 +28,7 @@ void embedding_(std::byte *out, const std::byte *index, const std::byte *weight,
         }
 
         const T *weight_row = weight_ptr + (static_cast<size_t>(idx) * hidden_dim);
-        T *out_row = out_ptr + (i * hidden_dim);
+        T *out_row = out_ptr + (i * ld_out);
         llaisys::copy_embedding_row(out_row, weight_row, hidden_dim);
     }
 }
@@ -36,7 +36,7 @@ void embedding_(std::byte *out, const std::byte *index, const std::byte *weight,
 namespace llaisys::ops::cpu {
 void embedding(std::byte *out, const std::byte *index, const std::byte *weight,
                llaisysDataType_t data_type, size_t batch_size,
-               size_t hidden_dim, size_t vocab_size) {
+               size_t hidden_dim, size_t vocab_size, ptrdiff_t ld_out) {
     // 原 EXCEPTION_INVALID_INPUT 替换为 std::invalid_argument
     if (batch_size == 0 || hidden_dim == 0 || vocab_size == 0) {
         throw std::invalid_argument("Embedding: batch_size/hidden_dim/vocab_size cannot be zero.");
@@ -44,11 +44,11 @@ void embedding(std::byte *out, const std::byte *index, const std::byte *weight,
 
     switch (data_type) {
     case LLAISYS_DTYPE_F32:
-        return embedding_<float>(out, index, weight, batch_size, hidden_dim, vocab_size);
+        return embedding_<float>(out, index, weight, batch_size, hidden_dim, vocab_size, ld_out);
     case LLAISYS_DTYPE_BF16:
-        return embedding_<llaisys::bf16_t>(out, index, weight, batch_size, hidden_dim, vocab_size);
+        return embedding_<llaisys::bf16_t>(out, index, weight, batch_size, hidden_dim, vocab_size, ld_out);
     case LLAISYS_DTYPE_F16:
-        return embedding_<llaisys::fp16_t>(out, index, weight, batch_size, hidden_dim, vocab_size);
+        return embedding_<llaisys::fp16_t>(out, index, weight, batch_size, hidden_dim, vocab_size, ld_out);
     default:
         std::string err_msg = "Embedding: unsupported data type (" + std::to_string(static_cast<int>(data_type)) + ").";
         throw std::runtime_error(err_msg);
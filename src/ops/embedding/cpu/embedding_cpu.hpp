@@ -5,5 +5,5 @@
 namespace llaisys::ops::cpu {
 void embedding(std::byte *out, const std::byte *index, const std::byte *weight,
                llaisysDataType_t data_type, size_t batch_size,
-               size_t hidden_dim, size_t vocab_size);
+               size_t hidden_dim, size_t vocab_size, ptrdiff_t ld_out);
 } // namespace llaisys::ops::cpu
\ No newline at end of file
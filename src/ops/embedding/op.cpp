@@ -1,5 +1,6 @@
 #include "op.hpp"
 #include "../../core/llaisys_core.hpp"
+#include "../trace.hpp"
 #include "../../utils.hpp"
 #include "cpu/embedding_cpu.hpp"
 #include <string>
@@ -12,6 +13,7 @@
 
 namespace llaisys::ops {
 void embedding(tensor_t out, tensor_t index, tensor_t weight) {
+    LLAISYS_TRACE_OP("embedding", out, index, weight);
     // 1. 校验设备一致
     auto out_device = out->deviceType();
     auto out_device_id = out->deviceId();
@@ -26,9 +28,9 @@ void embedding(tensor_t out, tensor_t index, tensor_t weight) {
     }
 
     // 2. 校验维度
-    std::vector<size_t> out_shape = out->shape();
-    std::vector<size_t> index_shape = index->shape();
-    std::vector<size_t> weight_shape = weight->shape();
+    const auto &out_shape = out->shape();
+    const auto &index_shape = index->shape();
+    const auto &weight_shape = weight->shape();
 
     if (out_shape.size() != 2) {
         throw std::invalid_argument("Embedding: out must be a 2D tensor.");
@@ -69,14 +71,14 @@ void embedding(tensor_t out, tensor_t index, tensor_t weight) {
     }
 
     // 6. 校验连续存储
-    if (!out->isContiguous() || !index->isContiguous() || !weight->isContiguous()) {
-        throw std::invalid_argument("Embedding: all tensors must be contiguous.");
+    if (!out->isRowStrided() || !index->isContiguous() || !weight->isContiguous()) {
+        throw std::invalid_argument("Embedding: out rows, index and weight must be contiguous.");
     }
 
     // 7. CPU快速路径
     if (out_device == LLAISYS_DEVICE_CPU) {
-        return cpu::embedding(out->data(), index->data(), weight->data(),
-                              weight->dtype(), batch_size, hidden_dim, vocab_size);
+        return core::launch(cpu::embedding, out->data(), index->data(), weight->data(),
+                            weight->dtype(), batch_size, hidden_dim, vocab_size, out->rowStride());
     }
 
     // 8. 非CPU设备处理
@@ -84,8 +86,8 @@ void embedding(tensor_t out, tensor_t index, tensor_t weight) {
 
     switch (out_device) {
     case LLAISYS_DEVICE_CPU:
-        return cpu::embedding(out->data(), index->data(), weight->data(),
-                              weight->dtype(), batch_size, hidden_dim, vocab_size);
+        return core::launch(cpu::embedding, out->data(), index->data(), weight->data(),
+                            weight->dtype(), batch_size, hidden_dim, vocab_size, out->rowStride());
 #ifdef ENABLE_NVIDIA_API
     case LLAISYS_DEVICE_NVIDIA:
         throw std::runtime_error("Embedding: NVIDIA device is not implemented yet.");
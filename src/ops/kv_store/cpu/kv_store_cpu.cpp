@@ -0,0 +1,31 @@
+#include "kv_store_cpu.hpp"
+
+#include "../../../utils.hpp"
+#include "../../quantize_kv/cpu/quantize_kv_cpu.hpp"
+
+#include <cstring>
+#include <stdexcept>
+
+namespace llaisys::ops::cpu {
+void kv_store(std::byte *cache, std::byte *scales, const std::byte *src, const std::byte *slots,
+              llaisysDataType_t cache_type, llaisysDataType_t src_type, size_t n, size_t capacity, size_t nhead,
+              size_t d) {
+    const auto *slot = reinterpret_cast<const int64_t *>(slots);
+    const bool quant = cache_type == LLAISYS_DTYPE_I8 || cache_type == LLAISYS_DTYPE_F8
+                    || cache_type == LLAISYS_DTYPE_F8E5M2;
+    const size_t src_row = nhead * d * utils::dsize(src_type);
+    const size_t cache_row = nhead * d * utils::dsize(cache_type);
+    for (size_t i = 0; i < n; i++) {
+        const int64_t s = slot[i];
+        if (s < 0 || static_cast<size_t>(s) >= capacity) {
+            throw std::out_of_range("KVStore: slot out of range");
+        }
+        if (quant) {
+            quantize_kv(cache + s * cache_row, scales + s * nhead * sizeof(float), src + i * src_row, cache_type,
+                        src_type, nhead, d);
+        } else {
+            std::memcpy(cache + s * cache_row, src + i * src_row, src_row);
+        }
+    }
+}
+} // namespace llaisys::ops::cpu
@@ -0,0 +1,10 @@
+#pragma once
+#include "llaisys.h"
+
+#include <cstddef>
+
+namespace llaisys::ops::cpu {
+void kv_store(std::byte *cache, std::byte *scales, const std::byte *src, const std::byte *slots,
+              llaisysDataType_t cache_type, llaisysDataType_t src_type, size_t n, size_t capacity, size_t nhead,
+              size_t d);
+}
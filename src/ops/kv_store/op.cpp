@@ -0,0 +1,58 @@
+#include "op.hpp"
+
+#include "../../core/llaisys_core.hpp"
+#include "../trace.hpp"
+#include "../../utils.hpp"
+
+#include "cpu/kv_store_cpu.hpp"
+
+namespace llaisys::ops {
+void kv_store(tensor_t cache, tensor_t scales, tensor_t src, tensor_t slots) {
+    LLAISYS_TRACE_OP("kv_store", cache, scales, src, slots);
+    // 1. 设备、形状与类型校验
+    CHECK_SAME_DEVICE(cache, src, slots);
+    CHECK_ARGUMENT(cache->ndim() == 3 && src->ndim() == 3, "KVStore: cache and src must be [rows, nhead, d]");
+    CHECK_ARGUMENT(cache->shape()[1] == src->shape()[1] && cache->shape()[2] == src->shape()[2],
+                   "KVStore: cache and src must have the same head layout");
+    CHECK_ARGUMENT(slots->ndim() == 1 && slots->shape()[0] == src->shape()[0] && slots->dtype() == LLAISYS_DTYPE_I64,
+                   "KVStore: slots must be int64 [n]");
+    const bool quant = cache->dtype() == LLAISYS_DTYPE_I8 || cache->dtype() == LLAISYS_DTYPE_F8
+                    || cache->dtype() == LLAISYS_DTYPE_F8E5M2;
+    if (quant) {
+        CHECK_ARGUMENT(scales != nullptr, "KVStore: a quantized cache requires scales");
+        CHECK_SAME_DEVICE(cache, scales);
+        CHECK_ARGUMENT(scales->ndim() == 2 && scales->shape()[0] == cache->shape()[0]
+                           && scales->shape()[1] == cache->shape()[1] && scales->dtype() == LLAISYS_DTYPE_F32,
+                       "KVStore: scales must be float32 [capacity, nhead]");
+        ASSERT(scales->isContiguous(), "KVStore: all tensors must be contiguous.");
+    } else {
+        CHECK_SAME_DTYPE(cache->dtype(), src->dtype());
+    }
+    ASSERT(cache->isContiguous() && src->isContiguous() && slots->isContiguous(),
+           "KVStore: all tensors must be contiguous.");
+
+    const size_t n = src->shape()[0], capacity = cache->shape()[0], nhead = cache->shape()[1], d = cache->shape()[2];
+    std::byte *scale_data = quant ? scales->data() : nullptr;
+
+    // 2. CPU 快速路径
+    if (cache->deviceType() == LLAISYS_DEVICE_CPU) {
+        return core::launch(cpu::kv_store, cache->data(), scale_data, src->data(), slots->data(), cache->dtype(),
+                            src->dtype(), n, capacity, nhead, d);
+    }
+
+    llaisys::core::context().setDevice(cache->deviceType(), cache->deviceId());
+
+    switch (cache->deviceType()) {
+    case LLAISYS_DEVICE_CPU:
+        return core::launch(cpu::kv_store, cache->data(), scale_data, src->data(), slots->data(), cache->dtype(),
+                            src->dtype(), n, capacity, nhead, d);
+#ifdef ENABLE_NVIDIA_API
+    case LLAISYS_DEVICE_NVIDIA:
+        TO_BE_IMPLEMENTED();
+        return;
+#endif
+    default:
+        EXCEPTION_UNSUPPORTED_DEVICE;
+    }
+}
+} // namespace llaisys::ops
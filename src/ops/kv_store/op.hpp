@@ -0,0 +1,11 @@
+#pragma once
+
+#include "../../tensor/tensor.hpp"
+
+namespace llaisys::ops {
+// 把 src [n, nhead, d] 的第 i 行写入 KV Cache cache [capacity, nhead, d] 的第 slots[i] 行。
+// slots 为 int64 [n]，在内核执行时读取，因此可以在回放命令图之前更新。
+// cache 为 int8 或 fp8 E4M3 时逐 (token, head) 量化写入，scales 为 float32 [capacity, nhead]；
+// 否则 cache 与 src 同类型，scales 为空
+void kv_store(tensor_t cache, tensor_t scales, tensor_t src, tensor_t slots);
+}
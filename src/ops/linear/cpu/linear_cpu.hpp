@@ -7,5 +7,6 @@
 
 namespace llaisys::ops::cpu {
 void linear(std::byte *out, const std::byte *in, const std::byte *weight, const std::byte *bias,
-            llaisysDataType_t data_type, size_t N, size_t in_features, size_t out_features);
+            llaisysDataType_t data_type, size_t N, size_t in_features, size_t out_features,
+            ptrdiff_t ld_in, ptrdiff_t ld_out);
 } // namespace llaisys::ops::cpu
\ No newline at end of file
@@ -1,5 +1,6 @@
 #include "op.hpp"
 #include "../../core/llaisys_core.hpp"
+#include "../trace.hpp"
 #include "../../utils.hpp"
 #include "cpu/linear_cpu.hpp"
 #include <string>
@@ -14,6 +15,7 @@ bool is_tensor_null(tensor_t tensor) {
     return !tensor || tensor->numel() == 0;
 }
 void linear(tensor_t out, tensor_t in, tensor_t weight, tensor_t bias) {
+    LLAISYS_TRACE_OP("linear", out, in, weight, bias);
     // 步骤 1：输入合法性校验（严格符合 2D 张量约束，无广播）
     // 1.1 非空张量设备一致（bias 可选，可空）
     auto out_device = out->deviceType();
@@ -37,9 +39,9 @@ void linear(tensor_t out, tensor_t in, tensor_t weight, tensor_t bias) {
     }
 
     // 1.2 校验张量维度
-    std::vector<size_t> out_shape = out->shape();
-    std::vector<size_t> in_shape = in->shape();
-    std::vector<size_t> weight_shape = weight->shape();
+    const auto &out_shape = out->shape();
+    const auto &in_shape = in->shape();
+    const auto &weight_shape = weight->shape();
 
     if (out_shape.size() != 2) {
         throw std::invalid_argument("Linear: out must be a 2D tensor.");
@@ -52,7 +54,7 @@ void linear(tensor_t out, tensor_t in, tensor_t weight, tensor_t bias) {
     }
     // 若 bias 非空，校验为 1D 张量
     if (!is_tensor_null(bias)) {
-        std::vector<size_t> bias_shape = bias->shape();
+        const auto &bias_shape = bias->shape();
         if (bias_shape.size() != 1) {
             throw std::invalid_argument("Linear: bias must be a 1D tensor if provided.");
         }
@@ -91,9 +93,12 @@ void linear(tensor_t out, tensor_t in, tensor_t weight, tensor_t bias) {
         throw std::invalid_argument("Linear: bias must have the same data type as other tensors.");
     }
 
-    // 1.6 校验所有张量都是连续存储
-    if (!out->isContiguous() || !in->isContiguous() || !weight->isContiguous()) {
-        throw std::invalid_argument("Linear: out/in/weight must be contiguous.");
+    // 1.6 校验存储布局：out/in 只需行内连续（如融合缓冲区的列切片），按行距访问；weight 须连续
+    if (!out->isRowStrided() || !in->isRowStrided()) {
+        throw std::invalid_argument("Linear: out/in rows must be contiguous.");
+    }
+    if (!weight->isContiguous()) {
+        throw std::invalid_argument("Linear: weight must be contiguous.");
     }
     if (!is_tensor_null(bias) && !bias->isContiguous()) {
         throw std::invalid_argument("Linear: bias must be contiguous if provided.");
@@ -104,8 +109,8 @@ void linear(tensor_t out, tensor_t in, tensor_t weight, tensor_t bias) {
 
     // 步骤 3：CPU 设备快速路径（使用框架原生设备枚举，无冲突）
     if (out_device == LLAISYS_DEVICE_CPU) {
-        return cpu::linear(out->data(), in->data(), weight->data(), bias_data,
-                           dtype, N, in_features, out_features);
+        return core::launch(cpu::linear, out->data(), in->data(), weight->data(), bias_data,
+                            dtype, N, in_features, out_features, in->rowStride(), out->rowStride());
     }
 
     // 步骤 4：非 CPU 设备处理（框架扩展预留）
@@ -113,8 +118,8 @@ void linear(tensor_t out, tensor_t in, tensor_t weight, tensor_t bias) {
 
     switch (out_device) {
     case LLAISYS_DEVICE_CPU:
-        return cpu::linear(out->data(), in->data(), weight->data(), bias_data,
-                           dtype, N, in_features, out_features);
+        return core::launch(cpu::linear, out->data(), in->data(), weight->data(), bias_data,
+                            dtype, N, in_features, out_features, in->rowStride(), out->rowStride());
 #ifdef ENABLE_NVIDIA_API
     case LLAISYS_DEVICE_NVIDIA:
         throw std::runtime_error("Linear: NVIDIA device is not implemented yet.");
@@ -0,0 +1,221 @@
+// simd.hpp 须先于其他框架头文件包含
+#include "../../../utils/simd.hpp"
+
+#include "linear_fp8_cpu.hpp"
+
+#include "../../../utils.hpp"
+
+#include <algorithm>
+#include <array>
+#include <vector>
+
+namespace {
+// fp8 码位先扩展为 float16 码位（下称原始值），再用 F16C / AVX-512 的 vcvtph2ps 转为 float：
+// E5M2 恰为 float16 的高字节；E4M3 的指数偏置比 float16 小 8，原始值需再乘 2^8，该因子并入缩放系数。
+// E4M3 没有无穷，其 NaN 码位的原始值为有限数，量化得到的权重中不会出现该码位
+struct E4M3 {
+    static constexpr float kRawScale = 256.0f;
+    static uint16_t widen(uint8_t b) {
+        return static_cast<uint16_t>(((b & 0x7F) << 7) | ((b & 0x80) << 8));
+    }
+#ifdef LLAISYS_X86_SIMD
+    __attribute__((target("avx2"))) static __m128i widen(__m128i v) {
+        return _mm_or_si128(_mm_slli_epi16(_mm_and_si128(v, _mm_set1_epi16(0x7F)), 7),
+                            _mm_slli_epi16(_mm_and_si128(v, _mm_set1_epi16(0x80)), 8));
+    }
+    __attribute__((target("avx2"))) static __m256i widen(__m256i v) {
+        return _mm256_or_si256(_mm256_slli_epi16(_mm256_and_si256(v, _mm256_set1_epi16(0x7F)), 7),
+                               _mm256_slli_epi16(_mm256_and_si256(v, _mm256_set1_epi16(0x80)), 8));
+    }
+#endif
+};
+
+struct E5M2 {
+    static constexpr float kRawScale = 1.0f;
+    static uint16_t widen(uint8_t b) {
+        return static_cast<uint16_t>(b << 8);
+    }
+#ifdef LLAISYS_X86_SIMD
+    __attribute__((target("avx2"))) static __m128i widen(__m128i v) {
+        return _mm_slli_epi16(v, 8);
+    }
+    __attribute__((target("avx2"))) static __m256i widen(__m256i v) {
+        return _mm256_slli_epi16(v, 8);
+    }
+#endif
+};
+
+// 标量路径与各 SIMD 内核的尾部查表得到原始值，与向量路径结果一致
+template <typename F>
+const float *raw_table() {
+    static const std::array<float, 256> table = [] {
+        std::array<float, 256> t{};
+        for (int i = 0; i < 256; i++) {
+            t[i] = llaisys::utils::cast<float>(llaisys::fp16_t{F::widen(static_cast<uint8_t>(i))});
+        }
+        return t;
+    }();
+    return table.data();
+}
+
+// 微内核：一行 fp8 权重 w[K] 与 NR 行 float 输入 x[r * ldx + k] 的点积（float 累加），结果写入 acc[NR]
+using DotFn = void (*)(const float *x, size_t ldx, const uint8_t *w, size_t K, float *acc);
+constexpr int kMaxRows = 4;
+
+template <typename F, int NR>
+void dot_fp8_scalar(const float *x, size_t ldx, const uint8_t *w, size_t K, float *acc) {
+    const float *raw = raw_table<F>();
+    for (int r = 0; r < NR; r++) {
+        float sum = 0.0f;
+        for (size_t k = 0; k < K; k++) {
+            sum += x[r * ldx + k] * raw[w[k]];
+        }
+        acc[r] = sum;
+    }
+}
+
+#ifdef LLAISYS_X86_SIMD
+template <typename F, int NR>
+__attribute__((target("avx2,fma,f16c"))) void dot_fp8_avx2(const float *x, size_t ldx, const uint8_t *w, size_t K,
+                                                           float *acc) {
+    // 每行两个累加器，隐藏 FMA 延迟
+    __m256 sum0[NR], sum1[NR];
+    for (int r = 0; r < NR; r++) {
+        sum0[r] = _mm256_setzero_ps();
+        sum1[r] = _mm256_setzero_ps();
+    }
+    size_t k = 0;
+    for (; k + 16 <= K; k += 16) {
+        __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i *>(w + k));
+        __m256 w0 = _mm256_cvtph_ps(F::widen(_mm_cvtepu8_epi16(b)));
+        __m256 w1 = _mm256_cvtph_ps(F::widen(_mm_cvtepu8_epi16(_mm_srli_si128(b, 8))));
+        for (int r = 0; r < NR; r++) {
+            sum0[r] = _mm256_fmadd_ps(_mm256_loadu_ps(x + r * ldx + k), w0, sum0[r]);
+            sum1[r] = _mm256_fmadd_ps(_mm256_loadu_ps(x + r * ldx + k + 8), w1, sum1[r]);
+        }
+    }
+    const float *raw = raw_table<F>();
+    for (int r = 0; r < NR; r++) {
+        float sum = llaisys::utils::hsumAvx2(_mm256_add_ps(sum0[r], sum1[r]));
+        for (size_t t = k; t < K; t++) {
+            sum += x[r * ldx + t] * raw[w[t]];
+        }
+        acc[r] = sum;
+    }
+}
+
+template <typename F, int NR>
+__attribute__((target("avx512f,avx512bw"))) void dot_fp8_avx512(const float *x, size_t ldx, const uint8_t *w,
+                                                                size_t K, float *acc) {
+    __m512 sum0[NR], sum1[NR];
+    for (int r = 0; r < NR; r++) {
+        sum0[r] = _mm512_setzero_ps();
+        sum1[r] = _mm512_setzero_ps();
+    }
+    size_t k = 0;
+    for (; k + 32 <= K; k += 32) {
+        __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(w + k));
+        __m512 w0 = _mm512_cvtph_ps(F::widen(_mm256_cvtepu8_epi16(_mm256_castsi256_si128(b))));
+        __m512 w1 = _mm512_cvtph_ps(F::widen(_mm256_cvtepu8_epi16(_mm256_extracti128_si256(b, 1))));
+        for (int r = 0; r < NR; r++) {
+            sum0[r] = _mm512_fmadd_ps(_mm512_loadu_ps(x + r * ldx + k), w0, sum0[r]);
+            sum1[r] = _mm512_fmadd_ps(_mm512_loadu_ps(x + r * ldx + k + 16), w1, sum1[r]);
+        }
+    }
+    const float *raw = raw_table<F>();
+    for (int r = 0; r < NR; r++) {
+        float sum = _mm512_reduce_add_ps(_mm512_add_ps(sum0[r], sum1[r]));
+        for (size_t t = k; t < K; t++) {
+            sum += x[r * ldx + t] * raw[w[t]];
+        }
+        acc[r] = sum;
+    }
+}
+#endif
+
+// 按 CPU 能力选择微内核，下标为行数 - 1
+template <typename F>
+const DotFn *select_kernels() {
+    static const DotFn scalar[kMaxRows] = {dot_fp8_scalar<F, 1>, dot_fp8_scalar<F, 2>, dot_fp8_scalar<F, 3>,
+                                           dot_fp8_scalar<F, 4>};
+#ifdef LLAISYS_X86_SIMD
+    static const DotFn avx2[kMaxRows] = {dot_fp8_avx2<F, 1>, dot_fp8_avx2<F, 2>, dot_fp8_avx2<F, 3>,
+                                         dot_fp8_avx2<F, 4>};
+    static const DotFn avx512[kMaxRows] = {dot_fp8_avx512<F, 1>, dot_fp8_avx512<F, 2>, dot_fp8_avx512<F, 3>,
+                                           dot_fp8_avx512<F, 4>};
+    if (llaisys::utils::cpuHasAvx512()) {
+        return avx512;
+    }
+    if (llaisys::utils::cpuHasAvx2() && llaisys::utils::cpuHasF16c()) {
+        return avx2;
+    }
+#endif
+    return scalar;
+}
+
+template <typename F, typename T>
+void linear_fp8_(T *out, const T *in, const uint8_t *qweight, const float *scales, const T *bias,
+                 size_t N, size_t K, size_t M, ptrdiff_t ld_in, ptrdiff_t ld_out) {
+    // 1. 激活一次性转为 float
+    std::vector<float> in_f(N * K);
+    for (size_t i = 0; i < N; i++) {
+        for (size_t k = 0; k < K; k++) {
+            in_f[i * K + k] = llaisys::utils::cast<float>(in[i * ld_in + k]);
+        }
+    }
+    const DotFn *kernels = select_kernels<F>();
+
+    // 2. 按输出通道并行；每行权重只读取一次，被批内所有输入行复用（每次最多 kMaxRows 行）
+    const ptrdiff_t m = static_cast<ptrdiff_t>(M);
+#pragma omp parallel for schedule(static)
+    for (ptrdiff_t j = 0; j < m; j++) {
+        const uint8_t *w = qweight + j * K;
+        const float scale = scales[j] * F::kRawScale;
+        const float b = bias ? llaisys::utils::cast<float>(bias[j]) : 0.0f;
+        float acc[kMaxRows];
+        for (size_t i = 0; i < N; i += kMaxRows) {
+            size_t nr = std::min(N - i, static_cast<size_t>(kMaxRows));
+            kernels[nr - 1](in_f.data() + i * K, K, w, K, acc);
+            for (size_t r = 0; r < nr; r++) {
+                out[(i + r) * ld_out + j] = llaisys::utils::cast<T>(acc[r] * scale + b);
+            }
+        }
+    }
+}
+
+template <typename F>
+void linear_fp8_dispatch(std::byte *out, const std::byte *in, const uint8_t *w, const float *s,
+                         const std::byte *bias, llaisysDataType_t type, size_t N, size_t K, size_t M,
+                         ptrdiff_t ld_in, ptrdiff_t ld_out) {
+    switch (type) {
+    case LLAISYS_DTYPE_F32:
+        return linear_fp8_<F>(reinterpret_cast<float *>(out), reinterpret_cast<const float *>(in), w, s,
+                              reinterpret_cast<const float *>(bias), N, K, M, ld_in, ld_out);
+    case LLAISYS_DTYPE_BF16:
+        return linear_fp8_<F>(reinterpret_cast<llaisys::bf16_t *>(out), reinterpret_cast<const llaisys::bf16_t *>(in),
+                              w, s, reinterpret_cast<const llaisys::bf16_t *>(bias), N, K, M, ld_in, ld_out);
+    case LLAISYS_DTYPE_F16:
+        return linear_fp8_<F>(reinterpret_cast<llaisys::fp16_t *>(out), reinterpret_cast<const llaisys::fp16_t *>(in),
+                              w, s, reinterpret_cast<const llaisys::fp16_t *>(bias), N, K, M, ld_in, ld_out);
+    default:
+        EXCEPTION_UNSUPPORTED_DATATYPE(type);
+    }
+}
+} // namespace
+
+namespace llaisys::ops::cpu {
+void linear_fp8(std::byte *out, const std::byte *in, const std::byte *qweight, const std::byte *scales,
+                const std::byte *bias, llaisysDataType_t type, llaisysDataType_t qtype, size_t N, size_t K, size_t M,
+                ptrdiff_t ld_in, ptrdiff_t ld_out) {
+    auto w = reinterpret_cast<const uint8_t *>(qweight);
+    auto s = reinterpret_cast<const float *>(scales);
+    switch (qtype) {
+    case LLAISYS_DTYPE_F8:
+        return linear_fp8_dispatch<E4M3>(out, in, w, s, bias, type, N, K, M, ld_in, ld_out);
+    case LLAISYS_DTYPE_F8E5M2:
+        return linear_fp8_dispatch<E5M2>(out, in, w, s, bias, type, N, K, M, ld_in, ld_out);
+    default:
+        EXCEPTION_UNSUPPORTED_DATATYPE(qtype);
+    }
+}
+} // namespace llaisys::ops::cpu
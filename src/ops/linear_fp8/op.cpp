@@ -0,0 +1,66 @@
+#include "op.hpp"
+
+#include "../../core/llaisys_core.hpp"
+#include "../trace.hpp"
+#include "../../utils.hpp"
+
+#include "cpu/linear_fp8_cpu.hpp"
+
+namespace llaisys::ops {
+void linear_fp8(tensor_t out, tensor_t in, tensor_t qweight, tensor_t scales, tensor_t bias) {
+    LLAISYS_TRACE_OP("linear_fp8", out, in, qweight, scales, bias);
+    // 1. 设备一致性校验
+    CHECK_SAME_DEVICE(out, in, qweight, scales);
+    if (bias) {
+        CHECK_SAME_DEVICE(out, bias);
+    }
+
+    // 2. 形状校验：in [N, K]，qweight [M, K]，scales [M]，out [N, M]
+    CHECK_ARGUMENT(out->ndim() == 2 && in->ndim() == 2 && qweight->ndim() == 2,
+                   "LinearFP8: out/in/qweight must be 2D tensors");
+    const size_t N = in->shape()[0], K = in->shape()[1], M = qweight->shape()[0];
+    CHECK_ARGUMENT(qweight->shape()[1] == K, "LinearFP8: in second dim must match qweight second dim");
+    CHECK_ARGUMENT(out->shape()[0] == N && out->shape()[1] == M, "LinearFP8: out shape must be [N, out_features]");
+    CHECK_ARGUMENT(scales->ndim() == 1 && scales->shape()[0] == M, "LinearFP8: scales must be [out_features]");
+    if (bias) {
+        CHECK_ARGUMENT(bias->ndim() == 1 && bias->shape()[0] == M, "LinearFP8: bias must be [out_features]");
+    }
+
+    // 3. 类型校验：激活与输出同为浮点类型，权重为 fp8，缩放系数为 float32
+    CHECK_SAME_DTYPE(out->dtype(), in->dtype());
+    if (bias) {
+        CHECK_SAME_DTYPE(out->dtype(), bias->dtype());
+    }
+    CHECK_ARGUMENT(qweight->dtype() == LLAISYS_DTYPE_F8 || qweight->dtype() == LLAISYS_DTYPE_F8E5M2,
+                   "LinearFP8: qweight must be float8 (e4m3 or e5m2)");
+    CHECK_ARGUMENT(scales->dtype() == LLAISYS_DTYPE_F32, "LinearFP8: scales must be float32");
+
+    ASSERT(out->isRowStrided() && in->isRowStrided(), "LinearFP8: out/in rows must be contiguous.");
+    ASSERT(qweight->isContiguous() && scales->isContiguous()
+               && (!bias || bias->isContiguous()),
+           "LinearFP8: weight tensors must be contiguous.");
+
+    const std::byte *bias_data = bias ? bias->data() : nullptr;
+
+    // 4. CPU 快速路径
+    if (out->deviceType() == LLAISYS_DEVICE_CPU) {
+        return core::launch(cpu::linear_fp8, out->data(), in->data(), qweight->data(), scales->data(), bias_data,
+                            out->dtype(), qweight->dtype(), N, K, M, in->rowStride(), out->rowStride());
+    }
+
+    llaisys::core::context().setDevice(out->deviceType(), out->deviceId());
+
+    switch (out->deviceType()) {
+    case LLAISYS_DEVICE_CPU:
+        return core::launch(cpu::linear_fp8, out->data(), in->data(), qweight->data(), scales->data(), bias_data,
+                            out->dtype(), qweight->dtype(), N, K, M, in->rowStride(), out->rowStride());
+#ifdef ENABLE_NVIDIA_API
+    case LLAISYS_DEVICE_NVIDIA:
+        TO_BE_IMPLEMENTED();
+        return;
+#endif
+    default:
+        EXCEPTION_UNSUPPORTED_DEVICE;
+    }
+}
+} // namespace llaisys::ops
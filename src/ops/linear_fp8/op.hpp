@@ -0,0 +1,9 @@
+#pragma once
+
+#include "../../tensor/tensor.hpp"
+
+namespace llaisys::ops {
+// fp8 权重的 linear：out = in * (qweight * scales[:, None])^T + bias，float32 累加
+// qweight 为 fp8 E4M3 或 E5M2 [out_features, in_features]，scales 为 float32 [out_features]，bias 可为空
+void linear_fp8(tensor_t out, tensor_t in, tensor_t qweight, tensor_t scales, tensor_t bias);
+}
@@ -0,0 +1,212 @@
+// simd.hpp 须先于其他框架头文件包含
+#include "../../../utils/simd.hpp"
+
+#include "linear_q4_cpu.hpp"
+
+#include "../../../utils.hpp"
+
+#include <algorithm>
+#include <vector>
+
+namespace {
+// 一行 q4 权重的反量化参数与输入的分组和：
+// scales/zeros 为该行每组的缩放系数与零点（已转为 float），xsum[r * ngroup + g] 为第 r 行输入第 g 组元素之和
+struct GroupParams {
+    const float *scales;
+    const float *zeros;
+    const float *xsum;
+    size_t group_size;
+    size_t ngroup;
+};
+
+// 微内核：一行 q4 权重 w[K / 2] 与 NR 行 float 输入 x[r * ldx + k] 的点积，结果写入 acc[NR]。
+// 每 32 个元素为一块（16 字节）：第 i 字节低 4 位为元素 i、高 4 位为元素 i + 16。
+// sum_k x_k * (q_k - z) * s = s * sum_k x_k * q_k - z * s * sum_k x_k：
+// 组内只做 4-bit 整数到 float 的转换与 FMA，缩放系数每组乘一次，零点项由输入的分组和补偿。
+using DotFn = void (*)(const float *x, size_t ldx, const uint8_t *w, const GroupParams &p, float *acc);
+constexpr int kMaxRows = 4;
+
+template <int NR>
+void dot_q4_scalar(const float *x, size_t ldx, const uint8_t *w, const GroupParams &p, float *acc) {
+    float sum[NR] = {};
+    for (size_t g = 0; g < p.ngroup; g++) {
+        float gsum[NR] = {};
+        for (size_t base = g * p.group_size; base < (g + 1) * p.group_size; base += 32) {
+            const uint8_t *blk = w + base / 2;
+            for (size_t i = 0; i < 16; i++) {
+                const float w0 = static_cast<float>(blk[i] & 0x0F);
+                const float w1 = static_cast<float>(blk[i] >> 4);
+                for (int r = 0; r < NR; r++) {
+                    gsum[r] += x[r * ldx + base + i] * w0 + x[r * ldx + base + 16 + i] * w1;
+                }
+            }
+        }
+        for (int r = 0; r < NR; r++) {
+            sum[r] += p.scales[g] * (gsum[r] - p.zeros[g] * p.xsum[r * p.ngroup + g]);
+        }
+    }
+    for (int r = 0; r < NR; r++) {
+        acc[r] = sum[r];
+    }
+}
+
+#ifdef LLAISYS_X86_SIMD
+template <int NR>
+__attribute__((target("avx2,fma"))) void dot_q4_avx2(const float *x, size_t ldx, const uint8_t *w, const GroupParams &p, float *acc) {
+    __m256 total[NR];
+    float corr[NR] = {};
+    for (int r = 0; r < NR; r++) {
+        total[r] = _mm256_setzero_ps();
+    }
+    const __m128i mask = _mm_set1_epi8(0x0F);
+    for (size_t g = 0; g < p.ngroup; g++) {
+        __m256 gsum0[NR], gsum1[NR];
+        for (int r = 0; r < NR; r++) {
+            gsum0[r] = _mm256_setzero_ps();
+            gsum1[r] = _mm256_setzero_ps();
+        }
+        for (size_t base = g * p.group_size; base < (g + 1) * p.group_size; base += 32) {
+            // 解包 32 个 4-bit 权重：低 4 位为元素 0..15，高 4 位为元素 16..31
+            const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i *>(w + base / 2));
+            const __m128i lo = _mm_and_si128(bytes, mask);
+            const __m128i hi = _mm_and_si128(_mm_srli_epi16(bytes, 4), mask);
+            const __m256 w0 = _mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(lo));
+            const __m256 w1 = _mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(_mm_srli_si128(lo, 8)));
+            const __m256 w2 = _mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(hi));
+            const __m256 w3 = _mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(_mm_srli_si128(hi, 8)));
+            for (int r = 0; r < NR; r++) {
+                const float *xr = x + r * ldx + base;
+                gsum0[r] = _mm256_fmadd_ps(_mm256_loadu_ps(xr), w0, gsum0[r]);
+                gsum1[r] = _mm256_fmadd_ps(_mm256_loadu_ps(xr + 8), w1, gsum1[r]);
+                gsum0[r] = _mm256_fmadd_ps(_mm256_loadu_ps(xr + 16), w2, gsum0[r]);
+                gsum1[r] = _mm256_fmadd_ps(_mm256_loadu_ps(xr + 24), w3, gsum1[r]);
+            }
+        }
+        const __m256 scale = _mm256_set1_ps(p.scales[g]);
+        for (int r = 0; r < NR; r++) {
+            total[r] = _mm256_fmadd_ps(_mm256_add_ps(gsum0[r], gsum1[r]), scale, total[r]);
+            corr[r] += p.scales[g] * p.zeros[g] * p.xsum[r * p.ngroup + g];
+        }
+    }
+    for (int r = 0; r < NR; r++) {
+        acc[r] = llaisys::utils::hsumAvx2(total[r]) - corr[r];
+    }
+}
+
+template <int NR>
+__attribute__((target("avx512f,avx512bw"))) void dot_q4_avx512(const float *x, size_t ldx, const uint8_t *w, const GroupParams &p, float *acc) {
+    __m512 total[NR];
+    float corr[NR] = {};
+    for (int r = 0; r < NR; r++) {
+        total[r] = _mm512_setzero_ps();
+    }
+    const __m128i mask = _mm_set1_epi8(0x0F);
+    for (size_t g = 0; g < p.ngroup; g++) {
+        __m512 gsum0[NR], gsum1[NR];
+        for (int r = 0; r < NR; r++) {
+            gsum0[r] = _mm512_setzero_ps();
+            gsum1[r] = _mm512_setzero_ps();
+        }
+        for (size_t base = g * p.group_size; base < (g + 1) * p.group_size; base += 32) {
+            const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i *>(w + base / 2));
+            const __m512 w0 = _mm512_cvtepi32_ps(_mm512_cvtepu8_epi32(_mm_and_si128(bytes, mask)));
+            const __m512 w1 = _mm512_cvtepi32_ps(_mm512_cvtepu8_epi32(_mm_and_si128(_mm_srli_epi16(bytes, 4), mask)));
+            for (int r = 0; r < NR; r++) {
+                const float *xr = x + r * ldx + base;
+                gsum0[r] = _mm512_fmadd_ps(_mm512_loadu_ps(xr), w0, gsum0[r]);
+                gsum1[r] = _mm512_fmadd_ps(_mm512_loadu_ps(xr + 16), w1, gsum1[r]);
+            }
+        }
+        const __m512 scale = _mm512_set1_ps(p.scales[g]);
+        for (int r = 0; r < NR; r++) {
+            total[r] = _mm512_fmadd_ps(_mm512_add_ps(gsum0[r], gsum1[r]), scale, total[r]);
+            corr[r] += p.scales[g] * p.zeros[g] * p.xsum[r * p.ngroup + g];
+        }
+    }
+    for (int r = 0; r < NR; r++) {
+        acc[r] = _mm512_reduce_add_ps(total[r]) - corr[r];
+    }
+}
+#endif
+
+// 按 CPU 能力选择微内核，下标为行数 - 1
+const DotFn *select_kernels() {
+    static const DotFn scalar[kMaxRows] = {dot_q4_scalar<1>, dot_q4_scalar<2>, dot_q4_scalar<3>, dot_q4_scalar<4>};
+#ifdef LLAISYS_X86_SIMD
+    static const DotFn avx2[kMaxRows] = {dot_q4_avx2<1>, dot_q4_avx2<2>, dot_q4_avx2<3>, dot_q4_avx2<4>};
+    static const DotFn avx512[kMaxRows] = {dot_q4_avx512<1>, dot_q4_avx512<2>, dot_q4_avx512<3>, dot_q4_avx512<4>};
+    if (llaisys::utils::cpuHasAvx512()) {
+        return avx512;
+    }
+    if (llaisys::utils::cpuHasAvx2()) {
+        return avx2;
+    }
+#endif
+    return scalar;
+}
+
+template <typename T>
+void linear_q4_(T *out, const T *in, const uint8_t *qweight, const llaisys::fp16_t *scales, const uint8_t *zeros,
+                const T *bias, size_t N, size_t K, size_t M, size_t group_size, ptrdiff_t ld_in, ptrdiff_t ld_out) {
+    const size_t ngroup = K / group_size;
+
+    // 1. 激活一次性转为 float，并求每行每组的元素和（用于零点补偿）
+    std::vector<float> in_f(N * K), xsum(N * ngroup, 0.0f);
+    for (size_t i = 0; i < N; i++) {
+        for (size_t k = 0; k < K; k++) {
+            in_f[i * K + k] = llaisys::utils::cast<float>(in[i * ld_in + k]);
+            xsum[(i * K + k) / group_size] += in_f[i * K + k];
+        }
+    }
+    const DotFn *kernels = select_kernels();
+
+    // 2. 按输出通道并行；每行权重的缩放系数与零点先转为 float，
+    //    权重只读取一次，被批内所有输入行复用（每次最多 kMaxRows 行）
+    const ptrdiff_t m = static_cast<ptrdiff_t>(M);
+#pragma omp parallel
+    {
+        std::vector<float> row_scales(ngroup), row_zeros(ngroup);
+#pragma omp for schedule(static)
+        for (ptrdiff_t j = 0; j < m; j++) {
+            for (size_t g = 0; g < ngroup; g++) {
+                row_scales[g] = llaisys::utils::cast<float>(scales[j * ngroup + g]);
+                row_zeros[g] = zeros ? static_cast<float>(zeros[j * ngroup + g]) : 8.0f;
+            }
+            const uint8_t *w = qweight + j * (K / 2);
+            const float b = bias ? llaisys::utils::cast<float>(bias[j]) : 0.0f;
+            float acc[kMaxRows];
+            for (size_t i = 0; i < N; i += kMaxRows) {
+                size_t nr = std::min(N - i, static_cast<size_t>(kMaxRows));
+                const GroupParams params{row_scales.data(), row_zeros.data(), xsum.data() + i * ngroup, group_size, ngroup};
+                kernels[nr - 1](in_f.data() + i * K, K, w, params, acc);
+                for (size_t r = 0; r < nr; r++) {
+                    out[(i + r) * ld_out + j] = llaisys::utils::cast<T>(acc[r] + b);
+                }
+            }
+        }
+    }
+}
+} // namespace
+
+namespace llaisys::ops::cpu {
+void linear_q4(std::byte *out, const std::byte *in, const std::byte *qweight, const std::byte *scales,
+               const std::byte *zeros, const std::byte *bias, llaisysDataType_t type,
+               size_t N, size_t K, size_t M, size_t group_size, ptrdiff_t ld_in, ptrdiff_t ld_out) {
+    auto w = reinterpret_cast<const uint8_t *>(qweight);
+    auto s = reinterpret_cast<const fp16_t *>(scales);
+    auto z = reinterpret_cast<const uint8_t *>(zeros);
+    switch (type) {
+    case LLAISYS_DTYPE_F32:
+        return linear_q4_(reinterpret_cast<float *>(out), reinterpret_cast<const float *>(in), w, s, z,
+                          reinterpret_cast<const float *>(bias), N, K, M, group_size, ld_in, ld_out);
+    case LLAISYS_DTYPE_BF16:
+        return linear_q4_(reinterpret_cast<bf16_t *>(out), reinterpret_cast<const bf16_t *>(in), w, s, z,
+                          reinterpret_cast<const bf16_t *>(bias), N, K, M, group_size, ld_in, ld_out);
+    case LLAISYS_DTYPE_F16:
+        return linear_q4_(reinterpret_cast<fp16_t *>(out), reinterpret_cast<const fp16_t *>(in), w, s, z,
+                          reinterpret_cast<const fp16_t *>(bias), N, K, M, group_size, ld_in, ld_out);
+    default:
+        EXCEPTION_UNSUPPORTED_DATATYPE(type);
+    }
+}
+} // namespace llaisys::ops::cpu
@@ -0,0 +1,76 @@
+#include "op.hpp"
+
+#include "../../core/llaisys_core.hpp"
+#include "../trace.hpp"
+#include "../../utils.hpp"
+
+#include "cpu/linear_q4_cpu.hpp"
+
+namespace llaisys::ops {
+void linear_q4(tensor_t out, tensor_t in, tensor_t qweight, tensor_t scales, tensor_t zeros, tensor_t bias) {
+    LLAISYS_TRACE_OP("linear_q4", out, in, qweight, scales, zeros, bias);
+    // 1. 设备一致性校验
+    CHECK_SAME_DEVICE(out, in, qweight, scales);
+    if (zeros) {
+        CHECK_SAME_DEVICE(out, zeros);
+    }
+    if (bias) {
+        CHECK_SAME_DEVICE(out, bias);
+    }
+
+    // 2. 形状校验：in [N, K]，qweight [M, K / 2]，scales/zeros [M, K / group_size]，out [N, M]
+    CHECK_ARGUMENT(out->ndim() == 2 && in->ndim() == 2 && qweight->ndim() == 2 && scales->ndim() == 2,
+                   "LinearQ4: out/in/qweight/scales must be 2D tensors");
+    const size_t N = in->shape()[0], K = in->shape()[1], M = qweight->shape()[0];
+    CHECK_ARGUMENT(qweight->shape()[1] * 2 == K, "LinearQ4: qweight must be [out_features, in_features / 2]");
+    CHECK_ARGUMENT(out->shape()[0] == N && out->shape()[1] == M, "LinearQ4: out shape must be [N, out_features]");
+    CHECK_ARGUMENT(scales->shape()[0] == M && scales->shape()[1] > 0 && K % scales->shape()[1] == 0,
+                   "LinearQ4: scales must be [out_features, in_features / group_size]");
+    const size_t group_size = K / scales->shape()[1];
+    CHECK_ARGUMENT(group_size % 32 == 0, "LinearQ4: group_size must be a multiple of 32");
+    if (zeros) {
+        CHECK_SAME_SHAPE(zeros->shape(), scales->shape());
+    }
+    if (bias) {
+        CHECK_ARGUMENT(bias->ndim() == 1 && bias->shape()[0] == M, "LinearQ4: bias must be [out_features]");
+    }
+
+    // 3. 类型校验：激活与输出同为浮点类型，权重与零点为 uint8，缩放系数为 float16
+    CHECK_SAME_DTYPE(out->dtype(), in->dtype());
+    if (bias) {
+        CHECK_SAME_DTYPE(out->dtype(), bias->dtype());
+    }
+    CHECK_ARGUMENT(qweight->dtype() == LLAISYS_DTYPE_U8, "LinearQ4: qweight must be uint8");
+    CHECK_ARGUMENT(scales->dtype() == LLAISYS_DTYPE_F16, "LinearQ4: scales must be float16");
+    CHECK_ARGUMENT(!zeros || zeros->dtype() == LLAISYS_DTYPE_U8, "LinearQ4: zeros must be uint8");
+
+    ASSERT(out->isRowStrided() && in->isRowStrided(), "LinearQ4: out/in rows must be contiguous.");
+    ASSERT(qweight->isContiguous() && scales->isContiguous()
+               && (!zeros || zeros->isContiguous()) && (!bias || bias->isContiguous()),
+           "LinearQ4: weight tensors must be contiguous.");
+
+    const std::byte *zeros_data = zeros ? zeros->data() : nullptr;
+    const std::byte *bias_data = bias ? bias->data() : nullptr;
+
+    // 4. CPU 快速路径
+    if (out->deviceType() == LLAISYS_DEVICE_CPU) {
+        return core::launch(cpu::linear_q4, out->data(), in->data(), qweight->data(), scales->data(), zeros_data, bias_data,
+                            out->dtype(), N, K, M, group_size, in->rowStride(), out->rowStride());
+    }
+
+    llaisys::core::context().setDevice(out->deviceType(), out->deviceId());
+
+    switch (out->deviceType()) {
+    case LLAISYS_DEVICE_CPU:
+        return core::launch(cpu::linear_q4, out->data(), in->data(), qweight->data(), scales->data(), zeros_data, bias_data,
+                            out->dtype(), N, K, M, group_size, in->rowStride(), out->rowStride());
+#ifdef ENABLE_NVIDIA_API
+    case LLAISYS_DEVICE_NVIDIA:
+        TO_BE_IMPLEMENTED();
+        return;
+#endif
+    default:
+        EXCEPTION_UNSUPPORTED_DEVICE;
+    }
+}
+} // namespace llaisys::ops
@@ -0,0 +1,9 @@
+#pragma once
+
+#include "../../tensor/tensor.hpp"
+
+namespace llaisys::ops {
+// 4-bit 分组量化的 linear：out = in * dequant(qweight, scales, zeros)^T + bias
+// 权重布局见 quantize_q4；zeros 与 bias 可为空
+void linear_q4(tensor_t out, tensor_t in, tensor_t qweight, tensor_t scales, tensor_t zeros, tensor_t bias);
+}
@@ -0,0 +1,147 @@
+// simd.hpp 须先于其他框架头文件包含
+#include "../../../utils/simd.hpp"
+
+#include "linear_q8_cpu.hpp"
+
+#include "../../../utils.hpp"
+
+#include <algorithm>
+#include <vector>
+
+namespace {
+// 微内核：一行 int8 权重 w[K] 与 NR 行 float 输入 x[r * ldx + k] 的点积，结果写入 acc[NR]。
+// 权重在寄存器内反量化（int8 -> int32 -> float），缩放系数在外层统一乘上。
+using DotFn = void (*)(const float *x, size_t ldx, const int8_t *w, size_t K, float *acc);
+constexpr int kMaxRows = 4;
+
+template <int NR>
+void dot_q8_scalar(const float *x, size_t ldx, const int8_t *w, size_t K, float *acc) {
+    for (int r = 0; r < NR; r++) {
+        float sum = 0.0f;
+        for (size_t k = 0; k < K; k++) {
+            sum += x[r * ldx + k] * static_cast<float>(w[k]);
+        }
+        acc[r] = sum;
+    }
+}
+
+#ifdef LLAISYS_X86_SIMD
+template <int NR>
+__attribute__((target("avx2,fma"))) void dot_q8_avx2(const float *x, size_t ldx, const int8_t *w, size_t K, float *acc) {
+    // 每行两个累加器，隐藏 FMA 延迟
+    __m256 sum0[NR], sum1[NR];
+    for (int r = 0; r < NR; r++) {
+        sum0[r] = _mm256_setzero_ps();
+        sum1[r] = _mm256_setzero_ps();
+    }
+    size_t k = 0;
+    for (; k + 16 <= K; k += 16) {
+        __m256 w0 = _mm256_cvtepi32_ps(_mm256_cvtepi8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(w + k))));
+        __m256 w1 = _mm256_cvtepi32_ps(_mm256_cvtepi8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(w + k + 8))));
+        for (int r = 0; r < NR; r++) {
+            sum0[r] = _mm256_fmadd_ps(_mm256_loadu_ps(x + r * ldx + k), w0, sum0[r]);
+            sum1[r] = _mm256_fmadd_ps(_mm256_loadu_ps(x + r * ldx + k + 8), w1, sum1[r]);
+        }
+    }
+    for (int r = 0; r < NR; r++) {
+        float sum = llaisys::utils::hsumAvx2(_mm256_add_ps(sum0[r], sum1[r]));
+        for (size_t t = k; t < K; t++) {
+            sum += x[r * ldx + t] * static_cast<float>(w[t]);
+        }
+        acc[r] = sum;
+    }
+}
+
+template <int NR>
+__attribute__((target("avx512f,avx512bw"))) void dot_q8_avx512(const float *x, size_t ldx, const int8_t *w, size_t K, float *acc) {
+    __m512 sum0[NR], sum1[NR];
+    for (int r = 0; r < NR; r++) {
+        sum0[r] = _mm512_setzero_ps();
+        sum1[r] = _mm512_setzero_ps();
+    }
+    size_t k = 0;
+    for (; k + 32 <= K; k += 32) {
+        __m512 w0 = _mm512_cvtepi32_ps(_mm512_cvtepi8_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i *>(w + k))));
+        __m512 w1 = _mm512_cvtepi32_ps(_mm512_cvtepi8_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i *>(w + k + 16))));
+        for (int r = 0; r < NR; r++) {
+            sum0[r] = _mm512_fmadd_ps(_mm512_loadu_ps(x + r * ldx + k), w0, sum0[r]);
+            sum1[r] = _mm512_fmadd_ps(_mm512_loadu_ps(x + r * ldx + k + 16), w1, sum1[r]);
+        }
+    }
+    for (int r = 0; r < NR; r++) {
+        float sum = _mm512_reduce_add_ps(_mm512_add_ps(sum0[r], sum1[r]));
+        for (size_t t = k; t < K; t++) {
+            sum += x[r * ldx + t] * static_cast<float>(w[t]);
+        }
+        acc[r] = sum;
+    }
+}
+#endif
+
+// 按 CPU 能力选择微内核，下标为行数 - 1
+const DotFn *select_kernels() {
+    static const DotFn scalar[kMaxRows] = {dot_q8_scalar<1>, dot_q8_scalar<2>, dot_q8_scalar<3>, dot_q8_scalar<4>};
+#ifdef LLAISYS_X86_SIMD
+    static const DotFn avx2[kMaxRows] = {dot_q8_avx2<1>, dot_q8_avx2<2>, dot_q8_avx2<3>, dot_q8_avx2<4>};
+    static const DotFn avx512[kMaxRows] = {dot_q8_avx512<1>, dot_q8_avx512<2>, dot_q8_avx512<3>, dot_q8_avx512<4>};
+    if (llaisys::utils::cpuHasAvx512()) {
+        return avx512;
+    }
+    if (llaisys::utils::cpuHasAvx2()) {
+        return avx2;
+    }
+#endif
+    return scalar;
+}
+
+template <typename T>
+void linear_q8_(T *out, const T *in, const int8_t *qweight, const float *scales, const T *bias,
+                size_t N, size_t K, size_t M, ptrdiff_t ld_in, ptrdiff_t ld_out) {
+    // 1. 激活一次性转为 float
+    std::vector<float> in_f(N * K);
+    for (size_t i = 0; i < N; i++) {
+        for (size_t k = 0; k < K; k++) {
+            in_f[i * K + k] = llaisys::utils::cast<float>(in[i * ld_in + k]);
+        }
+    }
+    const DotFn *kernels = select_kernels();
+
+    // 2. 按输出通道并行；每行权重只读取一次，被批内所有输入行复用（每次最多 kMaxRows 行）
+    const ptrdiff_t m = static_cast<ptrdiff_t>(M);
+#pragma omp parallel for schedule(static)
+    for (ptrdiff_t j = 0; j < m; j++) {
+        const int8_t *w = qweight + j * K;
+        const float b = bias ? llaisys::utils::cast<float>(bias[j]) : 0.0f;
+        float acc[kMaxRows];
+        for (size_t i = 0; i < N; i += kMaxRows) {
+            size_t nr = std::min(N - i, static_cast<size_t>(kMaxRows));
+            kernels[nr - 1](in_f.data() + i * K, K, w, K, acc);
+            for (size_t r = 0; r < nr; r++) {
+                out[(i + r) * ld_out + j] = llaisys::utils::cast<T>(acc[r] * scales[j] + b);
+            }
+        }
+    }
+}
+} // namespace
+
+namespace llaisys::ops::cpu {
+void linear_q8(std::byte *out, const std::byte *in, const std::byte *qweight, const std::byte *scales,
+               const std::byte *bias, llaisysDataType_t type, size_t N, size_t K, size_t M,
+               ptrdiff_t ld_in, ptrdiff_t ld_out) {
+    auto w = reinterpret_cast<const int8_t *>(qweight);
+    auto s = reinterpret_cast<const float *>(scales);
+    switch (type) {
+    case LLAISYS_DTYPE_F32:
+        return linear_q8_(reinterpret_cast<float *>(out), reinterpret_cast<const float *>(in), w, s,
+                          reinterpret_cast<const float *>(bias), N, K, M, ld_in, ld_out);
+    case LLAISYS_DTYPE_BF16:
+        return linear_q8_(reinterpret_cast<bf16_t *>(out), reinterpret_cast<const bf16_t *>(in), w, s,
+                          reinterpret_cast<const bf16_t *>(bias), N, K, M, ld_in, ld_out);
+    case LLAISYS_DTYPE_F16:
+        return linear_q8_(reinterpret_cast<fp16_t *>(out), reinterpret_cast<const fp16_t *>(in), w, s,
+                          reinterpret_cast<const fp16_t *>(bias), N, K, M, ld_in, ld_out);
+    default:
+        EXCEPTION_UNSUPPORTED_DATATYPE(type);
+    }
+}
+} // namespace llaisys::ops::cpu
@@ -0,0 +1,10 @@
+#pragma once
+#include "llaisys.h"
+
+#include <cstddef>
+
+namespace llaisys::ops::cpu {
+void linear_q8(std::byte *out, const std::byte *in, const std::byte *qweight, const std::byte *scales,
+               const std::byte *bias, llaisysDataType_t type, size_t N, size_t K, size_t M,
+               ptrdiff_t ld_in, ptrdiff_t ld_out);
+}
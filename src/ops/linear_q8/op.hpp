@@ -0,0 +1,9 @@
+#pragma once
+
+#include "../../tensor/tensor.hpp"
+
+namespace llaisys::ops {
+// int8 仅权重量化的 linear：out = in * (qweight * scales[:, None])^T + bias
+// qweight 为 int8 [out_features, in_features]，scales 为 float32 [out_features]，bias 可为空
+void linear_q8(tensor_t out, tensor_t in, tensor_t qweight, tensor_t scales, tensor_t bias);
+}
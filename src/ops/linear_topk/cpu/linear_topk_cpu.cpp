@@ -0,0 +1,170 @@
+#include "linear_topk_cpu.hpp"
+
+#include "../../../utils.hpp"
+
+#include "../../linear/cpu/linear_cpu.hpp"
+#include "../../linear_fp8/cpu/linear_fp8_cpu.hpp"
+#include "../../linear_q4/cpu/linear_q4_cpu.hpp"
+#include "../../linear_q8/cpu/linear_q8_cpu.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+namespace {
+// 每次投影的输出通道数：[N, kChunk] 的 logits 块常驻 L1/L2，读出后立即被选择消费
+constexpr size_t kChunk = 256;
+
+struct Candidate {
+    float val;
+    int64_t idx;
+};
+
+// 值大者优先，相等时下标小者优先（与 argmax 取第一个最大值一致）
+inline bool better(const Candidate &a, const Candidate &b) {
+    return a.val > b.val || (a.val == b.val && a.idx < b.idx);
+}
+
+// 每行保留至多 k 个候选，按 better 降序排列；k 很小，插入排序即可
+class TopK {
+public:
+    TopK(size_t nrow, size_t k) : _k(k), _size(nrow, 0), _cand(nrow * k) {}
+
+    void push(size_t row, Candidate c) {
+        Candidate *list = _cand.data() + row * _k;
+        size_t &n = _size[row];
+        if (n == _k && !better(c, list[n - 1])) {
+            return;
+        }
+        size_t pos = n < _k ? n++ : _k - 1;
+        while (pos > 0 && better(c, list[pos - 1])) {
+            list[pos] = list[pos - 1];
+            pos--;
+        }
+        list[pos] = c;
+    }
+
+    size_t size(size_t row) const { return _size[row]; }
+    const Candidate *row(size_t row) const { return _cand.data() + row * _k; }
+
+private:
+    size_t _k;
+    std::vector<size_t> _size;
+    std::vector<Candidate> _cand;
+};
+
+// 用 weight 的 [j0, j0 + mc) 行计算 out [N, mc]，各权重类型复用对应的 linear kernel
+void project(std::byte *out, const std::byte *in, const llaisys::ops::cpu::LinearWeight &w, llaisysDataType_t type,
+             size_t N, size_t K, size_t j0, size_t mc) {
+    using namespace llaisys::ops;
+    switch (w.wtype) {
+    case LLAISYS_DTYPE_I8:
+        return cpu::linear_q8(out, in, w.weight + j0 * K, w.scales + j0 * sizeof(float), nullptr, type, N, K, mc, K, mc);
+    case LLAISYS_DTYPE_U8: {
+        const size_t ngroup = K / w.group_size;
+        return cpu::linear_q4(out, in, w.weight + j0 * K / 2, w.scales + j0 * ngroup * sizeof(llaisys::fp16_t),
+                              w.zeros ? w.zeros + j0 * ngroup : nullptr, nullptr, type, N, K, mc, w.group_size, K,
+                              mc);
+    }
+    case LLAISYS_DTYPE_F8:
+    case LLAISYS_DTYPE_F8E5M2:
+        return cpu::linear_fp8(out, in, w.weight + j0 * K, w.scales + j0 * sizeof(float), nullptr, type, w.wtype, N,
+                               K, mc, K, mc);
+    default:
+        return cpu::linear(out, in, w.weight + j0 * K * llaisys::utils::dsize(type), nullptr, type, N, K, mc, K, mc);
+    }
+}
+
+// 把 [N, mc] 的 logits 块（行距 ld）并入 top-k。B 为块的存储类型，先舍入到激活类型 T，
+// 与非融合路径写出的 T 类型 logits 逐位一致
+template <typename T, typename B>
+void scan(TopK &top, const B *vals, size_t ld, size_t N, size_t j0, size_t mc) {
+    for (size_t i = 0; i < N; i++) {
+        for (size_t j = 0; j < mc; j++) {
+            const float v = llaisys::utils::cast<float>(llaisys::utils::cast<T>(vals[i * ld + j]));
+            top.push(i, {v, static_cast<int64_t>(j0 + j)});
+        }
+    }
+}
+
+// 词表按 kChunk 分块并行：每个线程把自己的块投影到线程私有的小缓冲区，只保留局部 top-k，
+// 块内的 linear kernel 处于并行区域中，按单线程执行。x 为 xtype 类型的输入，块按 B 类型计算
+template <typename T, typename B>
+void select_chunks(TopK &global, const std::byte *x, llaisysDataType_t xtype,
+                   const llaisys::ops::cpu::LinearWeight &w, size_t N, size_t K, size_t M, size_t k) {
+    const ptrdiff_t nchunk = static_cast<ptrdiff_t>((M + kChunk - 1) / kChunk);
+#pragma omp parallel
+    {
+        TopK local(N, k);
+        std::vector<B> buf(N * kChunk);
+#pragma omp for schedule(static)
+        for (ptrdiff_t c = 0; c < nchunk; c++) {
+            const size_t j0 = c * kChunk;
+            const size_t mc = std::min(kChunk, M - j0);
+            project(reinterpret_cast<std::byte *>(buf.data()), x, w, xtype, N, K, j0, mc);
+            scan<T>(local, buf.data(), mc, N, j0, mc);
+        }
+        // 跨线程归约：better 是全序，合并结果与线程划分无关
+#pragma omp critical
+        for (size_t i = 0; i < N; i++) {
+            for (size_t t = 0; t < local.size(i); t++) {
+                global.push(i, local.row(i)[t]);
+            }
+        }
+    }
+}
+
+template <typename T>
+void linear_topk_(int64_t *out_idx, T *out_val, T *logits, const T *in, const llaisys::ops::cpu::LinearWeight &w,
+                  llaisysDataType_t type, size_t N, size_t K, size_t M, size_t k) {
+    TopK global(N, k);
+    if (logits) {
+        // 需要完整 logits 时整体投影一次，再在其上选择
+        project(reinterpret_cast<std::byte *>(logits), reinterpret_cast<const std::byte *>(in), w, type, N, K, 0, M);
+        scan<T>(global, logits, M, N, 0, M);
+    } else if (w.wtype == type) {
+        // 浮点权重与激活同类型，按 T 计算
+        select_chunks<T, T>(global, reinterpret_cast<const std::byte *>(in), type, w, N, K, M, k);
+    } else {
+        // 量化权重的 kernel 以 float32 累加：激活只转换一次，各块按 float32 输入输出，
+        // 避免每块重复转换激活
+        std::vector<float> in_f(N * K);
+        for (size_t i = 0; i < N * K; i++) {
+            in_f[i] = llaisys::utils::cast<float>(in[i]);
+        }
+        select_chunks<T, float>(global, reinterpret_cast<const std::byte *>(in_f.data()), LLAISYS_DTYPE_F32, w, N, K,
+                                M, k);
+    }
+
+    for (size_t i = 0; i < N; i++) {
+        const Candidate *list = global.row(i);
+        for (size_t t = 0; t < k; t++) {
+            out_idx[i * k + t] = list[t].idx;
+            out_val[i * k + t] = llaisys::utils::cast<T>(list[t].val);
+        }
+    }
+}
+} // namespace
+
+namespace llaisys::ops::cpu {
+void linear_topk(std::byte *out_idx, std::byte *out_val, std::byte *logits, const std::byte *in,
+                 const LinearWeight &weight, llaisysDataType_t type, size_t N, size_t K, size_t M, size_t k) {
+    auto idx = reinterpret_cast<int64_t *>(out_idx);
+    switch (type) {
+    case LLAISYS_DTYPE_F32:
+        return linear_topk_(idx, reinterpret_cast<float *>(out_val), reinterpret_cast<float *>(logits),
+                            reinterpret_cast<const float *>(in), weight, type,
+                            N, K, M, k);
+    case LLAISYS_DTYPE_BF16:
+        return linear_topk_(idx, reinterpret_cast<bf16_t *>(out_val), reinterpret_cast<bf16_t *>(logits),
+                            reinterpret_cast<const bf16_t *>(in), weight, type,
+                            N, K, M, k);
+    case LLAISYS_DTYPE_F16:
+        return linear_topk_(idx, reinterpret_cast<fp16_t *>(out_val), reinterpret_cast<fp16_t *>(logits),
+                            reinterpret_cast<const fp16_t *>(in), weight, type,
+                            N, K, M, k);
+    default:
+        EXCEPTION_UNSUPPORTED_DATATYPE(type);
+    }
+}
+} // namespace llaisys::ops::cpu
@@ -0,0 +1,18 @@
+#pragma once
+#include "llaisys.h"
+
+#include <cstddef>
+
+namespace llaisys::ops::cpu {
+// lm_head 权重：wtype 决定调用的 linear kernel，scales / zeros / group_size 仅用于量化权重
+struct LinearWeight {
+    const std::byte *weight;
+    const std::byte *scales;
+    const std::byte *zeros;
+    llaisysDataType_t wtype;
+    size_t group_size;
+};
+
+void linear_topk(std::byte *out_idx, std::byte *out_val, std::byte *logits, const std::byte *in,
+                 const LinearWeight &weight, llaisysDataType_t type, size_t N, size_t K, size_t M, size_t k);
+} // namespace llaisys::ops::cpu
@@ -0,0 +1,92 @@
+#include "op.hpp"
+
+#include "../../core/llaisys_core.hpp"
+#include "../trace.hpp"
+#include "../../utils.hpp"
+
+#include "cpu/linear_topk_cpu.hpp"
+
+namespace llaisys::ops {
+void linear_topk(tensor_t out_idx, tensor_t out_val, tensor_t in, tensor_t weight, tensor_t scales, tensor_t zeros,
+                 tensor_t logits) {
+    LLAISYS_TRACE_OP("linear_topk", out_idx, out_val, in, weight, scales, zeros, logits);
+    // 1. 设备一致性校验
+    CHECK_SAME_DEVICE(out_idx, out_val, in, weight);
+    for (const auto &t : {scales, zeros, logits}) {
+        if (t) {
+            CHECK_SAME_DEVICE(in, t);
+        }
+    }
+
+    // 2. 形状与类型校验：in [N, K]，out_idx / out_val [N, k]，logits [N, M]
+    CHECK_ARGUMENT(in->ndim() == 2 && weight->ndim() == 2, "LinearTopK: in/weight must be 2D tensors");
+    const size_t N = in->shape()[0], K = in->shape()[1], M = weight->shape()[0];
+    CHECK_ARGUMENT(out_idx->ndim() == 2 && out_idx->shape()[0] == N && out_idx->dtype() == LLAISYS_DTYPE_I64,
+                   "LinearTopK: out_idx must be int64 [N, k]");
+    const size_t k = out_idx->shape()[1];
+    CHECK_ARGUMENT(k > 0 && k <= M, "LinearTopK: k must be in [1, out_features]");
+    CHECK_SAME_SHAPE(out_val->shape(), out_idx->shape());
+    CHECK_SAME_DTYPE(out_val->dtype(), in->dtype());
+    if (logits) {
+        CHECK_ARGUMENT(logits->ndim() == 2 && logits->shape()[0] == N && logits->shape()[1] == M,
+                       "LinearTopK: logits must be [N, out_features]");
+        CHECK_SAME_DTYPE(logits->dtype(), in->dtype());
+    }
+
+    // 3. 权重按 dtype 解释，量化参数的校验同对应的 linear 算子
+    cpu::LinearWeight w{weight->data(), scales ? scales->data() : nullptr, zeros ? zeros->data() : nullptr,
+                        weight->dtype(), 0};
+    switch (weight->dtype()) {
+    case LLAISYS_DTYPE_I8:
+    case LLAISYS_DTYPE_F8:
+    case LLAISYS_DTYPE_F8E5M2:
+        CHECK_ARGUMENT(weight->shape()[1] == K, "LinearTopK: in second dim must match weight second dim");
+        CHECK_ARGUMENT(scales && scales->ndim() == 1 && scales->shape()[0] == M
+                           && scales->dtype() == LLAISYS_DTYPE_F32,
+                       "LinearTopK: scales must be float32 [out_features]");
+        break;
+    case LLAISYS_DTYPE_U8:
+        CHECK_ARGUMENT(weight->shape()[1] * 2 == K, "LinearTopK: 4-bit weight must be [out_features, in_features / 2]");
+        CHECK_ARGUMENT(scales && scales->ndim() == 2 && scales->shape()[0] == M && scales->shape()[1] > 0
+                           && K % scales->shape()[1] == 0 && scales->dtype() == LLAISYS_DTYPE_F16,
+                       "LinearTopK: scales must be float16 [out_features, in_features / group_size]");
+        w.group_size = K / scales->shape()[1];
+        CHECK_ARGUMENT(w.group_size % 32 == 0, "LinearTopK: group_size must be a multiple of 32");
+        if (zeros) {
+            CHECK_SAME_SHAPE(zeros->shape(), scales->shape());
+            CHECK_ARGUMENT(zeros->dtype() == LLAISYS_DTYPE_U8, "LinearTopK: zeros must be uint8");
+        }
+        break;
+    default:
+        CHECK_ARGUMENT(weight->shape()[1] == K, "LinearTopK: in second dim must match weight second dim");
+        CHECK_SAME_DTYPE(weight->dtype(), in->dtype());
+        break;
+    }
+
+    ASSERT(out_idx->isContiguous() && out_val->isContiguous() && in->isContiguous() && weight->isContiguous()
+               && (!scales || scales->isContiguous()) && (!zeros || zeros->isContiguous())
+               && (!logits || logits->isContiguous()),
+           "LinearTopK: all tensors must be contiguous.");
+
+    std::byte *logits_data = logits ? logits->data() : nullptr;
+
+    // 4. CPU 快速路径
+    if (in->deviceType() == LLAISYS_DEVICE_CPU) {
+        return core::launch(cpu::linear_topk, out_idx->data(), out_val->data(), logits_data, in->data(), w, in->dtype(), N, K, M, k);
+    }
+
+    llaisys::core::context().setDevice(in->deviceType(), in->deviceId());
+
+    switch (in->deviceType()) {
+    case LLAISYS_DEVICE_CPU:
+        return core::launch(cpu::linear_topk, out_idx->data(), out_val->data(), logits_data, in->data(), w, in->dtype(), N, K, M, k);
+#ifdef ENABLE_NVIDIA_API
+    case LLAISYS_DEVICE_NVIDIA:
+        TO_BE_IMPLEMENTED();
+        return;
+#endif
+    default:
+        EXCEPTION_UNSUPPORTED_DEVICE;
+    }
+}
+} // namespace llaisys::ops
@@ -0,0 +1,13 @@
+#pragma once
+
+#include "../../tensor/tensor.hpp"
+
+namespace llaisys::ops {
+// 融合 lm_head 投影与选择：对 in [N, K] * weight^T 的每一行输出值最大的 k 个位置，
+// 按值降序（相等时下标小者优先）写入 out_idx（int64 [N, k]）与 out_val（[N, k]，同 in 的类型），k = 1 即 argmax。
+// weight 按 dtype 解释：与 in 同类型的浮点权重、int8（scales 为 float32 [M]）、
+// 4-bit（uint8 [M, K / 2]，scales / zeros 见 linear_q4）或 fp8（scales 为 float32 [M]）。
+// 词表分块计算，不写出完整 logits；logits 非空时才额外写出完整的 [N, M] logits
+void linear_topk(tensor_t out_idx, tensor_t out_val, tensor_t in, tensor_t weight, tensor_t scales, tensor_t zeros,
+                 tensor_t logits = nullptr);
+} // namespace llaisys::ops
@@ -0,0 +1,219 @@
+// simd.hpp 须先于其他框架头文件包含
+#include "../../../utils/simd.hpp"
+
+#include "linear_w8a8_cpu.hpp"
+
+#include "../../../utils.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+namespace {
+// vpdpbusd 要求一侧为无符号数：激活量化为 [-127, 127] 后加 128 存为 uint8，
+// 整数点积再减去 128 * sum(w) 还原为有符号点积。各 ISA 的内核都使用同一表示，结果逐位一致
+constexpr int32_t kActOffset = 128;
+// 量化后的激活行按 64 字节补齐，SIMD 内核读取激活时无需处理 K 的尾部
+constexpr size_t kRowAlign = 64;
+constexpr int kMaxRows = 4; // 每次处理的激活行数
+constexpr int kMaxCols = 4; // 每次处理的权重行（输出通道）数
+
+// 微内核：NR 行激活 x[r * ldx + k] 与 MC 行权重 w[c * K + k] 的 uint8 x int8 -> int32 点积，
+// 结果写入 acc[r * kMaxCols + c]。权重行不补齐，尾部由内核自行处理
+using GemmFn = void (*)(const uint8_t *x, size_t ldx, const int8_t *w, size_t K, int32_t *acc);
+
+struct GemmScalar {
+    template <int NR, int MC>
+    static void run(const uint8_t *x, size_t ldx, const int8_t *w, size_t K, int32_t *acc) {
+        for (int r = 0; r < NR; r++) {
+            for (int c = 0; c < MC; c++) {
+                int32_t sum = 0;
+                for (size_t k = 0; k < K; k++) {
+                    sum += static_cast<int32_t>(x[r * ldx + k]) * static_cast<int32_t>(w[c * K + k]);
+                }
+                acc[r * kMaxCols + c] = sum;
+            }
+        }
+    }
+};
+
+#ifdef LLAISYS_X86_SIMD
+struct GemmAvx2 {
+    // 扩展为 int16 后用 vpmaddwd 相邻两项相乘再相加，乘积不会饱和
+    template <int NR, int MC>
+    __attribute__((target("avx2"))) static void run(const uint8_t *x, size_t ldx, const int8_t *w, size_t K,
+                                                    int32_t *acc) {
+        __m256i sum[NR][MC];
+        for (int r = 0; r < NR; r++) {
+            for (int c = 0; c < MC; c++) {
+                sum[r][c] = _mm256_setzero_si256();
+            }
+        }
+        size_t k = 0;
+        for (; k + 16 <= K; k += 16) {
+            __m256i wv[MC];
+            for (int c = 0; c < MC; c++) {
+                wv[c] = _mm256_cvtepi8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i *>(w + c * K + k)));
+            }
+            for (int r = 0; r < NR; r++) {
+                __m256i xv = _mm256_cvtepu8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i *>(x + r * ldx + k)));
+                for (int c = 0; c < MC; c++) {
+                    sum[r][c] = _mm256_add_epi32(sum[r][c], _mm256_madd_epi16(xv, wv[c]));
+                }
+            }
+        }
+        for (int r = 0; r < NR; r++) {
+            for (int c = 0; c < MC; c++) {
+                __m128i s = _mm_add_epi32(_mm256_castsi256_si128(sum[r][c]), _mm256_extracti128_si256(sum[r][c], 1));
+                s = _mm_hadd_epi32(s, s);
+                s = _mm_hadd_epi32(s, s);
+                int32_t total = _mm_cvtsi128_si32(s);
+                for (size_t t = k; t < K; t++) {
+                    total += static_cast<int32_t>(x[r * ldx + t]) * static_cast<int32_t>(w[c * K + t]);
+                }
+                acc[r * kMaxCols + c] = total;
+            }
+        }
+    }
+};
+
+struct GemmVnni {
+    // 每条 vpdpbusd 完成 64 次 uint8 x int8 乘加；4 x 4 分块共 16 个累加器，权重与激活各复用 4 次
+    template <int NR, int MC>
+    __attribute__((target("avx512f,avx512bw,avx512vnni"))) static void run(const uint8_t *x, size_t ldx,
+                                                                            const int8_t *w, size_t K,
+                                                                            int32_t *acc) {
+        __m512i sum[NR][MC];
+        for (int r = 0; r < NR; r++) {
+            for (int c = 0; c < MC; c++) {
+                sum[r][c] = _mm512_setzero_si512();
+            }
+        }
+        for (size_t k = 0; k < K; k += 64) {
+            // 权重尾部用掩码读取并置零，补齐部分的激活不影响结果
+            const __mmask64 mask = K - k >= 64 ? ~__mmask64(0) : (__mmask64(1) << (K - k)) - 1;
+            __m512i wv[MC];
+            for (int c = 0; c < MC; c++) {
+                wv[c] = _mm512_maskz_loadu_epi8(mask, w + c * K + k);
+            }
+            for (int r = 0; r < NR; r++) {
+                __m512i xv = _mm512_loadu_si512(x + r * ldx + k);
+                for (int c = 0; c < MC; c++) {
+                    sum[r][c] = _mm512_dpbusd_epi32(sum[r][c], xv, wv[c]);
+                }
+            }
+        }
+        for (int r = 0; r < NR; r++) {
+            for (int c = 0; c < MC; c++) {
+                acc[r * kMaxCols + c] = _mm512_reduce_add_epi32(sum[r][c]);
+            }
+        }
+    }
+};
+#endif
+
+// 下标为 (行数 - 1) * kMaxCols + (输出通道数 - 1)
+template <typename Impl>
+const GemmFn *kernel_table() {
+    static const GemmFn table[kMaxRows * kMaxCols] = {
+        Impl::template run<1, 1>, Impl::template run<1, 2>, Impl::template run<1, 3>, Impl::template run<1, 4>,
+        Impl::template run<2, 1>, Impl::template run<2, 2>, Impl::template run<2, 3>, Impl::template run<2, 4>,
+        Impl::template run<3, 1>, Impl::template run<3, 2>, Impl::template run<3, 3>, Impl::template run<3, 4>,
+        Impl::template run<4, 1>, Impl::template run<4, 2>, Impl::template run<4, 3>, Impl::template run<4, 4>,
+    };
+    return table;
+}
+
+// 按 CPU 能力选择微内核
+const GemmFn *select_kernels() {
+#ifdef LLAISYS_X86_SIMD
+    if (llaisys::utils::cpuHasAvx512Vnni()) {
+        return kernel_table<GemmVnni>();
+    }
+    if (llaisys::utils::cpuHasAvx2()) {
+        return kernel_table<GemmAvx2>();
+    }
+#endif
+    return kernel_table<GemmScalar>();
+}
+
+template <typename T>
+void linear_w8a8_(T *out, const T *in, const int8_t *qweight, const float *scales, const T *bias,
+                  size_t N, size_t K, size_t M, ptrdiff_t ld_in, ptrdiff_t ld_out) {
+    // 1. 激活按 token 做对称量化：scale = absmax / 127
+    const size_t ldx = (K + kRowAlign - 1) / kRowAlign * kRowAlign;
+    std::vector<uint8_t> in_q(N * ldx, static_cast<uint8_t>(kActOffset));
+    std::vector<float> in_s(N);
+    const ptrdiff_t n = static_cast<ptrdiff_t>(N);
+#pragma omp parallel for schedule(static)
+    for (ptrdiff_t i = 0; i < n; i++) {
+        const T *x = in + i * ld_in;
+        float absmax = 0.0f;
+        for (size_t k = 0; k < K; k++) {
+            absmax = std::max(absmax, std::fabs(llaisys::utils::cast<float>(x[k])));
+        }
+        const float inv = absmax > 0.0f ? 127.0f / absmax : 0.0f;
+        in_s[i] = absmax / 127.0f;
+        uint8_t *q = in_q.data() + i * ldx;
+        for (size_t k = 0; k < K; k++) {
+            const float v = std::clamp(std::nearbyint(llaisys::utils::cast<float>(x[k]) * inv), -127.0f, 127.0f);
+            q[k] = static_cast<uint8_t>(static_cast<int32_t>(v) + kActOffset);
+        }
+    }
+    const GemmFn *kernels = select_kernels();
+
+    // 2. 每 kMaxCols 个输出通道一块并行：权重块常驻 L1，被所有激活行复用；
+    //    收尾时扣除激活偏移并乘回两侧缩放系数
+    const ptrdiff_t nblock = static_cast<ptrdiff_t>((M + kMaxCols - 1) / kMaxCols);
+#pragma omp parallel for schedule(static)
+    for (ptrdiff_t jb = 0; jb < nblock; jb++) {
+        const size_t j0 = jb * kMaxCols;
+        const size_t mc = std::min(M - j0, static_cast<size_t>(kMaxCols));
+        const int8_t *w = qweight + j0 * K;
+        int32_t offset[kMaxCols];
+        float b[kMaxCols];
+        for (size_t c = 0; c < mc; c++) {
+            int32_t wsum = 0;
+            for (size_t k = 0; k < K; k++) {
+                wsum += w[c * K + k];
+            }
+            offset[c] = kActOffset * wsum;
+            b[c] = bias ? llaisys::utils::cast<float>(bias[j0 + c]) : 0.0f;
+        }
+        int32_t acc[kMaxRows * kMaxCols];
+        for (size_t i = 0; i < N; i += kMaxRows) {
+            const size_t nr = std::min(N - i, static_cast<size_t>(kMaxRows));
+            kernels[(nr - 1) * kMaxCols + (mc - 1)](in_q.data() + i * ldx, ldx, w, K, acc);
+            for (size_t r = 0; r < nr; r++) {
+                for (size_t c = 0; c < mc; c++) {
+                    const float dot = static_cast<float>(acc[r * kMaxCols + c] - offset[c]);
+                    out[(i + r) * ld_out + j0 + c] = llaisys::utils::cast<T>(dot * (in_s[i + r] * scales[j0 + c]) + b[c]);
+                }
+            }
+        }
+    }
+}
+} // namespace
+
+namespace llaisys::ops::cpu {
+void linear_w8a8(std::byte *out, const std::byte *in, const std::byte *qweight, const std::byte *scales,
+                 const std::byte *bias, llaisysDataType_t type, size_t N, size_t K, size_t M,
+                 ptrdiff_t ld_in, ptrdiff_t ld_out) {
+    auto w = reinterpret_cast<const int8_t *>(qweight);
+    auto s = reinterpret_cast<const float *>(scales);
+    switch (type) {
+    case LLAISYS_DTYPE_F32:
+        return linear_w8a8_(reinterpret_cast<float *>(out), reinterpret_cast<const float *>(in), w, s,
+                            reinterpret_cast<const float *>(bias), N, K, M, ld_in, ld_out);
+    case LLAISYS_DTYPE_BF16:
+        return linear_w8a8_(reinterpret_cast<bf16_t *>(out), reinterpret_cast<const bf16_t *>(in), w, s,
+                            reinterpret_cast<const bf16_t *>(bias), N, K, M, ld_in, ld_out);
+    case LLAISYS_DTYPE_F16:
+        return linear_w8a8_(reinterpret_cast<fp16_t *>(out), reinterpret_cast<const fp16_t *>(in), w, s,
+                            reinterpret_cast<const fp16_t *>(bias), N, K, M, ld_in, ld_out);
+    default:
+        EXCEPTION_UNSUPPORTED_DATATYPE(type);
+    }
+}
+} // namespace llaisys::ops::cpu
@@ -0,0 +1,10 @@
+#pragma once
+
+#include "../../tensor/tensor.hpp"
+
+namespace llaisys::ops {
+// 动态量化激活的 int8 linear：权重格式与 linear_q8 相同（int8 [out_features, in_features] +
+// float32 [out_features] 缩放系数），激活按 token 动态量化为 int8，做 int8 x int8 -> int32 的整数 GEMM，
+// 在收尾阶段乘回两侧缩放系数并加 bias。适合计算密集的长 prefill，bias 可为空
+void linear_w8a8(tensor_t out, tensor_t in, tensor_t qweight, tensor_t scales, tensor_t bias);
+}
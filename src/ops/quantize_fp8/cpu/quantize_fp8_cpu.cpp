@@ -0,0 +1,70 @@
+#include "quantize_fp8_cpu.hpp"
+
+#include "../../../utils.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <type_traits>
+#include <vector>
+
+namespace {
+// fp8 的最大有限值：E4M3 为 448，E5M2 为 57344
+template <typename Q>
+constexpr float kFp8Max = std::is_same_v<Q, llaisys::fp8e4m3_t> ? 448.0f : 57344.0f;
+
+template <typename Q, typename T>
+void quantize_fp8_(Q *qweight, float *scales, const T *weight, size_t rows, size_t cols) {
+    const ptrdiff_t n = static_cast<ptrdiff_t>(rows);
+#pragma omp parallel
+    {
+        std::vector<float> row(cols);
+#pragma omp for schedule(static)
+        for (ptrdiff_t j = 0; j < n; j++) {
+            // 1. 该输出通道的最大绝对值映射到 fp8 的最大有限值
+            float absmax = 0.0f;
+            for (size_t k = 0; k < cols; k++) {
+                row[k] = llaisys::utils::cast<float>(weight[j * cols + k]);
+                absmax = std::max(absmax, std::fabs(row[k]));
+            }
+            const float scale = absmax / kFp8Max<Q>;
+            const float inv = absmax > 0.0f ? kFp8Max<Q> / absmax : 0.0f;
+            scales[j] = scale;
+
+            // 2. 缩放后就近舍入到 fp8，相对误差与数值大小无关，离群值附近的小权重也保有精度
+            for (size_t k = 0; k < cols; k++) {
+                qweight[j * cols + k] = llaisys::utils::cast<Q>(row[k] * inv);
+            }
+        }
+    }
+}
+
+template <typename Q>
+void quantize_fp8_dispatch(Q *qweight, float *scales, const std::byte *weight, llaisysDataType_t type, size_t rows,
+                           size_t cols) {
+    switch (type) {
+    case LLAISYS_DTYPE_F32:
+        return quantize_fp8_(qweight, scales, reinterpret_cast<const float *>(weight), rows, cols);
+    case LLAISYS_DTYPE_BF16:
+        return quantize_fp8_(qweight, scales, reinterpret_cast<const llaisys::bf16_t *>(weight), rows, cols);
+    case LLAISYS_DTYPE_F16:
+        return quantize_fp8_(qweight, scales, reinterpret_cast<const llaisys::fp16_t *>(weight), rows, cols);
+    default:
+        EXCEPTION_UNSUPPORTED_DATATYPE(type);
+    }
+}
+} // namespace
+
+namespace llaisys::ops::cpu {
+void quantize_fp8(std::byte *qweight, std::byte *scales, const std::byte *weight, llaisysDataType_t qtype,
+                  llaisysDataType_t type, size_t rows, size_t cols) {
+    auto s = reinterpret_cast<float *>(scales);
+    switch (qtype) {
+    case LLAISYS_DTYPE_F8:
+        return quantize_fp8_dispatch(reinterpret_cast<fp8e4m3_t *>(qweight), s, weight, type, rows, cols);
+    case LLAISYS_DTYPE_F8E5M2:
+        return quantize_fp8_dispatch(reinterpret_cast<fp8e5m2_t *>(qweight), s, weight, type, rows, cols);
+    default:
+        EXCEPTION_UNSUPPORTED_DATATYPE(qtype);
+    }
+}
+} // namespace llaisys::ops::cpu
@@ -0,0 +1,47 @@
+#include "op.hpp"
+
+#include "../../core/llaisys_core.hpp"
+#include "../trace.hpp"
+#include "../../utils.hpp"
+
+#include "cpu/quantize_fp8_cpu.hpp"
+
+namespace llaisys::ops {
+void quantize_fp8(tensor_t qweight, tensor_t scales, tensor_t weight) {
+    LLAISYS_TRACE_OP("quantize_fp8", qweight, scales, weight);
+    // 1. 设备、形状与类型校验
+    CHECK_SAME_DEVICE(qweight, scales, weight);
+    CHECK_ARGUMENT(weight->ndim() == 2, "QuantizeFP8: weight must be a 2D tensor");
+    CHECK_SAME_SHAPE(qweight->shape(), weight->shape());
+    CHECK_ARGUMENT(scales->ndim() == 1 && scales->shape()[0] == weight->shape()[0],
+                   "QuantizeFP8: scales must have one element per output channel");
+    CHECK_ARGUMENT(qweight->dtype() == LLAISYS_DTYPE_F8 || qweight->dtype() == LLAISYS_DTYPE_F8E5M2,
+                   "QuantizeFP8: qweight must be float8 (e4m3 or e5m2)");
+    CHECK_ARGUMENT(scales->dtype() == LLAISYS_DTYPE_F32, "QuantizeFP8: scales must be float32");
+    ASSERT(qweight->isContiguous() && scales->isContiguous() && weight->isContiguous(),
+           "QuantizeFP8: all tensors must be contiguous.");
+
+    const size_t rows = weight->shape()[0], cols = weight->shape()[1];
+
+    // 2. CPU 快速路径
+    if (weight->deviceType() == LLAISYS_DEVICE_CPU) {
+        return core::launch(cpu::quantize_fp8, qweight->data(), scales->data(), weight->data(), qweight->dtype(), weight->dtype(),
+                            rows, cols);
+    }
+
+    llaisys::core::context().setDevice(weight->deviceType(), weight->deviceId());
+
+    switch (weight->deviceType()) {
+    case LLAISYS_DEVICE_CPU:
+        return core::launch(cpu::quantize_fp8, qweight->data(), scales->data(), weight->data(), qweight->dtype(), weight->dtype(),
+                            rows, cols);
+#ifdef ENABLE_NVIDIA_API
+    case LLAISYS_DEVICE_NVIDIA:
+        TO_BE_IMPLEMENTED();
+        return;
+#endif
+    default:
+        EXCEPTION_UNSUPPORTED_DEVICE;
+    }
+}
+} // namespace llaisys::ops
@@ -0,0 +1,9 @@
+#pragma once
+
+#include "../../tensor/tensor.hpp"
+
+namespace llaisys::ops {
+// fp8 权重量化：weight [out_features, in_features] -> qweight（同形状，fp8 E4M3 或 E5M2），
+// scales 为 float32 [out_features]，每个输出通道一个缩放系数（absmax / fp8 最大有限值）
+void quantize_fp8(tensor_t qweight, tensor_t scales, tensor_t weight);
+}
@@ -0,0 +1,77 @@
+#include "quantize_kv_cpu.hpp"
+
+#include "../../../utils.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <type_traits>
+
+namespace {
+// 量化类型的取值上限：int8 取对称的 127，fp8 取最大有限值（E4M3 为 448，E5M2 为 57344）
+template <typename Q>
+constexpr float kQuantMax = 127.0f;
+template <>
+constexpr float kQuantMax<llaisys::fp8e4m3_t> = 448.0f;
+template <>
+constexpr float kQuantMax<llaisys::fp8e5m2_t> = 57344.0f;
+
+template <typename Q>
+Q quantize_value(float v) {
+    if constexpr (std::is_same_v<Q, int8_t>) {
+        return static_cast<int8_t>(std::clamp(std::nearbyint(v), -127.0f, 127.0f));
+    } else {
+        return llaisys::utils::cast<Q>(v);
+    }
+}
+
+template <typename Q, typename T>
+void quantize_kv_(Q *out, float *scales, const T *in, size_t nrow, size_t d) {
+    const ptrdiff_t n = static_cast<ptrdiff_t>(nrow);
+#pragma omp parallel for schedule(static)
+    for (ptrdiff_t r = 0; r < n; r++) {
+        const T *x = in + r * d;
+        float absmax = 0.0f;
+        for (size_t k = 0; k < d; k++) {
+            absmax = std::max(absmax, std::fabs(llaisys::utils::cast<float>(x[k])));
+        }
+        const float scale = absmax / kQuantMax<Q>;
+        const float inv = absmax > 0.0f ? kQuantMax<Q> / absmax : 0.0f;
+        scales[r] = scale;
+        for (size_t k = 0; k < d; k++) {
+            out[r * d + k] = quantize_value<Q>(llaisys::utils::cast<float>(x[k]) * inv);
+        }
+    }
+}
+
+template <typename Q>
+void quantize_kv_dispatch(Q *out, float *scales, const std::byte *in, llaisysDataType_t in_type, size_t nrow,
+                          size_t d) {
+    switch (in_type) {
+    case LLAISYS_DTYPE_F32:
+        return quantize_kv_(out, scales, reinterpret_cast<const float *>(in), nrow, d);
+    case LLAISYS_DTYPE_BF16:
+        return quantize_kv_(out, scales, reinterpret_cast<const llaisys::bf16_t *>(in), nrow, d);
+    case LLAISYS_DTYPE_F16:
+        return quantize_kv_(out, scales, reinterpret_cast<const llaisys::fp16_t *>(in), nrow, d);
+    default:
+        EXCEPTION_UNSUPPORTED_DATATYPE(in_type);
+    }
+}
+} // namespace
+
+namespace llaisys::ops::cpu {
+void quantize_kv(std::byte *out, std::byte *scales, const std::byte *in, llaisysDataType_t out_type,
+                 llaisysDataType_t in_type, size_t nrow, size_t d) {
+    auto s = reinterpret_cast<float *>(scales);
+    switch (out_type) {
+    case LLAISYS_DTYPE_I8:
+        return quantize_kv_dispatch(reinterpret_cast<int8_t *>(out), s, in, in_type, nrow, d);
+    case LLAISYS_DTYPE_F8:
+        return quantize_kv_dispatch(reinterpret_cast<fp8e4m3_t *>(out), s, in, in_type, nrow, d);
+    case LLAISYS_DTYPE_F8E5M2:
+        return quantize_kv_dispatch(reinterpret_cast<fp8e5m2_t *>(out), s, in, in_type, nrow, d);
+    default:
+        EXCEPTION_UNSUPPORTED_DATATYPE(out_type);
+    }
+}
+} // namespace llaisys::ops::cpu
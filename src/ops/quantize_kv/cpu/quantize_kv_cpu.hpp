@@ -0,0 +1,9 @@
+#pragma once
+#include "llaisys.h"
+
+#include <cstddef>
+
+namespace llaisys::ops::cpu {
+void quantize_kv(std::byte *out, std::byte *scales, const std::byte *in, llaisysDataType_t out_type,
+                 llaisysDataType_t in_type, size_t nrow, size_t d);
+}
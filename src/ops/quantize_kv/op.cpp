@@ -0,0 +1,46 @@
+#include "op.hpp"
+
+#include "../../core/llaisys_core.hpp"
+#include "../trace.hpp"
+#include "../../utils.hpp"
+
+#include "cpu/quantize_kv_cpu.hpp"
+
+namespace llaisys::ops {
+void quantize_kv(tensor_t out, tensor_t scales, tensor_t in) {
+    LLAISYS_TRACE_OP("quantize_kv", out, scales, in);
+    // 1. 设备、形状与类型校验
+    CHECK_SAME_DEVICE(out, scales, in);
+    CHECK_ARGUMENT(in->ndim() == 3, "QuantizeKV: in must be [ntoken, nhead, d]");
+    CHECK_SAME_SHAPE(out->shape(), in->shape());
+    CHECK_ARGUMENT(scales->ndim() == 2 && scales->shape()[0] == in->shape()[0] && scales->shape()[1] == in->shape()[1],
+                   "QuantizeKV: scales must be [ntoken, nhead]");
+    CHECK_ARGUMENT(out->dtype() == LLAISYS_DTYPE_I8 || out->dtype() == LLAISYS_DTYPE_F8
+                       || out->dtype() == LLAISYS_DTYPE_F8E5M2,
+                   "QuantizeKV: out must be int8 or float8");
+    CHECK_ARGUMENT(scales->dtype() == LLAISYS_DTYPE_F32, "QuantizeKV: scales must be float32");
+    ASSERT(out->isContiguous() && scales->isContiguous() && in->isContiguous(),
+           "QuantizeKV: all tensors must be contiguous.");
+
+    const size_t nrow = in->shape()[0] * in->shape()[1], d = in->shape()[2];
+
+    // 2. CPU 快速路径
+    if (out->deviceType() == LLAISYS_DEVICE_CPU) {
+        return core::launch(cpu::quantize_kv, out->data(), scales->data(), in->data(), out->dtype(), in->dtype(), nrow, d);
+    }
+
+    llaisys::core::context().setDevice(out->deviceType(), out->deviceId());
+
+    switch (out->deviceType()) {
+    case LLAISYS_DEVICE_CPU:
+        return core::launch(cpu::quantize_kv, out->data(), scales->data(), in->data(), out->dtype(), in->dtype(), nrow, d);
+#ifdef ENABLE_NVIDIA_API
+    case LLAISYS_DEVICE_NVIDIA:
+        TO_BE_IMPLEMENTED();
+        return;
+#endif
+    default:
+        EXCEPTION_UNSUPPORTED_DEVICE;
+    }
+}
+} // namespace llaisys::ops
@@ -0,0 +1,9 @@
+#pragma once
+
+#include "../../tensor/tensor.hpp"
+
+namespace llaisys::ops {
+// 把 K/V [ntoken, nhead, d] 量化后写入 KV Cache：out 为 int8、fp8 E4M3（LLAISYS_DTYPE_F8）或 E5M2（LLAISYS_DTYPE_F8E5M2），
+// scales 为 float32 [ntoken, nhead]，每个 token 的每个 head 一个缩放系数（absmax / 量化上限）
+void quantize_kv(tensor_t out, tensor_t scales, tensor_t in);
+}
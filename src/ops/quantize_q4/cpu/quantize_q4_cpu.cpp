@@ -0,0 +1,76 @@
+#include "quantize_q4_cpu.hpp"
+
+#include "../../../utils.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+template <typename T>
+void quantize_q4_(uint8_t *qweight, llaisys::fp16_t *scales, uint8_t *zeros, const T *weight,
+                  size_t rows, size_t cols, size_t group_size) {
+    const size_t ngroup = cols / group_size;
+    const ptrdiff_t n = static_cast<ptrdiff_t>(rows);
+#pragma omp parallel
+    {
+        std::vector<float> w(group_size);
+        std::vector<uint8_t> q(group_size);
+#pragma omp for schedule(static)
+        for (ptrdiff_t j = 0; j < n; j++) {
+            for (size_t g = 0; g < ngroup; g++) {
+                const size_t begin = j * cols + g * group_size;
+                // 取值范围包含 0，保证零点落在 [0, 15] 内
+                float lo = 0.0f, hi = 0.0f;
+                for (size_t k = 0; k < group_size; k++) {
+                    w[k] = llaisys::utils::cast<float>(weight[begin + k]);
+                    lo = std::min(lo, w[k]);
+                    hi = std::max(hi, w[k]);
+                }
+                const float absmax = std::max(-lo, hi);
+
+                // 1. 缩放系数先舍入到 float16，量化与反量化使用同一个值
+                //    对称：[-absmax, absmax] 映射到 [1, 15]，零点固定为 8；非对称：[min, max] 映射到 [0, 15]
+                float scale = zeros ? (hi - lo) / 15.0f : absmax / 7.0f;
+                llaisys::fp16_t scale_h = llaisys::utils::cast<llaisys::fp16_t>(scale);
+                scale = llaisys::utils::cast<float>(scale_h);
+                const float inv = scale > 0.0f ? 1.0f / scale : 0.0f;
+                float zero = 8.0f;
+                if (zeros) {
+                    zero = std::clamp(std::nearbyint(-lo * inv), 0.0f, 15.0f);
+                    zeros[j * ngroup + g] = static_cast<uint8_t>(zero);
+                }
+                scales[j * ngroup + g] = scale_h;
+
+                // 2. 量化并按 32 元素一块打包：低 4 位为前 16 个元素，高 4 位为后 16 个元素
+                for (size_t k = 0; k < group_size; k++) {
+                    q[k] = static_cast<uint8_t>(std::clamp(std::nearbyint(w[k] * inv) + zero, 0.0f, 15.0f));
+                }
+                uint8_t *out = qweight + begin / 2;
+                for (size_t b = 0; b < group_size; b += 32) {
+                    for (size_t i = 0; i < 16; i++) {
+                        out[b / 2 + i] = static_cast<uint8_t>(q[b + i] | (q[b + i + 16] << 4));
+                    }
+                }
+            }
+        }
+    }
+}
+
+namespace llaisys::ops::cpu {
+void quantize_q4(std::byte *qweight, std::byte *scales, std::byte *zeros, const std::byte *weight,
+                 llaisysDataType_t type, size_t rows, size_t cols, size_t group_size) {
+    auto q = reinterpret_cast<uint8_t *>(qweight);
+    auto s = reinterpret_cast<fp16_t *>(scales);
+    auto z = reinterpret_cast<uint8_t *>(zeros);
+    switch (type) {
+    case LLAISYS_DTYPE_F32:
+        return quantize_q4_(q, s, z, reinterpret_cast<const float *>(weight), rows, cols, group_size);
+    case LLAISYS_DTYPE_BF16:
+        return quantize_q4_(q, s, z, reinterpret_cast<const bf16_t *>(weight), rows, cols, group_size);
+    case LLAISYS_DTYPE_F16:
+        return quantize_q4_(q, s, z, reinterpret_cast<const fp16_t *>(weight), rows, cols, group_size);
+    default:
+        EXCEPTION_UNSUPPORTED_DATATYPE(type);
+    }
+}
+} // namespace llaisys::ops::cpu
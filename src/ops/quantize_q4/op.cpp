@@ -0,0 +1,59 @@
+#include "op.hpp"
+
+#include "../../core/llaisys_core.hpp"
+#include "../trace.hpp"
+#include "../../utils.hpp"
+
+#include "cpu/quantize_q4_cpu.hpp"
+
+namespace llaisys::ops {
+void quantize_q4(tensor_t qweight, tensor_t scales, tensor_t zeros, tensor_t weight) {
+    LLAISYS_TRACE_OP("quantize_q4", qweight, scales, zeros, weight);
+    // 1. 设备、形状与类型校验
+    CHECK_SAME_DEVICE(qweight, scales, weight);
+    if (zeros) {
+        CHECK_SAME_DEVICE(weight, zeros);
+    }
+    CHECK_ARGUMENT(weight->ndim() == 2 && qweight->ndim() == 2 && scales->ndim() == 2,
+                   "QuantizeQ4: weight/qweight/scales must be 2D tensors");
+    const size_t rows = weight->shape()[0], cols = weight->shape()[1];
+    CHECK_ARGUMENT(scales->shape()[0] == rows && scales->shape()[1] > 0 && cols % scales->shape()[1] == 0,
+                   "QuantizeQ4: scales must be [out_features, in_features / group_size]");
+    const size_t group_size = cols / scales->shape()[1];
+    CHECK_ARGUMENT(group_size % 32 == 0, "QuantizeQ4: group_size must be a multiple of 32");
+    CHECK_ARGUMENT(qweight->shape()[0] == rows && qweight->shape()[1] == cols / 2,
+                   "QuantizeQ4: qweight must be [out_features, in_features / 2]");
+    CHECK_ARGUMENT(qweight->dtype() == LLAISYS_DTYPE_U8, "QuantizeQ4: qweight must be uint8");
+    CHECK_ARGUMENT(scales->dtype() == LLAISYS_DTYPE_F16, "QuantizeQ4: scales must be float16");
+    if (zeros) {
+        CHECK_SAME_SHAPE(zeros->shape(), scales->shape());
+        CHECK_ARGUMENT(zeros->dtype() == LLAISYS_DTYPE_U8, "QuantizeQ4: zeros must be uint8");
+    }
+    ASSERT(qweight->isContiguous() && scales->isContiguous() && weight->isContiguous()
+               && (!zeros || zeros->isContiguous()),
+           "QuantizeQ4: all tensors must be contiguous.");
+
+    std::byte *zeros_data = zeros ? zeros->data() : nullptr;
+
+    // 2. CPU 快速路径
+    if (weight->deviceType() == LLAISYS_DEVICE_CPU) {
+        return core::launch(cpu::quantize_q4, qweight->data(), scales->data(), zeros_data, weight->data(), weight->dtype(),
+                            rows, cols, group_size);
+    }
+
+    llaisys::core::context().setDevice(weight->deviceType(), weight->deviceId());
+
+    switch (weight->deviceType()) {
+    case LLAISYS_DEVICE_CPU:
+        return core::launch(cpu::quantize_q4, qweight->data(), scales->data(), zeros_data, weight->data(), weight->dtype(),
+                            rows, cols, group_size);
+#ifdef ENABLE_NVIDIA_API
+    case LLAISYS_DEVICE_NVIDIA:
+        TO_BE_IMPLEMENTED();
+        return;
+#endif
+    default:
+        EXCEPTION_UNSUPPORTED_DEVICE;
+    }
+}
+} // namespace llaisys::ops
@@ -0,0 +1,14 @@
+#pragma once
+
+#include "../../tensor/tensor.hpp"
+
+namespace llaisys::ops {
+// 4-bit 分组量化：沿 in_features 每 group_size 个元素共享一个 float16 缩放系数（与可选的零点），
+// group_size = in_features / scales.shape[1]，须为 32 的倍数。
+//   qweight uint8 [out_features, in_features / 2]：每 32 个元素打包为 16 字节，
+//           第 i 字节低 4 位为第 i 个元素、高 4 位为第 i + 16 个元素
+//   scales  float16 [out_features, ngroup]
+//   zeros   uint8 [out_features, ngroup]，可为空：为空时对称量化（隐式零点 8），否则按组 min/max 非对称量化
+// 反量化：w = (q - zero) * scale
+void quantize_q4(tensor_t qweight, tensor_t scales, tensor_t zeros, tensor_t weight);
+}
@@ -0,0 +1,52 @@
+#include "quantize_q8_cpu.hpp"
+
+#include "../../../utils.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+template <typename T>
+void quantize_q8_(int8_t *qweight, float *scales, const T *weight, size_t rows, size_t cols) {
+    const ptrdiff_t n = static_cast<ptrdiff_t>(rows);
+#pragma omp parallel
+    {
+        std::vector<float> row(cols);
+#pragma omp for schedule(static)
+        for (ptrdiff_t j = 0; j < n; j++) {
+            // 1. 该输出通道的最大绝对值决定缩放系数
+            float absmax = 0.0f;
+            for (size_t k = 0; k < cols; k++) {
+                row[k] = llaisys::utils::cast<float>(weight[j * cols + k]);
+                absmax = std::max(absmax, std::fabs(row[k]));
+            }
+            float scale = absmax / 127.0f;
+            float inv = scale > 0.0f ? 1.0f / scale : 0.0f;
+            scales[j] = scale;
+
+            // 2. 对称量化到 [-127, 127]
+            for (size_t k = 0; k < cols; k++) {
+                float q = std::nearbyint(row[k] * inv);
+                qweight[j * cols + k] = static_cast<int8_t>(std::clamp(q, -127.0f, 127.0f));
+            }
+        }
+    }
+}
+
+namespace llaisys::ops::cpu {
+void quantize_q8(std::byte *qweight, std::byte *scales, const std::byte *weight,
+                 llaisysDataType_t type, size_t rows, size_t cols) {
+    auto q = reinterpret_cast<int8_t *>(qweight);
+    auto s = reinterpret_cast<float *>(scales);
+    switch (type) {
+    case LLAISYS_DTYPE_F32:
+        return quantize_q8_(q, s, reinterpret_cast<const float *>(weight), rows, cols);
+    case LLAISYS_DTYPE_BF16:
+        return quantize_q8_(q, s, reinterpret_cast<const llaisys::bf16_t *>(weight), rows, cols);
+    case LLAISYS_DTYPE_F16:
+        return quantize_q8_(q, s, reinterpret_cast<const llaisys::fp16_t *>(weight), rows, cols);
+    default:
+        EXCEPTION_UNSUPPORTED_DATATYPE(type);
+    }
+}
+} // namespace llaisys::ops::cpu
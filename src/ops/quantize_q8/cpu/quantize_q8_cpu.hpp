@@ -0,0 +1,9 @@
+#pragma once
+#include "llaisys.h"
+
+#include <cstddef>
+
+namespace llaisys::ops::cpu {
+void quantize_q8(std::byte *qweight, std::byte *scales, const std::byte *weight,
+                 llaisysDataType_t type, size_t rows, size_t cols);
+}
@@ -0,0 +1,8 @@
+#pragma once
+
+#include "../../tensor/tensor.hpp"
+
+namespace llaisys::ops {
+// 按输出通道对称量化：qweight[j, k] = round(weight[j, k] / scales[j])，scales[j] = max_k |weight[j, k]| / 127
+void quantize_q8(tensor_t qweight, tensor_t scales, tensor_t weight);
+}
@@ -5,43 +5,75 @@
 #include <cstring>
 
 namespace llaisys {
-// 辅助：逐元素复制（适配任意数据类型）
+// 辅助：递归遍历外层维度，最内层维度按步长逐元素复制；两侧都连续时整行 memcpy
 template <typename T>
-void copy_elementwise(T *out, const T *in, size_t total_elements) {
-    for (size_t idx = 0; idx < total_elements; ++idx) {
-        out[idx] = in[idx];
+void copy_strided(T *out, const T *in, const shape_t &shape, const strides_t &out_strides,
+                  const strides_t &in_strides, size_t dim) {
+    const size_t n = shape[dim];
+    const ptrdiff_t so = out_strides[dim], si = in_strides[dim];
+    if (dim + 1 == shape.size()) {
+        if (so == 1 && si == 1) {
+            std::memcpy(out, in, n * sizeof(T));
+            return;
+        }
+        for (size_t idx = 0; idx < n; ++idx) {
+            out[idx * so] = in[idx * si];
+        }
+        return;
+    }
+    for (size_t idx = 0; idx < n; ++idx) {
+        copy_strided(out + idx * so, in + idx * si, shape, out_strides, in_strides, dim + 1);
     }
 }
 } // namespace llaisys
 
 // 模板核心函数
 template <typename T>
-void rearrange_(std::byte *out, const std::byte *in, size_t total_elements) {
+void rearrange_(std::byte *out, const std::byte *in, const llaisys::shape_t &shape,
+                const llaisys::strides_t &out_strides, const llaisys::strides_t &in_strides) {
     const T *in_ptr = reinterpret_cast<const T*>(in);
     T *out_ptr = reinterpret_cast<T*>(out);
 
-    llaisys::copy_elementwise<T>(out_ptr, in_ptr, total_elements);
+    // 0 维张量只有一个元素
+    if (shape.size() == 0) {
+        *out_ptr = *in_ptr;
+        return;
+    }
+    llaisys::copy_strided<T>(out_ptr, in_ptr, shape, out_strides, in_strides, 0);
 }
 
 namespace llaisys::ops::cpu {
-void rearrange(std::byte *out, const std::byte *in,
-               llaisysDataType_t data_type, size_t total_elements, size_t elem_size) {
+void rearrange(std::byte *out, const std::byte *in, llaisysDataType_t data_type, const shape_t &shape,
+               const strides_t &out_strides, const strides_t &in_strides) {
     // 空值保护
-    if (total_elements == 0 || elem_size == 0) {
-        throw std::invalid_argument("Rearrange: total_elements/elem_size cannot be zero.");
+    if (out_strides.size() != shape.size() || in_strides.size() != shape.size()) {
+        throw std::invalid_argument("Rearrange: strides must match shape rank.");
+    }
+    for (size_t dim : shape) {
+        if (dim == 0) {
+            return;
+        }
     }
 
-    // 数据类型分发
+    // 数据类型分发：只做搬运，按元素字节数选择复制单位
     switch (data_type) {
     case LLAISYS_DTYPE_F32:
-        return rearrange_<float>(out, in, total_elements);
+    case LLAISYS_DTYPE_I32:
+        return rearrange_<uint32_t>(out, in, shape, out_strides, in_strides);
+    case LLAISYS_DTYPE_I64:
+        return rearrange_<uint64_t>(out, in, shape, out_strides, in_strides);
     case LLAISYS_DTYPE_F16:
-        return rearrange_<llaisys::fp16_t>(out, in, total_elements);
     case LLAISYS_DTYPE_BF16:
-        return rearrange_<llaisys::bf16_t>(out, in, total_elements);
+        return rearrange_<uint16_t>(out, in, shape, out_strides, in_strides);
+    case LLAISYS_DTYPE_I8:
+    case LLAISYS_DTYPE_U8:
+    case LLAISYS_DTYPE_F8:
+    case LLAISYS_DTYPE_F8E5M2:
+        // 单字节类型（量化 KV Cache）按字节复制
+        return rearrange_<uint8_t>(out, in, shape, out_strides, in_strides);
     default:
         std::string err_msg = "Rearrange: unsupported data type (" + std::to_string(static_cast<int>(data_type)) + ").";
         throw std::runtime_error(err_msg);
     }
 }
-} // namespace llaisys::ops::cpu
\ No newline at end of file
+} // namespace llaisys::ops::cpu
@@ -1,8 +1,10 @@
 #pragma once
 #include "llaisys.h"
+#include "../../../tensor/tensor.hpp"
 #include <cstddef>
 
 namespace llaisys::ops::cpu {
-void rearrange(std::byte *out, const std::byte *in,
-               llaisysDataType_t data_type, size_t total_elements, size_t elem_size);
-} // namespace llaisys::ops::cpu
\ No newline at end of file
+// 按各自的步长（元素数）把 in 复制到同形状的 out，两者均可为非连续视图
+void rearrange(std::byte *out, const std::byte *in, llaisysDataType_t data_type, const shape_t &shape,
+               const strides_t &out_strides, const strides_t &in_strides);
+} // namespace llaisys::ops::cpu
@@ -31,22 +31,23 @@ void rms_norm_row(T *out_row, const T *in_row, const T *weight, size_t hidden_di
 // 模板核心函数（通用模板，适配所有框架原生类型）
 template <typename T>
 void rms_norm_(std::byte *out, const std::byte *in, const std::byte *weight,
-               size_t batch_size, size_t hidden_dim, float eps) {
+               size_t batch_size, size_t hidden_dim, float eps, ptrdiff_t ld_out, ptrdiff_t ld_in) {
     const T *in_ptr = reinterpret_cast<const T*>(in);
     const T *weight_ptr = reinterpret_cast<const T*>(weight);
     T *out_ptr = reinterpret_cast<T*>(out);
 
-    // 遍历每一批，执行 RMS 归一化
+    // 遍历每一批，执行 RMS 归一化（行距可大于 hidden_dim）
     for (size_t i = 0; i < batch_size; ++i) {
-        const T *in_row = in_ptr + i * hidden_dim;
-        T *out_row = out_ptr + i * hidden_dim;
+        const T *in_row = in_ptr + i * ld_in;
+        T *out_row = out_ptr + i * ld_out;
         llaisys::rms_norm_row<T>(out_row, in_row, weight_ptr, hidden_dim, eps);
     }
 }
 
 namespace llaisys::ops::cpu {
 void rms_norm(std::byte *out, const std::byte *in, const std::byte *weight,
-              llaisysDataType_t data_type, size_t batch_size, size_t hidden_dim, float eps) {
+              llaisysDataType_t data_type, size_t batch_size, size_t hidden_dim, float eps,
+              ptrdiff_t ld_out, ptrdiff_t ld_in) {
     // 1. 空值保护
     if (batch_size == 0 || hidden_dim == 0) {
         throw std::invalid_argument("RMS Norm: batch_size/hidden_dim cannot be zero.");
@@ -55,11 +56,11 @@ void rms_norm(std::byte *out, const std::byte *in, const std::byte *weight,
     // 2. 数据类型分发（使用框架原生类型名 fp16_t/bf16_t，移除 Custom 前缀）
     switch (data_type) {
     case LLAISYS_DTYPE_F32:
-        return rms_norm_<float>(out, in, weight, batch_size, hidden_dim, eps);
+        return rms_norm_<float>(out, in, weight, batch_size, hidden_dim, eps, ld_out, ld_in);
     case LLAISYS_DTYPE_F16:
-        return rms_norm_<llaisys::fp16_t>(out, in, weight, batch_size, hidden_dim, eps); // 框架原生 F16 类型
+        return rms_norm_<llaisys::fp16_t>(out, in, weight, batch_size, hidden_dim, eps, ld_out, ld_in); // 框架原生 F16 类型
     case LLAISYS_DTYPE_BF16:
-        return rms_norm_<llaisys::bf16_t>(out, in, weight, batch_size, hidden_dim, eps); // 框架原生 BF16 类型
+        return rms_norm_<llaisys::bf16_t>(out, in, weight, batch_size, hidden_dim, eps, ld_out, ld_in); // 框架原生 BF16 类型
     default:
         std::string err_msg = "RMS Norm: unsupported data type (" + std::to_string(static_cast<int>(data_type)) + ").";
         throw std::runtime_error(err_msg);
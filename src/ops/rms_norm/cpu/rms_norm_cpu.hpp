@@ -4,5 +4,6 @@
 
 namespace llaisys::ops::cpu {
 void rms_norm(std::byte *out, const std::byte *in, const std::byte *weight,
-              llaisysDataType_t data_type, size_t batch_size, size_t hidden_dim, float eps);
+              llaisysDataType_t data_type, size_t batch_size, size_t hidden_dim, float eps,
+              ptrdiff_t ld_out, ptrdiff_t ld_in);
 } // namespace llaisys::ops::cpu
\ No newline at end of file
@@ -1,5 +1,6 @@
 #include "op.hpp"
 #include "../../core/llaisys_core.hpp"
+#include "../trace.hpp"
 #include "../../utils.hpp"
 #include "cpu/rms_norm_cpu.hpp"
 #include <string>
@@ -8,6 +9,7 @@
 
 namespace llaisys::ops {
 void rms_norm(tensor_t out, tensor_t in, tensor_t weight, float eps) {
+    LLAISYS_TRACE_OP("rms_norm", out, in, weight);
     // 1. 设备一致性校验
     auto out_device = out->deviceType();
     auto out_device_id = out->deviceId();
@@ -22,9 +24,9 @@ void rms_norm(tensor_t out, tensor_t in, tensor_t weight, float eps) {
     }
 
     // 2. 维度校验
-    std::vector<size_t> out_shape = out->shape();
-    std::vector<size_t> in_shape = in->shape();
-    std::vector<size_t> weight_shape = weight->shape();
+    const auto &out_shape = out->shape();
+    const auto &in_shape = in->shape();
+    const auto &weight_shape = weight->shape();
 
     if (out_shape.size() != 2 || in_shape.size() != 2) {
         throw std::invalid_argument("RMS Norm: out/in must be 2D tensors.");
@@ -50,15 +52,15 @@ void rms_norm(tensor_t out, tensor_t in, tensor_t weight, float eps) {
         throw std::invalid_argument("RMS Norm: all tensors must have the same data type.");
     }
 
-    // 5. 连续性校验
-    if (!out->isContiguous() || !in->isContiguous() || !weight->isContiguous()) {
-        throw std::invalid_argument("RMS Norm: all tensors must be contiguous.");
+    // 5. 布局校验：out/in 按行距访问，只要求行内连续
+    if (!out->isRowStrided() || !in->isRowStrided() || !weight->isContiguous()) {
+        throw std::invalid_argument("RMS Norm: rows of out/in and weight must be contiguous.");
     }
 
     // 6. CPU 快速路径
     if (out_device == LLAISYS_DEVICE_CPU) {
-        return cpu::rms_norm(out->data(), in->data(), weight->data(),
-                            dtype, batch_size, hidden_dim, eps);
+        return core::launch(cpu::rms_norm, out->data(), in->data(), weight->data(),
+                            dtype, batch_size, hidden_dim, eps, out->rowStride(), in->rowStride());
     }
 
     // 7. 非 CPU 设备
@@ -66,8 +68,8 @@ void rms_norm(tensor_t out, tensor_t in, tensor_t weight, float eps) {
 
     switch (out_device) {
     case LLAISYS_DEVICE_CPU:
-        return cpu::rms_norm(out->data(), in->data(), weight->data(),
-                            dtype, batch_size, hidden_dim, eps);
+        return core::launch(cpu::rms_norm, out->data(), in->data(), weight->data(),
+                            dtype, batch_size, hidden_dim, eps, out->rowStride(), in->rowStride());
 #ifdef ENABLE_NVIDIA_API
     case LLAISYS_DEVICE_NVIDIA:
         throw std::runtime_error("RMS Norm: NVIDIA device is not implemented yet.");
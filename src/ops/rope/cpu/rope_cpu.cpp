@@ -34,7 +34,8 @@ void rotate_vector(T *out_vec, const T *in_vec, size_t pos, size_t d, float thet
 // 模板核心函数
 template <typename T>
 void rope_(std::byte *out, const std::byte *in, const std::byte *pos_ids,
-           size_t seq_len, size_t n_head, size_t d, float theta) {
+           size_t seq_len, size_t n_head, size_t d, float theta,
+           ptrdiff_t out_row, ptrdiff_t out_head, ptrdiff_t in_row, ptrdiff_t in_head) {
     const T *in_ptr = reinterpret_cast<const T*>(in);
     T *out_ptr = reinterpret_cast<T*>(out);
     const int64_t *pos_ids_ptr = reinterpret_cast<const int64_t*>(pos_ids);
@@ -43,10 +44,9 @@ void rope_(std::byte *out, const std::byte *in, const std::byte *pos_ids,
     for (size_t seq_idx = 0; seq_idx < seq_len; ++seq_idx) {
         int64_t pos = pos_ids_ptr[seq_idx];
         for (size_t head_idx = 0; head_idx < n_head; ++head_idx) {
-            // 计算当前向量的起始索引
-            size_t vec_start = seq_idx * n_head * d + head_idx * d;
-            const T *in_vec = in_ptr + vec_start;
-            T *out_vec = out_ptr + vec_start;
+            // 按行距与头距定位当前向量（可为融合 QKV 缓冲区中的一段）
+            const T *in_vec = in_ptr + seq_idx * in_row + head_idx * in_head;
+            T *out_vec = out_ptr + seq_idx * out_row + head_idx * out_head;
             // 执行旋转
             llaisys::rotate_vector<T>(out_vec, in_vec, pos, d, theta);
         }
@@ -55,7 +55,8 @@ void rope_(std::byte *out, const std::byte *in, const std::byte *pos_ids,
 
 namespace llaisys::ops::cpu {
 void rope(std::byte *out, const std::byte *in, const std::byte *pos_ids,
-          llaisysDataType_t data_type, size_t seq_len, size_t n_head, size_t d, float theta) {
+          llaisysDataType_t data_type, size_t seq_len, size_t n_head, size_t d, float theta,
+          ptrdiff_t out_row, ptrdiff_t out_head, ptrdiff_t in_row, ptrdiff_t in_head) {
     // 空值保护
     if (seq_len == 0 || n_head == 0 || d == 0 || d % 2 != 0) {
         throw std::invalid_argument("RoPE: seq_len/n_head/d cannot be zero, and d must be even.");
@@ -64,11 +65,11 @@ void rope(std::byte *out, const std::byte *in, const std::byte *pos_ids,
     // 数据类型分发
     switch (data_type) {
     case LLAISYS_DTYPE_F32:
-        return rope_<float>(out, in, pos_ids, seq_len, n_head, d, theta);
+        return rope_<float>(out, in, pos_ids, seq_len, n_head, d, theta, out_row, out_head, in_row, in_head);
     case LLAISYS_DTYPE_F16:
-        return rope_<llaisys::fp16_t>(out, in, pos_ids, seq_len, n_head, d, theta);
+        return rope_<llaisys::fp16_t>(out, in, pos_ids, seq_len, n_head, d, theta, out_row, out_head, in_row, in_head);
     case LLAISYS_DTYPE_BF16:
-        return rope_<llaisys::bf16_t>(out, in, pos_ids, seq_len, n_head, d, theta);
+        return rope_<llaisys::bf16_t>(out, in, pos_ids, seq_len, n_head, d, theta, out_row, out_head, in_row, in_head);
     default:
         std::string err_msg = "RoPE: unsupported data type (" + std::to_string(static_cast<int>(data_type)) + ").";
         throw std::runtime_error(err_msg);
@@ -4,5 +4,6 @@
 
 namespace llaisys::ops::cpu {
 void rope(std::byte *out, const std::byte *in, const std::byte *pos_ids,
-          llaisysDataType_t data_type, size_t seq_len, size_t n_head, size_t d, float theta);
+          llaisysDataType_t data_type, size_t seq_len, size_t n_head, size_t d, float theta,
+          ptrdiff_t out_row, ptrdiff_t out_head, ptrdiff_t in_row, ptrdiff_t in_head);
 } // namespace llaisys::ops::cpu
\ No newline at end of file
@@ -1,5 +1,6 @@
 #include "op.hpp"
 #include "../../core/llaisys_core.hpp"
+#include "../trace.hpp"
 #include "../../utils.hpp"
 #include "cpu/rope_cpu.hpp"
 #include <string>
@@ -8,6 +9,7 @@
 
 namespace llaisys::ops {
 void rope(tensor_t out, tensor_t in, tensor_t pos_ids, float theta) {
+    LLAISYS_TRACE_OP("rope", out, in, pos_ids);
     // 1. 设备一致性校验（无修改）
     auto out_device = out->deviceType();
     auto out_device_id = out->deviceId();
@@ -22,9 +24,9 @@ void rope(tensor_t out, tensor_t in, tensor_t pos_ids, float theta) {
     }
 
     // 2. 维度校验（无修改）
-    std::vector<size_t> out_shape = out->shape();
-    std::vector<size_t> in_shape = in->shape();
-    std::vector<size_t> pos_ids_shape = pos_ids->shape();
+    const auto &out_shape = out->shape();
+    const auto &in_shape = in->shape();
+    const auto &pos_ids_shape = pos_ids->shape();
 
     if (out_shape.size() != 3 || in_shape.size() != 3 || pos_ids_shape.size() != 1) {
         throw std::invalid_argument("RoPE: out/in must be 3D tensors, pos_ids must be 1D tensor.");
@@ -55,15 +57,17 @@ void rope(tensor_t out, tensor_t in, tensor_t pos_ids, float theta) {
     // 注释：pos_ids 应为 Int64 整数类型（框架对应枚举可后续补充，当前不影响编译和核心功能）
     // 若运行时出现 pos_ids 类型错误，可在此处补充框架实际枚举名
 
-    // 5. 连续性校验（无修改）
-    if (!out->isContiguous() || !in->isContiguous() || !pos_ids->isContiguous()) {
-        throw std::invalid_argument("RoPE: all tensors must be contiguous.");
+    // 5. 布局校验：out/in 按 (seq, head) 步长访问，只要求每个头向量连续
+    if (out->strides()[2] != 1 || in->strides()[2] != 1 || !pos_ids->isContiguous()) {
+        throw std::invalid_argument("RoPE: head vectors and pos_ids must be contiguous.");
     }
+    const auto &so = out->strides();
+    const auto &si = in->strides();
 
     // 6. CPU 快速路径（无修改）
     if (out_device == LLAISYS_DEVICE_CPU) {
-        return cpu::rope(out->data(), in->data(), pos_ids->data(),
-                        dtype, seq_len, n_head, d, theta);
+        return core::launch(cpu::rope, out->data(), in->data(), pos_ids->data(),
+                            dtype, seq_len, n_head, d, theta, so[0], so[1], si[0], si[1]);
     }
 
     // 7. 非 CPU 设备（无修改）
@@ -71,8 +75,8 @@ void rope(tensor_t out, tensor_t in, tensor_t pos_ids, float theta) {
 
     switch (out_device) {
     case LLAISYS_DEVICE_CPU:
-        return cpu::rope(out->data(), in->data(), pos_ids->data(),
-                        dtype, seq_len, n_head, d, theta);
+        return core::launch(cpu::rope, out->data(), in->data(), pos_ids->data(),
+                            dtype, seq_len, n_head, d, theta, so[0], so[1], si[0], si[1]);
 #ifdef ENABLE_NVIDIA_API
     case LLAISYS_DEVICE_NVIDIA:
         throw std::runtime_error("RoPE: NVIDIA device is not implemented yet.");
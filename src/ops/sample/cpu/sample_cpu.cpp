@@ -0,0 +1,211 @@
+#include "sample_cpu.hpp"
+
+#include "../../../utils.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <numeric>
+#include <vector>
+
+namespace {
+// 只设置 top_p 时先在概率最高的 kTopPCandidates 个候选内寻找截断点，质量不足时再对整个词表排序
+constexpr size_t kTopPCandidates = 1024;
+
+// splitmix64：一个 uint64 即为发生器的全部状态
+uint64_t next_random(uint64_t &state) {
+    uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+// [0, 1) 上的均匀分布，取高 24 位
+float uniform(uint64_t &state) {
+    return static_cast<float>(next_random(state) >> 40) * (1.0f / 16777216.0f);
+}
+
+// 每个线程一份，跨行复用
+struct Scratch {
+    std::vector<float> x;      // 温度缩放后的 logits
+    std::vector<int32_t> idx;  // 候选下标，前 k 个按 logit 降序
+    std::vector<float> prob;   // 前 k 个候选未归一化的概率
+    std::vector<int64_t> ids;  // 去重后的惩罚 token
+};
+
+template <typename T>
+int64_t sample_row(T *row, size_t vocab, const LlaisysSamplingParams &p, uint64_t &state, const int64_t *hist,
+                   size_t nhist, Scratch &s) {
+    // 1. 重复惩罚（同 HuggingFace）：出现过的 token 正 logit 除以 penalty、负 logit 乘以 penalty，每个 token 只作用一次
+    if (p.repetition_penalty != 1.0f && nhist > 0) {
+        s.ids.assign(hist, hist + nhist);
+        std::sort(s.ids.begin(), s.ids.end());
+        s.ids.erase(std::unique(s.ids.begin(), s.ids.end()), s.ids.end());
+        for (int64_t id : s.ids) {
+            if (id >= 0 && static_cast<size_t>(id) < vocab) {
+                float v = llaisys::utils::cast<float>(row[id]);
+                row[id] = llaisys::utils::cast<T>(v > 0.0f ? v / p.repetition_penalty : v * p.repetition_penalty);
+            }
+        }
+    }
+
+    // 2. 贪心：取第一个最大值（与 argmax 算子一致），不消耗随机数
+    if (p.temperature <= 0.0f || p.top_k == 1) {
+        size_t best = 0;
+        float best_val = llaisys::utils::cast<float>(row[0]);
+        for (size_t i = 1; i < vocab; i++) {
+            float v = llaisys::utils::cast<float>(row[i]);
+            if (v > best_val) {
+                best_val = v;
+                best = i;
+            }
+        }
+        return static_cast<int64_t>(best);
+    }
+
+    // 3. 温度缩放，结果写回 logits，后续在 float 副本上计算
+    const float inv_t = 1.0f / p.temperature;
+    s.x.resize(vocab);
+    float *x = s.x.data();
+    float max_val = -INFINITY;
+    for (size_t i = 0; i < vocab; i++) {
+        x[i] = llaisys::utils::cast<float>(row[i]) * inv_t;
+        max_val = std::max(max_val, x[i]);
+    }
+    if (inv_t != 1.0f) {
+        for (size_t i = 0; i < vocab; i++) {
+            row[i] = llaisys::utils::cast<T>(x[i]);
+        }
+    }
+
+    // 4. 不截断：在整个词表上按 softmax 概率抽取
+    const bool use_top_k = p.top_k > 0 && p.top_k < vocab;
+    if (!use_top_k && p.top_p >= 1.0f) {
+        double total = 0.0;
+        for (size_t i = 0; i < vocab; i++) {
+            x[i] = std::exp(x[i] - max_val);
+            total += x[i];
+        }
+        const double target = uniform(state) * total;
+        double acc = 0.0;
+        for (size_t i = 0; i < vocab; i++) {
+            acc += x[i];
+            if (acc > target && x[i] > 0.0f) {
+                return static_cast<int64_t>(i);
+            }
+        }
+        return static_cast<int64_t>(std::max_element(x, x + vocab) - x);
+    }
+
+    // 5. 部分选择出 logit 最大的 k 个候选并降序排列（相等时下标小者优先）
+    auto greater = [x](int32_t a, int32_t b) { return x[a] > x[b] || (x[a] == x[b] && a < b); };
+    s.idx.resize(vocab);
+    std::iota(s.idx.begin(), s.idx.end(), 0);
+    auto select = [&](size_t k) {
+        if (k < vocab) {
+            std::nth_element(s.idx.begin(), s.idx.begin() + k, s.idx.end(), greater);
+        }
+        std::sort(s.idx.begin(), s.idx.begin() + k, greater);
+        s.prob.resize(k);
+        for (size_t j = 0; j < k; j++) {
+            s.prob[j] = std::exp(x[s.idx[j]] - max_val);
+        }
+    };
+    size_t k = use_top_k ? p.top_k : std::min(kTopPCandidates, vocab);
+    select(k);
+
+    // 6. 归一化常数：设置了 top_k 时只在前 k 个候选内归一化（先 top-k 后 top-p，同 HuggingFace），否则为整个词表
+    double total = 0.0;
+    if (use_top_k) {
+        for (size_t j = 0; j < k; j++) {
+            total += s.prob[j];
+        }
+    } else {
+        for (size_t i = 0; i < vocab; i++) {
+            total += std::exp(x[i] - max_val);
+        }
+    }
+
+    // 7. top-p：保留累计概率首次达到 top_p 的最短前缀（至少一个候选）
+    size_t n = k;
+    double kept = 0.0;
+    if (p.top_p < 1.0f) {
+        const double cutoff = p.top_p * total;
+        for (n = 0; n < k && (n == 0 || kept < cutoff); n++) {
+            kept += s.prob[n];
+        }
+        if (kept < cutoff && k < vocab && !use_top_k) {
+            k = vocab;
+            select(k);
+            kept = 0.0;
+            for (n = 0; n < k && (n == 0 || kept < cutoff); n++) {
+                kept += s.prob[n];
+            }
+        }
+    } else {
+        for (size_t j = 0; j < k; j++) {
+            kept += s.prob[j];
+        }
+    }
+
+    // 8. 在保留的候选中按概率抽取
+    const double target = uniform(state) * kept;
+    double acc = 0.0;
+    for (size_t j = 0; j < n; j++) {
+        acc += s.prob[j];
+        if (acc > target) {
+            return s.idx[j];
+        }
+    }
+    return s.idx[n - 1];
+}
+
+template <typename T>
+void sample_(int64_t *out_idx, T *logits, size_t batch, size_t vocab, const LlaisysSamplingParams *params,
+             uint64_t *rng_state, const int64_t *history, const int64_t *offsets) {
+    // 各行相互独立，按行并行；每行的词表扫描与排序代价相近，动态调度平衡不同的 top_k / top_p 设置
+    const ptrdiff_t n = static_cast<ptrdiff_t>(batch);
+#pragma omp parallel
+    {
+        Scratch s;
+#pragma omp for schedule(dynamic)
+        for (ptrdiff_t i = 0; i < n; i++) {
+            const int64_t *hist = history ? history + offsets[i] : nullptr;
+            const size_t nhist = history ? static_cast<size_t>(offsets[i + 1] - offsets[i]) : 0;
+            out_idx[i] = sample_row(logits + i * vocab, vocab, params[i], rng_state[i], hist, nhist, s);
+        }
+    }
+}
+} // namespace
+
+namespace llaisys::ops::cpu {
+void sample(std::byte *out_idx, std::byte *logits, llaisysDataType_t type, size_t batch, size_t vocab,
+            const LlaisysSamplingParams *params, std::byte *rng_state, const std::byte *history,
+            const std::byte *history_offsets, size_t nhistory) {
+    auto out = reinterpret_cast<int64_t *>(out_idx);
+    auto rng = reinterpret_cast<uint64_t *>(rng_state);
+    auto hist = reinterpret_cast<const int64_t *>(history);
+    auto offsets = reinterpret_cast<const int64_t *>(history_offsets);
+    for (size_t i = 0; i < batch; i++) {
+        CHECK_ARGUMENT(params[i].temperature <= 0.0f || std::isfinite(1.0f / params[i].temperature),
+                       "Sample: temperature is too small");
+        CHECK_ARGUMENT(params[i].top_p > 0.0f, "Sample: top_p must be positive");
+        CHECK_ARGUMENT(params[i].repetition_penalty > 0.0f, "Sample: repetition_penalty must be positive");
+        if (hist) {
+            CHECK_ARGUMENT(offsets[i] >= 0 && offsets[i] <= offsets[i + 1]
+                               && static_cast<size_t>(offsets[i + 1]) <= nhistory,
+                           "Sample: invalid history_offsets");
+        }
+    }
+    switch (type) {
+    case LLAISYS_DTYPE_F32:
+        return sample_(out, reinterpret_cast<float *>(logits), batch, vocab, params, rng, hist, offsets);
+    case LLAISYS_DTYPE_BF16:
+        return sample_(out, reinterpret_cast<bf16_t *>(logits), batch, vocab, params, rng, hist, offsets);
+    case LLAISYS_DTYPE_F16:
+        return sample_(out, reinterpret_cast<fp16_t *>(logits), batch, vocab, params, rng, hist, offsets);
+    default:
+        EXCEPTION_UNSUPPORTED_DATATYPE(type);
+    }
+}
+} // namespace llaisys::ops::cpu
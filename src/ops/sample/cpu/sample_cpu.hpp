@@ -0,0 +1,10 @@
+#pragma once
+#include "llaisys/ops.h"
+
+#include <cstddef>
+
+namespace llaisys::ops::cpu {
+void sample(std::byte *out_idx, std::byte *logits, llaisysDataType_t type, size_t batch, size_t vocab,
+            const LlaisysSamplingParams *params, std::byte *rng_state, const std::byte *history,
+            const std::byte *history_offsets, size_t nhistory);
+}
@@ -0,0 +1,74 @@
+#include "op.hpp"
+
+#include "../../core/llaisys_core.hpp"
+#include "../trace.hpp"
+#include "../../utils.hpp"
+
+#include "cpu/sample_cpu.hpp"
+
+#include <vector>
+
+namespace llaisys::ops {
+namespace {
+// 采样参数位于调用方的主机内存中，捕获时复制一份随命令保存
+std::function<void()> sampleOnCpu(tensor_t out_idx, tensor_t logits, size_t batch, size_t vocab,
+                                  const LlaisysSamplingParams *params, tensor_t rng_state,
+                                  const std::byte *hist, const std::byte *offsets, size_t nhist) {
+    return [out = out_idx->data(), in = logits->data(), dtype = logits->dtype(), batch, vocab,
+            p = std::vector<LlaisysSamplingParams>(params, params + batch), rng = rng_state->data(),
+            hist, offsets, nhist] {
+        cpu::sample(out, in, dtype, batch, vocab, p.data(), rng, hist, offsets, nhist);
+    };
+}
+} // namespace
+
+void sample(tensor_t out_idx, tensor_t logits, const LlaisysSamplingParams *params, tensor_t rng_state,
+            tensor_t history, tensor_t history_offsets) {
+    LLAISYS_TRACE_OP("sample", out_idx, logits, rng_state, history, history_offsets);
+    // 1. 设备、形状与类型校验
+    CHECK_SAME_DEVICE(out_idx, logits, rng_state);
+    CHECK_ARGUMENT(logits->ndim() == 2, "Sample: logits must be [batch, vocab]");
+    const size_t batch = logits->shape()[0], vocab = logits->shape()[1];
+    CHECK_ARGUMENT(vocab > 0, "Sample: empty vocabulary");
+    CHECK_ARGUMENT(params != nullptr, "Sample: params must not be null");
+    CHECK_ARGUMENT(out_idx->ndim() == 1 && out_idx->shape()[0] == batch && out_idx->dtype() == LLAISYS_DTYPE_I64,
+                   "Sample: out_idx must be int64 [batch]");
+    CHECK_ARGUMENT(rng_state->ndim() == 1 && rng_state->shape()[0] == batch && rng_state->dtype() == LLAISYS_DTYPE_U64,
+                   "Sample: rng_state must be uint64 [batch]");
+    CHECK_ARGUMENT((history == nullptr) == (history_offsets == nullptr),
+                   "Sample: history and history_offsets must be given together");
+    if (history) {
+        CHECK_SAME_DEVICE(logits, history, history_offsets);
+        CHECK_ARGUMENT(history->ndim() == 1 && history->dtype() == LLAISYS_DTYPE_I64, "Sample: history must be int64 1D");
+        CHECK_ARGUMENT(history_offsets->ndim() == 1 && history_offsets->shape()[0] == batch + 1
+                           && history_offsets->dtype() == LLAISYS_DTYPE_I64,
+                       "Sample: history_offsets must be int64 [batch + 1]");
+        ASSERT(history->isContiguous() && history_offsets->isContiguous(), "Sample: all tensors must be contiguous.");
+    }
+    ASSERT(out_idx->isContiguous() && logits->isContiguous() && rng_state->isContiguous(),
+           "Sample: all tensors must be contiguous.");
+
+    const std::byte *hist = history ? history->data() : nullptr;
+    const std::byte *offsets = history ? history_offsets->data() : nullptr;
+    const size_t nhist = history ? history->numel() : 0;
+
+    // 2. CPU 快速路径
+    if (logits->deviceType() == LLAISYS_DEVICE_CPU) {
+        return core::launch(sampleOnCpu(out_idx, logits, batch, vocab, params, rng_state, hist, offsets, nhist));
+    }
+
+    llaisys::core::context().setDevice(logits->deviceType(), logits->deviceId());
+
+    switch (logits->deviceType()) {
+    case LLAISYS_DEVICE_CPU:
+        return core::launch(sampleOnCpu(out_idx, logits, batch, vocab, params, rng_state, hist, offsets, nhist));
+#ifdef ENABLE_NVIDIA_API
+    case LLAISYS_DEVICE_NVIDIA:
+        TO_BE_IMPLEMENTED();
+        return;
+#endif
+    default:
+        EXCEPTION_UNSUPPORTED_DEVICE;
+    }
+}
+} // namespace llaisys::ops
@@ -0,0 +1,19 @@
+#pragma once
+
+#include "llaisys/ops.h"
+
+#include "../../tensor/tensor.hpp"
+
+namespace llaisys::ops {
+// 按行采样：logits [batch, vocab] 的每一行按 params[i] 依次做重复惩罚、温度缩放、top-k、top-p，
+// 再从剩余候选中抽取一个 token 写入 out_idx（int64 [batch]）。惩罚与温度原地作用于 logits。
+// rng_state 为 uint64 [batch]，每行一个独立的随机数发生器，结果与批内其他行无关；
+// history / history_offsets（int64，可为空）给出每行参与重复惩罚的 token
+void sample(tensor_t out_idx, tensor_t logits, const LlaisysSamplingParams *params, tensor_t rng_state,
+            tensor_t history = nullptr, tensor_t history_offsets = nullptr);
+
+// temperature <= 0 或 top_k == 1 且无重复惩罚时，采样退化为 argmax
+inline bool isGreedy(const LlaisysSamplingParams &params) {
+    return (params.temperature <= 0.0f || params.top_k == 1) && params.repetition_penalty == 1.0f;
+}
+} // namespace llaisys::ops
@@ -10,10 +10,11 @@
 namespace llaisys {
 
 // 辅助：将 K/V head 重复以匹配 Q head 数量 (GQA)
-// 输入: [total_len, nkvhead, d] -> 输出: [total_len, nhead, d]
+// 输入: [total_len, nkvhead, d]（按步长 s 访问）-> 输出: 连续的 [total_len, nhead, d]
 template <typename T>
 void repeat_kv_heads(T* expanded_kv, const T* kv,
-                     size_t total_len, size_t nkvhead, size_t d, size_t nhead) {
+                     size_t total_len, size_t nkvhead, size_t d, size_t nhead,
+                     const llaisys::ops::cpu::HeadStrides &s) {
     size_t heads_per_group = nhead / nkvhead;
     
     for (size_t t = 0; t < total_len; ++t) {
@@ -23,7 +24,7 @@ void repeat_kv_heads(T* expanded_kv, const T* kv,
                 // 复制当前 kv head 到 target_h
                 for (size_t k = 0; k < d; ++k) {
                     expanded_kv[t * nhead * d + target_h * d + k] = 
-                        kv[t * nkvhead * d + kv_h * d + k];
+                        kv[t * s.row + kv_h * s.head + k];
                 }
             }
         }
@@ -35,13 +36,14 @@ void repeat_kv_heads(T* expanded_kv, const T* kv,
 // 输出: [seqlen, nhead, total_len]
 template <typename T>
 void compute_qk_t(float *qk_t, const T *q, const T *k_expanded,
-                  size_t seqlen, size_t nhead, size_t d, size_t total_len) {
+                  size_t seqlen, size_t nhead, size_t d, size_t total_len,
+                  const llaisys::ops::cpu::HeadStrides &sq) {
     for (size_t i = 0; i < seqlen; ++i) {
         for (size_t h = 0; h < nhead; ++h) {
             for (size_t j = 0; j < total_len; ++j) {
                 float sum = 0.0f;
                 for (size_t k_idx = 0; k_idx < d; ++k_idx) {
-                    float q_val = llaisys::utils::cast<float>(q[i * nhead * d + h * d + k_idx]);
+                    float q_val = llaisys::utils::cast<float>(q[i * sq.row + h * sq.head + k_idx]);
                     float k_val = llaisys::utils::cast<float>(k_expanded[j * nhead * d + h * d + k_idx]);
                     sum += q_val * k_val;
                 }
@@ -97,7 +99,8 @@ void apply_causal_softmax(float *attn_weights, size_t seqlen, size_t nhead, size
 // 输出: [seqlen, nhead, dv]
 template <typename T>
 void compute_attn_v(T *attn_val, const float *attn_weights, const T *v_expanded,
-                    size_t seqlen, size_t nhead, size_t total_len, size_t dv) {
+                    size_t seqlen, size_t nhead, size_t total_len, size_t dv,
+                    const llaisys::ops::cpu::HeadStrides &so) {
     for (size_t i = 0; i < seqlen; ++i) {
         for (size_t h = 0; h < nhead; ++h) {
             for (size_t v_idx = 0; v_idx < dv; ++v_idx) {
@@ -109,7 +112,7 @@ void compute_attn_v(T *attn_val, const float *attn_weights, const T *v_expanded,
                         sum += weight * v_val;
                     }
                 }
-                attn_val[i * nhead * dv + h * dv + v_idx] = llaisys::utils::cast<T>(sum);
+                attn_val[i * so.row + h * so.head + v_idx] = llaisys::utils::cast<T>(sum);
             }
         }
     }
@@ -121,7 +124,8 @@ void compute_attn_v(T *attn_val, const float *attn_weights, const T *v_expanded,
 template <typename T>
 void self_attention_(std::byte *attn_val, const std::byte *q, const std::byte *k, const std::byte *v,
                      size_t seqlen, size_t nhead, size_t d,
-                     size_t total_len, size_t nkvhead, size_t dv, float scale) {
+                     size_t total_len, size_t nkvhead, size_t dv, float scale,
+                     const llaisys::ops::cpu::AttentionStrides &strides) {
     const T *q_ptr = reinterpret_cast<const T*>(q);
     const T *k_ptr = reinterpret_cast<const T*>(k);
     const T *v_ptr = reinterpret_cast<const T*>(v);
@@ -144,11 +148,11 @@ void self_attention_(std::byte *attn_val, const std::byte *q, const std::byte *k
     }
 
     // 1. 扩展 K 和 V head (GQA: repeat_interleave)
-    llaisys::repeat_kv_heads(k_expanded, k_ptr, total_len, nkvhead, d, nhead);
-    llaisys::repeat_kv_heads(v_expanded, v_ptr, total_len, nkvhead, dv, nhead);
+    llaisys::repeat_kv_heads(k_expanded, k_ptr, total_len, nkvhead, d, nhead, strides.k);
+    llaisys::repeat_kv_heads(v_expanded, v_ptr, total_len, nkvhead, dv, nhead, strides.v);
 
     // 2. 计算 QK^T
-    llaisys::compute_qk_t<T>(qk_t, q_ptr, k_expanded, seqlen, nhead, d, total_len);
+    llaisys::compute_qk_t<T>(qk_t, q_ptr, k_expanded, seqlen, nhead, d, total_len, strides.q);
     
     // 3. 应用缩放因子
     for (size_t idx = 0; idx < seqlen * nhead * total_len; ++idx) {
@@ -159,7 +163,7 @@ void self_attention_(std::byte *attn_val, const std::byte *q, const std::byte *k
     llaisys::apply_causal_softmax<T>(qk_t, seqlen, nhead, total_len);
 
     // 5. 计算注意力权重 × V
-    llaisys::compute_attn_v<T>(attn_val_ptr, qk_t, v_expanded, seqlen, nhead, total_len, dv);
+    llaisys::compute_attn_v<T>(attn_val_ptr, qk_t, v_expanded, seqlen, nhead, total_len, dv, strides.out);
 
     // 释放临时空间
     free(k_expanded);
@@ -170,7 +174,7 @@ void self_attention_(std::byte *attn_val, const std::byte *q, const std::byte *k
 namespace llaisys::ops::cpu {
 void self_attention(std::byte *attn_val, const std::byte *q, const std::byte *k, const std::byte *v,
                     llaisysDataType_t data_type, size_t seqlen, size_t nhead, size_t d,
-                    size_t total_len, size_t nkvhead, size_t dv, float scale) {
+                    size_t total_len, size_t nkvhead, size_t dv, float scale, const AttentionStrides &strides) {
     // 空值保护
     if (seqlen == 0 || nhead == 0 || d == 0 || total_len == 0 || nkvhead == 0 || dv == 0) {
         throw std::invalid_argument("Self-Attention: all dimensions must be non-zero.");
@@ -185,11 +189,11 @@ void self_attention(std::byte *attn_val, const std::byte *q, const std::byte *k,
     // 数据类型分发
     switch (data_type) {
     case LLAISYS_DTYPE_F32:
-        return self_attention_<float>(attn_val, q, k, v, seqlen, nhead, d, total_len, nkvhead, dv, scale);
+        return self_attention_<float>(attn_val, q, k, v, seqlen, nhead, d, total_len, nkvhead, dv, scale, strides);
     case LLAISYS_DTYPE_F16:
-        return self_attention_<llaisys::fp16_t>(attn_val, q, k, v, seqlen, nhead, d, total_len, nkvhead, dv, scale);
+        return self_attention_<llaisys::fp16_t>(attn_val, q, k, v, seqlen, nhead, d, total_len, nkvhead, dv, scale, strides);
     case LLAISYS_DTYPE_BF16:
-        return self_attention_<llaisys::bf16_t>(attn_val, q, k, v, seqlen, nhead, d, total_len, nkvhead, dv, scale);
+        return self_attention_<llaisys::bf16_t>(attn_val, q, k, v, seqlen, nhead, d, total_len, nkvhead, dv, scale, strides);
     default:
         std::string err_msg = "Self-Attention: unsupported data type (" + 
                              std::to_string(static_cast<int>(data_type)) + ").";
@@ -3,7 +3,25 @@
 #include <cstddef>
 
 namespace llaisys::ops::cpu {
+// [len, nhead, d] 张量的行距与头距（元素数），每个头向量须连续
+struct HeadStrides {
+    ptrdiff_t row;
+    ptrdiff_t head;
+};
+
+// 注意力各操作数的布局，q/k/v/out 可为整块缓冲区（KV Cache、融合 QKV）的切片；
+// k_scale/v_scale 为 [total_len, nkvhead]，仅量化 KV Cache 使用
+struct AttentionStrides {
+    HeadStrides out, q, k, v, k_scale, v_scale;
+};
+
 void self_attention(std::byte *attn_val, const std::byte *q, const std::byte *k, const std::byte *v,
                     llaisysDataType_t data_type, size_t seqlen, size_t nhead, size_t d,
-                    size_t total_len, size_t nkvhead, size_t dv, float scale);
+                    size_t total_len, size_t nkvhead, size_t dv, float scale, const AttentionStrides &strides);
+
+// k/v 为量化的 KV Cache（int8 或 fp8 E4M3），k_scale/v_scale 为 float32 [total_len, nkvhead]
+void self_attention_quant(std::byte *attn_val, const std::byte *q, const std::byte *k, const std::byte *k_scale,
+                          const std::byte *v, const std::byte *v_scale, llaisysDataType_t data_type,
+                          llaisysDataType_t kv_type, size_t seqlen, size_t nhead, size_t d, size_t total_len,
+                          size_t nkvhead, size_t dv, float scale, const AttentionStrides &strides);
 } // namespace llaisys::ops::cpu
\ No newline at end of file
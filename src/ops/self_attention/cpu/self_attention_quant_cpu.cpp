@@ -0,0 +1,209 @@
+// simd.hpp 须先于其他框架头文件包含
+#include "../../../utils/simd.hpp"
+
+#include "self_attention_cpu.hpp"
+
+#include "../../../utils.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+// 量化 KV Cache 的注意力：K/V 为 int8 或 fp8（E4M3 / E5M2），每个 (token, kv head) 一个 float32 缩放系数。
+// 不整体反量化缓存：逐行把 K/V 反量化到 L1 中的 float 缓冲区，并在 GQA 组内所有 q head 间复用；
+// 行缩放系数从点积中提出，打分乘 k_scale，加权求和时并入 softmax 概率
+namespace {
+using DotFn = float (*)(const float *a, const float *b, size_t n);
+using AxpyFn = void (*)(float *y, const float *x, float alpha, size_t n);
+
+float dot_scalar(const float *a, const float *b, size_t n) {
+    float sum = 0.0f;
+    for (size_t i = 0; i < n; i++) {
+        sum += a[i] * b[i];
+    }
+    return sum;
+}
+
+void axpy_scalar(float *y, const float *x, float alpha, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        y[i] += alpha * x[i];
+    }
+}
+
+#ifdef LLAISYS_X86_SIMD
+__attribute__((target("avx2,fma"))) float dot_avx2(const float *a, const float *b, size_t n) {
+    __m256 sum = _mm256_setzero_ps();
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        sum = _mm256_fmadd_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i), sum);
+    }
+    float total = llaisys::utils::hsumAvx2(sum);
+    for (; i < n; i++) {
+        total += a[i] * b[i];
+    }
+    return total;
+}
+
+__attribute__((target("avx2,fma"))) void axpy_avx2(float *y, const float *x, float alpha, size_t n) {
+    const __m256 va = _mm256_set1_ps(alpha);
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        _mm256_storeu_ps(y + i, _mm256_fmadd_ps(va, _mm256_loadu_ps(x + i), _mm256_loadu_ps(y + i)));
+    }
+    for (; i < n; i++) {
+        y[i] += alpha * x[i];
+    }
+}
+#endif
+
+// fp8 的 256 种取值查表反量化
+template <typename F8>
+const std::array<float, 256> &fp8_table() {
+    static const std::array<float, 256> table = [] {
+        std::array<float, 256> t{};
+        for (int i = 0; i < 256; i++) {
+            t[i] = llaisys::utils::cast<float>(F8{static_cast<uint8_t>(i)});
+        }
+        return t;
+    }();
+    return table;
+}
+
+void dequant_row(float *dst, const int8_t *src, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        dst[i] = static_cast<float>(src[i]);
+    }
+}
+
+template <typename F8>
+void dequant_row(float *dst, const F8 *src, size_t n) {
+    const auto &table = fp8_table<F8>();
+    for (size_t i = 0; i < n; i++) {
+        dst[i] = table[src[i]._v];
+    }
+}
+
+template <typename T, typename KV>
+void self_attention_quant_(T *out, const T *q, const KV *k, const float *k_scale, const KV *v, const float *v_scale,
+                           size_t seqlen, size_t nhead, size_t d, size_t total_len, size_t nkvhead, size_t dv,
+                           float scale, const llaisys::ops::cpu::AttentionStrides &st) {
+    DotFn dot = dot_scalar;
+    AxpyFn axpy = axpy_scalar;
+#ifdef LLAISYS_X86_SIMD
+    if (llaisys::utils::cpuHasAvx2()) {
+        dot = dot_avx2;
+        axpy = axpy_avx2;
+    }
+#endif
+    const size_t group = nhead / nkvhead;
+    const size_t kv_offset = total_len - seqlen; // query[i] 对应 kv[kv_offset + i]
+    const ptrdiff_t ntask = static_cast<ptrdiff_t>(seqlen * nkvhead);
+
+#pragma omp parallel
+    {
+        std::vector<float> qf(group * d), row(std::max(d, dv)), scores(group * total_len), acc(group * dv), inv(group);
+        // 因果掩码使各任务的 kv 长度不同，动态调度
+#pragma omp for schedule(dynamic)
+        for (ptrdiff_t task = 0; task < ntask; task++) {
+            const size_t i = task / nkvhead, kvh = task % nkvhead;
+            const size_t len = kv_offset + i + 1;
+            for (size_t g = 0; g < group; g++) {
+                const T *qh = q + i * st.q.row + (kvh * group + g) * st.q.head;
+                for (size_t t = 0; t < d; t++) {
+                    qf[g * d + t] = llaisys::utils::cast<float>(qh[t]) * scale;
+                }
+            }
+
+            // 1. 打分：每行 K 只反量化一次
+            for (size_t j = 0; j < len; j++) {
+                dequant_row(row.data(), k + j * st.k.row + kvh * st.k.head, d);
+                const float ks = k_scale[j * st.k_scale.row + kvh * st.k_scale.head];
+                for (size_t g = 0; g < group; g++) {
+                    scores[g * total_len + j] = dot(qf.data() + g * d, row.data(), d) * ks;
+                }
+            }
+
+            // 2. softmax，归一化系数留到加权求和时并入
+            for (size_t g = 0; g < group; g++) {
+                float *s = scores.data() + g * total_len;
+                float max_val = -std::numeric_limits<float>::infinity();
+                for (size_t j = 0; j < len; j++) {
+                    max_val = std::max(max_val, s[j]);
+                }
+                float sum = 0.0f;
+                for (size_t j = 0; j < len; j++) {
+                    s[j] = std::exp(s[j] - max_val);
+                    sum += s[j];
+                }
+                inv[g] = 1.0f / sum;
+            }
+
+            // 3. 加权求和：每行 V 只反量化一次
+            std::fill(acc.begin(), acc.end(), 0.0f);
+            for (size_t j = 0; j < len; j++) {
+                dequant_row(row.data(), v + j * st.v.row + kvh * st.v.head, dv);
+                const float vs = v_scale[j * st.v_scale.row + kvh * st.v_scale.head];
+                for (size_t g = 0; g < group; g++) {
+                    axpy(acc.data() + g * dv, row.data(), scores[g * total_len + j] * vs, dv);
+                }
+            }
+            for (size_t g = 0; g < group; g++) {
+                T *oh = out + i * st.out.row + (kvh * group + g) * st.out.head;
+                for (size_t t = 0; t < dv; t++) {
+                    oh[t] = llaisys::utils::cast<T>(acc[g * dv + t] * inv[g]);
+                }
+            }
+        }
+    }
+}
+
+template <typename T>
+void self_attention_quant_dispatch(std::byte *out, const std::byte *q, const std::byte *k, const std::byte *k_scale,
+                                   const std::byte *v, const std::byte *v_scale, llaisysDataType_t kv_type,
+                                   size_t seqlen, size_t nhead, size_t d, size_t total_len, size_t nkvhead,
+                                   size_t dv, float scale, const llaisys::ops::cpu::AttentionStrides &strides) {
+    auto o = reinterpret_cast<T *>(out);
+    auto qp = reinterpret_cast<const T *>(q);
+    auto ks = reinterpret_cast<const float *>(k_scale);
+    auto vs = reinterpret_cast<const float *>(v_scale);
+    switch (kv_type) {
+    case LLAISYS_DTYPE_I8:
+        return self_attention_quant_(o, qp, reinterpret_cast<const int8_t *>(k), ks,
+                                     reinterpret_cast<const int8_t *>(v), vs,
+                                     seqlen, nhead, d, total_len, nkvhead, dv, scale, strides);
+    case LLAISYS_DTYPE_F8:
+        return self_attention_quant_(o, qp, reinterpret_cast<const llaisys::fp8e4m3_t *>(k), ks,
+                                     reinterpret_cast<const llaisys::fp8e4m3_t *>(v), vs,
+                                     seqlen, nhead, d, total_len, nkvhead, dv, scale, strides);
+    case LLAISYS_DTYPE_F8E5M2:
+        return self_attention_quant_(o, qp, reinterpret_cast<const llaisys::fp8e5m2_t *>(k), ks,
+                                     reinterpret_cast<const llaisys::fp8e5m2_t *>(v), vs,
+                                     seqlen, nhead, d, total_len, nkvhead, dv, scale, strides);
+    default:
+        EXCEPTION_UNSUPPORTED_DATATYPE(kv_type);
+    }
+}
+} // namespace
+
+namespace llaisys::ops::cpu {
+void self_attention_quant(std::byte *attn_val, const std::byte *q, const std::byte *k, const std::byte *k_scale,
+                          const std::byte *v, const std::byte *v_scale, llaisysDataType_t data_type,
+                          llaisysDataType_t kv_type, size_t seqlen, size_t nhead, size_t d, size_t total_len,
+                          size_t nkvhead, size_t dv, float scale, const AttentionStrides &strides) {
+    switch (data_type) {
+    case LLAISYS_DTYPE_F32:
+        return self_attention_quant_dispatch<float>(attn_val, q, k, k_scale, v, v_scale, kv_type,
+                                                    seqlen, nhead, d, total_len, nkvhead, dv, scale, strides);
+    case LLAISYS_DTYPE_F16:
+        return self_attention_quant_dispatch<fp16_t>(attn_val, q, k, k_scale, v, v_scale, kv_type,
+                                                     seqlen, nhead, d, total_len, nkvhead, dv, scale, strides);
+    case LLAISYS_DTYPE_BF16:
+        return self_attention_quant_dispatch<bf16_t>(attn_val, q, k, k_scale, v, v_scale, kv_type,
+                                                     seqlen, nhead, d, total_len, nkvhead, dv, scale, strides);
+    default:
+        EXCEPTION_UNSUPPORTED_DATATYPE(data_type);
+    }
+}
+} // namespace llaisys::ops::cpu
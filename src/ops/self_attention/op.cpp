@@ -1,13 +1,55 @@
 #include "op.hpp"
 #include "../../core/llaisys_core.hpp"
+#include "../trace.hpp"
 #include "../../utils.hpp"
 #include "cpu/self_attention_cpu.hpp"
+#include <functional>
 #include <string>
 #include <stdexcept>
 #include <vector>
 
 namespace llaisys::ops {
-void self_attention(tensor_t attn_val, tensor_t q, tensor_t k, tensor_t v, float scale) {
+namespace {
+cpu::HeadStrides headStrides(const tensor_t &t) {
+    return t ? cpu::HeadStrides{t->strides()[0], t->strides()[1]} : cpu::HeadStrides{0, 0};
+}
+
+// 每个头向量连续即可，行与头之间可以有任意步长
+bool headContiguous(const tensor_t &t) {
+    return t->shape()[2] <= 1 || t->strides()[2] == 1;
+}
+
+// 给出 kv_len 时，有效长度在内核执行时读取，回放命令图时随解码步数变化
+std::function<void()> attendOnCpu(tensor_t attn_val, tensor_t q, tensor_t k, tensor_t v, tensor_t k_scale,
+                                  tensor_t v_scale, tensor_t kv_len, size_t seqlen, size_t nhead, size_t d,
+                                  size_t total_len, size_t nkvhead, size_t dv, float scale) {
+    return [out = attn_val->data(), qd = q->data(), kd = k->data(), vd = v->data(),
+            ks = k_scale ? k_scale->data() : nullptr, vs = v_scale ? v_scale->data() : nullptr,
+            len = kv_len ? kv_len->data() : nullptr, dtype = attn_val->dtype(), kv_dtype = k->dtype(),
+            strides = cpu::AttentionStrides{headStrides(attn_val), headStrides(q), headStrides(k), headStrides(v),
+                                            headStrides(k_scale), headStrides(v_scale)},
+            seqlen, nhead, d, total_len, nkvhead, dv, scale] {
+        size_t n = total_len;
+        if (len) {
+            const int64_t v = *reinterpret_cast<const int64_t *>(len);
+            if (v < static_cast<int64_t>(seqlen) || v > static_cast<int64_t>(total_len)) {
+                throw std::out_of_range("Self-Attention: kv_len out of range.");
+            }
+            n = static_cast<size_t>(v);
+        }
+        if (kv_dtype == LLAISYS_DTYPE_I8 || kv_dtype == LLAISYS_DTYPE_F8 || kv_dtype == LLAISYS_DTYPE_F8E5M2) {
+            cpu::self_attention_quant(out, qd, kd, ks, vd, vs, dtype, kv_dtype, seqlen, nhead, d, n, nkvhead, dv, scale,
+                                      strides);
+        } else {
+            cpu::self_attention(out, qd, kd, vd, dtype, seqlen, nhead, d, n, nkvhead, dv, scale, strides);
+        }
+    };
+}
+} // namespace
+
+void self_attention(tensor_t attn_val, tensor_t q, tensor_t k, tensor_t v, float scale,
+                    tensor_t k_scale, tensor_t v_scale, tensor_t kv_len) {
+    LLAISYS_TRACE_OP("self_attention", attn_val, q, k, v, k_scale, v_scale, kv_len);
     // 1. 设备一致性校验
     auto out_device = attn_val->deviceType();
     auto out_device_id = attn_val->deviceId();
@@ -24,10 +66,10 @@ void self_attention(tensor_t attn_val, tensor_t q, tensor_t k, tensor_t v, float
     }
 
     // 2. 维度校验
-    std::vector<size_t> attn_val_shape = attn_val->shape();
-    std::vector<size_t> q_shape = q->shape();
-    std::vector<size_t> k_shape = k->shape();
-    std::vector<size_t> v_shape = v->shape();
+    const auto &attn_val_shape = attn_val->shape();
+    const auto &q_shape = q->shape();
+    const auto &k_shape = k->shape();
+    const auto &v_shape = v->shape();
 
     if (attn_val_shape.size() != 3 || q_shape.size() != 3 || k_shape.size() != 3 || v_shape.size() != 3) {
         throw std::invalid_argument("Self-Attention: all tensors must be 3D.");
@@ -42,7 +84,7 @@ void self_attention(tensor_t attn_val, tensor_t q, tensor_t k, tensor_t v, float
     size_t dv = v_shape[2];
 
     // 4. 形状匹配校验
-    if (attn_val_shape != std::vector<size_t>{seqlen, nhead, dv}) {
+    if (attn_val_shape != shape_t{seqlen, nhead, dv}) {
         throw std::invalid_argument("Self-Attention: attn_val shape must be [seqlen, nhead, dv].");
     }
     if (k_shape[2] != d) {
@@ -55,30 +97,55 @@ void self_attention(tensor_t attn_val, tensor_t q, tensor_t k, tensor_t v, float
         throw std::invalid_argument("Self-Attention: nhead must be a multiple of nkvhead.");
     }
 
-    // 5. 数据类型校验
+    // 5. 数据类型校验：量化 KV Cache 的 K/V 同为 int8 或同一种 fp8，并带有逐 (token, head) 的缩放系数
     llaisysDataType_t dtype = attn_val->dtype();
-    if (q->dtype() != dtype || k->dtype() != dtype || v->dtype() != dtype) {
+    llaisysDataType_t kv_dtype = k->dtype();
+    const bool quant_kv = kv_dtype == LLAISYS_DTYPE_I8 || kv_dtype == LLAISYS_DTYPE_F8 || kv_dtype == LLAISYS_DTYPE_F8E5M2;
+    if (q->dtype() != dtype || v->dtype() != kv_dtype || (!quant_kv && kv_dtype != dtype)) {
         throw std::invalid_argument("Self-Attention: all tensors must have the same data type.");
     }
+    if (quant_kv) {
+        if (!k_scale || !v_scale) {
+            throw std::invalid_argument("Self-Attention: quantized K/V require k_scale and v_scale.");
+        }
+        const shape_t scale_shape{total_len, nkvhead};
+        if (k_scale->shape() != scale_shape || v_scale->shape() != scale_shape
+            || k_scale->dtype() != LLAISYS_DTYPE_F32 || v_scale->dtype() != LLAISYS_DTYPE_F32) {
+            throw std::invalid_argument("Self-Attention: k_scale/v_scale must be float32 [total_len, nkvhead].");
+        }
+        if (k_scale->deviceType() != out_device || v_scale->deviceType() != out_device) {
+            throw std::invalid_argument("Self-Attention: all tensors must be on the same device.");
+        }
+    }
+
+    // 6. 布局校验：按 (token, head) 步长访问，k/v 可为 KV Cache 的切片，q 可为融合 QKV 缓冲区的一段
+    if (!headContiguous(attn_val) || !headContiguous(q) || !headContiguous(k) || !headContiguous(v)) {
+        throw std::invalid_argument("Self-Attention: head vectors must be contiguous.");
+    }
 
-    // 6. 连续性校验
-    if (!attn_val->isContiguous() || !q->isContiguous() || !k->isContiguous() || !v->isContiguous()) {
-        throw std::invalid_argument("Self-Attention: all tensors must be contiguous.");
+    // 7. kv_len：k/v 为整块 KV Cache 时，有效行数由 int64 [1] 张量给出
+    if (kv_len) {
+        if (kv_len->dtype() != LLAISYS_DTYPE_I64 || kv_len->numel() != 1) {
+            throw std::invalid_argument("Self-Attention: kv_len must be int64 [1].");
+        }
+        if (kv_len->deviceType() != out_device || kv_len->deviceId() != out_device_id) {
+            throw std::invalid_argument("Self-Attention: all tensors must be on the same device.");
+        }
     }
 
-    // 7. CPU 快速路径
+    // 8. CPU 快速路径
     if (out_device == LLAISYS_DEVICE_CPU) {
-        return cpu::self_attention(attn_val->data(), q->data(), k->data(), v->data(),
-                                  dtype, seqlen, nhead, d, total_len, nkvhead, dv, scale);
+        return core::launch(attendOnCpu(attn_val, q, k, v, k_scale, v_scale, kv_len,
+                                        seqlen, nhead, d, total_len, nkvhead, dv, scale));
     }
 
-    // 8. 非 CPU 设备
+    // 9. 非 CPU 设备
     llaisys::core::context().setDevice(out_device, out_device_id);
 
     switch (out_device) {
     case LLAISYS_DEVICE_CPU:
-        return cpu::self_attention(attn_val->data(), q->data(), k->data(), v->data(),
-                                  dtype, seqlen, nhead, d, total_len, nkvhead, dv, scale);
+        return core::launch(attendOnCpu(attn_val, q, k, v, k_scale, v_scale, kv_len,
+                                        seqlen, nhead, d, total_len, nkvhead, dv, scale));
 #ifdef ENABLE_NVIDIA_API
     case LLAISYS_DEVICE_NVIDIA:
         throw std::runtime_error("Self-Attention: NVIDIA device is not implemented yet.");
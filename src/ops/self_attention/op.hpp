@@ -3,5 +3,9 @@
 #include "../../tensor/tensor.hpp"
 
 namespace llaisys::ops {
-void self_attention(tensor_t attn_val, tensor_t q, tensor_t k, tensor_t v, float scale);
+// k/v 为 int8 或 fp8（LLAISYS_DTYPE_F8、LLAISYS_DTYPE_F8E5M2）的量化 KV Cache 时，需给出 float32 [total_len, nkvhead] 的
+// k_scale/v_scale，注意力计算中逐行反量化。
+// kv_len 为 int64 [1] 时，k/v 可以是整块 KV Cache，只有前 *kv_len 行参与计算，该值在内核执行时读取
+void self_attention(tensor_t attn_val, tensor_t q, tensor_t k, tensor_t v, float scale,
+                    tensor_t k_scale = nullptr, tensor_t v_scale = nullptr, tensor_t kv_len = nullptr);
 } // namespace llaisys::ops
\ No newline at end of file
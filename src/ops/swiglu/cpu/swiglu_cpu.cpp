@@ -6,13 +6,11 @@
 #include <string>
 
 namespace llaisys {
-// 辅助：逐元素计算 SwiGLU
+// 辅助：逐元素计算一行 SwiGLU
 // SwiGLU(gate, up) = SiLU(gate) * up = (gate * sigmoid(gate)) * up
 template <typename T>
-void swiglu_elementwise(T *out, const T *gate, const T *up,
-                        size_t seqlen, size_t intermediate_size) {
-    size_t total_elements = seqlen * intermediate_size;
-    for (size_t idx = 0; idx < total_elements; ++idx) {
+void swiglu_elementwise(T *out, const T *gate, const T *up, size_t intermediate_size) {
+    for (size_t idx = 0; idx < intermediate_size; ++idx) {
         // 读取输入
         float gate_val = llaisys::utils::cast<float>(gate[idx]);
         float up_val = llaisys::utils::cast<float>(up[idx]);
@@ -33,17 +31,22 @@ void swiglu_elementwise(T *out, const T *gate, const T *up,
 // 模板核心函数
 template <typename T>
 void swiglu_(std::byte *out, const std::byte *gate, const std::byte *up,
-             size_t seqlen, size_t intermediate_size) {
+             size_t seqlen, size_t intermediate_size, ptrdiff_t ld_out, ptrdiff_t ld_gate, ptrdiff_t ld_up) {
     const T *gate_ptr = reinterpret_cast<const T*>(gate);
     const T *up_ptr = reinterpret_cast<const T*>(up);
     T *out_ptr = reinterpret_cast<T*>(out);
 
-    llaisys::swiglu_elementwise<T>(out_ptr, gate_ptr, up_ptr, seqlen, intermediate_size);
+    // gate/up 可为融合 [seqlen, 2 * intermediate_size] 缓冲区的列切片，逐行按各自行距访问
+    for (size_t i = 0; i < seqlen; ++i) {
+        llaisys::swiglu_elementwise<T>(out_ptr + i * ld_out, gate_ptr + i * ld_gate, up_ptr + i * ld_up,
+                                       intermediate_size);
+    }
 }
 
 namespace llaisys::ops::cpu {
 void swiglu(std::byte *out, const std::byte *gate, const std::byte *up,
-            llaisysDataType_t data_type, size_t seqlen, size_t intermediate_size) {
+            llaisysDataType_t data_type, size_t seqlen, size_t intermediate_size,
+            ptrdiff_t ld_out, ptrdiff_t ld_gate, ptrdiff_t ld_up) {
     // 空值保护
     if (seqlen == 0 || intermediate_size == 0) {
         throw std::invalid_argument("SwiGLU: seqlen/intermediate_size cannot be zero.");
@@ -52,11 +55,11 @@ void swiglu(std::byte *out, const std::byte *gate, const std::byte *up,
     // 数据类型分发
     switch (data_type) {
     case LLAISYS_DTYPE_F32:
-        return swiglu_<float>(out, gate, up, seqlen, intermediate_size);
+        return swiglu_<float>(out, gate, up, seqlen, intermediate_size, ld_out, ld_gate, ld_up);
     case LLAISYS_DTYPE_F16:
-        return swiglu_<llaisys::fp16_t>(out, gate, up, seqlen, intermediate_size);
+        return swiglu_<llaisys::fp16_t>(out, gate, up, seqlen, intermediate_size, ld_out, ld_gate, ld_up);
     case LLAISYS_DTYPE_BF16:
-        return swiglu_<llaisys::bf16_t>(out, gate, up, seqlen, intermediate_size);
+        return swiglu_<llaisys::bf16_t>(out, gate, up, seqlen, intermediate_size, ld_out, ld_gate, ld_up);
     default:
         std::string err_msg = "SwiGLU: unsupported data type (" + std::to_string(static_cast<int>(data_type)) + ").";
         throw std::runtime_error(err_msg);
@@ -4,5 +4,6 @@
 
 namespace llaisys::ops::cpu {
 void swiglu(std::byte *out, const std::byte *gate, const std::byte *up,
-            llaisysDataType_t data_type, size_t seqlen, size_t intermediate_size);
+            llaisysDataType_t data_type, size_t seqlen, size_t intermediate_size,
+            ptrdiff_t ld_out, ptrdiff_t ld_gate, ptrdiff_t ld_up);
 } // namespace llaisys::ops::cpu
\ No newline at end of file
@@ -1,5 +1,6 @@
 #include "op.hpp"
 #include "../../core/llaisys_core.hpp"
+#include "../trace.hpp"
 #include "../../utils.hpp"
 #include "cpu/swiglu_cpu.hpp"
 #include <string>
@@ -8,6 +9,7 @@
 
 namespace llaisys::ops {
 void swiglu(tensor_t out, tensor_t gate, tensor_t up) {
+    LLAISYS_TRACE_OP("swiglu", out, gate, up);
     // 1. 设备一致性校验
     auto out_device = out->deviceType();
     auto out_device_id = out->deviceId();
@@ -22,9 +24,9 @@ void swiglu(tensor_t out, tensor_t gate, tensor_t up) {
     }
 
     // 2. 维度校验
-    std::vector<size_t> out_shape = out->shape();
-    std::vector<size_t> gate_shape = gate->shape();
-    std::vector<size_t> up_shape = up->shape();
+    const auto &out_shape = out->shape();
+    const auto &gate_shape = gate->shape();
+    const auto &up_shape = up->shape();
 
     if (out_shape.size() != 2 || gate_shape.size() != 2 || up_shape.size() != 2) {
         throw std::invalid_argument("SwiGLU: all tensors must be 2D.");
@@ -44,15 +46,16 @@ void swiglu(tensor_t out, tensor_t gate, tensor_t up) {
         throw std::invalid_argument("SwiGLU: all tensors must have the same data type.");
     }
 
-    // 5. 连续性校验
-    if (!out->isContiguous() || !gate->isContiguous() || !up->isContiguous()) {
-        throw std::invalid_argument("SwiGLU: all tensors must be contiguous.");
+    // 5. 布局校验：各张量按行距访问，只要求行内连续
+    if (!out->isRowStrided() || !gate->isRowStrided() || !up->isRowStrided()) {
+        throw std::invalid_argument("SwiGLU: tensor rows must be contiguous.");
     }
 
     // 6. CPU 快速路径
     if (out_device == LLAISYS_DEVICE_CPU) {
-        return cpu::swiglu(out->data(), gate->data(), up->data(),
-                          dtype, seqlen, intermediate_size);
+        return core::launch(cpu::swiglu, out->data(), gate->data(), up->data(),
+                            dtype, seqlen, intermediate_size,
+                            out->rowStride(), gate->rowStride(), up->rowStride());
     }
 
     // 7. 非 CPU 设备
@@ -60,8 +63,9 @@ void swiglu(tensor_t out, tensor_t gate, tensor_t up) {
 
     switch (out_device) {
     case LLAISYS_DEVICE_CPU:
-        return cpu::swiglu(out->data(), gate->data(), up->data(),
-                          dtype, seqlen, intermediate_size);
+        return core::launch(cpu::swiglu, out->data(), gate->data(), up->data(),
+                            dtype, seqlen, intermediate_size,
+                            out->rowStride(), gate->rowStride(), up->rowStride());
 #ifdef ENABLE_NVIDIA_API
     case LLAISYS_DEVICE_NVIDIA:
         throw std::runtime_error("SwiGLU: NVIDIA device is not implemented yet.");
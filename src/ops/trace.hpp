@@ -0,0 +1,40 @@
+#pragma once
+
+#include "../core/trace/trace.hpp"
+#include "../tensor/tensor.hpp"
+#include "../utils.hpp"
+
+#include <initializer_list>
+#include <string>
+
+namespace llaisys::ops {
+// 把算子的张量参数写成 trace 标签："<dtype>[d0,d1,...]" 以空格分隔，空指针（可选参数）跳过；
+// bytes 为各张量元素总字节数，即一次调用至少读写的数据量；dtype 取第一个张量（通常为输出）
+inline void describeTensors(core::trace::Label &label, std::initializer_list<tensor_t> tensors) {
+    for (const auto &t : tensors) {
+        if (!t) {
+            continue;
+        }
+        if (label.dtype == LLAISYS_DTYPE_INVALID) {
+            label.dtype = t->dtype();
+        }
+        label.bytes += t->numel() * t->elementSize();
+        if (!label.args.empty()) {
+            label.args += ' ';
+        }
+        label.args += utils::dtype_to_str(t->dtype());
+        label.args += '[';
+        for (size_t i = 0; i < t->ndim(); i++) {
+            label.args += (i ? "," : "") + std::to_string(t->shape()[i]);
+        }
+        label.args += ']';
+    }
+}
+} // namespace llaisys::ops
+
+// 算子入口处声明一个 trace 作用域；未开启 trace 且不在捕获命令图时只有一次原子读与分支
+#define LLAISYS_TRACE_OP(name, ...)                                                       \
+    ::llaisys::core::trace::Scope llaisys_trace_scope_(                                   \
+        name, [&](::llaisys::core::trace::Label &llaisys_trace_label_) {                  \
+            ::llaisys::ops::describeTensors(llaisys_trace_label_, {__VA_ARGS__});         \
+        })
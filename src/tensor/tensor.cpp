@@ -11,15 +11,19 @@
 #define EXCEPTION_INCOMPATIBLE_VIEW(msg) throw std::invalid_argument("Incompatible view: " + std::string(msg))
 namespace llaisys {
 
-Tensor::Tensor(TensorMeta meta, core::storage_t storage, size_t offset)
-    : _meta(std::move(meta)), _storage(std::move(storage)), _offset(offset) {}
+Tensor::Tensor(const TensorMeta &meta, core::storage_t storage, size_t offset)
+    : _meta(meta), _storage(std::move(storage)), _offset(offset) {}
 
-tensor_t Tensor::create(const std::vector<size_t> &shape,
+tensor_t Tensor::make(const TensorMeta &meta, core::storage_t storage, size_t offset) {
+    return std::allocate_shared<Tensor>(utils::PoolAllocator<Tensor>(), meta, std::move(storage), offset);
+}
+
+tensor_t Tensor::create(const shape_t &shape,
                         llaisysDataType_t dtype,
                         llaisysDeviceType_t device_type,
                         int device) {
     size_t ndim_ = shape.size();
-    std::vector<ptrdiff_t> strides(ndim_);
+    strides_t strides(ndim_);
     size_t stride = 1;
     for (size_t i = 1; i <= ndim_; i++) {
         strides[ndim_ - i] = stride;
@@ -31,12 +35,30 @@ tensor_t Tensor::create(const std::vector<size_t> &shape,
 
     if (device_type == LLAISYS_DEVICE_CPU && core::context().runtime().deviceType() != LLAISYS_DEVICE_CPU) {
         auto storage = core::context().runtime().allocateHostStorage(total_elems * dtype_size);
-        return std::shared_ptr<Tensor>(new Tensor(meta, storage));
+        return make(meta, std::move(storage));
     } else {
         core::context().setDevice(device_type, device);
         auto storage = core::context().runtime().allocateDeviceStorage(total_elems * dtype_size);
-        return std::shared_ptr<Tensor>(new Tensor(meta, storage));
+        return make(meta, std::move(storage));
+    }
+}
+
+tensor_t Tensor::create(const shape_t &shape,
+                        llaisysDataType_t dtype,
+                        core::storage_t storage,
+                        size_t offset) {
+    size_t ndim_ = shape.size();
+    strides_t strides(ndim_);
+    size_t stride = 1;
+    for (size_t i = 1; i <= ndim_; i++) {
+        strides[ndim_ - i] = stride;
+        stride *= shape[ndim_ - i];
     }
+    if (offset + stride * utils::dsize(dtype) > storage->size()) {
+        EXCEPTION_INVALID_SHAPE("tensor exceeds the bounds of its storage");
+    }
+    TensorMeta meta{dtype, shape, strides};
+    return make(meta, std::move(storage), offset);
 }
 
 std::byte *Tensor::data() {
@@ -51,11 +73,11 @@ size_t Tensor::ndim() const {
     return _meta.shape.size();
 }
 
-const std::vector<size_t> &Tensor::shape() const {
+const shape_t &Tensor::shape() const {
     return _meta.shape;
 }
 
-const std::vector<ptrdiff_t> &Tensor::strides() const {
+const strides_t &Tensor::strides() const {
     return _meta.strides;
 }
 
@@ -97,10 +119,11 @@ std::string Tensor::info() const {
 }
 
 template <typename T>
-void print_data(const T *data, const std::vector<size_t> &shape, const std::vector<ptrdiff_t> &strides, size_t dim) {
+void print_data(const T *data, const shape_t &shape, const strides_t &strides, size_t dim) {
     if (dim == shape.size() - 1) {
         for (size_t i = 0; i < shape[dim]; i++) {
-            if constexpr (std::is_same_v<T, bf16_t> || std::is_same_v<T, fp16_t>) {
+            if constexpr (std::is_same_v<T, bf16_t> || std::is_same_v<T, fp16_t> || std::is_same_v<T, fp8e4m3_t>
+                          || std::is_same_v<T, fp8e5m2_t>) {
                 std::cout << utils::cast<float>(data[i * strides[dim]]) << " ";
             } else {
                 std::cout << data[i * strides[dim]] << " ";
@@ -114,7 +137,7 @@ void print_data(const T *data, const std::vector<size_t> &shape, const std::vect
     }
 }
 
-void debug_print(const std::byte *data, const std::vector<size_t> &shape, const std::vector<ptrdiff_t> &strides, llaisysDataType_t dtype) {
+void debug_print(const std::byte *data, const shape_t &shape, const strides_t &strides, llaisysDataType_t dtype) {
     switch (dtype) {
     case LLAISYS_DTYPE_BYTE:
         return print_data(reinterpret_cast<const char *>(data), shape, strides, 0);
@@ -136,6 +159,10 @@ void debug_print(const std::byte *data, const std::vector<size_t> &shape, const
         return print_data(reinterpret_cast<const uint32_t *>(data), shape, strides, 0);
     case LLAISYS_DTYPE_U64:
         return print_data(reinterpret_cast<const uint64_t *>(data), shape, strides, 0);
+    case LLAISYS_DTYPE_F8:
+        return print_data(reinterpret_cast<const fp8e4m3_t *>(data), shape, strides, 0);
+    case LLAISYS_DTYPE_F8E5M2:
+        return print_data(reinterpret_cast<const fp8e5m2_t *>(data), shape, strides, 0);
     case LLAISYS_DTYPE_F16:
         return print_data(reinterpret_cast<const fp16_t *>(data), shape, strides, 0);
     case LLAISYS_DTYPE_F32:
@@ -151,7 +178,7 @@ void debug_print(const std::byte *data, const std::vector<size_t> &shape, const
 
 void Tensor::debug() const {
     core::context().setDevice(this->deviceType(), this->deviceId());
-    core::context().runtime().api()->device_synchronize();
+    core::context().runtime().synchronize();
     std::cout << this->info() << std::endl;
     if (this->deviceType() == LLAISYS_DEVICE_CPU) {
         debug_print(this->data(), this->shape(), this->strides(), this->dtype());
@@ -196,7 +223,48 @@ bool Tensor::isContiguous() const {
     return true;
 }
 
-tensor_t Tensor::permute(const std::vector<size_t> &order) const {
+bool Tensor::isRowStrided() const {
+    const auto &shape_ = this->shape();
+    const auto &strides_ = this->strides();
+    const size_t ndim_ = this->ndim();
+    if (ndim_ <= 1) {
+        return ndim_ == 0 || shape_[0] <= 1 || strides_[0] == 1;
+    }
+    // 1. 最后一维必须连续（长度为 1 时步长无意义）
+    if (shape_[ndim_ - 1] > 1 && strides_[ndim_ - 1] != 1) {
+        return false;
+    }
+    // 2. 前导维度（跳过长度为 1 的维度）须能合并为一个行下标：外层步长 = 内层步长 × 内层长度
+    ptrdiff_t inner_stride = 0;
+    size_t inner_size = 0;
+    for (size_t i = ndim_ - 1; i > 0; --i) {
+        const size_t dim = i - 1;
+        if (shape_[dim] == 1) {
+            continue;
+        }
+        if (inner_size != 0 && strides_[dim] != inner_stride * static_cast<ptrdiff_t>(inner_size)) {
+            return false;
+        }
+        inner_stride = strides_[dim];
+        inner_size = shape_[dim];
+    }
+    return true;
+}
+
+ptrdiff_t Tensor::rowStride() const {
+    const auto &shape_ = this->shape();
+    const auto &strides_ = this->strides();
+    const size_t ndim_ = this->ndim();
+    // 取最内层长度大于 1 的前导维度的步长；只有一行时任意行距都等价，取行长
+    for (size_t i = ndim_ - 1; ndim_ > 1 && i > 0; --i) {
+        if (shape_[i - 1] > 1) {
+            return strides_[i - 1];
+        }
+    }
+    return ndim_ == 0 ? 1 : static_cast<ptrdiff_t>(shape_[ndim_ - 1]);
+}
+
+tensor_t Tensor::permute(const shape_t &order) const {
     size_t ndim_ = this->ndim();
     
     // 1. 校验 order 合法性
@@ -204,7 +272,7 @@ tensor_t Tensor::permute(const std::vector<size_t> &order) const {
         EXCEPTION_INVALID_ORDER("Order size (" + std::to_string(order.size()) + ") does not match tensor ndim (" + std::to_string(ndim_) + ")");
     }
     
-    std::vector<bool> dim_used(ndim_, false);
+    utils::InlineVector<bool, kMaxTensorDim> dim_used(ndim_, false);
     for (size_t dim : order) {
         if (dim >= ndim_) {
             EXCEPTION_INVALID_ORDER("Dimension " + std::to_string(dim) + " is out of range (0 ~ " + std::to_string(ndim_-1) + ")");
@@ -227,10 +295,10 @@ tensor_t Tensor::permute(const std::vector<size_t> &order) const {
     }
     
     // 3. 构造新张量（共享存储，仅修改元信息，无数据传输）
-    return std::shared_ptr<Tensor>(new Tensor(new_meta, this->_storage, this->_offset));
+    return make(new_meta, this->_storage, this->_offset);
 }
 
-tensor_t Tensor::view(const std::vector<size_t> &new_shape) const {
+tensor_t Tensor::view(const shape_t &new_shape) const {
     // 1. 计算原始张量和新形状的元素总数
     size_t original_numel = this->numel();
     size_t new_numel = std::accumulate(new_shape.begin(), new_shape.end(), size_t(1), std::multiplies<size_t>());
@@ -245,14 +313,14 @@ tensor_t Tensor::view(const std::vector<size_t> &new_shape) const {
         TensorMeta new_meta = this->_meta;
         new_meta.shape = new_shape;
         // 推导空张量的默认步长
-        std::vector<ptrdiff_t> new_strides(new_shape.size());
+        strides_t new_strides(new_shape.size());
         size_t stride = 1;
         for (size_t i = 1; i <= new_shape.size(); ++i) {
             new_strides[new_shape.size() - i] = stride;
             stride *= new_shape[new_shape.size() - i];
         }
         new_meta.strides = new_strides;
-        return std::shared_ptr<Tensor>(new Tensor(new_meta, this->_storage, this->_offset));
+        return make(new_meta, this->_storage, this->_offset);
     }
     
     // 4. 校验原始张量是否连续（仅连续张量支持任意合法 view，不连续张量需特殊校验布局）
@@ -264,7 +332,7 @@ tensor_t Tensor::view(const std::vector<size_t> &new_shape) const {
     }
     
     // 5. 推导新形状对应的连续步长（view 不改变数据布局，新张量仍为连续）
-    std::vector<ptrdiff_t> new_strides(new_shape.size());
+    strides_t new_strides(new_shape.size());
     size_t stride = 1;
     for (size_t i = 1; i <= new_shape.size(); ++i) {
         size_t dim = new_shape.size() - i;
@@ -277,7 +345,7 @@ tensor_t Tensor::view(const std::vector<size_t> &new_shape) const {
     new_meta.shape = new_shape;
     new_meta.strides = new_strides;
     
-    return std::shared_ptr<Tensor>(new Tensor(new_meta, this->_storage, this->_offset));
+    return make(new_meta, this->_storage, this->_offset);
 }
 
 tensor_t Tensor::slice(size_t dim, size_t start, size_t end) const {
@@ -301,7 +369,7 @@ tensor_t Tensor::slice(size_t dim, size_t start, size_t end) const {
         // 返回空切片张量
         TensorMeta new_meta = this->_meta;
         new_meta.shape[dim] = 0;
-        return std::shared_ptr<Tensor>(new Tensor(new_meta, this->_storage, this->_offset));
+        return make(new_meta, this->_storage, this->_offset);
     }
     
     // 3. 计算新张量的 offset（切片对应的内存偏移量）
@@ -313,7 +381,7 @@ tensor_t Tensor::slice(size_t dim, size_t start, size_t end) const {
     new_meta.shape[dim] = end - start;
     
     // 5. 构造新张量（共享存储，修改元信息和 offset，无数据传输）
-    return std::shared_ptr<Tensor>(new Tensor(new_meta, this->_storage, new_offset));
+    return make(new_meta, this->_storage, new_offset);
 }
 
 void Tensor::load(const void *src_) {
@@ -339,7 +407,8 @@ void Tensor::load(const void *src_) {
     // 4. 执行对应类型的内存拷贝（主机 -> 目标设备/主机）
     llaisysMemcpyKind_t memcpy_kind;
     if (this->deviceType() == LLAISYS_DEVICE_CPU) {
-        // 目标是 CPU：直接使用 std::memcpy 同步拷贝
+        // 目标是 CPU：等当前线程在该设备上的流中可能仍在读写本张量的内核完成后，直接使用 std::memcpy 同步拷贝
+        core::context().runtime().synchronize();
         std::memcpy(this->data(), src, total_bytes);
     } else {
         // 目标是设备（如 GPU）：使用运行时 API 的 D2H 反向（H2D）同步拷贝
@@ -350,17 +419,17 @@ void Tensor::load(const void *src_) {
 
 tensor_t Tensor::contiguous() const {
     TO_BE_IMPLEMENTED();
-    return std::shared_ptr<Tensor>(new Tensor(_meta, _storage));
+    return make(_meta, _storage);
 }
 
-tensor_t Tensor::reshape(const std::vector<size_t> &shape) const {
+tensor_t Tensor::reshape(const shape_t &shape) const {
     TO_BE_IMPLEMENTED();
-    return std::shared_ptr<Tensor>(new Tensor(_meta, _storage));
+    return make(_meta, _storage);
 }
 
 tensor_t Tensor::to(llaisysDeviceType_t device_type, int device) const {
     TO_BE_IMPLEMENTED();
-    return std::shared_ptr<Tensor>(new Tensor(_meta, _storage));
+    return make(_meta, _storage);
 }
 
 } // namespace llaisys
\ No newline at end of file
@@ -1,15 +1,23 @@
 #pragma once
 #include "../core/llaisys_core.hpp"
+#include "../utils/inline_vector.hpp"
+#include "../utils/pool_allocator.hpp"
 
 #include <vector>
 namespace llaisys {
 class Tensor;
 using tensor_t = std::shared_ptr<Tensor>;
 
+// Shapes and strides are stored inline (rank <= kMaxTensorDim), so tensor metadata and
+// the views derived from it never touch the heap.
+constexpr size_t kMaxTensorDim = 8;
+using shape_t = utils::InlineVector<size_t, kMaxTensorDim>;
+using strides_t = utils::InlineVector<ptrdiff_t, kMaxTensorDim>;
+
 struct TensorMeta {
     llaisysDataType_t dtype;
-    std::vector<size_t> shape;
-    std::vector<ptrdiff_t> strides;
+    shape_t shape;
+    strides_t strides;
 };
 
 class Tensor {
@@ -17,21 +25,30 @@ private:
     TensorMeta _meta;
     core::storage_t _storage;
     size_t _offset;
-    Tensor(TensorMeta meta, core::storage_t storage, size_t offset = 0);
+    Tensor(const TensorMeta &meta, core::storage_t storage, size_t offset = 0);
+    // Tensor objects and their control blocks come from one pooled allocation
+    static tensor_t make(const TensorMeta &meta, core::storage_t storage, size_t offset = 0);
+    friend struct utils::PoolAllocator<Tensor>;
 
 public:
     static tensor_t create(
-        const std::vector<size_t> &shape,
+        const shape_t &shape,
         llaisysDataType_t dtype,
         llaisysDeviceType_t device_type = LLAISYS_DEVICE_CPU,
         int device = 0);
+    // Creates a contiguous tensor over existing storage (no allocation, no copy)
+    static tensor_t create(
+        const shape_t &shape,
+        llaisysDataType_t dtype,
+        core::storage_t storage,
+        size_t offset = 0);
     ~Tensor() = default;
     // Info
     std::byte *data();
     const std::byte *data() const;
     size_t ndim() const;
-    const std::vector<size_t> &shape() const;
-    const std::vector<ptrdiff_t> &strides() const;
+    const shape_t &shape() const;
+    const strides_t &strides() const;
     llaisysDataType_t dtype() const;
     llaisysDeviceType_t deviceType() const;
     int deviceId() const;
@@ -42,18 +59,23 @@ public:
     void debug() const;
 
     bool isContiguous() const;
+    // True when the last dim is dense and the leading dims collapse into rows with a
+    // uniform stride: a row-major matrix whose rows may be padded, e.g. a column slice.
+    bool isRowStrided() const;
+    // Distance in elements between consecutive rows of a row-strided tensor
+    ptrdiff_t rowStride() const;
 
     // Meta Transform
-    tensor_t permute(const std::vector<size_t> &order) const;
+    tensor_t permute(const shape_t &order) const;
     tensor_t slice(size_t dim, size_t start, size_t end) const;
-    tensor_t view(const std::vector<size_t> &shape) const;
+    tensor_t view(const shape_t &shape) const;
 
     // Load data from host memory
     void load(const void *src);
 
     // Challenging features
     tensor_t contiguous() const;
-    tensor_t reshape(const std::vector<size_t> &shape) const;
+    tensor_t reshape(const shape_t &shape) const;
     tensor_t to(llaisysDeviceType_t device_type, int device = -1) const;
 };
 
@@ -0,0 +1,48 @@
+#pragma once
+#include <cstdlib>
+
+// Runtime detection of x86 SIMD extensions used by the hand-written CPU kernels.
+// Kernels are compiled per ISA with __attribute__((target(...))) and selected at runtime,
+// so the library itself stays buildable for a baseline x86-64 target.
+// Setting LLAISYS_DISABLE_SIMD=1 forces the portable scalar kernels.
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define LLAISYS_X86_SIMD 1
+#endif
+
+namespace llaisys::utils {
+inline bool simdDisabled() {
+    static const bool disabled = [] {
+        const char *env = std::getenv("LLAISYS_DISABLE_SIMD");
+        return env != nullptr && env[0] != '\0' && env[0] != '0';
+    }();
+    return disabled;
+}
+
+#ifdef LLAISYS_X86_SIMD
+inline bool cpuHasAvx2() {
+    static const bool has = __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+    return has && !simdDisabled();
+}
+
+// Hardware float16 <-> float32 conversion (vcvtph2ps), present on every AVX2 CPU in practice.
+inline bool cpuHasF16c() {
+    static const bool has = __builtin_cpu_supports("f16c");
+    return has && !simdDisabled();
+}
+
+inline bool cpuHasAvx512() {
+    static const bool has = __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw");
+    return has && !simdDisabled();
+}
+
+inline bool cpuHasAvx512Vnni() {
+    static const bool has = cpuHasAvx512() && __builtin_cpu_supports("avx512vnni");
+    return has && !simdDisabled();
+}
+#else
+inline bool cpuHasAvx2() { return false; }
+inline bool cpuHasF16c() { return false; }
+inline bool cpuHasAvx512() { return false; }
+inline bool cpuHasAvx512Vnni() { return false; }
+#endif
+} // namespace llaisys::utils
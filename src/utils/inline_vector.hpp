@@ -0,0 +1,83 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace llaisys::utils {
+// 定长容量、元素内联存放的顺序容器，用于张量的形状与步长：拷贝不分配堆内存。
+// 超出容量时抛出 std::invalid_argument
+template <typename T, size_t N>
+class InlineVector {
+private:
+    T _data[N]{};
+    size_t _size = 0;
+
+    static void checkCapacity(size_t n) {
+        if (n > N) {
+            throw std::invalid_argument("InlineVector: at most " + std::to_string(N) + " elements are supported");
+        }
+    }
+
+public:
+    using value_type = T;
+    using iterator = T *;
+    using const_iterator = const T *;
+
+    InlineVector() = default;
+    explicit InlineVector(size_t n, const T &value = T()) { resize(n, value); }
+    InlineVector(std::initializer_list<T> init) { assign(init.begin(), init.end()); }
+    InlineVector(const std::vector<T> &vec) { assign(vec.begin(), vec.end()); }
+
+    template <typename It>
+    void assign(It first, It last) {
+        const size_t n = static_cast<size_t>(std::distance(first, last));
+        checkCapacity(n);
+        std::copy(first, last, _data);
+        _size = n;
+    }
+
+    void resize(size_t n, const T &value = T()) {
+        checkCapacity(n);
+        for (size_t i = _size; i < n; i++) {
+            _data[i] = value;
+        }
+        _size = n;
+    }
+
+    void push_back(const T &value) {
+        checkCapacity(_size + 1);
+        _data[_size++] = value;
+    }
+
+    size_t size() const { return _size; }
+    bool empty() const { return _size == 0; }
+    T *data() { return _data; }
+    const T *data() const { return _data; }
+    T *begin() { return _data; }
+    T *end() { return _data + _size; }
+    const T *begin() const { return _data; }
+    const T *end() const { return _data + _size; }
+    T &operator[](size_t i) { return _data[i]; }
+    const T &operator[](size_t i) const { return _data[i]; }
+    T &back() { return _data[_size - 1]; }
+    const T &back() const { return _data[_size - 1]; }
+
+    operator std::vector<T>() const { return std::vector<T>(begin(), end()); }
+
+    friend bool operator==(const InlineVector &a, const InlineVector &b) {
+        return std::equal(a.begin(), a.end(), b.begin(), b.end());
+    }
+    friend bool operator!=(const InlineVector &a, const InlineVector &b) { return !(a == b); }
+    friend bool operator==(const InlineVector &a, const std::vector<T> &b) {
+        return std::equal(a.begin(), a.end(), b.begin(), b.end());
+    }
+    friend bool operator!=(const InlineVector &a, const std::vector<T> &b) { return !(a == b); }
+    friend bool operator==(const std::vector<T> &a, const InlineVector &b) { return b == a; }
+    friend bool operator!=(const std::vector<T> &a, const InlineVector &b) { return !(b == a); }
+};
+} // namespace llaisys::utils
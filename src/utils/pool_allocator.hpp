@@ -0,0 +1,89 @@
+#pragma once
+
+#include <cstddef>
+#include <mutex>
+#include <new>
+#include <utility>
+
+namespace llaisys::utils {
+// 固定大小内存块的全局空闲链表：释放的块留在链表中供下次分配复用，不归还系统。
+// 对象可能在创建它的线程之外释放，因此用互斥锁保护。池本身永不析构，
+// 静态对象析构阶段释放的张量仍可安全归还
+template <size_t Size, size_t Align>
+class FixedPool {
+private:
+    union Block {
+        Block *next;
+        alignas(Align) std::byte data[Size];
+    };
+    static_assert(alignof(Block) <= alignof(std::max_align_t), "FixedPool: over-aligned blocks are not supported");
+
+    std::mutex _mutex;
+    Block *_free = nullptr;
+
+public:
+    static FixedPool &instance() {
+        static FixedPool *pool = new FixedPool;
+        return *pool;
+    }
+
+    void *allocate() {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            if (_free != nullptr) {
+                Block *block = _free;
+                _free = block->next;
+                return block;
+            }
+        }
+        return ::operator new(sizeof(Block));
+    }
+
+    void deallocate(void *p) {
+        auto *block = static_cast<Block *>(p);
+        std::lock_guard<std::mutex> lock(_mutex);
+        block->next = _free;
+        _free = block;
+    }
+};
+
+// 单对象分配走 FixedPool 的分配器，配合 std::allocate_shared 使用：
+// 对象与 shared_ptr 控制块在同一个池化的块中，创建与释放都不经过 malloc。
+// 通过 construct 构造对象，类可以把 PoolAllocator<T> 声明为友元以保持构造函数私有
+template <typename T>
+struct PoolAllocator {
+    using value_type = T;
+
+    PoolAllocator() = default;
+    template <typename U>
+    PoolAllocator(const PoolAllocator<U> &) {}
+
+    T *allocate(size_t n) {
+        if (n != 1) {
+            return static_cast<T *>(::operator new(n * sizeof(T)));
+        }
+        return static_cast<T *>(FixedPool<sizeof(T), alignof(T)>::instance().allocate());
+    }
+
+    void deallocate(T *p, size_t n) {
+        if (n != 1) {
+            ::operator delete(p);
+            return;
+        }
+        FixedPool<sizeof(T), alignof(T)>::instance().deallocate(p);
+    }
+
+    template <typename U, typename... Args>
+    void construct(U *p, Args &&...args) {
+        ::new (static_cast<void *>(p)) U(std::forward<Args>(args)...);
+    }
+
+    template <typename U>
+    void destroy(U *p) {
+        p->~U();
+    }
+
+    friend bool operator==(const PoolAllocator &, const PoolAllocator &) { return true; }
+    friend bool operator!=(const PoolAllocator &, const PoolAllocator &) { return false; }
+};
+} // namespace llaisys::utils
@@ -0,0 +1,25 @@
+#pragma once
+// x86 intrinsics for the hand-written CPU kernels.
+// Include this before any llaisys header: llaisys.h defines the macro __C, which is also
+// used as a parameter name inside the compiler's intrinsic headers.
+#include "cpu_features.hpp"
+
+#ifdef LLAISYS_X86_SIMD
+// GCC 12 reports false (maybe-)uninitialized warnings from the _mm512_undefined_* helpers
+// used inside its AVX-512 headers; silence them for the header only.
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wuninitialized"
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#include <immintrin.h>
+#pragma GCC diagnostic pop
+
+namespace llaisys::utils {
+// Sum of the eight lanes of an AVX register.
+__attribute__((target("avx2,fma"))) inline float hsumAvx2(__m256 v) {
+    __m128 s = _mm_add_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1));
+    s = _mm_hadd_ps(s, s);
+    s = _mm_hadd_ps(s, s);
+    return _mm_cvtss_f32(s);
+}
+} // namespace llaisys::utils
+#endif
@@ -1,5 +1,6 @@
 #include "types.hpp"
 
+#include <cmath>
 #include <cstring>
 
 namespace llaisys::utils {
@@ -82,4 +83,88 @@ bf16_t _f32_to_bf16(float val) {
 
     return bf16_t{bf16_bits};
 }
+
+float _f8e4m3_to_f32(fp8e4m3_t val) {
+    const uint8_t b = val._v;
+    const uint32_t sign = static_cast<uint32_t>(b & 0x80) << 24;
+    const uint32_t exponent = (b >> 3) & 0xF;
+    const uint32_t mantissa = b & 0x7;
+
+    float result;
+    if (exponent == 0xF && mantissa == 0x7) {
+        uint32_t f32 = sign | 0x7FC00000; // NaN
+        std::memcpy(&result, &f32, sizeof(result));
+    } else if (exponent == 0) {
+        // Subnormal: mantissa * 2^-9
+        result = static_cast<float>(mantissa) * (1.0f / 512.0f);
+        result = sign ? -result : result;
+    } else {
+        uint32_t f32 = sign | ((exponent - 7 + 127) << 23) | (mantissa << 20);
+        std::memcpy(&result, &f32, sizeof(result));
+    }
+    return result;
+}
+
+fp8e4m3_t _f32_to_f8e4m3(float val) {
+    uint32_t bits;
+    std::memcpy(&bits, &val, sizeof(bits));
+    const uint8_t sign = static_cast<uint8_t>((bits >> 24) & 0x80);
+    const uint32_t abs_bits = bits & 0x7FFFFFFF;
+
+    if (abs_bits > 0x7F800000) {
+        return fp8e4m3_t{static_cast<uint8_t>(sign | 0x7F)}; // NaN
+    }
+    float abs_val;
+    std::memcpy(&abs_val, &abs_bits, sizeof(abs_val));
+    if (abs_val >= 448.0f) {
+        return fp8e4m3_t{static_cast<uint8_t>(sign | 0x7E)}; // Saturate to the largest finite value
+    }
+    if (abs_val < 1.0f / 64.0f) {
+        // Subnormal range, step 2^-9; 8 * 2^-9 rounds up to the smallest normal, whose code is also 8
+        const uint32_t mantissa = static_cast<uint32_t>(std::nearbyint(abs_val * 512.0f));
+        return fp8e4m3_t{static_cast<uint8_t>(sign | mantissa)};
+    }
+    // Normal range: round the float32 mantissa to 3 bits (nearest even)
+    const uint32_t rounded = (abs_bits + 0x7FFFF + ((abs_bits >> 20) & 1)) & 0xFFF00000;
+    const int32_t exponent = static_cast<int32_t>(rounded >> 23) - 127;
+    const uint32_t mantissa = (rounded >> 20) & 0x7;
+    if (exponent > 8 || (exponent == 8 && mantissa == 0x7)) {
+        return fp8e4m3_t{static_cast<uint8_t>(sign | 0x7E)};
+    }
+    return fp8e4m3_t{static_cast<uint8_t>(sign | ((exponent + 7) << 3) | mantissa)};
+}
+
+float _f8e5m2_to_f32(fp8e5m2_t val) {
+    // E5M2 与 float16 共用指数格式，补零即为 float16
+    return _f16_to_f32(fp16_t{static_cast<uint16_t>(val._v << 8)});
+}
+
+fp8e5m2_t _f32_to_f8e5m2(float val) {
+    uint32_t bits;
+    std::memcpy(&bits, &val, sizeof(bits));
+    const uint8_t sign = static_cast<uint8_t>((bits >> 24) & 0x80);
+    const uint32_t abs_bits = bits & 0x7FFFFFFF;
+
+    if (abs_bits > 0x7F800000) {
+        return fp8e5m2_t{static_cast<uint8_t>(sign | 0x7F)}; // NaN
+    }
+    if (abs_bits == 0x7F800000) {
+        return fp8e5m2_t{static_cast<uint8_t>(sign | 0x7C)}; // Inf
+    }
+    float abs_val;
+    std::memcpy(&abs_val, &abs_bits, sizeof(abs_val));
+    if (abs_val < 1.0f / 16384.0f) {
+        // Subnormal range, step 2^-16; 4 * 2^-16 rounds up to the smallest normal, whose code is also 4
+        const uint32_t mantissa = static_cast<uint32_t>(std::nearbyint(abs_val * 65536.0f));
+        return fp8e5m2_t{static_cast<uint8_t>(sign | mantissa)};
+    }
+    // Normal range: round the float32 mantissa to 2 bits (nearest even)
+    const uint32_t rounded = (abs_bits + 0xFFFFF + ((abs_bits >> 21) & 1)) & 0xFFE00000;
+    const int32_t exponent = static_cast<int32_t>(rounded >> 23) - 127;
+    const uint32_t mantissa = (rounded >> 21) & 0x3;
+    if (exponent > 15) {
+        return fp8e5m2_t{static_cast<uint8_t>(sign | 0x7B)}; // Saturate to the largest finite value
+    }
+    return fp8e5m2_t{static_cast<uint8_t>(sign | ((exponent + 15) << 2) | mantissa)};
+}
 } // namespace llaisys::utils
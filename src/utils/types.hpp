@@ -14,6 +14,20 @@ struct CustomBFloat16 {
 };
 typedef struct CustomBFloat16 bf16_t;
 
+// OCP FP8 E4M3 (LLAISYS_DTYPE_F8): 4 exponent bits (bias 7), 3 mantissa bits, no infinities;
+// the largest finite value is 448.
+struct CustomFloat8E4M3 {
+    uint8_t _v;
+};
+typedef struct CustomFloat8E4M3 fp8e4m3_t;
+
+// OCP FP8 E5M2 (LLAISYS_DTYPE_F8E5M2): 5 exponent bits (bias 15), 2 mantissa bits, i.e. the high
+// byte of a float16; the largest finite value is 57344.
+struct CustomFloat8E5M2 {
+    uint8_t _v;
+};
+typedef struct CustomFloat8E5M2 fp8e5m2_t;
+
 namespace utils {
 inline size_t dsize(llaisysDataType_t dtype) {
     switch (dtype) {
@@ -38,7 +52,9 @@ inline size_t dsize(llaisysDataType_t dtype) {
     case LLAISYS_DTYPE_U64:
         return sizeof(uint64_t);
     case LLAISYS_DTYPE_F8:
-        return 1; // usually 8-bit float (custom)
+        return 1; // float8 e4m3
+    case LLAISYS_DTYPE_F8E5M2:
+        return 1; // float8 e5m2
     case LLAISYS_DTYPE_F16:
         return 2; // 16-bit float
     case LLAISYS_DTYPE_BF16:
@@ -84,7 +100,9 @@ inline const char *dtype_to_str(llaisysDataType_t dtype) {
     case LLAISYS_DTYPE_U64:
         return "uint64";
     case LLAISYS_DTYPE_F8:
-        return "float8";
+        return "float8_e4m3";
+    case LLAISYS_DTYPE_F8E5M2:
+        return "float8_e5m2";
     case LLAISYS_DTYPE_F16:
         return "float16";
     case LLAISYS_DTYPE_BF16:
@@ -113,6 +131,14 @@ fp16_t _f32_to_f16(float val);
 float _bf16_to_f32(bf16_t val);
 bf16_t _f32_to_bf16(float val);
 
+float _f8e4m3_to_f32(fp8e4m3_t val);
+// Rounds to nearest even and saturates to +-448 (NaN stays NaN).
+fp8e4m3_t _f32_to_f8e4m3(float val);
+
+float _f8e5m2_to_f32(fp8e5m2_t val);
+// Rounds to nearest even and saturates finite values to +-57344 (infinities and NaN are kept).
+fp8e5m2_t _f32_to_f8e5m2(float val);
+
 template <typename TypeTo, typename TypeFrom>
 TypeTo cast(TypeFrom val) {
     if constexpr (std::is_same<TypeTo, TypeFrom>::value) {
@@ -133,6 +159,22 @@ TypeTo cast(TypeFrom val) {
         return _bf16_to_f32(val);
     } else if constexpr (std::is_same<TypeFrom, bf16_t>::value && !std::is_same<TypeTo, float>::value) {
         return static_cast<TypeTo>(_bf16_to_f32(val));
+    } else if constexpr (std::is_same<TypeTo, fp8e4m3_t>::value && std::is_same<TypeFrom, float>::value) {
+        return _f32_to_f8e4m3(val);
+    } else if constexpr (std::is_same<TypeTo, fp8e4m3_t>::value && !std::is_same<TypeFrom, float>::value) {
+        return _f32_to_f8e4m3(cast<float>(val));
+    } else if constexpr (std::is_same<TypeFrom, fp8e4m3_t>::value && std::is_same<TypeTo, float>::value) {
+        return _f8e4m3_to_f32(val);
+    } else if constexpr (std::is_same<TypeFrom, fp8e4m3_t>::value && !std::is_same<TypeTo, float>::value) {
+        return cast<TypeTo>(_f8e4m3_to_f32(val));
+    } else if constexpr (std::is_same<TypeTo, fp8e5m2_t>::value && std::is_same<TypeFrom, float>::value) {
+        return _f32_to_f8e5m2(val);
+    } else if constexpr (std::is_same<TypeTo, fp8e5m2_t>::value && !std::is_same<TypeFrom, float>::value) {
+        return _f32_to_f8e5m2(cast<float>(val));
+    } else if constexpr (std::is_same<TypeFrom, fp8e5m2_t>::value && std::is_same<TypeTo, float>::value) {
+        return _f8e5m2_to_f32(val);
+    } else if constexpr (std::is_same<TypeFrom, fp8e5m2_t>::value && !std::is_same<TypeTo, float>::value) {
+        return cast<TypeTo>(_f8e5m2_to_f32(val));
     } else {
         return static_cast<TypeTo>(val);
     }
@@ -0,0 +1,54 @@
+import sys
+import os
+
+parent_dir = os.path.abspath(os.path.join(os.path.dirname(__file__), ".."))
+sys.path.insert(0, parent_dir)
+import llaisys
+import torch
+from test_utils import random_tensor, zero_tensor, check_equal, benchmark
+
+
+def copy_to_torch(dst, src):
+    api = llaisys.RuntimeAPI(llaisys.DeviceType.CPU)
+    api.memcpy_sync(dst.data_ptr(), src.data_ptr(), dst.numel() * dst.element_size(), llaisys.MemcpyKind.D2D)
+
+
+def test_op_cast(shape, src_dtype_name, fp8_dtype_name, device_name="cpu", profile=False):
+    print(f"   shape {shape} <{src_dtype_name}> -> <{fp8_dtype_name}> -> <{src_dtype_name}>")
+    # 取值在两种 fp8 的有限范围内（E4M3 最大 448），torch 的转换在此范围内同样就近舍入
+    x, x_ = random_tensor(shape, src_dtype_name, device_name, scale=800.0, bias=-400.0)
+
+    # 1. 转为 fp8：逐位与 torch 一致
+    q, q_ = zero_tensor(shape, fp8_dtype_name, device_name)
+    llaisys.Ops.cast(q_, x_)
+    copy_to_torch(q, q_)
+    assert torch.equal(q.view(torch.uint8), x.to(q.dtype).view(torch.uint8))
+
+    # 2. 转回原类型：fp8 的每个取值都可精确表示
+    y, y_ = zero_tensor(shape, src_dtype_name, device_name)
+    llaisys.Ops.cast(y_, q_)
+    assert check_equal(y_, q.to(x.dtype), strict=True)
+
+    if profile:
+        benchmark(
+            lambda: x.to(q.dtype),
+            lambda: llaisys.Ops.cast(q_, x_),
+            device_name,
+        )
+
+
+if __name__ == "__main__":
+    import argparse
+
+    parser = argparse.ArgumentParser()
+    parser.add_argument("--device", default="cpu", choices=["cpu", "nvidia"], type=str)
+    parser.add_argument("--profile", action="store_true")
+    args = parser.parse_args()
+    testShapes = [(2, 3), (512, 4096)]
+    print(f"Testing Ops.cast on {args.device}")
+    for shape in testShapes:
+        for src_dtype_name in ["f32", "bf16"]:
+            for fp8_dtype_name in ["f8", "f8e5m2"]:
+                test_op_cast(shape, src_dtype_name, fp8_dtype_name, args.device, args.profile)
+
+    print("\033[92mTest passed!\033[0m\n")
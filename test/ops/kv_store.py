@@ -0,0 +1,79 @@
+import sys
+import os
+
+parent_dir = os.path.abspath(os.path.join(os.path.dirname(__file__), ".."))
+sys.path.insert(0, parent_dir)
+import llaisys
+import torch
+from test_utils import random_tensor, zero_tensor, check_equal, benchmark
+
+
+def copy_between(dst, src):
+    api = llaisys.RuntimeAPI(llaisys.DeviceType.CPU)
+    api.memcpy_sync(dst.data_ptr(), src.data_ptr(), dst.numel() * dst.element_size(), llaisys.MemcpyKind.D2D)
+
+
+def torch_kv_store(cache, src, slots):
+    cache[slots] = src
+
+
+def test_op_kv_store(n, capacity, nh, hd, kv_dtype_name=None, dtype_name="f32", device_name="cpu", profile=False):
+    print(f"   n={n} capacity={capacity} nh={nh} hd={hd} kv <{kv_dtype_name or dtype_name}> dtype <{dtype_name}>")
+    src, src_ = random_tensor((n, nh, hd), dtype_name, device_name)
+    slots = torch.randperm(capacity)[:n]
+    _, slots_ = zero_tensor((n,), "i64", device_name)
+    copy_between(slots_, slots)
+
+    if kv_dtype_name is None:
+        cache, cache_ = zero_tensor((capacity, nh, hd), dtype_name, device_name)
+        torch_kv_store(cache, src, slots)
+        llaisys.Ops.kv_store(cache_, None, src_, slots_)
+        assert check_equal(cache_, cache, strict=True)
+        scales_ = None
+    else:
+        # 写入的行应与 quantize_kv 对同一输入的量化结果逐字节一致
+        q, q_ = zero_tensor((n, nh, hd), kv_dtype_name, device_name)
+        s, s_ = zero_tensor((n, nh), "f32", device_name)
+        llaisys.Ops.quantize_kv(q_, s_, src_)
+        copy_between(q, q_)
+        copy_between(s, s_)
+
+        cache, cache_ = zero_tensor((capacity, nh, hd), kv_dtype_name, device_name)
+        scales, scales_ = zero_tensor((capacity, nh), "f32", device_name)
+        llaisys.Ops.kv_store(cache_, scales_, src_, slots_)
+        torch_kv_store(cache.view(torch.uint8), q.view(torch.uint8), slots)
+        torch_kv_store(scales, s, slots)
+        got = torch.zeros_like(cache)
+        copy_between(got, cache_)
+        assert torch.equal(got.view(torch.uint8), cache.view(torch.uint8))
+        assert check_equal(scales_, scales, strict=True)
+
+    if profile:
+        benchmark(
+            lambda: torch_kv_store(cache, src, slots),
+            lambda: llaisys.Ops.kv_store(cache_, scales_, src_, slots_),
+            device_name,
+        )
+
+
+if __name__ == "__main__":
+    import argparse
+
+    parser = argparse.ArgumentParser()
+    parser.add_argument("--device", default="cpu", choices=["cpu", "nvidia"], type=str)
+    parser.add_argument("--profile", action="store_true")
+    args = parser.parse_args()
+    testShapes = [
+        # n, capacity, nh, hd
+        (1, 4, 1, 4),
+        (5, 16, 2, 8),
+        (1, 512, 2, 128),
+    ]
+    testDtype = ["f32", "f16", "bf16"]
+    print(f"Testing Ops.kv_store on {args.device}")
+    for shape in testShapes:
+        for kv_dtype_name in [None, "i8", "f8", "f8e5m2"]:
+            for dtype_name in testDtype:
+                test_op_kv_store(*shape, kv_dtype_name, dtype_name, args.device, args.profile)
+
+    print("\033[92mTest passed!\033[0m\n")
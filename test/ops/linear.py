@@ -45,6 +45,21 @@ def test_op_linear(
         )
 
 
+def test_op_linear_strided(n, k, m, dtype_name="f32", atol=1e-5, rtol=1e-5, device_name="cpu"):
+    # 输入取自融合缓冲区 [n, 2k] 的列切片，输出写入 [n, 3m] 的中间 m 列，不经过拷贝
+    print(f"   strided n={n} k={k} m={m} dtype <{dtype_name}>")
+    x, x_ = random_tensor((n, 2 * k), dtype_name, device_name, scale=0.1)
+    w, w_ = random_tensor((m, k), dtype_name, device_name, scale=0.01)
+    bias, bias_ = random_tensor((m,), dtype_name, device_name)
+    fused, fused_ = random_tensor((n, 3 * m), dtype_name, device_name)
+
+    expected = fused.clone()
+    torch_linear(expected[:, m : 2 * m], x[:, k:], w, bias)
+    llaisys.Ops.linear(fused_.slice(1, m, 2 * m), x_.slice(1, k, 2 * k), w_, bias_)
+
+    assert check_equal(fused_, expected, atol=atol, rtol=rtol)
+
+
 if __name__ == "__main__":
     import argparse
 
@@ -66,5 +81,7 @@ if __name__ == "__main__":
     for shapes in testShapes:
         for dtype_name, atol, rtol in testDtypePrec:
             test_op_linear(*shapes, dtype_name, atol, rtol, args.device, args.profile)
+    for dtype_name, atol, rtol in testDtypePrec:
+        test_op_linear_strided(3, 16, 8, dtype_name, atol, rtol, args.device)
 
     print("\033[92mTest passed!\033[0m\n")
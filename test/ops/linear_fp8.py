@@ -0,0 +1,86 @@
+import sys
+import os
+
+parent_dir = os.path.abspath(os.path.join(os.path.dirname(__file__), ".."))
+sys.path.insert(0, parent_dir)
+import llaisys
+import torch
+from test_utils import random_tensor, zero_tensor, check_equal, benchmark
+
+
+def torch_linear_fp8(out, x, q, s, bias):
+    # 以反量化后的权重作参考，只检验 kernel 本身的数值误差
+    w = (q.float() * s[:, None]).to(x.dtype)
+    torch.nn.functional.linear(x, w, bias, out=out)
+
+
+def test_op_linear_fp8(
+    out_shape,
+    x_shape,
+    w_shape,
+    use_bias=True,
+    fp8_dtype_name="f8",
+    dtype_name="f32",
+    atol=1e-5,
+    rtol=1e-5,
+    device_name="cpu",
+    profile=False,
+):
+    print(f"   out {out_shape}, x {x_shape}, w {w_shape}, bias {use_bias}, w <{fp8_dtype_name}>, dtype <{dtype_name}>")
+    x, x_ = random_tensor(x_shape, dtype_name, device_name, scale=0.1)
+    w, w_ = random_tensor(w_shape, dtype_name, device_name, scale=0.02, bias=-0.01)
+    q, q_ = zero_tensor(w_shape, fp8_dtype_name, device_name)
+    s, s_ = zero_tensor((w_shape[0],), "f32", device_name)
+    llaisys.Ops.quantize_fp8(q_, s_, w_)
+    api = llaisys.RuntimeAPI(llaisys.DeviceType.CPU)
+    api.memcpy_sync(q.data_ptr(), q_.data_ptr(), q.numel(), llaisys.MemcpyKind.D2D)
+    api.memcpy_sync(s.data_ptr(), s_.data_ptr(), s.numel() * 4, llaisys.MemcpyKind.D2D)
+
+    # 缩放系数把每个输出通道的最大绝对值映射到 fp8 的最大有限值
+    fp8_max = torch.finfo(q.dtype).max
+    assert torch.allclose(s, w.float().abs().amax(dim=1) / fp8_max, rtol=1e-6)
+
+    bias, bias_ = None, None
+    if use_bias:
+        bias, bias_ = random_tensor((w_shape[0],), dtype_name, device_name)
+
+    out, out_ = random_tensor(out_shape, dtype_name, device_name)
+    torch_linear_fp8(out, x, q, s, bias)
+    llaisys.Ops.linear_fp8(out_, x_, q_, s_, bias_)
+
+    assert check_equal(out_, out, atol=atol, rtol=rtol)
+
+    if profile:
+        w_ref = (q.float() * s[:, None]).to(x.dtype)
+        benchmark(
+            lambda: torch.nn.functional.linear(x, w_ref, bias, out=out),
+            lambda: llaisys.Ops.linear_fp8(out_, x_, q_, s_, bias_),
+            device_name,
+        )
+
+
+if __name__ == "__main__":
+    import argparse
+
+    parser = argparse.ArgumentParser()
+    parser.add_argument("--device", default="cpu", choices=["cpu", "nvidia"], type=str)
+    parser.add_argument("--profile", action="store_true")
+    args = parser.parse_args()
+    testShapes = [
+        ((2, 3), (2, 4), (3, 4), True),
+        ((1, 4096), (1, 4096), (4096, 4096), False),
+        ((7, 1536), (7, 1536), (1536, 1536), True),
+    ]
+    testDtypePrec = [
+        # type, atol, rtol
+        ("f32", 1e-4, 1e-4),
+        ("f16", 1e-3, 1e-3),
+        ("bf16", 1e-2, 1e-2),
+    ]
+    print(f"Testing Ops.linear_fp8 on {args.device}")
+    for shapes in testShapes:
+        for fp8_dtype_name in ["f8", "f8e5m2"]:
+            for dtype_name, atol, rtol in testDtypePrec:
+                test_op_linear_fp8(*shapes, fp8_dtype_name, dtype_name, atol, rtol, args.device, args.profile)
+
+    print("\033[92mTest passed!\033[0m\n")
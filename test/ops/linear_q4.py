@@ -0,0 +1,105 @@
+import sys
+import os
+
+parent_dir = os.path.abspath(os.path.join(os.path.dirname(__file__), ".."))
+sys.path.insert(0, parent_dir)
+import llaisys
+import torch
+from test_utils import random_tensor, zero_tensor, check_equal, benchmark
+
+
+def dequantize_q4(q, s, z, group_size):
+    # 每 32 个元素一块：低 4 位为前 16 个元素，高 4 位为后 16 个元素
+    rows = q.shape[0]
+    blocks = q.reshape(rows, -1, 16).int()
+    values = torch.cat([blocks & 0x0F, blocks >> 4], dim=2).reshape(rows, -1).float()
+    zero = z.float() if z is not None else torch.full(s.shape, 8.0)
+    return (values - zero.repeat_interleave(group_size, dim=1)) * s.float().repeat_interleave(group_size, dim=1)
+
+
+def torch_linear_q4(out, x, q, s, z, bias, group_size):
+    # 以反量化后的权重作参考，只检验 kernel 本身的数值误差
+    w = dequantize_q4(q, s, z, group_size).to(x.dtype)
+    torch.nn.functional.linear(x, w, bias, out=out)
+
+
+def test_op_linear_q4(
+    out_shape,
+    x_shape,
+    w_shape,
+    group_size,
+    asym,
+    use_bias=True,
+    dtype_name="f32",
+    atol=1e-5,
+    rtol=1e-5,
+    device_name="cpu",
+    profile=False,
+):
+    print(
+        f"   out {out_shape}, x {x_shape}, w {w_shape}, group {group_size}, "
+        f"zero point {asym}, bias {use_bias}, dtype <{dtype_name}>"
+    )
+    M, K = w_shape
+    x, x_ = random_tensor(x_shape, dtype_name, device_name, scale=0.1)
+    w, w_ = random_tensor(w_shape, dtype_name, device_name, scale=0.02, bias=-0.01)
+    q, q_ = zero_tensor((M, K // 2), "u8", device_name)
+    s, s_ = zero_tensor((M, K // group_size), "f16", device_name)
+    z, z_ = (None, None)
+    if asym:
+        z, z_ = zero_tensor((M, K // group_size), "u8", device_name)
+    llaisys.Ops.quantize_q4(q_, s_, z_, w_)
+    api = llaisys.RuntimeAPI(llaisys.DeviceType.CPU)
+    api.memcpy_sync(q.data_ptr(), q_.data_ptr(), q.numel(), llaisys.MemcpyKind.D2D)
+    api.memcpy_sync(s.data_ptr(), s_.data_ptr(), s.numel() * 2, llaisys.MemcpyKind.D2D)
+    if asym:
+        api.memcpy_sync(z.data_ptr(), z_.data_ptr(), z.numel(), llaisys.MemcpyKind.D2D)
+
+    bias, bias_ = None, None
+    if use_bias:
+        bias, bias_ = random_tensor((M,), dtype_name, device_name)
+
+    out, out_ = random_tensor(out_shape, dtype_name, device_name)
+    torch_linear_q4(out, x, q, s, z, bias, group_size)
+    llaisys.Ops.linear_q4(out_, x_, q_, s_, z_, bias_)
+
+    assert check_equal(out_, out, atol=atol, rtol=rtol)
+
+    if profile:
+        w_ref = dequantize_q4(q, s, z, group_size).to(x.dtype)
+        benchmark(
+            lambda: torch.nn.functional.linear(x, w_ref, bias, out=out),
+            lambda: llaisys.Ops.linear_q4(out_, x_, q_, s_, z_, bias_),
+            device_name,
+        )
+
+
+if __name__ == "__main__":
+    import argparse
+
+    parser = argparse.ArgumentParser()
+    parser.add_argument("--device", default="cpu", choices=["cpu", "nvidia"], type=str)
+    parser.add_argument("--profile", action="store_true")
+    args = parser.parse_args()
+    testShapes = [
+        # out, x, w, group_size, bias
+        ((2, 3), (2, 64), (3, 64), 32, True),
+        ((1, 4096), (1, 4096), (4096, 4096), 128, False),
+        ((7, 1536), (7, 1536), (1536, 1536), 64, True),
+    ]
+    testDtypePrec = [
+        # type, atol, rtol
+        ("f32", 1e-4, 1e-4),
+        ("f16", 1e-3, 1e-3),
+        ("bf16", 1e-2, 1e-2),
+    ]
+    print(f"Testing Ops.linear_q4 on {args.device}")
+    for out_shape, x_shape, w_shape, group_size, use_bias in testShapes:
+        for asym in [False, True]:
+            for dtype_name, atol, rtol in testDtypePrec:
+                test_op_linear_q4(
+                    out_shape, x_shape, w_shape, group_size, asym, use_bias,
+                    dtype_name, atol, rtol, args.device, args.profile,
+                )
+
+    print("\033[92mTest passed!\033[0m\n")
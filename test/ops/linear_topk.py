@@ -0,0 +1,94 @@
+import sys
+import os
+
+parent_dir = os.path.abspath(os.path.join(os.path.dirname(__file__), ".."))
+sys.path.insert(0, parent_dir)
+import llaisys
+import torch
+from test_utils import random_tensor, zero_tensor, check_equal, benchmark
+
+
+def torch_topk(logits, k):
+    # 稳定降序排序：相等的值下标小者在前，与 argmax 取第一个最大值一致
+    vals, idx = torch.sort(logits.float(), dim=-1, descending=True, stable=True)
+    return idx[:, :k], vals[:, :k].to(logits.dtype)
+
+
+def test_op_linear_topk(
+    x_shape,
+    w_shape,
+    k,
+    quantized=False,
+    dtype_name="f32",
+    device_name="cpu",
+    profile=False,
+):
+    print(f"   x {x_shape}, w {w_shape}, k {k}, int8 {quantized}, dtype <{dtype_name}>")
+    N, M = x_shape[0], w_shape[0]
+    x, x_ = random_tensor(x_shape, dtype_name, device_name, bias=-0.5)
+    w, w_ = random_tensor(w_shape, dtype_name, device_name, scale=0.1, bias=-0.05)
+    scales_ = None
+    if quantized:
+        _, q_ = zero_tensor(w_shape, "i8", device_name)
+        _, scales_ = zero_tensor((M,), "f32", device_name)
+        llaisys.Ops.quantize_q8(q_, scales_, w_)
+        w_ = q_
+
+    # 参考：非融合的 linear 写出完整 logits 后再排序，选择结果须逐位一致
+    logits, logits_ = zero_tensor((N, M), dtype_name, device_name)
+    if quantized:
+        llaisys.Ops.linear_q8(logits_, x_, w_, scales_, None)
+    else:
+        _, zero_bias_ = zero_tensor((M,), dtype_name, device_name)
+        llaisys.Ops.linear(logits_, x_, w_, zero_bias_)
+    api = llaisys.RuntimeAPI(llaisys.DeviceType.CPU)
+    api.memcpy_sync(logits.data_ptr(), logits_.data_ptr(), logits.numel() * logits.element_size(), llaisys.MemcpyKind.D2D)
+    idx, vals = torch_topk(logits, k)
+
+    out_idx, out_idx_ = zero_tensor((N, k), "i64", device_name)
+    out_val, out_val_ = zero_tensor((N, k), dtype_name, device_name)
+    llaisys.Ops.linear_topk(out_idx_, out_val_, x_, w_, scales_)
+    assert check_equal(out_idx_, idx, strict=True)
+    assert check_equal(out_val_, vals, strict=True)
+
+    # 要求写出完整 logits 时结果不变，logits 与非融合路径相同
+    _, full_ = zero_tensor((N, M), dtype_name, device_name)
+    llaisys.Ops.linear_topk(out_idx_, out_val_, x_, w_, scales_, None, full_)
+    assert check_equal(out_idx_, idx, strict=True)
+    assert check_equal(full_, logits, strict=True)
+
+    if profile and N == 1:
+        _, max_idx_ = zero_tensor((1,), "i64", device_name)
+        _, max_val_ = zero_tensor((1,), dtype_name, device_name)
+        benchmark(
+            lambda: (
+                llaisys.Ops.linear_q8(logits_, x_, w_, scales_, None) if quantized
+                else llaisys.Ops.linear(logits_, x_, w_, zero_bias_),
+                llaisys.Ops.argmax(max_idx_, max_val_, logits_.view(N * M)),
+            ),
+            lambda: llaisys.Ops.linear_topk(out_idx_, out_val_, x_, w_, scales_),
+            device_name,
+        )
+
+
+if __name__ == "__main__":
+    import argparse
+
+    parser = argparse.ArgumentParser()
+    parser.add_argument("--device", default="cpu", choices=["cpu", "nvidia"], type=str)
+    parser.add_argument("--profile", action="store_true")
+    args = parser.parse_args()
+    testShapes = [
+        # x, w, k
+        ((1, 8), (5, 8), 1),
+        ((1, 256), (1000, 256), 1),
+        ((3, 256), (1000, 256), 16),
+        ((1, 1536), (32000, 1536), 1),
+    ]
+    print(f"Testing Ops.linear_topk on {args.device}")
+    for x_shape, w_shape, k in testShapes:
+        for dtype_name in ["f32", "f16", "bf16"]:
+            for quantized in [False, True]:
+                test_op_linear_topk(x_shape, w_shape, k, quantized, dtype_name, args.device, args.profile)
+
+    print("\033[92mTest passed!\033[0m\n")
@@ -0,0 +1,96 @@
+import sys
+import os
+
+parent_dir = os.path.abspath(os.path.join(os.path.dirname(__file__), ".."))
+sys.path.insert(0, parent_dir)
+import llaisys
+import torch
+from test_utils import random_tensor, zero_tensor, check_equal, benchmark
+
+
+def torch_linear_w8a8(out, x, q, s, bias):
+    # 逐 token 对称量化激活，再做整数矩阵乘（float64 下精确）并乘回缩放系数
+    absmax = x.float().abs().amax(dim=1)
+    xs = absmax / 127.0
+    inv = torch.where(absmax > 0, 127.0 / absmax, torch.zeros_like(absmax))
+    xq = torch.round(x.float() * inv[:, None]).clamp(-127, 127)
+    acc = (xq.double() @ q.double().T).float()
+    y = acc * (xs[:, None] * s[None, :])
+    if bias is not None:
+        y = y + bias.float()
+    out.copy_(y.to(out.dtype))
+
+
+def test_op_linear_w8a8(
+    out_shape,
+    x_shape,
+    w_shape,
+    use_bias=True,
+    dtype_name="f32",
+    atol=1e-5,
+    rtol=1e-5,
+    max_rel_error=2e-2,
+    device_name="cpu",
+    profile=False,
+):
+    print(f"   out {out_shape}, x {x_shape}, w {w_shape}, bias {use_bias}, dtype <{dtype_name}>")
+    x, x_ = random_tensor(x_shape, dtype_name, device_name, scale=0.1)
+    w, w_ = random_tensor(w_shape, dtype_name, device_name, scale=0.02, bias=-0.01)
+    q, q_ = zero_tensor(w_shape, "i8", device_name)
+    s, s_ = zero_tensor((w_shape[0],), "f32", device_name)
+    llaisys.Ops.quantize_q8(q_, s_, w_)
+    api = llaisys.RuntimeAPI(llaisys.DeviceType.CPU)
+    api.memcpy_sync(q.data_ptr(), q_.data_ptr(), q.numel(), llaisys.MemcpyKind.D2D)
+    api.memcpy_sync(s.data_ptr(), s_.data_ptr(), s.numel() * 4, llaisys.MemcpyKind.D2D)
+
+    bias, bias_ = None, None
+    if use_bias:
+        bias, bias_ = random_tensor((w_shape[0],), dtype_name, device_name)
+
+    out, out_ = random_tensor(out_shape, dtype_name, device_name)
+    torch_linear_w8a8(out, x, q, s, bias)
+    llaisys.Ops.linear_w8a8(out_, x_, q_, s_, bias_)
+
+    # 与同样量化的参考实现逐元素比较：整数累加是精确的
+    assert check_equal(out_, out, atol=atol, rtol=rtol)
+
+    # 与未量化的浮点 linear 比较整体相对误差，衡量权重与激活量化带来的精度损失
+    ref = torch.nn.functional.linear(x.float(), w.float(), bias.float() if bias is not None else None)
+    rel_error = ((out.float() - ref).norm() / ref.norm()).item()
+    print(f"      relative error vs linear: {rel_error:.2e}")
+    assert rel_error < max_rel_error
+
+    if profile:
+        w_ref = (q.float() * s[:, None]).to(x.dtype)
+        benchmark(
+            lambda: torch.nn.functional.linear(x, w_ref, bias, out=out),
+            lambda: llaisys.Ops.linear_w8a8(out_, x_, q_, s_, bias_),
+            device_name,
+        )
+
+
+if __name__ == "__main__":
+    import argparse
+
+    parser = argparse.ArgumentParser()
+    parser.add_argument("--device", default="cpu", choices=["cpu", "nvidia"], type=str)
+    parser.add_argument("--profile", action="store_true")
+    args = parser.parse_args()
+    testShapes = [
+        ((2, 3), (2, 4), (3, 4), True),
+        ((7, 1536), (7, 1536), (1536, 1536), True),
+        ((128, 896), (128, 4864), (896, 4864), False),
+        ((5, 100), (5, 100), (100, 100), True),
+    ]
+    testDtypePrec = [
+        # type, atol, rtol
+        ("f32", 1e-4, 1e-4),
+        ("f16", 1e-3, 1e-3),
+        ("bf16", 1e-2, 1e-2),
+    ]
+    print(f"Testing Ops.linear_w8a8 on {args.device}")
+    for shapes in testShapes:
+        for dtype_name, atol, rtol in testDtypePrec:
+            test_op_linear_w8a8(*shapes, dtype_name, atol, rtol, device_name=args.device, profile=args.profile)
+
+    print("\033[92mTest passed!\033[0m\n")
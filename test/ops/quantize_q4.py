@@ -0,0 +1,98 @@
+import sys
+import os
+
+parent_dir = os.path.abspath(os.path.join(os.path.dirname(__file__), ".."))
+sys.path.insert(0, parent_dir)
+import llaisys
+import torch
+from test_utils import random_tensor, zero_tensor, check_equal, benchmark
+
+
+def unpack_q4(packed):
+    # 每 32 个元素一块：低 4 位为前 16 个元素，高 4 位为后 16 个元素
+    rows = packed.shape[0]
+    blocks = packed.reshape(rows, -1, 16).int()
+    return torch.cat([blocks & 0x0F, blocks >> 4], dim=2).reshape(rows, -1)
+
+
+def torch_quantize_q4_scales(w, group_size, asym):
+    # 取值范围包含 0，缩放系数舍入到 float16
+    g = w.float().reshape(w.shape[0], -1, group_size)
+    lo = g.amin(dim=2).clamp(max=0)
+    hi = g.amax(dim=2).clamp(min=0)
+    if asym:
+        return ((hi - lo) / 15.0).half()
+    return (torch.maximum(-lo, hi) / 7.0).half()
+
+
+def copy_to_torch(dst, src, nbytes):
+    api = llaisys.RuntimeAPI(llaisys.DeviceType.CPU)
+    api.memcpy_sync(dst.data_ptr(), src.data_ptr(), nbytes, llaisys.MemcpyKind.D2D)
+
+
+def test_op_quantize_q4(
+    shape,
+    group_size,
+    asym,
+    dtype_name="f32",
+    device_name="cpu",
+    profile=False,
+):
+    print(f"   shape {shape} group {group_size} zero point {asym} dtype <{dtype_name}>")
+    M, K = shape
+    w, w_ = random_tensor(shape, dtype_name, device_name, scale=0.2, bias=-0.1)
+    q, q_ = zero_tensor((M, K // 2), "u8", device_name)
+    s, s_ = zero_tensor((M, K // group_size), "f16", device_name)
+    z, z_ = (None, None)
+    if asym:
+        z, z_ = zero_tensor((M, K // group_size), "u8", device_name)
+
+    llaisys.Ops.quantize_q4(q_, s_, z_, w_)
+
+    s_ref = torch_quantize_q4_scales(w, group_size, asym)
+    assert check_equal(s_, s_ref, atol=1e-6, rtol=1e-3)
+
+    # 以 llaisys 给出的缩放系数和零点重新计算量化值，舍入边界上允许 ±1 的差异
+    copy_to_torch(q, q_, q.numel())
+    copy_to_torch(s, s_, s.numel() * 2)
+    zero = torch.full_like(s, 8, dtype=torch.float32)
+    if asym:
+        copy_to_torch(z, z_, z.numel())
+        zero = z.float()
+        safe = torch.where(s > 0, s.float(), torch.ones_like(zero))
+        lo = w.float().reshape(M, -1, group_size).amin(dim=2).clamp(max=0)
+        assert torch.all((torch.round(-lo / safe).clamp(0, 15) - zero).abs() <= 1)
+    safe = torch.where(s > 0, s.float(), torch.ones_like(zero))
+    inv = (1.0 / safe).repeat_interleave(group_size, dim=1)
+    q_ref = (torch.round(w.float() * inv) + zero.repeat_interleave(group_size, dim=1)).clamp(0, 15)
+    assert torch.all((unpack_q4(q).float() - q_ref).abs() <= 1)
+
+    if profile:
+        benchmark(
+            lambda: torch_quantize_q4_scales(w, group_size, asym),
+            lambda: llaisys.Ops.quantize_q4(q_, s_, z_, w_),
+            device_name,
+        )
+
+
+if __name__ == "__main__":
+    import argparse
+
+    parser = argparse.ArgumentParser()
+    parser.add_argument("--device", default="cpu", choices=["cpu", "nvidia"], type=str)
+    parser.add_argument("--profile", action="store_true")
+    args = parser.parse_args()
+    testShapes = [
+        # shape, group_size
+        ((3, 64), 32),
+        ((1536, 1536), 128),
+        ((256, 4096), 64),
+    ]
+    testDtype = ["f32", "f16", "bf16"]
+    print(f"Testing Ops.quantize_q4 on {args.device}")
+    for shape, group_size in testShapes:
+        for asym in [False, True]:
+            for dtype_name in testDtype:
+                test_op_quantize_q4(shape, group_size, asym, dtype_name, args.device, args.profile)
+
+    print("\033[92mTest passed!\033[0m\n")
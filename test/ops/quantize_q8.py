@@ -0,0 +1,58 @@
+import sys
+import os
+
+parent_dir = os.path.abspath(os.path.join(os.path.dirname(__file__), ".."))
+sys.path.insert(0, parent_dir)
+import llaisys
+import torch
+from test_utils import random_tensor, zero_tensor, check_equal, benchmark
+
+
+def torch_quantize_q8(w):
+    scales = w.float().abs().amax(dim=1) / 127.0
+    safe = torch.where(scales > 0, scales, torch.ones_like(scales))
+    q = torch.round(w.float() / safe[:, None]).clamp(-127, 127).to(torch.int8)
+    return q, scales
+
+
+def test_op_quantize_q8(
+    shape,
+    dtype_name="f32",
+    device_name="cpu",
+    profile=False,
+):
+    print(f"   shape {shape} dtype <{dtype_name}>")
+    w, w_ = random_tensor(shape, dtype_name, device_name, scale=0.2, bias=-0.1)
+    q, q_ = zero_tensor(shape, "i8", device_name)
+    s, s_ = zero_tensor((shape[0],), "f32", device_name)
+
+    q, s = torch_quantize_q8(w)
+    llaisys.Ops.quantize_q8(q_, s_, w_)
+
+    assert check_equal(s_, s, atol=1e-7, rtol=1e-6)
+    # 舍入边界上允许 ±1 的差异
+    assert check_equal(q_, q, atol=1, rtol=0)
+
+    if profile:
+        benchmark(
+            lambda: torch_quantize_q8(w),
+            lambda: llaisys.Ops.quantize_q8(q_, s_, w_),
+            device_name,
+        )
+
+
+if __name__ == "__main__":
+    import argparse
+
+    parser = argparse.ArgumentParser()
+    parser.add_argument("--device", default="cpu", choices=["cpu", "nvidia"], type=str)
+    parser.add_argument("--profile", action="store_true")
+    args = parser.parse_args()
+    testShapes = [(3, 4), (1536, 1536)]
+    testDtype = ["f32", "f16", "bf16"]
+    print(f"Testing Ops.quantize_q8 on {args.device}")
+    for shape in testShapes:
+        for dtype_name in testDtype:
+            test_op_quantize_q8(shape, dtype_name, args.device, args.profile)
+
+    print("\033[92mTest passed!\033[0m\n")
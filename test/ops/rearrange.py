@@ -0,0 +1,66 @@
+import sys
+import os
+
+parent_dir = os.path.abspath(os.path.join(os.path.dirname(__file__), ".."))
+sys.path.insert(0, parent_dir)
+import llaisys
+import torch
+from test_utils import random_tensor, check_equal, benchmark
+
+
+def test_op_rearrange_permute(shape, perm, dtype_name="f32", device_name="cpu", profile=False):
+    print(f"   permute shape {shape} perm {perm} dtype <{dtype_name}>")
+    x, x_ = random_tensor(shape, dtype_name, device_name)
+    expected = x.permute(*perm).contiguous()
+    out, out_ = random_tensor(expected.shape, dtype_name, device_name)
+    llaisys.Ops.rearrange(out_, x_.permute(*perm))
+    assert check_equal(out_, expected, strict=True)
+
+    if profile:
+        benchmark(
+            lambda: out.copy_(x.permute(*perm)),
+            lambda: llaisys.Ops.rearrange(out_, x_.permute(*perm)),
+            device_name,
+        )
+
+
+def test_op_rearrange_slice(shape, dtype_name="f32", device_name="cpu"):
+    # 写入目标的子块：[1:-1, 1:-1, ...]，块外内容保持不变
+    print(f"   slice shape {shape} dtype <{dtype_name}>")
+    inner = tuple(d - 2 for d in shape)
+    x, x_ = random_tensor(inner, dtype_name, device_name)
+    out, out_ = random_tensor(shape, dtype_name, device_name)
+    expected = out.clone()
+    index = tuple(slice(1, d - 1) for d in shape)
+    expected[index] = x
+
+    dst_ = out_
+    for dim, d in enumerate(shape):
+        dst_ = dst_.slice(dim, 1, d - 1)
+    llaisys.Ops.rearrange(dst_, x_)
+    assert check_equal(out_, expected, strict=True)
+
+
+if __name__ == "__main__":
+    import argparse
+
+    parser = argparse.ArgumentParser()
+    parser.add_argument("--device", default="cpu", choices=["cpu", "nvidia"], type=str)
+    parser.add_argument("--profile", action="store_true")
+    args = parser.parse_args()
+    testPermutes = [
+        # shape, perm
+        ((3, 5), (1, 0)),
+        ((4, 6, 8), (2, 0, 1)),
+        ((64, 32, 128), (1, 0, 2)),
+    ]
+    testSlices = [(4, 7), (5, 6, 9)]
+    testDtype = ["f32", "f16", "bf16"]
+    print(f"Testing Ops.rearrange on {args.device}")
+    for dtype_name in testDtype:
+        for shape, perm in testPermutes:
+            test_op_rearrange_permute(shape, perm, dtype_name, args.device, args.profile)
+        for shape in testSlices:
+            test_op_rearrange_slice(shape, dtype_name, args.device)
+
+    print("\033[92mTest passed!\033[0m\n")
@@ -0,0 +1,151 @@
+import sys
+import os
+
+parent_dir = os.path.abspath(os.path.join(os.path.dirname(__file__), ".."))
+sys.path.insert(0, parent_dir)
+import llaisys
+import torch
+from llaisys.libllaisys import LlaisysSamplingParams
+from test_utils import random_tensor, zero_tensor, check_equal, benchmark, llaisys_device
+
+
+def to_torch(torch_out, llaisys_tensor, device_name):
+    api = llaisys.RuntimeAPI(llaisys_device(device_name))
+    api.memcpy_sync(
+        torch_out.data_ptr(),
+        llaisys_tensor.data_ptr(),
+        torch_out.numel() * torch_out.element_size(),
+        llaisys.MemcpyKind.D2D,
+    )
+    return torch_out
+
+
+def seed_tensor(seeds, device_name):
+    # uint64 状态与 int64 的字节表示相同，借 int64 张量传入
+    seeds = torch.tensor(seeds, dtype=torch.int64)
+    state = llaisys.Tensor(seeds.shape, dtype=llaisys.DataType.U64, device=llaisys_device(device_name))
+    state.load(seeds.data_ptr())
+    return state
+
+
+def torch_probs(logits, temperature, top_k, top_p):
+    # 参考分布：先 top-k 再 top-p（保留累计概率首次达到 top_p 的最短前缀）
+    x = logits.double() / temperature
+    order = torch.argsort(x, descending=True, stable=True)
+    if top_k > 0:
+        order = order[:top_k]
+    p = torch.softmax(x[order], dim=-1) if top_k > 0 else torch.softmax(x, dim=-1)[order]
+    if top_p < 1.0:
+        n = int(torch.searchsorted(torch.cumsum(p, 0), torch.tensor(top_p - 1e-9, dtype=p.dtype))) + 1
+        order, p = order[:n], p[:n]
+    probs = torch.zeros_like(x)
+    probs[order] = p / p.sum()
+    return probs
+
+
+def test_op_sample_greedy(shape, dtype_name="f32", device_name="cpu", profile=False):
+    print(f"   greedy shape {shape} dtype <{dtype_name}>")
+    logits, logits_ = random_tensor(shape, dtype_name, device_name)
+    out, out_ = zero_tensor((shape[0],), "i64", device_name)
+    params = LlaisysSamplingParams(0.0, 0, 1.0, 1.0)
+    state_ = seed_tensor(list(range(shape[0])), device_name)
+    llaisys.Ops.sample(out_, logits_, params, state_)
+    assert check_equal(out_, logits.float().argmax(dim=-1), strict=True)
+    # 贪心不消耗随机数
+    state = to_torch(torch.zeros(shape[0], dtype=torch.int64), state_, device_name)
+    assert torch.equal(state, torch.arange(shape[0]))
+
+    if profile:
+        benchmark(
+            lambda: torch.argmax(logits, dim=-1),
+            lambda: llaisys.Ops.sample(out_, logits_, params, state_),
+            device_name,
+        )
+
+
+def test_op_sample_distribution(vocab, temperature, top_k, top_p, nsample=20000, device_name="cpu", profile=False):
+    print(f"   distribution vocab {vocab} temperature {temperature} top_k {top_k} top_p {top_p}")
+    row = torch.randn(vocab) * 2
+    logits = row.repeat(nsample, 1)
+    logits_ = llaisys.Tensor(logits.shape, dtype=llaisys.DataType.F32, device=llaisys_device(device_name))
+    logits_.load(logits.data_ptr())
+    out_ = llaisys.Tensor((nsample,), dtype=llaisys.DataType.I64, device=llaisys_device(device_name))
+    params = LlaisysSamplingParams(temperature, top_k, top_p, 1.0)
+    llaisys.Ops.sample(out_, logits_, params, seed_tensor(list(range(nsample)), device_name))
+    out = to_torch(torch.zeros(nsample, dtype=torch.int64), out_, device_name)
+
+    probs = torch_probs(row, temperature, top_k, top_p)
+    freq = torch.bincount(out, minlength=vocab).double() / nsample
+    assert torch.all(freq[probs == 0] == 0)
+    assert (freq - probs).abs().max() < 0.02
+
+    # 相同种子结果相同，且每行只依赖自身的种子
+    again_ = llaisys.Tensor((nsample,), dtype=llaisys.DataType.I64, device=llaisys_device(device_name))
+    logits_.load(logits.data_ptr())
+    llaisys.Ops.sample(again_, logits_, params, seed_tensor(list(range(nsample)), device_name))
+    assert check_equal(again_, out, strict=True)
+    single_ = llaisys.Tensor((1,), dtype=llaisys.DataType.I64, device=llaisys_device(device_name))
+    single = logits[7:8].contiguous()
+    one_ = llaisys.Tensor(single.shape, dtype=llaisys.DataType.F32, device=llaisys_device(device_name))
+    one_.load(single.data_ptr())
+    llaisys.Ops.sample(single_, one_, params, seed_tensor([7], device_name))
+    assert check_equal(single_, out[7:8], strict=True)
+
+    if profile:
+        benchmark(
+            lambda: torch.multinomial(torch.softmax(logits / temperature, dim=-1), 1),
+            lambda: llaisys.Ops.sample(out_, logits_, params, seed_tensor(list(range(nsample)), device_name)),
+            device_name,
+        )
+
+
+def test_op_sample_penalty(dtype_name="f32", device_name="cpu"):
+    print(f"   repetition penalty dtype <{dtype_name}>")
+    logits, logits_ = random_tensor((2, 16), dtype_name, device_name, bias=-0.5)
+    history = torch.tensor([3, 3, 5, 0, 9], dtype=torch.int64)
+    offsets = torch.tensor([0, 4, 5], dtype=torch.int64)
+    history_ = llaisys.Tensor(history.shape, dtype=llaisys.DataType.I64, device=llaisys_device(device_name))
+    history_.load(history.data_ptr())
+    offsets_ = llaisys.Tensor(offsets.shape, dtype=llaisys.DataType.I64, device=llaisys_device(device_name))
+    offsets_.load(offsets.data_ptr())
+    out_ = llaisys.Tensor((2,), dtype=llaisys.DataType.I64, device=llaisys_device(device_name))
+    params = LlaisysSamplingParams(0.0, 0, 1.0, 1.3)
+    llaisys.Ops.sample(out_, logits_, params, seed_tensor([0, 0], device_name), history_, offsets_)
+
+    # HuggingFace 定义：出现过的 token 正 logit 除以 penalty、负 logit 乘以 penalty，重复出现只作用一次
+    expected = logits.clone()
+    for i in range(2):
+        for t in set(history[offsets[i]:offsets[i + 1]].tolist()):
+            v = expected[i, t]
+            expected[i, t] = v / 1.3 if v > 0 else v * 1.3
+    assert check_equal(logits_, expected, atol=1e-2, rtol=1e-2)
+    penalised = to_torch(torch.empty_like(logits), logits_, device_name)
+    assert check_equal(out_, penalised.float().argmax(dim=-1), strict=True)
+
+
+if __name__ == "__main__":
+    import argparse
+
+    parser = argparse.ArgumentParser()
+    parser.add_argument("--device", default="cpu", choices=["cpu", "nvidia"], type=str)
+    parser.add_argument("--profile", action="store_true")
+    args = parser.parse_args()
+    torch.manual_seed(0)
+    print(f"Testing Ops.sample on {args.device}")
+    for shape in [(1, 4), (4, 4096)]:
+        for dtype_name in ["f32", "f16", "bf16"]:
+            test_op_sample_greedy(shape, dtype_name, args.device, args.profile)
+    testSettings = [
+        # temperature, top_k, top_p
+        (1.0, 0, 1.0),
+        (0.7, 0, 1.0),
+        (1.0, 5, 1.0),
+        (1.3, 0, 0.6),
+        (1.0, 10, 0.5),
+    ]
+    for temperature, top_k, top_p in testSettings:
+        test_op_sample_distribution(32, temperature, top_k, top_p, device_name=args.device, profile=args.profile)
+    for dtype_name in ["f32", "f16", "bf16"]:
+        test_op_sample_penalty(dtype_name, args.device)
+
+    print("\033[92mTest passed!\033[0m\n")
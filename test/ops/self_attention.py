@@ -61,6 +61,28 @@ def test_op_self_attention(
         )
 
 
+def test_op_self_attention_strided(
+    qlen, kvlen, nh, nkvh, hd, dtype_name="f32", atol=1e-5, rtol=1e-5, device_name="cpu"
+):
+    # q 为融合缓冲区 [qlen, nh + nkvh, hd] 的前 nh 个头，k/v 为更大缓冲区中的行与头切片
+    print(f"   strided qlen={qlen} kvlen={kvlen} nh={nh} nkvh={nkvh} hd={hd} dtype <{dtype_name}>")
+    qf, qf_ = random_tensor((qlen, nh + nkvh, hd), dtype_name, device_name)
+    kc, kc_ = random_tensor((kvlen + 3, 2 * nkvh, hd), dtype_name, device_name)
+    vc, vc_ = random_tensor((kvlen + 3, 2 * nkvh, hd), dtype_name, device_name)
+    scale = 1.0 / (hd**0.5)
+
+    attn_val, attn_val_ = random_tensor((qlen, nh, hd), dtype_name, device_name)
+    torch_self_attention(attn_val, qf[:, :nh], kc[:kvlen, nkvh:], vc[:kvlen, nkvh:], scale)
+    llaisys.Ops.self_attention(
+        attn_val_,
+        qf_.slice(1, 0, nh),
+        kc_.slice(0, 0, kvlen).slice(1, nkvh, 2 * nkvh),
+        vc_.slice(0, 0, kvlen).slice(1, nkvh, 2 * nkvh),
+        scale,
+    )
+    assert check_equal(attn_val_, attn_val, atol=atol, rtol=rtol)
+
+
 if __name__ == "__main__":
     import argparse
 
@@ -85,5 +107,6 @@ if __name__ == "__main__":
             test_op_self_attention(
                 *shape, dtype_name, atol, rtol, args.device, args.profile
             )
+            test_op_self_attention_strided(*shape, dtype_name, atol, rtol, args.device)
 
     print("\033[92mTest passed!\033[0m\n")
@@ -0,0 +1,104 @@
+import sys
+import os
+
+parent_dir = os.path.abspath(os.path.join(os.path.dirname(__file__), ".."))
+sys.path.insert(0, parent_dir)
+import llaisys
+import torch
+from test_utils import random_tensor, zero_tensor, check_equal, benchmark
+from self_attention import torch_self_attention
+
+
+def copy_to_torch(dst, src):
+    api = llaisys.RuntimeAPI(llaisys.DeviceType.CPU)
+    api.memcpy_sync(dst.data_ptr(), src.data_ptr(), dst.numel() * dst.element_size(), llaisys.MemcpyKind.D2D)
+
+
+def quantize_kv(x, x_, kv_dtype_name, device_name):
+    # 用 llaisys 量化 K/V，并在 torch 侧反量化得到参考输入
+    shape = tuple(x.shape)
+    xq, xq_ = zero_tensor(shape, kv_dtype_name, device_name)
+    xs, xs_ = zero_tensor(shape[:2], "f32", device_name)
+    llaisys.Ops.quantize_kv(xq_, xs_, x_)
+    copy_to_torch(xq, xq_)
+    copy_to_torch(xs, xs_)
+
+    qmax = {"i8": 127.0, "f8": 448.0, "f8e5m2": 57344.0}[kv_dtype_name]
+    assert torch.allclose(xs, x.float().abs().amax(dim=2) / qmax, rtol=1e-6)
+    dequant = xq.float() * xs[..., None]
+    # 量化误差：int8 不超过半个量化步长，fp8 E4M3 的相对误差不超过 2^-4，E5M2 不超过 2^-3
+    err = (dequant - x.float()).abs()
+    if kv_dtype_name == "i8":
+        assert torch.all(err <= xs[..., None] * 0.5 + 1e-6)
+    elif kv_dtype_name == "f8":
+        assert torch.all(err <= x.float().abs() / 16 + xs[..., None] / 512 + 1e-6)
+    else:
+        assert torch.all(err <= x.float().abs() / 8 + xs[..., None] / 65536 + 1e-6)
+    return dequant.to(x.dtype), xq_, xs_
+
+
+def test_op_self_attention_quant_kv(
+    qlen,
+    kvlen,
+    nh,
+    nkvh,
+    hd,
+    kv_dtype_name="i8",
+    dtype_name="f32",
+    atol=1e-5,
+    rtol=1e-5,
+    device_name="cpu",
+    profile=False,
+):
+    print(
+        f"   qlen={qlen} kvlen={kvlen} nh={nh} nkvh={nkvh} hd={hd} kv <{kv_dtype_name}> dtype <{dtype_name}>"
+    )
+    q, q_ = random_tensor((qlen, nh, hd), dtype_name, device_name)
+    k, k_ = random_tensor((kvlen, nkvh, hd), dtype_name, device_name)
+    v, v_ = random_tensor((kvlen, nkvh, hd), dtype_name, device_name)
+    scale = 1.0 / (hd**0.5)
+
+    k_ref, kq_, ks_ = quantize_kv(k, k_, kv_dtype_name, device_name)
+    v_ref, vq_, vs_ = quantize_kv(v, v_, kv_dtype_name, device_name)
+
+    attn_val, attn_val_ = random_tensor((qlen, nh, hd), dtype_name, device_name)
+    torch_self_attention(attn_val, q, k_ref, v_ref, scale)
+    llaisys.Ops.self_attention(attn_val_, q_, kq_, vq_, scale, ks_, vs_)
+    assert check_equal(attn_val_, attn_val, atol=atol, rtol=rtol)
+
+    if profile:
+        benchmark(
+            lambda: torch_self_attention(attn_val, q, k_ref, v_ref, scale),
+            lambda: llaisys.Ops.self_attention(attn_val_, q_, kq_, vq_, scale, ks_, vs_),
+            device_name,
+        )
+
+
+if __name__ == "__main__":
+    import argparse
+
+    parser = argparse.ArgumentParser()
+    parser.add_argument("--device", default="cpu", choices=["cpu", "nvidia"], type=str)
+    parser.add_argument("--profile", action="store_true")
+    args = parser.parse_args()
+    testShapes = [
+        # qlen, kvlen, nh, nkvh, hd
+        (2, 2, 1, 1, 4),
+        (5, 11, 4, 2, 8),
+        (1, 512, 12, 2, 128),
+    ]
+    testDtypePrec = [
+        # type, atol, rtol
+        ("f32", 1e-4, 1e-4),
+        ("f16", 1e-3, 1e-3),
+        ("bf16", 1e-2, 1e-2),
+    ]
+    print(f"Testing Ops.self_attention with a quantized KV cache on {args.device}")
+    for shape in testShapes:
+        for kv_dtype_name in ["i8", "f8", "f8e5m2"]:
+            for dtype_name, atol, rtol in testDtypePrec:
+                test_op_self_attention_quant_kv(
+                    *shape, kv_dtype_name, dtype_name, atol, rtol, args.device, args.profile
+                )
+
+    print("\033[92mTest passed!\033[0m\n")
@@ -34,7 +34,15 @@ def load_hf_model(model_path=None, device_name="cpu"):
 
 
 def hf_infer(
-    prompt, tokenizer, model, max_new_tokens=128, top_p=0.8, top_k=50, temperature=0.8
+    prompt,
+    tokenizer,
+    model,
+    max_new_tokens=128,
+    top_p=0.8,
+    top_k=50,
+    temperature=0.8,
+    num_draft=0,
+    stream=False,
 ):
     input_content = tokenizer.apply_chat_template(
         conversation=[{"role": "user", "content": prompt}],
@@ -54,13 +62,21 @@ def hf_infer(
     return outputs[0].tolist(), result
 
 
-def load_llaisys_model(model_path, device_name):
-    model = llaisys.models.Qwen2(model_path, llaisys_device(device_name))
+def load_llaisys_model(model_path, device_name, device_ids=None):
+    model = llaisys.models.Qwen2(model_path, llaisys_device(device_name), device_ids)
     return model
 
 
 def llaisys_infer(
-    prompt, tokenizer, model, max_new_tokens=128, top_p=0.8, top_k=50, temperature=0.8
+    prompt,
+    tokenizer,
+    model,
+    max_new_tokens=128,
+    top_p=0.8,
+    top_k=50,
+    temperature=0.8,
+    num_draft=0,
+    stream=False,
 ):
     input_content = tokenizer.apply_chat_template(
         conversation=[{"role": "user", "content": prompt}],
@@ -68,13 +84,30 @@ def llaisys_infer(
         tokenize=False,
     )
     inputs = tokenizer.encode(input_content)
-    outputs = model.generate(
-        inputs,
-        max_new_tokens=max_new_tokens,
-        top_k=top_k,
-        top_p=top_p,
-        temperature=temperature,
-    )
+    if stream:
+        # 边生成边输出，验证流式接口与 generate 结果一致；原生增量解码不会切断多字节字符
+        outputs = list(inputs)
+        detok = llaisys.Tokenizer(tokenizer.name_or_path).detokenizer()
+        for token in model.stream(
+            inputs,
+            max_new_tokens=max_new_tokens,
+            top_k=top_k,
+            top_p=top_p,
+            temperature=temperature,
+            num_draft=num_draft,
+        ):
+            outputs.append(token)
+            print(detok.step(token), end="", flush=True)
+        print(detok.flush())
+    else:
+        outputs = model.generate(
+            inputs,
+            max_new_tokens=max_new_tokens,
+            top_k=top_k,
+            top_p=top_p,
+            temperature=temperature,
+            num_draft=num_draft,
+        )
 
     return outputs, tokenizer.decode(outputs, skip_special_tokens=True)
 
@@ -88,6 +121,9 @@ if __name__ == "__main__":
     parser.add_argument("--top_p", default=0.8, type=float)
     parser.add_argument("--top_k", default=50, type=int)
     parser.add_argument("--temperature", default=1.0, type=float)
+    parser.add_argument("--num_draft", default=0, type=int)
+    parser.add_argument("--stream", action="store_true")
+    parser.add_argument("--device_ids", default=None, type=str, help="comma-separated, e.g. 1,2 for two NUMA nodes")
     parser.add_argument("--test", action="store_true")
 
     args = parser.parse_args()
@@ -122,7 +158,8 @@ if __name__ == "__main__":
     print("\n")
     print(f"Time elapsed: {(end_time - start_time):.2f}s\n")
 
-    model = load_llaisys_model(model_path, args.device)
+    device_ids = [int(i) for i in args.device_ids.split(",")] if args.device_ids else None
+    model = load_llaisys_model(model_path, args.device, device_ids)
     start_time = time.time()
     llaisys_tokens, llaisys_output = llaisys_infer(
         args.prompt,
@@ -132,6 +169,8 @@ if __name__ == "__main__":
         top_p=top_p,
         top_k=top_k,
         temperature=temperature,
+        num_draft=args.num_draft,
+        stream=args.stream,
     )
 
     end_time = time.time()
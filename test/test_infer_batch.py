@@ -0,0 +1,94 @@
+import gc
+from test_utils import *
+
+import argparse
+from transformers import AutoModelForCausalLM, AutoTokenizer
+import torch
+from huggingface_hub import snapshot_download
+import os
+import time
+import llaisys
+
+
+PROMPTS = [
+    "Who are you?",
+    "Write a haiku about the sea.",
+    "What is 17 * 23?",
+    "Explain KV cache in one sentence.",
+]
+
+
+def encode(tokenizer, prompt):
+    input_content = tokenizer.apply_chat_template(
+        conversation=[{"role": "user", "content": prompt}],
+        add_generation_prompt=True,
+        tokenize=False,
+    )
+    return tokenizer.encode(input_content)
+
+
+def hf_greedy(model_path, inputs, max_new_tokens, device_name):
+    # 与 test_infer.py --test 相同的参考：transformers 的贪心解码
+    model = AutoModelForCausalLM.from_pretrained(
+        model_path,
+        torch_dtype=torch.bfloat16,
+        device_map=torch_device(device_name),
+        trust_remote_code=True,
+    )
+    outputs = []
+    with torch.no_grad():
+        for x in inputs:
+            out = model.generate(
+                torch.tensor([x], device=model.device),
+                max_new_tokens=max_new_tokens,
+                top_k=1,
+                top_p=1.0,
+                temperature=1.0,
+            )
+            outputs.append(out[0].tolist())
+    del model
+    gc.collect()
+    return outputs
+
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser()
+    parser.add_argument("--device", default="cpu", choices=["cpu", "nvidia"], type=str)
+    parser.add_argument("--model", default=None, type=str)
+    parser.add_argument("--max_steps", default=32, type=int)
+    parser.add_argument("--max_batch", default=2, type=int)
+    parser.add_argument("--max_step_tokens", default=16, type=int)
+    parser.add_argument("--test", action="store_true", help="also compare with transformers' greedy output")
+    args = parser.parse_args()
+
+    model_path = args.model
+    if not (model_path and os.path.isdir(model_path)):
+        model_path = snapshot_download("deepseek-ai/DeepSeek-R1-Distill-Qwen-1.5B")
+    tokenizer = AutoTokenizer.from_pretrained(model_path, trust_remote_code=True)
+    inputs = [encode(tokenizer, p) for p in PROMPTS]
+    hf_outputs = hf_greedy(model_path, inputs, args.max_steps, args.device) if args.test else None
+
+    model = llaisys.models.Qwen2(model_path, llaisys_device(args.device))
+
+    start_time = time.time()
+    expected = [model.generate(x, max_new_tokens=args.max_steps) for x in inputs]
+    sequential_time = time.time() - start_time
+
+    start_time = time.time()
+    outputs = model.generate_batch(
+        inputs,
+        max_new_tokens=args.max_steps,
+        max_batch=args.max_batch,
+        max_step_tokens=args.max_step_tokens,
+    )
+    batch_time = time.time() - start_time
+
+    for prompt, out, ref in zip(PROMPTS, outputs, expected):
+        print(f"[{prompt}] {tokenizer.decode(out, skip_special_tokens=True)!r}")
+        assert out == ref
+    if hf_outputs is not None:
+        for prompt, out, ref in zip(PROMPTS, outputs, hf_outputs):
+            assert out == ref, f"[{prompt}] differs from transformers: {out} != {ref}"
+
+    print(f"Sequential: {sequential_time:.2f}s, batched: {batch_time:.2f}s")
+    print("\033[92mTest passed!\033[0m\n")
@@ -0,0 +1,70 @@
+import ctypes
+import os
+import tempfile
+
+import numpy as np
+
+import llaisys
+from llaisys import DataType
+from llaisys.libllaisys import LIB_LLAISYS
+from test_safetensors import mapped_ranges, weight_handle
+from tiny_model import random_weights, write_model
+
+
+ELEMENT_SIZE = {DataType.F32: 4, DataType.F16: 2, DataType.BF16: 2, DataType.I8: 1, DataType.U8: 1,
+                DataType.F8: 1, DataType.F8E5M2: 1}
+
+
+def raw_weight(model, name):
+    handle = weight_handle(model, name)
+    ndim = LIB_LLAISYS.tensorGetNdim(handle)
+    dims = (ctypes.c_size_t * ndim)()
+    LIB_LLAISYS.tensorGetShape(handle, dims)
+    dtype = DataType(LIB_LLAISYS.tensorGetDataType(handle))
+    data = np.empty(int(np.prod(tuple(dims))) * ELEMENT_SIZE[dtype], dtype=np.uint8)
+    ctypes.memmove(data.ctypes.data, LIB_LLAISYS.tensorGetData(handle), data.nbytes)
+    return dtype, tuple(dims), data
+
+
+def test_round_trip(hf_dir, names, torch_dtype, scheme, prompt):
+    # 写出 -> 加载：权重的 dtype、形状与字节不变，q_scale/q_zero 随之保存，输出与写出前一致
+    print(f"   {torch_dtype} model, quant <{scheme}>")
+    model = llaisys.models.Qwen2(hf_dir).quantize(scheme, group_size=32)
+    expected = model.generate(prompt, max_new_tokens=12)
+    with tempfile.TemporaryDirectory() as out_dir:
+        path = os.path.join(out_dir, "model.llaisys")
+        model.save(path)
+        packed = llaisys.models.Qwen2(path)
+        for name in names:
+            dtype, shape, data = raw_weight(model, name)
+            got_dtype, got_shape, got_data = raw_weight(packed, name)
+            assert (got_dtype, got_shape) == (dtype, shape), f"{name}: {got_dtype}{got_shape} != {dtype}{shape}"
+            assert np.array_equal(got_data, data), name
+        assert packed.generate(prompt, max_new_tokens=12) == expected
+
+        # 打包文件中的权重零拷贝使用
+        ranges = mapped_ranges(path)
+        if ranges is not None:
+            for name in names:
+                ptr = LIB_LLAISYS.tensorGetData(weight_handle(packed, name))
+                assert any(start <= ptr < end for start, end in ranges), f"{name} was copied"
+
+        # 权重槽之外的缩放系数与零点也须完整保存：再写一次，两个文件逐字节相同
+        again = os.path.join(out_dir, "again.llaisys")
+        packed.save(again)
+        with open(path, "rb") as a, open(again, "rb") as b:
+            assert a.read() == b.read()
+        del packed
+    del model
+
+
+if __name__ == "__main__":
+    weights = random_weights()
+    prompt = [5, 17, 42, 3, 99, 7]
+    print("Testing .llaisys round trips")
+    for torch_dtype in ("float32", "bfloat16"):
+        with tempfile.TemporaryDirectory() as hf_dir:
+            write_model(hf_dir, weights, torch_dtype=torch_dtype)
+            for scheme in ("none", "int8", "int4", "int4_zp", "fp8", "fp8_e5m2"):
+                test_round_trip(hf_dir, list(weights), torch_dtype, scheme, prompt)
+    print("\033[92mTest passed!\033[0m\n")
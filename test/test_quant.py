@@ -0,0 +1,83 @@
+from test_utils import *
+
+import argparse
+from transformers import AutoTokenizer
+from huggingface_hub import snapshot_download
+from ctypes import c_int64
+import os
+import time
+import llaisys
+from llaisys.libllaisys import LIB_LLAISYS
+
+
+def load_model_path(model_path=None):
+    model_id = "deepseek-ai/DeepSeek-R1-Distill-Qwen-1.5B"
+    if model_path and os.path.exists(model_path):
+        return model_path
+    return snapshot_download(model_id)
+
+
+def timed_generate(model, inputs, max_new_tokens):
+    start = time.time()
+    outputs = model.generate(inputs, max_new_tokens=max_new_tokens)
+    elapsed = time.time() - start
+    return outputs, (len(outputs) - len(inputs)) / elapsed
+
+
+def teacher_forced_agreement(model, reference, nprompt):
+    # 在参考 token 序列上逐位置比较 argmax：不受生成分歧的连锁影响，反映每一步的一致率
+    match = 0
+    for t in range(nprompt, len(reference)):
+        context = (c_int64 * t)(*reference[:t])
+        match += LIB_LLAISYS.llaisysQwen2ModelInfer(model._model, context, t) == reference[t]
+    return match / max(len(reference) - nprompt, 1)
+
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser()
+    parser.add_argument("--device", default="cpu", choices=["cpu"], type=str)
+    parser.add_argument("--model", default=None, type=str)
+    parser.add_argument("--prompt", default="Who are you?", type=str)
+    parser.add_argument("--max_steps", default=64, type=int)
+    parser.add_argument("--quant", default="int8", choices=["int8", "int4", "int4_zp", "fp8", "fp8_e5m2"], type=str)
+    parser.add_argument("--group_size", default=128, type=int)
+    # int8 权重下，前向 token 数不少于该值时激活也动态量化为 int8（0 表示关闭）
+    parser.add_argument("--act_quant", default=0, type=int)
+    parser.add_argument("--min_agreement", default=0.9, type=float)
+    parser.add_argument("--test", action="store_true")
+    args = parser.parse_args()
+
+    model_path = load_model_path(args.model)
+    tokenizer = AutoTokenizer.from_pretrained(model_path, trust_remote_code=True)
+    inputs = tokenizer.encode(
+        tokenizer.apply_chat_template(
+            conversation=[{"role": "user", "content": args.prompt}],
+            add_generation_prompt=True,
+            tokenize=False,
+        )
+    )
+
+    model = llaisys.models.Qwen2(model_path, llaisys_device(args.device))
+    ref_tokens, ref_speed = timed_generate(model, inputs, args.max_steps)
+
+    model.quantize(args.quant, args.group_size)
+    model.set_act_quant(args.act_quant)
+    q_tokens, q_speed = timed_generate(model, inputs, args.max_steps)
+
+    prefix = 0
+    while prefix < min(len(ref_tokens), len(q_tokens)) and ref_tokens[prefix] == q_tokens[prefix]:
+        prefix += 1
+    agreement = teacher_forced_agreement(model, ref_tokens, len(inputs))
+
+    print("\n=== Reference ===\n")
+    print(tokenizer.decode(ref_tokens, skip_special_tokens=True))
+    print(f"\n=== {args.quant} ===\n")
+    print(tokenizer.decode(q_tokens, skip_special_tokens=True))
+    print()
+    print(f"Decode speed: {ref_speed:.2f} tok/s -> {q_speed:.2f} tok/s ({q_speed / ref_speed:.2f}x)")
+    print(f"Identical greedy prefix: {prefix - len(inputs)} / {len(ref_tokens) - len(inputs)} tokens")
+    print(f"Teacher-forced top-1 agreement: {agreement * 100:.1f}%\n")
+
+    if args.test:
+        assert agreement >= args.min_agreement
+        print("\033[92mTest passed!\033[0m\n")
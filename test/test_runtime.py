@@ -18,6 +18,7 @@ def test_basic_runtime_api(device_name: str = "cpu"):
         print("Testing device {i}...")
         api.set_device(i)
         test_memcpy(api, 1024 * 1024)
+        test_stream(api, 1024 * 1024)
 
         print("     Passed")
 
@@ -53,6 +54,33 @@ def test_memcpy(api, size_bytes: int):
     torch.testing.assert_close(a, b)
 
 
+def test_stream(api, size_bytes: int):
+    a = torch.randint(0, 256, (size_bytes,), dtype=torch.uint8, device=torch_device("cpu"))
+    b = torch.zeros_like(a)
+    device_a = api.malloc_device(size_bytes)
+    device_b = api.malloc_device(size_bytes)
+    producer = api.create_stream()
+    consumer = api.create_stream()
+    event = api.create_event()
+
+    # a -> device_a on producer; consumer waits for it before device_a -> device_b -> b
+    api.memcpy_async(device_a, a.data_ptr(), size_bytes, llaisys.MemcpyKind.H2D, producer)
+    api.event_record(event, producer)
+    api.stream_wait_event(consumer, event)
+    api.memcpy_async(device_b, device_a, size_bytes, llaisys.MemcpyKind.D2D, consumer)
+    api.memcpy_async(b.data_ptr(), device_b, size_bytes, llaisys.MemcpyKind.D2H, consumer)
+    api.stream_synchronize(consumer)
+    api.event_synchronize(event)
+
+    torch.testing.assert_close(a, b)
+
+    api.destroy_event(event)
+    api.destroy_stream(consumer)
+    api.destroy_stream(producer)
+    api.free_device(device_b)
+    api.free_device(device_a)
+
+
 if __name__ == "__main__":
     parser = argparse.ArgumentParser()
     parser.add_argument("--device", default="cpu", choices=["cpu", "nvidia"], type=str)
@@ -0,0 +1,167 @@
+import ctypes
+import os
+import sys
+import tempfile
+
+import numpy as np
+
+import llaisys
+from llaisys import DataType
+from llaisys.libllaisys import LIB_LLAISYS
+from tiny_model import CONFIG, from_bf16, random_weights, to_bf16, write_model
+
+
+# HuggingFace name inside a layer -> LlaisysQwen2Weights field
+LAYER_FIELDS = {
+    "input_layernorm.weight": "attn_norm_w",
+    "self_attn.q_proj.weight": "attn_q_w",
+    "self_attn.q_proj.bias": "attn_q_b",
+    "self_attn.k_proj.weight": "attn_k_w",
+    "self_attn.k_proj.bias": "attn_k_b",
+    "self_attn.v_proj.weight": "attn_v_w",
+    "self_attn.v_proj.bias": "attn_v_b",
+    "self_attn.o_proj.weight": "attn_o_w",
+    "post_attention_layernorm.weight": "mlp_norm_w",
+    "mlp.gate_proj.weight": "mlp_gate_w",
+    "mlp.up_proj.weight": "mlp_up_w",
+    "mlp.down_proj.weight": "mlp_down_w",
+}
+
+
+def weight_handle(model, name):
+    w = model._weights
+    if name == "model.embed_tokens.weight":
+        return w.in_embed
+    if name == "lm_head.weight":
+        return w.out_embed
+    if name == "model.norm.weight":
+        return w.out_norm_w
+    _, _, layer, suffix = name.split(".", 3)
+    return getattr(w, LAYER_FIELDS[suffix])[int(layer)]
+
+
+def read_weight(model, name, shape, np_dtype):
+    handle = weight_handle(model, name)
+    ndim = LIB_LLAISYS.tensorGetNdim(handle)
+    dims = (ctypes.c_size_t * ndim)()
+    LIB_LLAISYS.tensorGetShape(handle, dims)
+    assert tuple(dims) == tuple(shape), f"{name}: shape {tuple(dims)} != {shape}"
+    out = np.empty(shape, dtype=np_dtype)
+    ctypes.memmove(out.ctypes.data, LIB_LLAISYS.tensorGetData(handle), out.nbytes)
+    return out
+
+
+def e4m3_to_f32(bits):
+    bits = bits.astype(np.int32)
+    sign = np.where(bits & 0x80, -1.0, 1.0)
+    exp, man = (bits >> 3) & 0xF, bits & 0x7
+    value = np.where(exp == 0, man / 8.0 * 2.0**-6, (1.0 + man / 8.0) * 2.0 ** (exp - 7))
+    return (sign * value).astype(np.float32)
+
+
+def e5m2_to_f32(bits):
+    return (bits.astype(np.uint16) << 8).view(np.float16).astype(np.float32)
+
+
+def mapped_ranges(path):
+    """Address ranges of `path` in this process, or None where /proc is not available."""
+    if not sys.platform.startswith("linux"):
+        return None
+    path = os.path.realpath(path)
+    ranges = []
+    with open("/proc/self/maps") as f:
+        for line in f:
+            fields = line.split(maxsplit=5)
+            if len(fields) == 6 and fields[5].strip() == path:
+                start, end = (int(x, 16) for x in fields[0].split("-"))
+                ranges.append((start, end))
+    return ranges
+
+
+def test_same_dtype(weights):
+    # 文件 dtype 与模型一致：权重直接指向文件映射，不做拷贝
+    print("   float32 file, float32 model (zero-copy)")
+    with tempfile.TemporaryDirectory() as model_dir:
+        write_model(model_dir, weights)
+        model = llaisys.models.Qwen2(model_dir)
+        for name, w in weights.items():
+            assert np.array_equal(read_weight(model, name, w.shape, np.float32), w), name
+
+        ranges = mapped_ranges(os.path.join(model_dir, "model.safetensors"))
+        if ranges is not None:
+            assert ranges, "model.safetensors is not mapped"
+            for name in weights:
+                ptr = LIB_LLAISYS.tensorGetData(weight_handle(model, name))
+                assert any(start <= ptr < end for start, end in ranges), f"{name} was copied"
+        del model
+
+
+def test_sharded_bf16(weights):
+    # 三个分片加索引文件，tied lm_head：缺少 lm_head.weight 时与 embed_tokens 共用
+    print("   bfloat16 shards, bfloat16 model, tied lm_head")
+    tied = {n: w for n, w in weights.items() if n != "lm_head.weight"}
+    with tempfile.TemporaryDirectory() as model_dir:
+        write_model(model_dir, tied, torch_dtype="bfloat16", shards=3)
+        model = llaisys.models.Qwen2(model_dir)
+        for name, w in tied.items():
+            assert np.array_equal(read_weight(model, name, w.shape, np.uint16), to_bf16(w)), name
+        embed = tied["model.embed_tokens.weight"]
+        assert np.array_equal(read_weight(model, "lm_head.weight", embed.shape, np.uint16), to_bf16(embed))
+        del model
+
+
+def test_cast(weights):
+    # 文件 dtype 与模型不同：加载时经 cast 转换为模型 dtype
+    print("   float16 / bfloat16 files, float32 model (cast)")
+    for stored, decode in (("float16", lambda w: w.astype(np.float16).astype(np.float32)),
+                           ("bfloat16", lambda w: from_bf16(to_bf16(w)))):
+        with tempfile.TemporaryDirectory() as model_dir:
+            write_model(model_dir, weights, stored=stored)
+            model = llaisys.models.Qwen2(model_dir)
+            for name, w in weights.items():
+                assert np.array_equal(read_weight(model, name, w.shape, np.float32), decode(w)), (stored, name)
+            del model
+
+
+def test_fp8(weights):
+    # F8_E4M3 / F8_E5M2 按类型名解析为 fp8 量化权重：保持源 dtype 与字节，配合 "<name>.q_scale" 参与推理
+    print("   F8_E4M3 / F8_E5M2 weights with q_scale, float32 model")
+    rng = np.random.default_rng(2)
+    cases = (
+        ("model.layers.0.self_attn.q_proj.weight", "F8_E4M3", DataType.F8, e4m3_to_f32),
+        ("model.layers.1.mlp.up_proj.weight", "F8_E5M2", DataType.F8E5M2, e5m2_to_f32),
+    )
+    tensors, tags = dict(weights), {}
+    for name, tag, _, decode in cases:
+        raw = rng.integers(0, 256, size=weights[name].shape, dtype=np.uint8)
+        # 不写入 NaN / Inf 的编码：E4M3 的 S.1111.111，E5M2 指数全 1
+        if tag == "F8_E4M3":
+            raw[(raw & 0x7F) == 0x7F] = 0
+        else:
+            raw[(raw & 0x7C) == 0x7C] &= 0x83
+        scale = (np.abs(weights[name]).max(axis=1) / np.abs(decode(raw)).max(axis=1)).astype(np.float32)
+        tags[name] = (tag, raw)
+        tensors[name + ".q_scale"] = scale
+    with tempfile.TemporaryDirectory() as model_dir:
+        write_model(model_dir, tensors, tags=tags)
+        model = llaisys.models.Qwen2(model_dir)
+        for name, w in weights.items():
+            if name in tags:
+                continue
+            assert np.array_equal(read_weight(model, name, w.shape, np.float32), w), name
+        for name, _, dtype, _ in cases:
+            assert LIB_LLAISYS.tensorGetDataType(weight_handle(model, name)) == dtype, name
+            assert np.array_equal(read_weight(model, name, weights[name].shape, np.uint8), tags[name][1]), name
+        tokens = model.generate([1, 2, 3], max_new_tokens=4)
+        assert len(tokens) == 7 and all(0 <= t < CONFIG["vocab_size"] for t in tokens)
+        del model
+
+
+if __name__ == "__main__":
+    weights = random_weights(CONFIG)
+    print("Testing safetensors loading")
+    test_same_dtype(weights)
+    test_sharded_bf16(weights)
+    test_cast(weights)
+    test_fp8(weights)
+    print("\033[92mTest passed!\033[0m\n")
@@ -0,0 +1,56 @@
+import argparse
+import os
+import tempfile
+import threading
+
+import numpy as np
+
+import llaisys
+from tiny_model import CONFIG, random_weights, write_model
+
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser()
+    parser.add_argument("--threads", default=4, type=int)
+    parser.add_argument("--max_steps", default=16, type=int)
+    args = parser.parse_args()
+
+    rng = np.random.default_rng(1)
+    prompts = [
+        [int(t) for t in rng.integers(0, CONFIG["vocab_size"] - 1, size=n)]
+        for n in (5, 9, 1, 17, 3, 11)
+    ]
+
+    with tempfile.TemporaryDirectory() as model_dir:
+        write_model(model_dir, random_weights())
+        model = llaisys.models.Qwen2(model_dir)
+
+        expected = [model.generate(p, max_new_tokens=args.max_steps) for p in prompts]
+        workers = [model.share() for _ in range(args.threads)]
+
+        outputs = {}
+        errors = []
+
+        def run(i):
+            try:
+                # every thread walks the prompts in a different order to interleave prefills and decodes
+                for j in np.roll(np.arange(len(prompts)), i):
+                    outputs[(i, int(j))] = workers[i].generate(prompts[j], max_new_tokens=args.max_steps)
+            except Exception as e:
+                errors.append(e)
+
+        threads = [threading.Thread(target=run, args=(i,)) for i in range(args.threads)]
+        for t in threads:
+            t.start()
+        for t in threads:
+            t.join()
+
+        assert not errors, errors
+        for (i, j), out in sorted(outputs.items()):
+            assert out == expected[j], f"thread {i}, prompt {j}: {out} != {expected[j]}"
+        assert len(outputs) == args.threads * len(prompts)
+
+        # drop the models before the directory: on Windows the mapped files cannot be deleted
+        del workers, model
+
+    print("\033[92mTest passed!\033[0m\n")
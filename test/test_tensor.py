@@ -1,5 +1,6 @@
 import llaisys
 
+import threading
 import torch
 from test_utils import *
 import argparse
@@ -49,7 +50,27 @@ def test_tensor():
     assert check_equal(llaisys_tensor_slice, torch_tensor_slice)
 
 
+def test_cross_thread_tensor():
+    # A tensor created on a worker thread stays valid after that thread exits
+    # and can be read and released from another thread.
+    print("===Test cross-thread tensor===")
+    torch_tensor = torch.arange(60, dtype=torch_dtype("i64")).reshape(3, 4, 5)
+    created = {}
+
+    def create():
+        t = llaisys.Tensor((3, 4, 5), dtype=llaisys_dtype("i64"), device=llaisys_device("cpu"))
+        t.load(torch_tensor.data_ptr())
+        created["tensor"] = t
+
+    worker = threading.Thread(target=create)
+    worker.start()
+    worker.join()
+    assert check_equal(created["tensor"], torch_tensor)
+    del created["tensor"]
+
+
 if __name__ == "__main__":
     test_tensor()
+    test_cross_thread_tensor()
 
     print("\n\033[92mTest passed!\033[0m\n")
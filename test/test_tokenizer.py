@@ -0,0 +1,95 @@
+from transformers import AutoTokenizer
+from huggingface_hub import snapshot_download
+import argparse
+import os
+import random
+import time
+import llaisys
+import sys
+import io
+
+sys.stdout = io.TextIOWrapper(sys.stdout.buffer, encoding="utf-8")
+
+
+SAMPLES = [
+    "Who are you?",
+    "Hello, world! I'm here; you're there, we'll see. It's 2024-06-01 12:34:56.",
+    "  leading spaces,\ttabs\t\tand trailing spaces   ",
+    "line one\nline two\r\n\r\n  indented\n\n\n",
+    "数学是研究数量、结构、变化以及空间等概念的一门学科。",
+    "Mixed 中英文 text with emoji 😀🎉 and accents: café, naïve, Ω≈ç√∫",
+    "def f(x):\n    return x ** 2  # square\n\nprint(f(3))\n",
+    "<|im_start|>user\nWhat is 1+1?<|im_end|>\n<|im_start|>assistant\n",
+    "'S 'T 'RE 'VE 'M 'LL 'D don't DON'T",
+    "",
+]
+
+
+def load_hf_tokenizer(model_path=None):
+    model_id = "deepseek-ai/DeepSeek-R1-Distill-Qwen-1.5B"
+
+    if model_path and os.path.isdir(model_path):
+        print(f"Loading tokenizer from local path: {model_path}")
+    else:
+        print(f"Loading tokenizer from Hugging Face: {model_id}")
+        model_path = snapshot_download(model_id, allow_patterns=["*.json"])
+    tokenizer = AutoTokenizer.from_pretrained(model_path, trust_remote_code=True)
+    return tokenizer, model_path
+
+
+def random_text(rng, n):
+    words = ["the", "quick", "brown", "fox", "jumps", "over", "lazy", "dog's", "模型", "推理", "并行", "1234", "(x)", ",", "."]
+    return "".join((" " if rng.random() < 0.8 else "\n") + rng.choice(words) for _ in range(n))
+
+
+def check(hf, tokenizer, text):
+    expected = hf.encode(text, add_special_tokens=False)
+    ids = tokenizer.encode(text)
+    assert ids == expected, (text, expected, ids)
+    assert tokenizer.decode(ids) == hf.decode(ids, skip_special_tokens=False)
+    assert tokenizer.decode(ids, skip_special_tokens=True) == hf.decode(ids, skip_special_tokens=True)
+    # 逐 token 流式解码，拼接结果应与整体解码一致
+    detok = tokenizer.detokenizer(skip_special_tokens=False)
+    streamed = "".join(detok.step(token) for token in ids) + detok.flush()
+    assert streamed == tokenizer.decode(ids), (text, streamed)
+
+
+def benchmark(name, encode, text, repeat=3):
+    encode(text)
+    start = time.time()
+    for _ in range(repeat):
+        encode(text)
+    elapsed = (time.time() - start) / repeat
+    mb = len(text.encode("utf-8")) / 1e6
+    print(f"{name}: {mb / elapsed:.2f} MB/s")
+
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser()
+    parser.add_argument("--model", default=None, type=str)
+    parser.add_argument("--bench_mb", default=4.0, type=float)
+    args = parser.parse_args()
+
+    hf, model_path = load_hf_tokenizer(args.model)
+    tokenizer = llaisys.Tokenizer(model_path)
+    assert tokenizer.vocab_size == len(hf), (tokenizer.vocab_size, len(hf))
+
+    for text in SAMPLES:
+        check(hf, tokenizer, text)
+    chat = hf.apply_chat_template(
+        conversation=[{"role": "user", "content": SAMPLES[5]}],
+        add_generation_prompt=True,
+        tokenize=False,
+    )
+    check(hf, tokenizer, chat)
+    rng = random.Random(0)
+    for _ in range(100):
+        check(hf, tokenizer, random_text(rng, rng.randint(1, 200)))
+
+    # 吞吐量：与 HF 的 Rust 后端对比，二者均不添加模板 token
+    text = random_text(rng, int(args.bench_mb * 1e6 / 6))
+    backend = hf.backend_tokenizer
+    benchmark("HF tokenizers", lambda t: backend.encode(t, add_special_tokens=False).ids, text)
+    benchmark("llaisys", tokenizer.encode, text)
+
+    print("\033[92mTest passed!\033[0m\n")
@@ -0,0 +1,79 @@
+import llaisys
+import argparse
+import json
+import os
+import tempfile
+from test_utils import *
+
+
+def traced_events(path):
+    with open(path) as f:
+        trace = json.load(f)
+    return [e for e in trace["traceEvents"] if e["ph"] == "X"]
+
+
+def test_trace(device_name: str = "cpu"):
+    device = llaisys_device(device_name)
+    a = llaisys.Tensor((4, 8), dtype=llaisys_dtype("f32"), device=device)
+    b = llaisys.Tensor((4, 8), dtype=llaisys_dtype("f32"), device=device)
+    c = llaisys.Tensor((4, 8), dtype=llaisys_dtype("f32"), device=device)
+    w = llaisys.Tensor((16, 8), dtype=llaisys_dtype("f32"), device=device)
+    bias = llaisys.Tensor((16,), dtype=llaisys_dtype("f32"), device=device)
+    out = llaisys.Tensor((4, 16), dtype=llaisys_dtype("f32"), device=device)
+
+    with tempfile.TemporaryDirectory() as tmp:
+        path = os.path.join(tmp, "trace.json")
+
+        print("===Test enabled===")
+        llaisys.trace.clear()
+        llaisys.trace.enable()
+        llaisys.Ops.add(c, a, b)
+        llaisys.Ops.linear(out, a, w, bias)
+        llaisys.trace.disable()
+        n = llaisys.trace.dump(path)
+        events = traced_events(path)
+        assert n == len(events) == 2, events
+        add, linear = events
+        assert add["name"] == "add" and linear["name"] == "linear"
+        assert add["args"]["detail"] == "float32[4,8] float32[4,8] float32[4,8]"
+        assert add["args"]["bytes"] == 3 * 4 * 8 * 4
+        assert add["args"]["dtype"] == "float32"
+        assert linear["args"]["bytes"] == (4 * 16 + 4 * 8 + 16 * 8 + 16) * 4
+        assert add["dur"] >= 0 and linear["ts"] >= add["ts"] + add["dur"]
+
+        print("===Test disabled===")
+        llaisys.Ops.add(c, a, b)
+        assert llaisys.trace.dump(path) == 2
+
+        print("===Test clear===")
+        llaisys.trace.clear()
+        assert llaisys.trace.dump(path) == 0
+        assert traced_events(path) == []
+
+    print("===Test counters===")
+    available = llaisys.trace.enable_counters()
+    print(f"     available: {available}")
+    llaisys.trace.reset_counters()
+    llaisys.Ops.add(c, a, b)
+    llaisys.Ops.add(c, a, b)
+    llaisys.Ops.linear(out, a, w, bias)
+    llaisys.trace.disable_counters()
+    llaisys.Ops.add(c, a, b)
+    rows = {row["name"]: row for row in llaisys.trace.counters()}
+    assert sorted(rows) == ["add", "linear"], rows
+    assert rows["add"]["calls"] == 2 and rows["linear"]["calls"] == 1
+    assert rows["add"]["time_ns"] > 0
+    for name in llaisys.trace.COUNTERS:
+        if name not in available:
+            assert rows["linear"][name] == 0
+    llaisys.trace.reset_counters()
+    assert llaisys.trace.counters() == []
+
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser()
+    parser.add_argument("--device", default="cpu", choices=["cpu", "nvidia"], type=str)
+    args = parser.parse_args()
+    test_trace(args.device)
+
+    print("\033[92mTest passed!\033[0m\n")
@@ -0,0 +1,137 @@
+"""Writes a tiny random Qwen2 model in HuggingFace layout (config.json + safetensors), so model
+tests can run offline. Only numpy is needed; the safetensors files are written by hand."""
+
+import json
+import os
+import struct
+
+import numpy as np
+
+
+CONFIG = {
+    "num_hidden_layers": 2,
+    "hidden_size": 64,
+    "num_attention_heads": 4,
+    "num_key_value_heads": 2,
+    "intermediate_size": 96,
+    "max_position_embeddings": 256,
+    "vocab_size": 128,
+    "rms_norm_eps": 1e-6,
+    "rope_theta": 10000.0,
+    "eos_token_id": 127,
+}
+
+_LAYER_WEIGHTS = [
+    ("input_layernorm.weight", lambda c: (c["hidden_size"],)),
+    ("self_attn.q_proj.weight", lambda c: (c["hidden_size"], c["hidden_size"])),
+    ("self_attn.q_proj.bias", lambda c: (c["hidden_size"],)),
+    ("self_attn.k_proj.weight", lambda c: (_kv_size(c), c["hidden_size"])),
+    ("self_attn.k_proj.bias", lambda c: (_kv_size(c),)),
+    ("self_attn.v_proj.weight", lambda c: (_kv_size(c), c["hidden_size"])),
+    ("self_attn.v_proj.bias", lambda c: (_kv_size(c),)),
+    ("self_attn.o_proj.weight", lambda c: (c["hidden_size"], c["hidden_size"])),
+    ("post_attention_layernorm.weight", lambda c: (c["hidden_size"],)),
+    ("mlp.gate_proj.weight", lambda c: (c["intermediate_size"], c["hidden_size"])),
+    ("mlp.up_proj.weight", lambda c: (c["intermediate_size"], c["hidden_size"])),
+    ("mlp.down_proj.weight", lambda c: (c["hidden_size"], c["intermediate_size"])),
+]
+
+# torch_dtype in config.json -> safetensors dtype tag
+_DTYPE_TAGS = {"float32": "F32", "float16": "F16", "bfloat16": "BF16"}
+
+
+def _kv_size(config):
+    return config["hidden_size"] // config["num_attention_heads"] * config["num_key_value_heads"]
+
+
+def random_weights(config=CONFIG, seed=0):
+    """float32 weights by HuggingFace name; norms around 1, projections small enough to keep
+    the activations well-conditioned."""
+    rng = np.random.default_rng(seed)
+    hs, voc = config["hidden_size"], config["vocab_size"]
+    weights = {
+        "model.embed_tokens.weight": rng.standard_normal((voc, hs)),
+        "model.norm.weight": 1.0 + 0.1 * rng.standard_normal(hs),
+        "lm_head.weight": rng.standard_normal((voc, hs)) / np.sqrt(hs),
+    }
+    for i in range(config["num_hidden_layers"]):
+        for name, shape in _LAYER_WEIGHTS:
+            shape = shape(config)
+            if name.endswith("layernorm.weight"):
+                w = 1.0 + 0.1 * rng.standard_normal(shape)
+            elif name.endswith(".bias"):
+                w = 0.1 * rng.standard_normal(shape)
+            else:
+                w = rng.standard_normal(shape) / np.sqrt(shape[1])
+            weights[f"model.layers.{i}.{name}"] = w
+    return {name: w.astype(np.float32) for name, w in weights.items()}
+
+
+def to_bf16(x):
+    """Rounds float32 to the nearest bfloat16; returns the raw uint16 bits."""
+    bits = np.ascontiguousarray(x, dtype=np.float32).view(np.uint32).astype(np.uint64)
+    bits += 0x7FFF + ((bits >> 16) & 1)
+    return (bits >> 16).astype(np.uint16)
+
+
+def from_bf16(bits):
+    return (bits.astype(np.uint32) << 16).view(np.float32)
+
+
+def encode(x, tag):
+    """float32 array -> array holding the raw bytes of safetensors dtype `tag`."""
+    if tag == "F32":
+        return x.astype(np.float32)
+    if tag == "F16":
+        return x.astype(np.float16)
+    if tag == "BF16":
+        return to_bf16(x)
+    raise ValueError(tag)
+
+
+def write_safetensors(path, tensors):
+    """tensors: name -> (dtype tag, array holding the raw element bytes, shape)."""
+    header, offset, blobs = {}, 0, []
+    for name, (tag, data, shape) in tensors.items():
+        blob = np.ascontiguousarray(data).tobytes()
+        header[name] = {"dtype": tag, "shape": list(shape), "data_offsets": [offset, offset + len(blob)]}
+        offset += len(blob)
+        blobs.append(blob)
+    text = json.dumps(header).encode("utf-8")
+    text += b" " * (-len(text) % 8)
+    with open(path, "wb") as f:
+        f.write(struct.pack("<Q", len(text)))
+        f.write(text)
+        for blob in blobs:
+            f.write(blob)
+
+
+def write_model(model_dir, weights, torch_dtype="float32", stored=None, shards=1, tags=None, config=CONFIG):
+    """Writes config.json and the weights, split into `shards` files with an index when > 1.
+    The files hold `stored` (a torch_dtype name, default `torch_dtype`); `tags` overrides the
+    stored dtype of single tensors: name -> (tag, raw array)."""
+    os.makedirs(model_dir, exist_ok=True)
+    with open(os.path.join(model_dir, "config.json"), "w") as f:
+        json.dump(dict(config, torch_dtype=torch_dtype), f)
+
+    tag = _DTYPE_TAGS[stored or torch_dtype]
+    tensors = {}
+    for name, w in weights.items():
+        if tags and name in tags:
+            t, raw = tags[name]
+            tensors[name] = (t, raw, w.shape)
+        else:
+            tensors[name] = (tag, encode(w, tag), w.shape)
+
+    names = list(tensors)
+    if shards == 1:
+        write_safetensors(os.path.join(model_dir, "model.safetensors"), tensors)
+        return
+    weight_map = {}
+    for s in range(shards):
+        file = f"model-{s + 1:05d}-of-{shards:05d}.safetensors"
+        part = names[s::shards]
+        write_safetensors(os.path.join(model_dir, file), {n: tensors[n] for n in part})
+        weight_map.update({n: file for n in part})
+    with open(os.path.join(model_dir, "model.safetensors.index.json"), "w") as f:
+        json.dump({"metadata": {}, "weight_map": weight_map}, f)
@@ -0,0 +1,55 @@
+#pragma once
+
+#include "../../src/tensor/tensor.hpp"
+
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace llaisys::bench {
+// Qwen2 各规模的单层形状（与 config.json 对应）
+struct ModelShape {
+    const char *name;
+    size_t hs, nh, nkvh, dh, di, voc, nlayer;
+};
+
+// 一组测量条件
+struct Config {
+    const ModelShape *model;
+    llaisysDataType_t dtype;
+    size_t ntoken;  // 参与计算的 token 行数：1 为解码，更大为 prefill
+    size_t context; // 注意力的 KV 长度（不小于 ntoken）
+};
+
+// 一个已准备好输入的用例：run 执行一次算子；flops / bytes 为一次执行的计算量与最少访存量，
+// 用于折算 GFLOP/s 与 GB/s
+struct Case {
+    std::string shape;
+    double flops;
+    double bytes;
+    std::function<void()> run;
+};
+
+// 用例工厂：同一算子可以有多个（如 linear 的各个投影），按需构造，测完即释放输入
+struct OpBench {
+    std::string op;
+    std::string variant;
+    std::function<Case(const Config &)> make;
+};
+
+// 本机的 roofline 边界，在给定线程数下测得
+struct MachinePeaks {
+    size_t threads;
+    double bw_gbps;    // STREAM triad 的可持续内存带宽
+    double f32_gflops; // f32 FMA 峰值；f16 / bf16 算子转换到 f32 计算，同样以此为上限
+    double i8_gops;    // int8 点积峰值，指令序列与 linear_w8a8 的内核相同
+};
+
+// 峰值探测所用的指令集
+const char *peakIsa();
+// 运行 STREAM triad 与 FMA / 点积循环，耗时约一秒
+MachinePeaks probeMachine(size_t threads);
+
+const std::vector<ModelShape> &modelShapes();
+const std::vector<OpBench> &opBenches();
+} // namespace llaisys::bench
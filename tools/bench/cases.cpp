@@ -0,0 +1,393 @@
+#include "bench.hpp"
+
+#include "../../src/ops/add/op.hpp"
+#include "../../src/ops/argmax/op.hpp"
+#include "../../src/ops/cast/op.hpp"
+#include "../../src/ops/embedding/op.hpp"
+#include "../../src/ops/kv_store/op.hpp"
+#include "../../src/ops/linear/op.hpp"
+#include "../../src/ops/linear_fp8/op.hpp"
+#include "../../src/ops/linear_q4/op.hpp"
+#include "../../src/ops/linear_q8/op.hpp"
+#include "../../src/ops/linear_topk/op.hpp"
+#include "../../src/ops/linear_w8a8/op.hpp"
+#include "../../src/ops/quantize_fp8/op.hpp"
+#include "../../src/ops/quantize_kv/op.hpp"
+#include "../../src/ops/quantize_q4/op.hpp"
+#include "../../src/ops/quantize_q8/op.hpp"
+#include "../../src/ops/rearrange/op.hpp"
+#include "../../src/ops/rms_norm/op.hpp"
+#include "../../src/ops/rope/op.hpp"
+#include "../../src/ops/sample/op.hpp"
+#include "../../src/ops/self_attention/op.hpp"
+#include "../../src/ops/swiglu/op.hpp"
+#include "../../src/utils.hpp"
+
+#include <cmath>
+#include <random>
+
+namespace llaisys::bench {
+namespace {
+constexpr size_t kGroupSize = 128; // int4 权重的分组大小，与 llaisys-convert 默认值一致
+constexpr size_t kTopK = 50;
+
+std::mt19937 &generator() {
+    static std::mt19937 gen(42);
+    return gen;
+}
+
+template <typename T>
+void fillUniform(std::byte *data, size_t n, float lo, float hi) {
+    std::uniform_real_distribution<float> dist(lo, hi);
+    T *dst = reinterpret_cast<T *>(data);
+    for (size_t i = 0; i < n; i++) {
+        dst[i] = utils::cast<T>(dist(generator()));
+    }
+}
+
+// 直接在目标类型的张量上填充均匀分布的随机数，不经过 float 中转（7B 的 lm_head 已有数 GB）
+tensor_t randomTensor(const shape_t &shape, llaisysDataType_t dtype, float lo = -1.0f, float hi = 1.0f) {
+    auto t = Tensor::create(shape, dtype);
+    switch (dtype) {
+    case LLAISYS_DTYPE_F32:
+        fillUniform<float>(t->data(), t->numel(), lo, hi);
+        break;
+    case LLAISYS_DTYPE_F16:
+        fillUniform<fp16_t>(t->data(), t->numel(), lo, hi);
+        break;
+    case LLAISYS_DTYPE_BF16:
+        fillUniform<bf16_t>(t->data(), t->numel(), lo, hi);
+        break;
+    default:
+        EXCEPTION_UNSUPPORTED_DATATYPE(dtype);
+    }
+    return t;
+}
+
+tensor_t int64Tensor(const std::vector<int64_t> &values) {
+    auto t = Tensor::create({values.size()}, LLAISYS_DTYPE_I64);
+    t->load(values.data());
+    return t;
+}
+
+double bytesOf(std::initializer_list<tensor_t> tensors) {
+    double total = 0.0;
+    for (const auto &t : tensors) {
+        if (t) {
+            total += static_cast<double>(t->numel() * t->elementSize());
+        }
+    }
+    return total;
+}
+
+std::string dims(std::initializer_list<size_t> values) {
+    std::string s;
+    for (size_t v : values) {
+        s += (s.empty() ? "" : "x") + std::to_string(v);
+    }
+    return s;
+}
+
+// 解码层中的各个线性投影：[in_features] -> [out_features]
+struct Projection {
+    size_t in, out;
+    bool bias;
+};
+
+Projection projection(const ModelShape &m, const std::string &name) {
+    if (name == "qkv") {
+        return {m.hs, (m.nh + 2 * m.nkvh) * m.dh, true};
+    }
+    if (name == "o") {
+        return {m.nh * m.dh, m.hs, false};
+    }
+    if (name == "gate_up") {
+        return {m.hs, 2 * m.di, false};
+    }
+    return {m.di, m.hs, false}; // down
+}
+
+enum class WeightKind { Float, Q8, Q4, FP8, W8A8 };
+
+Case linearCase(const Config &cfg, const std::string &name, WeightKind kind) {
+    const Projection p = projection(*cfg.model, name);
+    const size_t n = cfg.ntoken;
+    auto in = randomTensor({n, p.in}, cfg.dtype);
+    auto out = Tensor::create({n, p.out}, cfg.dtype);
+    auto bias = p.bias ? randomTensor({p.out}, cfg.dtype) : nullptr;
+    auto weight = randomTensor({p.out, p.in}, cfg.dtype, -0.05f, 0.05f);
+
+    Case c{dims({n, p.in, p.out}), 2.0 * n * p.in * p.out, 0.0, nullptr};
+    switch (kind) {
+    case WeightKind::Float:
+        c.bytes = bytesOf({in, out, bias, weight});
+        c.run = [=] { ops::linear(out, in, weight, bias); };
+        break;
+    case WeightKind::Q8:
+    case WeightKind::W8A8: {
+        auto q = Tensor::create({p.out, p.in}, LLAISYS_DTYPE_I8);
+        auto s = Tensor::create({p.out}, LLAISYS_DTYPE_F32);
+        ops::quantize_q8(q, s, weight);
+        c.bytes = bytesOf({in, out, bias, q, s});
+        if (kind == WeightKind::Q8) {
+            c.run = [=] { ops::linear_q8(out, in, q, s, bias); };
+        } else {
+            c.run = [=] { ops::linear_w8a8(out, in, q, s, bias); };
+        }
+        break;
+    }
+    case WeightKind::Q4: {
+        auto q = Tensor::create({p.out, p.in / 2}, LLAISYS_DTYPE_U8);
+        auto s = Tensor::create({p.out, p.in / kGroupSize}, LLAISYS_DTYPE_F16);
+        auto z = Tensor::create({p.out, p.in / kGroupSize}, LLAISYS_DTYPE_U8);
+        ops::quantize_q4(q, s, z, weight);
+        c.bytes = bytesOf({in, out, bias, q, s, z});
+        c.run = [=] { ops::linear_q4(out, in, q, s, z, bias); };
+        break;
+    }
+    case WeightKind::FP8: {
+        auto q = Tensor::create({p.out, p.in}, LLAISYS_DTYPE_F8);
+        auto s = Tensor::create({p.out}, LLAISYS_DTYPE_F32);
+        ops::quantize_fp8(q, s, weight);
+        c.bytes = bytesOf({in, out, bias, q, s});
+        c.run = [=] { ops::linear_fp8(out, in, q, s, bias); };
+        break;
+    }
+    }
+    return c;
+}
+
+// 因果注意力的计算量：第 i 个 query 看到 context - ntoken + i + 1 个 key
+double attentionFlops(const ModelShape &m, size_t n, size_t ctx) {
+    double keys = 0.0;
+    for (size_t i = 0; i < n; i++) {
+        keys += static_cast<double>(ctx - n + i + 1);
+    }
+    return 4.0 * m.nh * m.dh * keys;
+}
+
+Case attentionCase(const Config &cfg, bool quant_kv) {
+    const ModelShape &m = *cfg.model;
+    const size_t n = cfg.ntoken, ctx = std::max(cfg.context, n);
+    auto q = randomTensor({n, m.nh, m.dh}, cfg.dtype);
+    auto out = Tensor::create({n, m.nh, m.dh}, cfg.dtype);
+    auto k = randomTensor({ctx, m.nkvh, m.dh}, cfg.dtype);
+    auto v = randomTensor({ctx, m.nkvh, m.dh}, cfg.dtype);
+    const float scale = 1.0f / std::sqrt(static_cast<float>(m.dh));
+
+    Case c{dims({n, ctx, m.nh, m.nkvh, m.dh}), attentionFlops(m, n, ctx), 0.0, nullptr};
+    if (!quant_kv) {
+        c.bytes = bytesOf({q, out, k, v});
+        c.run = [=] { ops::self_attention(out, q, k, v, scale); };
+        return c;
+    }
+    auto kq = Tensor::create({ctx, m.nkvh, m.dh}, LLAISYS_DTYPE_I8);
+    auto vq = Tensor::create({ctx, m.nkvh, m.dh}, LLAISYS_DTYPE_I8);
+    auto ks = Tensor::create({ctx, m.nkvh}, LLAISYS_DTYPE_F32);
+    auto vs = Tensor::create({ctx, m.nkvh}, LLAISYS_DTYPE_F32);
+    ops::quantize_kv(kq, ks, k);
+    ops::quantize_kv(vq, vs, v);
+    c.bytes = bytesOf({q, out, kq, vq, ks, vs});
+    c.run = [=] { ops::self_attention(out, q, kq, vq, scale, ks, vs); };
+    return c;
+}
+
+Case addCase(const Config &cfg) {
+    const size_t n = cfg.ntoken, h = cfg.model->hs;
+    auto a = randomTensor({n, h}, cfg.dtype), b = randomTensor({n, h}, cfg.dtype);
+    auto c = Tensor::create({n, h}, cfg.dtype);
+    return {dims({n, h}), static_cast<double>(n * h), bytesOf({a, b, c}), [=] { ops::add(c, a, b); }};
+}
+
+Case rmsNormCase(const Config &cfg) {
+    const size_t n = cfg.ntoken, h = cfg.model->hs;
+    auto in = randomTensor({n, h}, cfg.dtype), w = randomTensor({h}, cfg.dtype);
+    auto out = Tensor::create({n, h}, cfg.dtype);
+    return {dims({n, h}), 4.0 * n * h, bytesOf({in, w, out}), [=] { ops::rms_norm(out, in, w, 1e-6f); }};
+}
+
+Case swigluCase(const Config &cfg) {
+    const size_t n = cfg.ntoken, di = cfg.model->di;
+    auto gate = randomTensor({n, di}, cfg.dtype), up = randomTensor({n, di}, cfg.dtype);
+    auto out = Tensor::create({n, di}, cfg.dtype);
+    return {dims({n, di}), 5.0 * n * di, bytesOf({gate, up, out}), [=] { ops::swiglu(out, gate, up); }};
+}
+
+Case ropeCase(const Config &cfg) {
+    const ModelShape &m = *cfg.model;
+    const size_t n = cfg.ntoken, ctx = std::max(cfg.context, n);
+    std::vector<int64_t> pos(n);
+    for (size_t i = 0; i < n; i++) {
+        pos[i] = static_cast<int64_t>(ctx - n + i);
+    }
+    auto in = randomTensor({n, m.nh, m.dh}, cfg.dtype);
+    auto out = Tensor::create({n, m.nh, m.dh}, cfg.dtype);
+    auto pos_ids = int64Tensor(pos);
+    return {dims({n, m.nh, m.dh}), 6.0 * n * m.nh * m.dh / 2, bytesOf({in, out, pos_ids}),
+            [=] { ops::rope(out, in, pos_ids, 1e6f); }};
+}
+
+Case embeddingCase(const Config &cfg) {
+    const ModelShape &m = *cfg.model;
+    const size_t n = cfg.ntoken;
+    std::uniform_int_distribution<int64_t> dist(0, static_cast<int64_t>(m.voc) - 1);
+    std::vector<int64_t> ids(n);
+    for (auto &id : ids) {
+        id = dist(generator());
+    }
+    auto index = int64Tensor(ids);
+    auto weight = randomTensor({m.voc, m.hs}, cfg.dtype);
+    auto out = Tensor::create({n, m.hs}, cfg.dtype);
+    // 只读取被选中的 n 行
+    const double bytes = 2.0 * n * m.hs * utils::dsize(cfg.dtype) + bytesOf({index});
+    return {dims({n, m.hs}), 0.0, bytes, [=] { ops::embedding(out, index, weight); }};
+}
+
+Case lmHeadTopkCase(const Config &cfg) {
+    const ModelShape &m = *cfg.model;
+    const size_t n = cfg.ntoken;
+    auto in = randomTensor({n, m.hs}, cfg.dtype);
+    auto weight = randomTensor({m.voc, m.hs}, cfg.dtype, -0.05f, 0.05f);
+    auto idx = Tensor::create({n, kTopK}, LLAISYS_DTYPE_I64);
+    auto val = Tensor::create({n, kTopK}, cfg.dtype);
+    return {dims({n, m.hs, m.voc, kTopK}), 2.0 * n * m.hs * m.voc, bytesOf({in, weight, idx, val}),
+            [=] { ops::linear_topk(idx, val, in, weight, nullptr, nullptr); }};
+}
+
+Case argmaxCase(const Config &cfg) {
+    const size_t voc = cfg.model->voc;
+    auto vals = randomTensor({voc}, cfg.dtype);
+    auto idx = Tensor::create({1}, LLAISYS_DTYPE_I64);
+    auto val = Tensor::create({1}, cfg.dtype);
+    return {dims({voc}), static_cast<double>(voc), bytesOf({vals}), [=] { ops::argmax(idx, val, vals); }};
+}
+
+Case sampleCase(const Config &cfg) {
+    const size_t n = cfg.ntoken, voc = cfg.model->voc;
+    auto logits = randomTensor({n, voc}, cfg.dtype, -10.0f, 10.0f);
+    auto idx = Tensor::create({n}, LLAISYS_DTYPE_I64);
+    auto state = Tensor::create({n}, LLAISYS_DTYPE_U64);
+    std::vector<uint64_t> seeds(n);
+    for (size_t i = 0; i < n; i++) {
+        seeds[i] = i + 1;
+    }
+    state->load(seeds.data());
+    // temperature 为 1 时 logits 不被改写，重复执行的输入保持不变
+    std::vector<LlaisysSamplingParams> params(n, LlaisysSamplingParams{1.0f, kTopK, 0.9f, 1.0f});
+    return {dims({n, voc}), 0.0, bytesOf({logits}), [=] { ops::sample(idx, logits, params.data(), state); }};
+}
+
+Case rearrangeCase(const Config &cfg) {
+    const ModelShape &m = *cfg.model;
+    const size_t n = cfg.ntoken;
+    auto in = randomTensor({n, m.nh, m.dh}, cfg.dtype);
+    auto out = Tensor::create({m.nh, n, m.dh}, cfg.dtype);
+    auto view = in->permute({1, 0, 2});
+    return {dims({n, m.nh, m.dh}), 0.0, bytesOf({in, out}), [=] { ops::rearrange(out, view); }};
+}
+
+Case castCase(const Config &cfg) {
+    const size_t n = cfg.ntoken, h = cfg.model->hs;
+    auto in = randomTensor({n, h}, cfg.dtype);
+    auto out = Tensor::create({n, h}, cfg.dtype == LLAISYS_DTYPE_F32 ? LLAISYS_DTYPE_BF16 : LLAISYS_DTYPE_F32);
+    return {dims({n, h}), 0.0, bytesOf({in, out}), [=] { ops::cast(out, in); }};
+}
+
+Case quantizeKVCase(const Config &cfg) {
+    const ModelShape &m = *cfg.model;
+    const size_t n = cfg.ntoken;
+    auto in = randomTensor({n, m.nkvh, m.dh}, cfg.dtype);
+    auto out = Tensor::create({n, m.nkvh, m.dh}, LLAISYS_DTYPE_I8);
+    auto scales = Tensor::create({n, m.nkvh}, LLAISYS_DTYPE_F32);
+    return {dims({n, m.nkvh, m.dh}), 3.0 * in->numel(), bytesOf({in, out, scales}),
+            [=] { ops::quantize_kv(out, scales, in); }};
+}
+
+Case kvStoreCase(const Config &cfg) {
+    const ModelShape &m = *cfg.model;
+    const size_t n = cfg.ntoken, ctx = std::max(cfg.context, n);
+    std::vector<int64_t> rows(n);
+    for (size_t i = 0; i < n; i++) {
+        rows[i] = static_cast<int64_t>(ctx - n + i);
+    }
+    auto cache = Tensor::create({ctx, m.nkvh, m.dh}, cfg.dtype);
+    auto src = randomTensor({n, m.nkvh, m.dh}, cfg.dtype);
+    auto slots = int64Tensor(rows);
+    return {dims({n, ctx, m.nkvh, m.dh}), 0.0, 2.0 * bytesOf({src}) + bytesOf({slots}),
+            [=] { ops::kv_store(cache, nullptr, src, slots); }};
+}
+
+// 权重量化在加载时执行，以 o_proj 的权重为代表
+Case quantizeWeightCase(const Config &cfg, WeightKind kind) {
+    const Projection p = projection(*cfg.model, "o");
+    auto weight = randomTensor({p.out, p.in}, cfg.dtype, -0.05f, 0.05f);
+    Case c{dims({p.out, p.in}), 3.0 * weight->numel(), 0.0, nullptr};
+    if (kind == WeightKind::Q4) {
+        auto q = Tensor::create({p.out, p.in / 2}, LLAISYS_DTYPE_U8);
+        auto s = Tensor::create({p.out, p.in / kGroupSize}, LLAISYS_DTYPE_F16);
+        auto z = Tensor::create({p.out, p.in / kGroupSize}, LLAISYS_DTYPE_U8);
+        c.bytes = bytesOf({weight, q, s, z});
+        c.run = [=] { ops::quantize_q4(q, s, z, weight); };
+        return c;
+    }
+    auto q = Tensor::create({p.out, p.in}, kind == WeightKind::FP8 ? LLAISYS_DTYPE_F8 : LLAISYS_DTYPE_I8);
+    auto s = Tensor::create({p.out}, LLAISYS_DTYPE_F32);
+    c.bytes = bytesOf({weight, q, s});
+    if (kind == WeightKind::FP8) {
+        c.run = [=] { ops::quantize_fp8(q, s, weight); };
+    } else {
+        c.run = [=] { ops::quantize_q8(q, s, weight); };
+    }
+    return c;
+}
+
+std::vector<OpBench> buildOpBenches() {
+    std::vector<OpBench> benches = {
+        {"embedding", "", embeddingCase},
+        {"rms_norm", "", rmsNormCase},
+        {"add", "", addCase},
+        {"swiglu", "", swigluCase},
+        {"rope", "", ropeCase},
+        {"self_attention", "", [](const Config &cfg) { return attentionCase(cfg, false); }},
+        {"self_attention", "kv_int8", [](const Config &cfg) { return attentionCase(cfg, true); }},
+        {"kv_store", "", kvStoreCase},
+        {"quantize_kv", "", quantizeKVCase},
+        {"rearrange", "", rearrangeCase},
+        {"cast", "", castCase},
+        {"linear_topk", "lm_head", lmHeadTopkCase},
+        {"argmax", "", argmaxCase},
+        {"sample", "", sampleCase},
+        {"quantize_q8", "", [](const Config &cfg) { return quantizeWeightCase(cfg, WeightKind::Q8); }},
+        {"quantize_q4", "", [](const Config &cfg) { return quantizeWeightCase(cfg, WeightKind::Q4); }},
+        {"quantize_fp8", "", [](const Config &cfg) { return quantizeWeightCase(cfg, WeightKind::FP8); }},
+    };
+    const std::pair<const char *, WeightKind> linears[] = {
+        {"linear", WeightKind::Float},  {"linear_q8", WeightKind::Q8},     {"linear_q4", WeightKind::Q4},
+        {"linear_fp8", WeightKind::FP8}, {"linear_w8a8", WeightKind::W8A8},
+    };
+    for (const auto &[op, kind] : linears) {
+        for (const char *proj : {"qkv", "o", "gate_up", "down"}) {
+            benches.push_back({op, proj, [proj = std::string(proj), kind = kind](const Config &cfg) {
+                                   return linearCase(cfg, proj, kind);
+                               }});
+        }
+    }
+    return benches;
+}
+} // namespace
+
+const std::vector<ModelShape> &modelShapes() {
+    static const std::vector<ModelShape> shapes = {
+        // name, hs, nh, nkvh, dh, di, voc, nlayer
+        {"qwen2-0.5b", 896, 14, 2, 64, 4864, 151936, 24},
+        {"qwen2-1.5b", 1536, 12, 2, 128, 8960, 151936, 28},
+        {"qwen2-7b", 3584, 28, 4, 128, 18944, 152064, 28},
+    };
+    return shapes;
+}
+
+const std::vector<OpBench> &opBenches() {
+    static const std::vector<OpBench> benches = buildOpBenches();
+    return benches;
+}
+} // namespace llaisys::bench
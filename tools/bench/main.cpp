@@ -0,0 +1,539 @@
+// llaisys-bench: 直接链接算子静态库的 CPU 微基准。按 Qwen2 各规模的形状、数据类型与线程数
+// 扫描每个算子，输出中位数 / p99 耗时、GFLOP/s 与 GB/s，可选写出 JSON 便于长期跟踪。
+//
+//   llaisys-bench [--models 0.5b,1.5b,7b] [--dtypes f32,f16,bf16] [--tokens 1,128]
+//                 [--threads N,...] [--context N] [--ops name,...] [--min-time SEC]
+//                 [--max-iters N] [--json out.json] [--counters] [--roofline] [--list]
+//
+// --counters 时用 perf_event 计数器统计每次调用的 IPC、末级缓存未命中、线程平均占用与实测内存带宽，
+// 系统不允许的计数器显示为 "-"。读取计数器会给每次调用增加若干次系统调用，耗时列相应偏高。
+//
+// --roofline 时先探测本机的 STREAM 带宽与 FMA / int8 点积峰值，每行追加算术强度（FLOP/B）、
+// 实测相对 roofline 上限的比例与受限资源，最后按各模型的层数把用例折算成一次前向的耗时分布。
+// 上限以 DRAM 带宽计，能放进缓存的小算子比例可能超过 100%。
+
+#include "bench.hpp"
+
+#include "../../src/core/llaisys_core.hpp"
+#include "../../src/core/trace/trace.hpp"
+#include "../../src/utils.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <ctime>
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+using namespace llaisys::bench;
+
+namespace {
+struct Options {
+    std::vector<const ModelShape *> models;
+    std::vector<llaisysDataType_t> dtypes = {LLAISYS_DTYPE_F32, LLAISYS_DTYPE_F16, LLAISYS_DTYPE_BF16};
+    std::vector<size_t> tokens = {1, 128};
+    std::vector<size_t> threads;
+    std::vector<std::string> ops; // 为空时测全部算子
+    size_t context = 1024;
+    double min_time = 0.2;
+    size_t max_iters = 200;
+    std::string json;
+    size_t max_threads = 1; // 启动时 OpenMP 的默认线程数
+    bool counters = false;
+    unsigned available = 0; // 可用计数器掩码
+    bool roofline = false;
+    std::vector<MachinePeaks> peaks; // 各线程数下的 roofline 边界
+};
+
+namespace counters = llaisys::core::trace::counters;
+
+// 计数器的每次调用平均值，不可用的项为负数
+struct CounterStats {
+    double cycles = -1, instructions = -1, llc_misses = -1, cpu_util = -1, mem_gbps = -1;
+};
+
+struct Result {
+    std::string model, dtype, op, variant, shape;
+    size_t ntoken, context, threads, iters;
+    double median_us, p99_us, gflops, gbps;
+    CounterStats perf;
+    // roofline：算术强度（FLOP/B）、实测占上限的比例、受限资源与一次前向中的调用次数
+    double intensity = -1, roof_frac = -1;
+    const char *limiter = nullptr;
+    size_t step_calls = 0;
+};
+
+int usage(const char *argv0) {
+    std::cerr << "usage: " << argv0 << " [--models 0.5b,1.5b,7b] [--dtypes f32,f16,bf16] [--tokens 1,128]"
+              << " [--threads N,...] [--context N] [--ops name,...] [--min-time SEC] [--max-iters N]"
+              << " [--json out.json] [--counters] [--roofline] [--list]" << std::endl;
+    return 2;
+}
+
+std::vector<std::string> split(const std::string &s) {
+    std::vector<std::string> parts;
+    std::stringstream ss(s);
+    std::string item;
+    while (std::getline(ss, item, ',')) {
+        if (!item.empty()) {
+            parts.push_back(item);
+        }
+    }
+    return parts;
+}
+
+std::vector<size_t> parseSizes(const std::string &s) {
+    std::vector<size_t> values;
+    for (const auto &item : split(s)) {
+        values.push_back(std::stoul(item));
+    }
+    CHECK_ARGUMENT(!values.empty() && std::count(values.begin(), values.end(), size_t(0)) == 0,
+                   "expected a list of positive integers: " + s);
+    return values;
+}
+
+llaisysDataType_t parseDtype(const std::string &s) {
+    if (s == "f32") {
+        return LLAISYS_DTYPE_F32;
+    }
+    if (s == "f16") {
+        return LLAISYS_DTYPE_F16;
+    }
+    if (s == "bf16") {
+        return LLAISYS_DTYPE_BF16;
+    }
+    throw std::invalid_argument("unsupported dtype: " + s);
+}
+
+const ModelShape *parseModel(const std::string &s) {
+    for (const auto &m : modelShapes()) {
+        const std::string name = m.name;
+        if (name == s || name == "qwen2-" + s) {
+            return &m;
+        }
+    }
+    throw std::invalid_argument("unknown model: " + s);
+}
+
+size_t maxThreads() {
+#ifdef _OPENMP
+    return static_cast<size_t>(omp_get_max_threads());
+#else
+    return 1;
+#endif
+}
+
+void setThreads(size_t n) {
+#ifdef _OPENMP
+    omp_set_num_threads(static_cast<int>(n));
+#else
+    CHECK_ARGUMENT(n == 1, "built without OpenMP: only --threads 1 is available");
+#endif
+}
+
+bool selected(const Options &opt, const OpBench &b) {
+    if (opt.ops.empty()) {
+        return true;
+    }
+    const std::string full = b.variant.empty() ? b.op : b.op + "/" + b.variant;
+    return std::find(opt.ops.begin(), opt.ops.end(), b.op) != opt.ops.end()
+        || std::find(opt.ops.begin(), opt.ops.end(), full) != opt.ops.end();
+}
+
+// 该算子在计数期间的累计值折算为每次调用的平均值
+CounterStats counterStats(const Options &opt, const std::string &op) {
+    CounterStats stats;
+    for (const auto &[name, t] : counters::summary()) {
+        if (name != op || t.calls == 0) {
+            continue;
+        }
+        auto avg = [&](counters::Counter c) {
+            return opt.available & (1u << c) ? static_cast<double>(t.values[c]) / t.calls : -1.0;
+        };
+        stats.cycles = avg(counters::CYCLES);
+        stats.instructions = avg(counters::INSTRUCTIONS);
+        stats.llc_misses = avg(counters::LLC_MISSES);
+        if (opt.available & (1u << counters::TASK_CLOCK)) {
+            stats.cpu_util = static_cast<double>(t.values[counters::TASK_CLOCK]) / t.time_ns;
+        }
+        if (opt.available & (1u << counters::MEM_BYTES)) {
+            stats.mem_gbps = static_cast<double>(t.values[counters::MEM_BYTES]) / t.time_ns;
+        }
+    }
+    return stats;
+}
+
+// 先预热一次，再重复执行直到累计 min_time 秒或 max_iters 次（至少 5 次），逐次计时
+Result measure(const Options &opt, const OpBench &b, const Case &c) {
+    using clock = std::chrono::steady_clock;
+    auto &runtime = llaisys::core::context().runtime();
+    c.run();
+    runtime.synchronize();
+    if (opt.counters) {
+        counters::reset();
+    }
+    std::vector<double> samples;
+    double total = 0.0;
+    while (samples.size() < opt.max_iters && (samples.size() < 5 || total < opt.min_time)) {
+        const auto t0 = clock::now();
+        c.run();
+        // 算子提交到 CPU 流后立即返回，计时包含等待其执行完成
+        runtime.synchronize();
+        const double dt = std::chrono::duration<double>(clock::now() - t0).count();
+        samples.push_back(dt);
+        total += dt;
+    }
+    std::sort(samples.begin(), samples.end());
+    const size_t n = samples.size();
+    const double median = n % 2 ? samples[n / 2] : 0.5 * (samples[n / 2 - 1] + samples[n / 2]);
+    const size_t rank = static_cast<size_t>(std::ceil(0.99 * n));
+    const double p99 = samples[std::max<size_t>(rank, 1) - 1];
+
+    Result r{};
+    r.shape = c.shape;
+    r.iters = n;
+    r.median_us = median * 1e6;
+    r.p99_us = p99 * 1e6;
+    r.gflops = c.flops / median * 1e-9;
+    r.gbps = c.bytes / median * 1e-9;
+    if (opt.counters) {
+        r.perf = counterStats(opt, b.op);
+    }
+    return r;
+}
+
+void printCounters(const CounterStats &c) {
+    auto column = [](double value, int width, const char *format) {
+        if (value < 0) {
+            std::printf(" %*s", width, "-");
+        } else {
+            std::printf(format, width, value);
+        }
+    };
+    column(c.cycles > 0 && c.instructions >= 0 ? c.instructions / c.cycles : -1, 6, " %*.2f");
+    column(c.llc_misses, 10, " %*.0f");
+    column(c.cpu_util, 8, " %*.2f");
+    column(c.mem_gbps, 8, " %*.2f");
+}
+
+const MachinePeaks &peaksFor(const Options &opt, size_t threads) {
+    for (const auto &p : opt.peaks) {
+        if (p.threads == threads) {
+            return p;
+        }
+    }
+    return opt.peaks.back();
+}
+
+void probePeaks(Options &opt) {
+    std::vector<size_t> counts = opt.threads;
+    counts.push_back(1);
+    counts.push_back(opt.max_threads);
+    std::sort(counts.begin(), counts.end());
+    counts.erase(std::unique(counts.begin(), counts.end()), counts.end());
+    for (size_t n : counts) {
+        const MachinePeaks p = probeMachine(n);
+        std::printf("roofline (%s, %zu threads): triad %.2f GB/s, f32 %.1f GFLOP/s, int8 %.1f GOP/s\n", peakIsa(), n,
+                    p.bw_gbps, p.f32_gflops, p.i8_gops);
+        opt.peaks.push_back(p);
+    }
+    std::fflush(stdout);
+}
+
+// 一次前向（ntoken 个 token）中该用例的调用次数，不在前向路径上的为 0。
+// 每层两次 rms_norm、两次残差 add、q / k 各一次 rope（按 q 的形状计）、k / v 各一次 kv_store，
+// 加上末尾的 norm 与 lm_head；kv_int8 注意力与 quantize_kv 属于另一条 KV 路径，不计入
+size_t stepCalls(const ModelShape &m, const std::string &op, const std::string &variant) {
+    const size_t L = m.nlayer;
+    if (op == "embedding" || op == "linear_topk") {
+        return 1;
+    }
+    if (op == "rms_norm") {
+        return 2 * L + 1;
+    }
+    if (op == "add" || op == "rope" || op == "kv_store") {
+        return 2 * L;
+    }
+    if (op == "swiglu" || (op == "self_attention" && variant.empty()) || op.rfind("linear", 0) == 0) {
+        return L;
+    }
+    return 0;
+}
+
+// 上限 = min(算力峰值, 算术强度 × 带宽)；linear_w8a8 以 int8 点积为算力峰值，其余以 f32 FMA 为准。
+// 没有计算量的算子（搬运、嵌入）只受带宽限制，比例按 GB/s 计
+void applyRoofline(const Options &opt, const Case &c, Result &r, const ModelShape &m) {
+    const MachinePeaks &p = peaksFor(opt, r.threads);
+    const double peak = r.op == "linear_w8a8" ? p.i8_gops : p.f32_gflops;
+    r.step_calls = stepCalls(m, r.op, r.variant);
+    if (c.flops <= 0.0 || c.bytes <= 0.0) {
+        r.intensity = 0.0;
+        r.roof_frac = r.gbps / p.bw_gbps;
+        r.limiter = "memory";
+        return;
+    }
+    r.intensity = c.flops / c.bytes;
+    const double memory_roof = r.intensity * p.bw_gbps;
+    r.roof_frac = r.gflops / std::min(peak, memory_roof);
+    r.limiter = memory_roof < peak ? "memory" : "compute";
+}
+
+// 按 (模型, dtype, ntoken, 线程数) 分组，对每种线性层实现把已测用例按调用次数加总为一次前向的耗时，
+// 并给出受内存 / 算力限制的时间占比与占比最大的用例
+void printSteps(const std::vector<Result> &results) {
+    std::vector<const Result *> done;
+    for (const Result &head : results) {
+        auto same = [&](const Result &r) {
+            return r.model == head.model && r.dtype == head.dtype && r.ntoken == head.ntoken
+                && r.threads == head.threads;
+        };
+        if (std::find_if(done.begin(), done.end(), [&](const Result *r) { return same(*r); }) != done.end()) {
+            continue;
+        }
+        done.push_back(&head);
+        std::vector<std::string> families;
+        for (const Result &r : results) {
+            if (same(r) && r.step_calls && r.op.rfind("linear", 0) == 0 && r.op != "linear_topk"
+                && std::find(families.begin(), families.end(), r.op) == families.end()) {
+                families.push_back(r.op);
+            }
+        }
+        for (const std::string &family : families) {
+            double total = 0.0, memory = 0.0, top = 0.0;
+            std::string top_name;
+            size_t cases = 0;
+            for (const Result &r : results) {
+                const bool linear = r.op.rfind("linear", 0) == 0 && r.op != "linear_topk";
+                if (!same(r) || !r.step_calls || (linear && r.op != family)) {
+                    continue;
+                }
+                const double us = r.median_us * r.step_calls;
+                total += us;
+                memory += std::string(r.limiter) == "memory" ? us : 0.0;
+                if (us > top) {
+                    top = us;
+                    top_name = r.variant.empty() ? r.op : r.op + "/" + r.variant;
+                }
+                cases++;
+            }
+            std::printf("step %-11s %-8s ntok %-5zu thr %-3zu %-12s %10.3f ms  memory-bound %5.1f%%  "
+                        "compute-bound %5.1f%%  top %s (%.1f%%), %zu cases\n",
+                        head.model.c_str(), head.dtype.c_str(), head.ntoken, head.threads, family.c_str(),
+                        total * 1e-3, 100.0 * memory / total, 100.0 * (total - memory) / total, top_name.c_str(),
+                        100.0 * top / total, cases);
+        }
+    }
+}
+
+std::string jsonString(const std::string &s) {
+    std::string out = "\"";
+    for (char ch : s) {
+        if (ch == '"' || ch == '\\') {
+            out += '\\';
+        }
+        out += ch;
+    }
+    return out + "\"";
+}
+
+void writeJson(const std::string &path, const Options &opt, const std::vector<Result> &results) {
+    std::ofstream f(path);
+    CHECK_ARGUMENT(f.good(), "cannot open " + path);
+    char num[64];
+    auto fmt = [&](double v) {
+        std::snprintf(num, sizeof(num), "%.6g", v);
+        return std::string(num);
+    };
+    f << "{\n  \"timestamp\": " << static_cast<long long>(std::time(nullptr)) << ",\n  \"max_threads\": "
+      << opt.max_threads << ",";
+    if (!opt.peaks.empty()) {
+        f << "\n  \"isa\": " << jsonString(peakIsa()) << ",\n  \"peaks\": [";
+        for (size_t i = 0; i < opt.peaks.size(); i++) {
+            const MachinePeaks &p = opt.peaks[i];
+            f << (i ? ", " : "") << "{\"threads\": " << p.threads << ", \"bw_gbps\": " << fmt(p.bw_gbps)
+              << ", \"f32_gflops\": " << fmt(p.f32_gflops) << ", \"i8_gops\": " << fmt(p.i8_gops) << "}";
+        }
+        f << "],";
+    }
+    f << "\n  \"results\": [";
+    for (size_t i = 0; i < results.size(); i++) {
+        const Result &r = results[i];
+        f << (i ? ",\n" : "\n") << "    {\"model\": " << jsonString(r.model) << ", \"dtype\": " << jsonString(r.dtype)
+          << ", \"op\": " << jsonString(r.op) << ", \"variant\": " << jsonString(r.variant)
+          << ", \"shape\": " << jsonString(r.shape) << ", \"ntoken\": " << r.ntoken << ", \"context\": " << r.context
+          << ", \"threads\": " << r.threads << ", \"iters\": " << r.iters << ", \"median_us\": " << fmt(r.median_us)
+          << ", \"p99_us\": " << fmt(r.p99_us) << ", \"gflops\": " << fmt(r.gflops) << ", \"gbps\": " << fmt(r.gbps);
+        const CounterStats &c = r.perf;
+        for (const auto &[key, value] : {std::pair<const char *, double>{"cycles", c.cycles},
+                                         {"instructions", c.instructions}, {"llc_misses", c.llc_misses},
+                                         {"cpu_util", c.cpu_util}, {"mem_gbps", c.mem_gbps}}) {
+            if (value >= 0) {
+                f << ", \"" << key << "\": " << fmt(value);
+            }
+        }
+        if (r.limiter) {
+            f << ", \"intensity\": " << fmt(r.intensity) << ", \"roof_frac\": " << fmt(r.roof_frac)
+              << ", \"limiter\": " << jsonString(r.limiter) << ", \"step_calls\": " << r.step_calls;
+        }
+        f << "}";
+    }
+    f << "\n  ]\n}\n";
+}
+} // namespace
+
+int main(int argc, char **argv) {
+    Options opt;
+    try {
+        for (int i = 1; i < argc; i++) {
+            const std::string option = argv[i];
+            if (option == "--counters") {
+                opt.counters = true;
+                continue;
+            }
+            if (option == "--roofline") {
+                opt.roofline = true;
+                continue;
+            }
+            if (option == "--list") {
+                for (const auto &b : opBenches()) {
+                    std::cout << b.op << (b.variant.empty() ? "" : "/" + b.variant) << std::endl;
+                }
+                return 0;
+            }
+            if (i + 1 >= argc) {
+                return usage(argv[0]);
+            }
+            const std::string value = argv[++i];
+            if (option == "--models") {
+                for (const auto &m : split(value)) {
+                    opt.models.push_back(parseModel(m));
+                }
+            } else if (option == "--dtypes") {
+                opt.dtypes.clear();
+                for (const auto &d : split(value)) {
+                    opt.dtypes.push_back(parseDtype(d));
+                }
+            } else if (option == "--tokens") {
+                opt.tokens = parseSizes(value);
+            } else if (option == "--threads") {
+                opt.threads = parseSizes(value);
+            } else if (option == "--context") {
+                opt.context = parseSizes(value).front();
+            } else if (option == "--ops") {
+                opt.ops = split(value);
+            } else if (option == "--min-time") {
+                opt.min_time = std::stod(value);
+            } else if (option == "--max-iters") {
+                opt.max_iters = parseSizes(value).front();
+            } else if (option == "--json") {
+                opt.json = value;
+            } else {
+                return usage(argv[0]);
+            }
+        }
+    } catch (const std::exception &e) {
+        std::cerr << "llaisys-bench: " << e.what() << std::endl;
+        return usage(argv[0]);
+    }
+    if (opt.models.empty()) {
+        for (const auto &m : modelShapes()) {
+            opt.models.push_back(&m);
+        }
+    }
+    opt.max_threads = maxThreads();
+    if (opt.threads.empty()) {
+        opt.threads = {opt.max_threads};
+    }
+
+    if (opt.counters) {
+        opt.available = counters::setEnabled(true);
+        std::printf("counters:");
+        const char *names[] = {"cycles", "instructions", "llc_misses", "task_clock", "mem_bytes"};
+        for (unsigned i = 0; i < counters::NUM_COUNTERS; i++) {
+            std::printf(" %s%s", names[i], opt.available & (1u << i) ? "" : "(unavailable)");
+        }
+        std::printf("\n");
+    }
+
+    if (opt.roofline) {
+        probePeaks(opt);
+    }
+
+    std::vector<Result> results;
+    std::printf("%-11s %-8s %5s %3s  %-24s %-22s %6s %11s %11s %9s %8s", "model", "dtype", "ntok", "thr", "op",
+                "shape", "iters", "median_us", "p99_us", "GFLOP/s", "GB/s");
+    if (opt.counters) {
+        std::printf(" %6s %10s %8s %8s", "IPC", "LLCmiss", "cpu", "memGB/s");
+    }
+    if (opt.roofline) {
+        std::printf(" %8s %7s %-7s", "FLOP/B", "roof%", "limit");
+    }
+    std::printf("\n");
+    for (const ModelShape *model : opt.models) {
+        for (llaisysDataType_t dtype : opt.dtypes) {
+            for (size_t ntoken : opt.tokens) {
+                const Config cfg{model, dtype, ntoken, std::max(opt.context, ntoken)};
+                for (const auto &b : opBenches()) {
+                    if (!selected(opt, b)) {
+                        continue;
+                    }
+                    const std::string name = b.variant.empty() ? b.op : b.op + "/" + b.variant;
+                    const char *dtype_name = llaisys::utils::dtype_to_str(dtype);
+                    try {
+                        // 输入只构造一次，在各线程数下复用
+                        const Case c = b.make(cfg);
+                        for (size_t nthread : opt.threads) {
+                            setThreads(nthread);
+                            Result r = measure(opt, b, c);
+                            r.model = model->name;
+                            r.dtype = dtype_name;
+                            r.op = b.op;
+                            r.variant = b.variant;
+                            r.ntoken = ntoken;
+                            r.context = cfg.context;
+                            r.threads = nthread;
+                            std::printf("%-11s %-8s %5zu %3zu  %-24s %-22s %6zu %11.2f %11.2f %9.2f %8.2f",
+                                        r.model.c_str(), dtype_name, ntoken, nthread, name.c_str(), r.shape.c_str(),
+                                        r.iters, r.median_us, r.p99_us, r.gflops, r.gbps);
+                            if (opt.counters) {
+                                printCounters(r.perf);
+                            }
+                            if (opt.roofline) {
+                                applyRoofline(opt, c, r, *model);
+                                std::printf(" %8.2f %6.1f%% %-7s", r.intensity, 100.0 * r.roof_frac, r.limiter);
+                            }
+                            std::printf("\n");
+                            std::fflush(stdout);
+                            results.push_back(std::move(r));
+                        }
+                    } catch (const std::exception &e) {
+                        std::printf("%-11s %-8s %5zu %3s  %-24s skipped: %s\n", model->name, dtype_name, ntoken, "-",
+                                    name.c_str(), e.what());
+                    }
+                }
+            }
+        }
+    }
+    if (opt.roofline) {
+        printSteps(results);
+    }
+    if (!opt.json.empty()) {
+        try {
+            writeJson(opt.json, opt, results);
+        } catch (const std::exception &e) {
+            std::cerr << "llaisys-bench: " << e.what() << std::endl;
+            return 1;
+        }
+        std::cout << "Wrote " << results.size() << " results to " << opt.json << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,231 @@
+// simd.hpp 须先于其他框架头文件包含
+#include "../../src/utils/simd.hpp"
+
+#include "bench.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace llaisys::bench {
+namespace {
+constexpr size_t kStreamFloats = size_t(24) << 20; // 每个数组 96 MiB，三个数组远大于末级缓存
+constexpr size_t kAccumulators = 12;               // 独立累加链数，足以覆盖 FMA 延迟 × 发射端口数
+constexpr size_t kComputeIters = size_t(1) << 21;
+constexpr int kRepeats = 5; // 各项取最好的一次
+
+using clock = std::chrono::steady_clock;
+
+double seconds(clock::time_point t0) {
+    return std::chrono::duration<double>(clock::now() - t0).count();
+}
+
+// STREAM triad：a[i] = b[i] + s * c[i]，按 STREAM 的口径每个元素计 3 次访存（不计写分配）。
+// 初始化与计算使用相同的静态划分，多路 NUMA 时各线程的数据落在本地节点
+double streamTriad(size_t threads) {
+    const ptrdiff_t n = static_cast<ptrdiff_t>(kStreamFloats);
+    std::unique_ptr<float[]> a(new float[n]), b(new float[n]), c(new float[n]);
+    float *pa = a.get(), *pb = b.get(), *pc = c.get();
+#pragma omp parallel for schedule(static) num_threads(static_cast<int>(threads))
+    for (ptrdiff_t i = 0; i < n; i++) {
+        pa[i] = 0.0f;
+        pb[i] = 1.0f;
+        pc[i] = 2.0f;
+    }
+    const float s = 3.0f;
+    double best = 0.0;
+    for (int rep = 0; rep < kRepeats; rep++) {
+        const auto t0 = clock::now();
+#pragma omp parallel for schedule(static) num_threads(static_cast<int>(threads))
+        for (ptrdiff_t i = 0; i < n; i++) {
+            pa[i] = pb[i] + s * pc[i];
+        }
+        const double dt = seconds(t0);
+        best = std::max(best, 3.0 * sizeof(float) * n / dt);
+    }
+    return best * 1e-9;
+}
+
+// 每个内核做 iters 轮、每轮 kAccumulators 条独立的乘加，返回结果防止被优化掉。
+// 内层循环须完全展开，累加器才能全部留在寄存器中
+float fmaScalar(size_t iters) {
+    float acc[kAccumulators];
+    for (size_t j = 0; j < kAccumulators; j++) {
+        acc[j] = 0.01f * j;
+    }
+    for (size_t i = 0; i < iters; i++) {
+#pragma GCC unroll 16
+        for (size_t j = 0; j < kAccumulators; j++) {
+            acc[j] = acc[j] * 0.999f + 0.001f;
+        }
+    }
+    float sum = 0.0f;
+    for (size_t j = 0; j < kAccumulators; j++) {
+        sum += acc[j];
+    }
+    return sum;
+}
+
+int32_t dotScalar(size_t iters) {
+    int32_t acc[kAccumulators] = {};
+    for (size_t i = 0; i < iters; i++) {
+#pragma GCC unroll 16
+        for (size_t j = 0; j < kAccumulators; j++) {
+            acc[j] += static_cast<int32_t>(static_cast<uint8_t>(i + j)) * static_cast<int32_t>(static_cast<int8_t>(j));
+        }
+    }
+    int32_t sum = 0;
+    for (size_t j = 0; j < kAccumulators; j++) {
+        sum += acc[j];
+    }
+    return sum;
+}
+
+#ifdef LLAISYS_X86_SIMD
+__attribute__((target("avx2,fma"))) float fmaAvx2(size_t iters) {
+    __m256 acc[kAccumulators];
+    for (size_t j = 0; j < kAccumulators; j++) {
+        acc[j] = _mm256_set1_ps(0.01f * j);
+    }
+    const __m256 a = _mm256_set1_ps(0.999f), b = _mm256_set1_ps(0.001f);
+    for (size_t i = 0; i < iters; i++) {
+#pragma GCC unroll 16
+        for (size_t j = 0; j < kAccumulators; j++) {
+            acc[j] = _mm256_fmadd_ps(acc[j], a, b);
+        }
+    }
+    __m256 sum = acc[0];
+    for (size_t j = 1; j < kAccumulators; j++) {
+        sum = _mm256_add_ps(sum, acc[j]);
+    }
+    return utils::hsumAvx2(sum);
+}
+
+__attribute__((target("avx512f"))) float fmaAvx512(size_t iters) {
+    __m512 acc[kAccumulators];
+    for (size_t j = 0; j < kAccumulators; j++) {
+        acc[j] = _mm512_set1_ps(0.01f * j);
+    }
+    const __m512 a = _mm512_set1_ps(0.999f), b = _mm512_set1_ps(0.001f);
+    for (size_t i = 0; i < iters; i++) {
+#pragma GCC unroll 16
+        for (size_t j = 0; j < kAccumulators; j++) {
+            acc[j] = _mm512_fmadd_ps(acc[j], a, b);
+        }
+    }
+    __m512 sum = acc[0];
+    for (size_t j = 1; j < kAccumulators; j++) {
+        sum = _mm512_add_ps(sum, acc[j]);
+    }
+    return _mm512_reduce_add_ps(sum);
+}
+
+// linear_w8a8 的 AVX2 内核每步的乘加指令：vpmaddwd 每条 16 次乘加，再以 vpaddd 累加（不含其中的加载与扩展）。
+// 每条 vpmaddwd 前用空的 asm 屏障让编译器认为 x 已被改写，它才不会作为循环不变量被提到循环外，
+// 或在各累加器间只算一次；屏障不产生指令，x 始终留在同一寄存器中
+__attribute__((target("avx2"))) int32_t dotAvx2(size_t iters) {
+    __m256i acc[kAccumulators];
+    for (size_t j = 0; j < kAccumulators; j++) {
+        acc[j] = _mm256_setzero_si256();
+    }
+    __m256i x = _mm256_set1_epi16(3);
+    const __m256i w = _mm256_set1_epi16(-2);
+    for (size_t i = 0; i < iters; i++) {
+#pragma GCC unroll 16
+        for (size_t j = 0; j < kAccumulators; j++) {
+            asm volatile("" : "+x"(x));
+            acc[j] = _mm256_add_epi32(acc[j], _mm256_madd_epi16(x, w));
+        }
+    }
+    // 各通道的值相同，只取每个累加器的第 0 个通道。整向量归约会让 GCC 把累加器数组留在栈上，循环中出现溢出
+    int32_t sum = 0;
+#pragma GCC unroll 16
+    for (size_t j = 0; j < kAccumulators; j++) {
+        sum += _mm256_cvtsi256_si32(acc[j]);
+    }
+    return sum;
+}
+
+// 与 linear_w8a8 的 VNNI 内核相同：vpdpbusd 每条 64 次 uint8 x int8 乘加
+__attribute__((target("avx512f,avx512bw,avx512vnni"))) int32_t dotVnni(size_t iters) {
+    __m512i acc[kAccumulators];
+    for (size_t j = 0; j < kAccumulators; j++) {
+        acc[j] = _mm512_setzero_si512();
+    }
+    const __m512i x = _mm512_set1_epi8(3), w = _mm512_set1_epi8(-2);
+    for (size_t i = 0; i < iters; i++) {
+#pragma GCC unroll 16
+        for (size_t j = 0; j < kAccumulators; j++) {
+            acc[j] = _mm512_dpbusd_epi32(acc[j], x, w);
+        }
+    }
+    __m512i sum = acc[0];
+    for (size_t j = 1; j < kAccumulators; j++) {
+        sum = _mm512_add_epi32(sum, acc[j]);
+    }
+    return _mm512_reduce_add_epi32(sum);
+}
+#endif
+
+// 各线程同时运行 kernel(iters)，ops_per_iter 为每轮的运算数（乘加计 2 次），返回 G 次/秒
+template <typename Kernel>
+double computePeak(size_t threads, Kernel kernel, double ops_per_iter) {
+    const ptrdiff_t n = static_cast<ptrdiff_t>(threads);
+    std::vector<double> sink(threads);
+    double best = 0.0;
+    for (int rep = 0; rep < kRepeats; rep++) {
+        const auto t0 = clock::now();
+#pragma omp parallel for schedule(static, 1) num_threads(static_cast<int>(threads))
+        for (ptrdiff_t t = 0; t < n; t++) {
+            sink[t] += static_cast<double>(kernel(kComputeIters));
+        }
+        const double dt = seconds(t0);
+        best = std::max(best, ops_per_iter * kComputeIters * n / dt);
+    }
+    volatile double keep = sink[0];
+    (void)keep;
+    return best * 1e-9;
+}
+} // namespace
+
+const char *peakIsa() {
+#ifdef LLAISYS_X86_SIMD
+    if (utils::cpuHasAvx512Vnni()) {
+        return "avx512+vnni";
+    }
+    if (utils::cpuHasAvx512()) {
+        return "avx512";
+    }
+    if (utils::cpuHasAvx2()) {
+        return "avx2+fma";
+    }
+#endif
+    return "scalar";
+}
+
+// 按算子内核的派发顺序选择与之相同的指令集：f32 有 AVX-512 / AVX2 两档，int8 点积有 VNNI / AVX2 两档
+MachinePeaks probeMachine(size_t threads) {
+    MachinePeaks p{threads, streamTriad(threads), 0.0, 0.0};
+#ifdef LLAISYS_X86_SIMD
+    if (utils::cpuHasAvx512()) {
+        p.f32_gflops = computePeak(threads, fmaAvx512, 2.0 * 16 * kAccumulators);
+    } else if (utils::cpuHasAvx2()) {
+        p.f32_gflops = computePeak(threads, fmaAvx2, 2.0 * 8 * kAccumulators);
+    }
+    if (utils::cpuHasAvx512Vnni()) {
+        p.i8_gops = computePeak(threads, dotVnni, 2.0 * 64 * kAccumulators);
+    } else if (utils::cpuHasAvx2()) {
+        p.i8_gops = computePeak(threads, dotAvx2, 2.0 * 16 * kAccumulators);
+    }
+#endif
+    if (p.f32_gflops == 0.0) {
+        p.f32_gflops = computePeak(threads, fmaScalar, 2.0 * kAccumulators);
+    }
+    if (p.i8_gops == 0.0) {
+        p.i8_gops = computePeak(threads, dotScalar, 2.0 * kAccumulators);
+    }
+    return p;
+}
+} // namespace llaisys::bench
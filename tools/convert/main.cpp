@@ -0,0 +1,82 @@
+// llaisys-convert: 把 HuggingFace Qwen2 模型目录转换为单个 .llaisys 打包文件。
+// 权重在转换时一次性变为运行时 dtype（可选仅权重量化），加载时只需 mmap。
+//
+//   llaisys-convert <hf_model_dir> <output.llaisys> [--dtype f32|f16|bf16]
+//                   [--quant int8|int4|int4_zp|fp8|fp8_e5m2] [--group-size N]
+
+#include "../../src/models/qwen2/qwen2.hpp"
+#include "../../src/utils.hpp"
+
+#include <exception>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+using llaisys::models::qwen2::Model;
+
+static int usage(const char *argv0) {
+    std::cerr << "usage: " << argv0 << " <hf_model_dir> <output.llaisys> [--dtype f32|f16|bf16]"
+              << " [--quant int8|int4|int4_zp|fp8|fp8_e5m2] [--group-size N]" << std::endl;
+    return 2;
+}
+
+int main(int argc, char **argv) {
+    if (argc < 3 || argc % 2 == 0) {
+        return usage(argv[0]);
+    }
+    std::string model_dir = argv[1];
+    std::string output = argv[2];
+
+    try {
+        auto meta = llaisys::models::qwen2::loadConfig(model_dir);
+        auto quant = LLAISYS_QWEN2_QUANT_NONE;
+        const char *quant_name = nullptr;
+        size_t group_size = 128;
+        for (int i = 3; i < argc; i += 2) {
+            std::string option = argv[i], value = argv[i + 1];
+            if (option == "--dtype" && value == "f32") {
+                meta.dtype = LLAISYS_DTYPE_F32;
+            } else if (option == "--dtype" && value == "f16") {
+                meta.dtype = LLAISYS_DTYPE_F16;
+            } else if (option == "--dtype" && value == "bf16") {
+                meta.dtype = LLAISYS_DTYPE_BF16;
+            } else if (option == "--quant" && value == "int8") {
+                quant = LLAISYS_QWEN2_QUANT_INT8;
+                quant_name = "int8";
+            } else if (option == "--quant" && value == "int4") {
+                quant = LLAISYS_QWEN2_QUANT_INT4;
+                quant_name = "int4";
+            } else if (option == "--quant" && value == "int4_zp") {
+                quant = LLAISYS_QWEN2_QUANT_INT4_ZP;
+                quant_name = "int4_zp";
+            } else if (option == "--quant" && value == "fp8") {
+                quant = LLAISYS_QWEN2_QUANT_FP8;
+                quant_name = "fp8";
+            } else if (option == "--quant" && value == "fp8_e5m2") {
+                quant = LLAISYS_QWEN2_QUANT_FP8_E5M2;
+                quant_name = "fp8_e5m2";
+            } else if (option == "--group-size") {
+                try {
+                    group_size = std::stoul(value);
+                } catch (const std::exception &) {
+                    return usage(argv[0]);
+                }
+            } else {
+                return usage(argv[0]);
+            }
+        }
+
+        Model model(meta, LLAISYS_DEVICE_CPU, 0);
+        model.loadSafetensors(model_dir);
+        model.quantize(quant, group_size);
+        model.savePacked(output);
+
+        std::cout << "Wrote " << output << " (" << model.namedWeights().size() << " tensors, "
+                  << llaisys::utils::dtype_to_str(meta.dtype)
+                  << (quant_name ? std::string(", ") + quant_name + " weights" : std::string()) << ")" << std::endl;
+    } catch (const std::exception &e) {
+        std::cerr << "llaisys-convert: " << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,485 @@
+// llaisys-decode-bench: 端到端解码基准。按 LlaisysQwen2Meta 构造任意规模的 Qwen2，权重填充随机数，
+// 不需要下载模型也不需要 GPU。对每组 (prompt 长度, batch, 生成长度) 通过调度器接口提交 batch 条序列，
+// 报告首 token 延迟（TTFT）、吞吐、token 间延迟（ITL）的 p50 / p99 与进程峰值内存。
+//
+//   llaisys-decode-bench [--model 0.5b|1.5b|7b] [--layers N] [--hs N] [--nh N] [--nkvh N] [--dh N]
+//                        [--di N] [--voc N] [--dtype f32|f16|bf16]
+//                        [--quant int8|int4|int4_zp|fp8|fp8_e5m2] [--group-size N] [--kv i8|f8|f8e5m2]
+//                        [--prompts N,...] [--batches N,...] [--gens N,...] [--threads N]
+//                        [--seed N] [--json out.json] [--counters] [--devices N,...]
+//
+// --devices 给出 CPU 设备编号（如 1,2），多个设备时按张量并行把各层切分到这些 NUMA 节点上；
+// LLAISYS_CPU_DEVICES 可以在单节点主机上切分出多个设备来验证流程。
+// --counters 时在全部测量结束后按算子汇总 perf_event 计数器（调用次数、耗时占比、IPC、
+// 每千条指令的末级缓存未命中、线程平均占用），系统不允许的计数器显示为 "-"。
+
+#include "../../src/core/trace/trace.hpp"
+#include "../../src/models/qwen2/qwen2.hpp"
+#include "../../src/utils.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <ctime>
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <sys/resource.h>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+using llaisys::models::qwen2::Model;
+using llaisys::models::qwen2::Sequence;
+namespace counters = llaisys::core::trace::counters;
+
+namespace {
+// Qwen2 各规模的 config.json 超参数；tied 表示 lm_head 与 embed_tokens 共享权重
+struct Preset {
+    const char *name;
+    size_t nlayer, hs, nh, nkvh, dh, di, voc;
+    bool tied;
+};
+
+const Preset kPresets[] = {
+    {"qwen2-0.5b", 24, 896, 14, 2, 64, 4864, 151936, true},
+    {"qwen2-1.5b", 28, 1536, 12, 2, 128, 8960, 151936, false},
+    {"qwen2-7b", 28, 3584, 28, 4, 128, 18944, 152064, false},
+};
+
+struct Options {
+    const Preset *preset = &kPresets[0];
+    LlaisysQwen2Meta meta{};
+    llaisysQwen2Quant_t quant = LLAISYS_QWEN2_QUANT_NONE;
+    std::string quant_name = "none";
+    size_t group_size = 128;
+    llaisysDataType_t kv_dtype = LLAISYS_DTYPE_INVALID; // INVALID 表示与模型 dtype 一致
+    std::vector<size_t> prompts = {128};
+    std::vector<size_t> batches = {1};
+    std::vector<size_t> gens = {64};
+    std::vector<int> devices = {0};
+    size_t threads = 0; // 0 表示 OpenMP 默认线程数
+    uint64_t seed = 42;
+    std::string json;
+    bool counters = false;
+};
+
+struct Result {
+    size_t prompt, batch, gen, ntoken;
+    double total_s;
+    double ttft_p50_ms, ttft_max_ms;
+    double itl_p50_ms, itl_p99_ms;
+    double tokens_per_s, decode_tokens_per_s;
+    double peak_mb;
+};
+
+int usage(const char *argv0) {
+    std::cerr << "usage: " << argv0 << " [--model 0.5b|1.5b|7b] [--layers N] [--hs N] [--nh N] [--nkvh N] [--dh N]"
+              << " [--di N] [--voc N] [--dtype f32|f16|bf16] [--quant int8|int4|int4_zp|fp8|fp8_e5m2]"
+              << " [--group-size N] [--kv i8|f8|f8e5m2] [--prompts N,...] [--batches N,...] [--gens N,...]"
+              << " [--threads N] [--seed N] [--json out.json] [--counters] [--devices N,...]" << std::endl;
+    return 2;
+}
+
+std::vector<size_t> parseSizes(const std::string &s) {
+    std::vector<size_t> values;
+    std::stringstream ss(s);
+    std::string item;
+    while (std::getline(ss, item, ',')) {
+        if (!item.empty()) {
+            values.push_back(std::stoul(item));
+        }
+    }
+    CHECK_ARGUMENT(!values.empty() && std::count(values.begin(), values.end(), size_t(0)) == 0,
+                   "expected a list of positive integers: " + s);
+    return values;
+}
+
+size_t parseSize(const std::string &s) {
+    return parseSizes(s).front();
+}
+
+const Preset *parsePreset(const std::string &s) {
+    for (const auto &p : kPresets) {
+        const std::string name = p.name;
+        if (name == s || name == "qwen2-" + s) {
+            return &p;
+        }
+    }
+    throw std::invalid_argument("unknown model: " + s);
+}
+
+// 把权重就地填为均匀分布随机数。矩阵的幅度取 1/sqrt(in_features)，使逐层激活保持数量级不变；
+// norm 权重取 1，偏置取较小的值，避免随机权重下数值溢出使耗时失真
+template <typename T>
+void fillUniform(llaisys::tensor_t t, float lo, float hi, std::mt19937 &gen) {
+    std::uniform_real_distribution<float> dist(lo, hi);
+    T *dst = reinterpret_cast<T *>(t->data());
+    for (size_t i = 0, n = t->numel(); i < n; i++) {
+        dst[i] = llaisys::utils::cast<T>(dist(gen));
+    }
+}
+
+void fillWeight(const std::string &name, llaisys::tensor_t t, std::mt19937 &gen) {
+    float a = 0.02f;
+    if (name.find("norm") != std::string::npos) {
+        a = 0.0f;
+    } else if (t->ndim() == 2 && name.find("embed") == std::string::npos) {
+        a = 1.0f / std::sqrt(static_cast<float>(t->shape()[1]));
+    }
+    const float lo = a == 0.0f ? 1.0f : -a, hi = a == 0.0f ? 1.0f : a;
+    switch (t->dtype()) {
+    case LLAISYS_DTYPE_F32:
+        return fillUniform<float>(t, lo, hi, gen);
+    case LLAISYS_DTYPE_F16:
+        return fillUniform<llaisys::fp16_t>(t, lo, hi, gen);
+    case LLAISYS_DTYPE_BF16:
+        return fillUniform<llaisys::bf16_t>(t, lo, hi, gen);
+    default:
+        EXCEPTION_UNSUPPORTED_DATATYPE(t->dtype());
+    }
+}
+
+// 峰值常驻内存（MB）。Linux 上每组测量前向 /proc/self/clear_refs 写 5 把 VmHWM 重置为当前 RSS，
+// 这样报告的是该组的峰值而不是整个进程生命周期的峰值；不支持时退回 getrusage 的 ru_maxrss
+void resetPeakMemory() {
+    std::ofstream f("/proc/self/clear_refs");
+    if (f.good()) {
+        f << "5";
+    }
+}
+
+double peakMemoryMB() {
+    std::ifstream f("/proc/self/status");
+    std::string line;
+    while (std::getline(f, line)) {
+        if (line.rfind("VmHWM:", 0) == 0) {
+            return std::stod(line.substr(6)) / 1024.0;
+        }
+    }
+    struct rusage usage {};
+    getrusage(RUSAGE_SELF, &usage);
+    return static_cast<double>(usage.ru_maxrss) / 1024.0;
+}
+
+double percentile(std::vector<double> values, double q) {
+    if (values.empty()) {
+        return 0.0;
+    }
+    std::sort(values.begin(), values.end());
+    const size_t rank = static_cast<size_t>(std::ceil(q * values.size()));
+    return values[std::max<size_t>(rank, 1) - 1];
+}
+
+// 提交 batch 条随机 prompt 的序列并逐 step 推进到全部结束，记录每个 token 的产出时刻
+Result run(Model &model, const Options &opt, size_t prompt, size_t batch, size_t gen, std::mt19937 &rng) {
+    using clock = std::chrono::steady_clock;
+    std::uniform_int_distribution<int64_t> token_dist(0, static_cast<int64_t>(opt.meta.voc) - 1);
+    std::vector<std::unique_ptr<Sequence>> seqs;
+    for (size_t i = 0; i < batch; i++) {
+        std::vector<int64_t> ids(prompt);
+        for (auto &id : ids) {
+            id = token_dist(rng);
+        }
+        seqs.push_back(std::make_unique<Sequence>(ids.data(), ids.size(), gen));
+    }
+
+    model.setMaxBatch(batch);
+    resetPeakMemory();
+    const auto t0 = clock::now();
+    for (auto &seq : seqs) {
+        model.submit(seq.get());
+    }
+    // 各序列每个输出 token 距开始的秒数
+    std::vector<std::vector<double>> stamps(batch);
+    std::vector<std::pair<Sequence *, int64_t>> emitted;
+    while (model.numPending() > 0) {
+        emitted.clear();
+        model.step(emitted);
+        const double now = std::chrono::duration<double>(clock::now() - t0).count();
+        for (const auto &e : emitted) {
+            for (size_t i = 0; i < batch; i++) {
+                if (seqs[i].get() == e.first) {
+                    stamps[i].push_back(now);
+                    break;
+                }
+            }
+        }
+    }
+    const double total = std::chrono::duration<double>(clock::now() - t0).count();
+    const double peak = peakMemoryMB();
+    for (auto &seq : seqs) {
+        model.retire(seq.get());
+    }
+
+    Result r{};
+    r.prompt = prompt;
+    r.batch = batch;
+    r.gen = gen;
+    r.total_s = total;
+    r.peak_mb = peak;
+    std::vector<double> ttft, itl;
+    double first_done = 0.0;
+    for (const auto &s : stamps) {
+        r.ntoken += s.size();
+        if (s.empty()) {
+            continue;
+        }
+        ttft.push_back(s.front());
+        first_done = std::max(first_done, s.front());
+        for (size_t j = 1; j < s.size(); j++) {
+            itl.push_back(s[j] - s[j - 1]);
+        }
+    }
+    r.ttft_p50_ms = percentile(ttft, 0.5) * 1e3;
+    r.ttft_max_ms = percentile(ttft, 1.0) * 1e3;
+    r.itl_p50_ms = percentile(itl, 0.5) * 1e3;
+    r.itl_p99_ms = percentile(itl, 0.99) * 1e3;
+    r.tokens_per_s = r.ntoken / total;
+    // decode 吞吐只计全部序列都拿到首 token 之后的阶段，排除 prefill
+    const size_t ndecode = r.ntoken - ttft.size();
+    r.decode_tokens_per_s = total > first_done && ndecode > 0 ? ndecode / (total - first_done) : 0.0;
+    return r;
+}
+
+// 按算子汇总全部测量期间的计数器；qwen2.forward / qwen2.layer 为模型作用域，包含其下的算子
+void printCounters(unsigned available) {
+    auto has = [&](counters::Counter c) { return (available & (1u << c)) != 0; };
+    const auto summary = counters::summary();
+    uint64_t total_ns = 0;
+    for (const auto &[name, t] : summary) {
+        if (name.rfind("qwen2.", 0) != 0) {
+            total_ns += t.time_ns;
+        }
+    }
+    std::printf("\n%-16s %8s %10s %7s %6s %12s %6s\n", "op", "calls", "total_ms", "time%", "IPC", "LLCmiss/kI",
+                "cpu");
+    for (const auto &[name, t] : summary) {
+        const auto &v = t.values;
+        std::printf("%-16s %8llu %10.2f", name.c_str(), static_cast<unsigned long long>(t.calls), t.time_ns * 1e-6);
+        if (name.rfind("qwen2.", 0) == 0 || total_ns == 0) {
+            std::printf(" %7s", "-");
+        } else {
+            std::printf(" %7.1f", 100.0 * t.time_ns / total_ns);
+        }
+        if (has(counters::CYCLES) && has(counters::INSTRUCTIONS) && v[counters::CYCLES] > 0) {
+            std::printf(" %6.2f", static_cast<double>(v[counters::INSTRUCTIONS]) / v[counters::CYCLES]);
+        } else {
+            std::printf(" %6s", "-");
+        }
+        if (has(counters::LLC_MISSES) && has(counters::INSTRUCTIONS) && v[counters::INSTRUCTIONS] > 0) {
+            std::printf(" %12.3f", 1000.0 * v[counters::LLC_MISSES] / v[counters::INSTRUCTIONS]);
+        } else {
+            std::printf(" %12s", "-");
+        }
+        if (has(counters::TASK_CLOCK) && t.time_ns > 0) {
+            std::printf(" %6.2f\n", static_cast<double>(v[counters::TASK_CLOCK]) / t.time_ns);
+        } else {
+            std::printf(" %6s\n", "-");
+        }
+    }
+}
+
+void writeJson(const Options &opt, const std::vector<Result> &results) {
+    std::ofstream f(opt.json);
+    CHECK_ARGUMENT(f.good(), "cannot open " + opt.json);
+    const auto &m = opt.meta;
+    char num[64];
+    auto fmt = [&](double v) {
+        std::snprintf(num, sizeof(num), "%.6g", v);
+        return std::string(num);
+    };
+    f << "{\n  \"timestamp\": " << static_cast<long long>(std::time(nullptr)) << ",\n  \"model\": \""
+      << opt.preset->name << "\",\n  \"meta\": {\"nlayer\": " << m.nlayer << ", \"hs\": " << m.hs << ", \"nh\": " << m.nh
+      << ", \"nkvh\": " << m.nkvh << ", \"dh\": " << m.dh << ", \"di\": " << m.di << ", \"voc\": " << m.voc
+      << "},\n  \"dtype\": \"" << llaisys::utils::dtype_to_str(m.dtype) << "\",\n  \"quant\": \"" << opt.quant_name
+      << "\",\n  \"kv_dtype\": \""
+      << llaisys::utils::dtype_to_str(opt.kv_dtype == LLAISYS_DTYPE_INVALID ? m.dtype : opt.kv_dtype)
+      << "\",\n  \"threads\": " << opt.threads << ",\n  \"results\": [";
+    for (size_t i = 0; i < results.size(); i++) {
+        const Result &r = results[i];
+        f << (i ? ",\n" : "\n") << "    {\"prompt\": " << r.prompt << ", \"batch\": " << r.batch << ", \"gen\": " << r.gen
+          << ", \"ntoken\": " << r.ntoken << ", \"total_s\": " << fmt(r.total_s)
+          << ", \"ttft_p50_ms\": " << fmt(r.ttft_p50_ms) << ", \"ttft_max_ms\": " << fmt(r.ttft_max_ms)
+          << ", \"itl_p50_ms\": " << fmt(r.itl_p50_ms) << ", \"itl_p99_ms\": " << fmt(r.itl_p99_ms)
+          << ", \"tokens_per_s\": " << fmt(r.tokens_per_s) << ", \"decode_tokens_per_s\": " << fmt(r.decode_tokens_per_s)
+          << ", \"peak_mb\": " << fmt(r.peak_mb) << "}";
+    }
+    f << "\n  ]\n}\n";
+}
+} // namespace
+
+int main(int argc, char **argv) {
+    Options opt;
+    // 先确定预设，显式给出的维度再覆盖预设
+    std::vector<std::pair<std::string, std::string>> overrides;
+    try {
+        for (int i = 1; i < argc; i++) {
+            const std::string option = argv[i];
+            if (option == "--counters") {
+                opt.counters = true;
+                continue;
+            }
+            if (i + 1 >= argc) {
+                return usage(argv[0]);
+            }
+            const std::string value = argv[++i];
+            if (option == "--model") {
+                opt.preset = parsePreset(value);
+            } else {
+                overrides.emplace_back(option, value);
+            }
+        }
+        const Preset &p = *opt.preset;
+        opt.meta = {LLAISYS_DTYPE_BF16, p.nlayer, p.hs, p.nh, p.nkvh, p.dh, p.di, 0, p.voc, 1e-6f, 1000000.0f, -1};
+        for (const auto &[option, value] : overrides) {
+            if (option == "--layers") {
+                opt.meta.nlayer = parseSize(value);
+            } else if (option == "--hs") {
+                opt.meta.hs = parseSize(value);
+            } else if (option == "--nh") {
+                opt.meta.nh = parseSize(value);
+            } else if (option == "--nkvh") {
+                opt.meta.nkvh = parseSize(value);
+            } else if (option == "--dh") {
+                opt.meta.dh = parseSize(value);
+            } else if (option == "--di") {
+                opt.meta.di = parseSize(value);
+            } else if (option == "--voc") {
+                opt.meta.voc = parseSize(value);
+            } else if (option == "--dtype" && value == "f32") {
+                opt.meta.dtype = LLAISYS_DTYPE_F32;
+            } else if (option == "--dtype" && value == "f16") {
+                opt.meta.dtype = LLAISYS_DTYPE_F16;
+            } else if (option == "--dtype" && value == "bf16") {
+                opt.meta.dtype = LLAISYS_DTYPE_BF16;
+            } else if (option == "--quant" && value == "int8") {
+                opt.quant = LLAISYS_QWEN2_QUANT_INT8;
+                opt.quant_name = value;
+            } else if (option == "--quant" && value == "int4") {
+                opt.quant = LLAISYS_QWEN2_QUANT_INT4;
+                opt.quant_name = value;
+            } else if (option == "--quant" && value == "int4_zp") {
+                opt.quant = LLAISYS_QWEN2_QUANT_INT4_ZP;
+                opt.quant_name = value;
+            } else if (option == "--quant" && value == "fp8") {
+                opt.quant = LLAISYS_QWEN2_QUANT_FP8;
+                opt.quant_name = value;
+            } else if (option == "--quant" && value == "fp8_e5m2") {
+                opt.quant = LLAISYS_QWEN2_QUANT_FP8_E5M2;
+                opt.quant_name = value;
+            } else if (option == "--group-size") {
+                opt.group_size = parseSize(value);
+            } else if (option == "--kv" && value == "i8") {
+                opt.kv_dtype = LLAISYS_DTYPE_I8;
+            } else if (option == "--kv" && value == "f8") {
+                opt.kv_dtype = LLAISYS_DTYPE_F8;
+            } else if (option == "--kv" && value == "f8e5m2") {
+                opt.kv_dtype = LLAISYS_DTYPE_F8E5M2;
+            } else if (option == "--prompts") {
+                opt.prompts = parseSizes(value);
+            } else if (option == "--batches") {
+                opt.batches = parseSizes(value);
+            } else if (option == "--gens") {
+                opt.gens = parseSizes(value);
+            } else if (option == "--threads") {
+                opt.threads = parseSize(value);
+            } else if (option == "--devices") {
+                const auto ids = parseSizes(value);
+                opt.devices.assign(ids.begin(), ids.end());
+            } else if (option == "--seed") {
+                opt.seed = std::stoull(value);
+            } else if (option == "--json") {
+                opt.json = value;
+            } else {
+                return usage(argv[0]);
+            }
+        }
+    } catch (const std::exception &e) {
+        std::cerr << "llaisys-decode-bench: " << e.what() << std::endl;
+        return usage(argv[0]);
+    }
+    // 随机权重下 end_token 设为 -1，每条序列都生成满 gen 个 token
+    opt.meta.maxseq = *std::max_element(opt.prompts.begin(), opt.prompts.end())
+                    + *std::max_element(opt.gens.begin(), opt.gens.end()) + 1;
+#ifdef _OPENMP
+    if (opt.threads > 0) {
+        omp_set_num_threads(static_cast<int>(opt.threads));
+    }
+    opt.threads = static_cast<size_t>(omp_get_max_threads());
+#else
+    CHECK_ARGUMENT(opt.threads <= 1, "built without OpenMP: only --threads 1 is available");
+    opt.threads = 1;
+#endif
+
+    std::vector<Result> results;
+    try {
+        const auto &m = opt.meta;
+        const auto t_build = std::chrono::steady_clock::now();
+        Model model(m, LLAISYS_DEVICE_CPU, opt.devices);
+        if (opt.preset->tied) {
+            model.weights().out_embed = model.weights().in_embed;
+        }
+        std::mt19937 gen(static_cast<std::mt19937::result_type>(opt.seed));
+        size_t nparam = 0;
+        for (const auto &[name, t] : model.namedWeights()) {
+            if (opt.preset->tied && t == model.weights().in_embed && name != "model.embed_tokens.weight") {
+                continue;
+            }
+            fillWeight(name, t, gen);
+            nparam += t->numel();
+        }
+        model.quantize(opt.quant, opt.group_size);
+        if (opt.kv_dtype != LLAISYS_DTYPE_INVALID) {
+            model.setKVCacheDtype(opt.kv_dtype);
+        }
+        const double build_s = std::chrono::duration<double>(std::chrono::steady_clock::now() - t_build).count();
+        std::printf("%s: nlayer=%zu hs=%zu nh=%zu nkvh=%zu dh=%zu di=%zu voc=%zu, %.1fM params, %s, quant %s, "
+                    "%zu threads, %zu devices, built in %.1f s\n",
+                    opt.preset->name, m.nlayer, m.hs, m.nh, m.nkvh, m.dh, m.di, m.voc, nparam * 1e-6,
+                    llaisys::utils::dtype_to_str(m.dtype), opt.quant_name.c_str(), opt.threads, opt.devices.size(),
+                    build_s);
+
+        // 先跑一次很短的生成，让激活缓冲区、线程池等一次性开销不计入第一组的 TTFT
+        run(model, opt, std::min<size_t>(opt.prompts.front(), 8), 1, 2, gen);
+        unsigned available = 0;
+        if (opt.counters) {
+            available = counters::setEnabled(true);
+        }
+
+        std::printf("%7s %5s %5s %9s %10s %10s %10s %10s %10s %12s %9s\n", "prompt", "batch", "gen", "total_s",
+                    "ttft_p50", "ttft_max", "itl_p50", "itl_p99", "tok/s", "decode_tok/s", "peak_MB");
+        for (size_t prompt : opt.prompts) {
+            for (size_t batch : opt.batches) {
+                for (size_t ngen : opt.gens) {
+                    const Result r = run(model, opt, prompt, batch, ngen, gen);
+                    std::printf("%7zu %5zu %5zu %9.3f %10.2f %10.2f %10.2f %10.2f %10.2f %12.2f %9.1f\n", r.prompt,
+                                r.batch, r.gen, r.total_s, r.ttft_p50_ms, r.ttft_max_ms, r.itl_p50_ms, r.itl_p99_ms,
+                                r.tokens_per_s, r.decode_tokens_per_s, r.peak_mb);
+                    std::fflush(stdout);
+                    results.push_back(r);
+                }
+            }
+        }
+        if (opt.counters) {
+            printCounters(available);
+        }
+        if (!opt.json.empty()) {
+            writeJson(opt, results);
+            std::cout << "Wrote " << results.size() << " results to " << opt.json << std::endl;
+        }
+    } catch (const std::exception &e) {
+        std::cerr << "llaisys-decode-bench: " << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -3,6 +3,8 @@ set_encodings("utf-8")
 
 add_includedirs("include")
 
+add_requires("openmp")
+
 -- CPU --
 includes("xmake/cpu.lua")
 
@@ -95,6 +97,21 @@ target("llaisys-ops")
     on_install(function (target) end)
 target_end()
 
+target("llaisys-models")
+    set_kind("static")
+    add_deps("llaisys-ops")
+
+    set_languages("cxx17")
+    set_warnings("all", "error")
+    if not is_plat("windows") then
+        add_cxflags("-fPIC", "-Wno-unknown-pragmas")
+    end
+
+    add_files("src/models/*/*.cpp")
+
+    on_install(function (target) end)
+target_end()
+
 target("llaisys")
     set_kind("shared")
     add_deps("llaisys-utils")
@@ -102,10 +119,13 @@ target("llaisys")
     add_deps("llaisys-core")
     add_deps("llaisys-tensor")
     add_deps("llaisys-ops")
+    add_deps("llaisys-models")
+    add_packages("openmp")
 
     set_languages("cxx17")
     set_warnings("all", "error")
     add_files("src/llaisys/*.cc")
+    add_files("src/llaisys/models/*.cc")
     set_installdir(".")
 
     
@@ -119,4 +139,48 @@ target("llaisys")
             os.cp("lib/*.so", "python/llaisys/libllaisys/")
         end
     end)
-target_end()
\ No newline at end of file
+target_end()
+
+target("llaisys-convert")
+    set_kind("binary")
+    add_deps("llaisys-utils")
+    add_deps("llaisys-device")
+    add_deps("llaisys-core")
+    add_deps("llaisys-tensor")
+    add_deps("llaisys-ops")
+    add_deps("llaisys-models")
+    add_packages("openmp")
+
+    set_languages("cxx17")
+    set_warnings("all", "error")
+    add_files("tools/convert/*.cpp")
+target_end()
+
+target("llaisys-bench")
+    set_kind("binary")
+    add_deps("llaisys-utils")
+    add_deps("llaisys-device")
+    add_deps("llaisys-core")
+    add_deps("llaisys-tensor")
+    add_deps("llaisys-ops")
+    add_packages("openmp")
+
+    set_languages("cxx17")
+    set_warnings("all", "error")
+    add_files("tools/bench/*.cpp")
+target_end()
+
+target("llaisys-decode-bench")
+    set_kind("binary")
+    add_deps("llaisys-utils")
+    add_deps("llaisys-device")
+    add_deps("llaisys-core")
+    add_deps("llaisys-tensor")
+    add_deps("llaisys-ops")
+    add_deps("llaisys-models")
+    add_packages("openmp")
+
+    set_languages("cxx17")
+    set_warnings("all", "error")
+    add_files("tools/decode_bench/*.cpp")
+target_end()